@@ -291,7 +291,7 @@ ifneq ("$(wildcard $(KEYBOARD_PATH_5)/info.json)","")
     INFO_JSON_FILES += $(KEYBOARD_PATH_5)/info.json
 endif
 
-CONFIG_H += $(KEYBOARD_OUTPUT)/src/info_config.h $(KEYBOARD_OUTPUT)/src/layouts.h
+CONFIG_H += $(KEYBOARD_OUTPUT)/src/info_config.h $(KEYBOARD_OUTPUT)/src/layouts.h $(KEYBOARD_OUTPUT)/src/led_config.h
 
 $(KEYBOARD_OUTPUT)/src/info_config.h: $(INFO_JSON_FILES)
 	bin/qmk generate-config-h --quiet --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/info_config.h
@@ -299,7 +299,10 @@ $(KEYBOARD_OUTPUT)/src/info_config.h: $(INFO_JSON_FILES)
 $(KEYBOARD_OUTPUT)/src/layouts.h: $(INFO_JSON_FILES)
 	bin/qmk generate-layouts --quiet --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/layouts.h
 
-generated-files: $(KEYBOARD_OUTPUT)/src/info_config.h $(KEYBOARD_OUTPUT)/src/layouts.h
+$(KEYBOARD_OUTPUT)/src/led_config.h: $(INFO_JSON_FILES)
+	bin/qmk generate-led-config --quiet --keyboard $(KEYBOARD) --output $(KEYBOARD_OUTPUT)/src/led_config.h
+
+generated-files: $(KEYBOARD_OUTPUT)/src/info_config.h $(KEYBOARD_OUTPUT)/src/layouts.h $(KEYBOARD_OUTPUT)/src/led_config.h
 
 .INTERMEDIATE : generated-files
 
@@ -329,6 +332,15 @@ ifneq ("$(wildcard $(KEYMAP_PATH)/config.h)","")
     CONFIG_H += $(KEYMAP_PATH)/config.h
 endif
 
+# Compile the keymap through a generated file that adds the sparse keymap tables
+ifeq ($(strip $(SPARSE_KEYMAP_ENABLE)), yes)
+    SPARSE_KEYMAP_SOURCE := $(KEYMAP_C)
+    KEYMAP_C := $(KEYMAP_OUTPUT)/src/sparse_keymap.c
+
+$(KEYMAP_OUTPUT)/src/sparse_keymap.c: $(SPARSE_KEYMAP_SOURCE) $(INFO_JSON_FILES)
+	bin/qmk sparse-keymap --quiet --no-cpp --keyboard $(KEYBOARD) --output $@ $<
+endif
+
 # project specific files
 SRC += $(KEYBOARD_SRC) \
     $(KEYMAP_C) \
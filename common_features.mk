@@ -200,6 +200,7 @@ ifeq ($(strip $(RGBLIGHT_ENABLE)), yes)
         OPT_DEFS += -DRGBLIGHT_ENABLE
         SRC += $(QUANTUM_DIR)/color.c
         SRC += $(QUANTUM_DIR)/rgblight.c
+        SRC += $(QUANTUM_DIR)/lighting_power.c
         CIE1931_CURVE := yes
         RGB_KEYCODES_ENABLE := yes
     endif
@@ -228,8 +229,13 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
         BACKLIGHT_ENABLE = yes
         BACKLIGHT_DRIVER = custom
         OPT_DEFS += -DLED_MATRIX_ENABLE
+ifneq (,$(filter $(MCU), atmega16u2 atmega32u2 at90usb162))
+        # ATmegaxxU2 does not have hardware MUL instruction - lib8tion must be told to use software multiplication routines
+        OPT_DEFS += -DLIB8_ATTINY
+endif
         SRC += $(QUANTUM_DIR)/led_matrix.c
         SRC += $(QUANTUM_DIR)/led_matrix_drivers.c
+        SRC += $(QUANTUM_DIR)/lighting_keyframes.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), IS31FL3731)
@@ -255,6 +261,8 @@ endif
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix.c
     SRC += $(QUANTUM_DIR)/rgb_matrix_drivers.c
+    SRC += $(QUANTUM_DIR)/lighting_keyframes.c
+    SRC += $(QUANTUM_DIR)/lighting_power.c
     CIE1931_CURVE := yes
     RGB_KEYCODES_ENABLE := yes
 
@@ -370,7 +378,7 @@ ifeq ($(strip $(BACKLIGHT_ENABLE)), yes)
     endif
 endif
 
-VALID_WS2812_DRIVER_TYPES := bitbang pwm spi i2c
+VALID_WS2812_DRIVER_TYPES := bitbang pwm spi i2c custom
 
 WS2812_DRIVER ?= bitbang
 ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
@@ -382,6 +390,8 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
 
     ifeq ($(strip $(WS2812_DRIVER)), bitbang)
         SRC += ws2812.c
+    else ifeq ($(strip $(WS2812_DRIVER)), custom)
+        # the keyboard provides ws2812_setleds()
     else
         SRC += ws2812_$(strip $(WS2812_DRIVER)).c
 
@@ -449,11 +459,35 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     OPT_DEFS += -DVIA_ENABLE
 endif
 
+ifeq ($(strip $(EVENT_TRACE_ENABLE)), yes)
+    RAW_ENABLE := yes
+    SRC += $(QUANTUM_DIR)/event_trace.c
+    OPT_DEFS += -DEVENT_TRACE_ENABLE
+endif
+
+ifeq ($(strip $(ADAPTIVE_TAPPING_TERM_ENABLE)), yes)
+    SRC += $(QUANTUM_DIR)/adaptive_tapping.c
+    OPT_DEFS += -DADAPTIVE_TAPPING_TERM_ENABLE
+endif
+
+ifeq ($(strip $(I2C_QUEUE_ENABLE)), yes)
+    OPT_DEFS += -DI2C_QUEUE_ENABLE
+    QUANTUM_LIB_SRC += i2c_master.c i2c_queue.c
+endif
+
 ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     OPT_DEFS += -DDYNAMIC_KEYMAP_ENABLE
     SRC += $(QUANTUM_DIR)/dynamic_keymap.c
 endif
 
+ifeq ($(strip $(SPARSE_KEYMAP_ENABLE)), yes)
+    ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
+        $(error SPARSE_KEYMAP_ENABLE is not compatible with DYNAMIC_KEYMAP_ENABLE, the dynamic keymap is reset from the dense keymaps array)
+    endif
+    OPT_DEFS += -DSPARSE_KEYMAP_ENABLE
+    SRC += $(QUANTUM_DIR)/sparse_keymap.c
+endif
+
 ifeq ($(strip $(DIP_SWITCH_ENABLE)), yes)
     OPT_DEFS += -DDIP_SWITCH_ENABLE
     SRC += $(QUANTUM_DIR)/dip_switch.c
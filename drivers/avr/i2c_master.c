@@ -24,6 +24,12 @@
 #include "timer.h"
 #include "wait.h"
 
+#ifdef I2C_QUEUE_ENABLE
+#    include <avr/interrupt.h>
+#    include <util/atomic.h>
+#    include "i2c_queue.h"
+#endif
+
 #ifndef F_SCL
 #    define F_SCL 400000UL  // SCL frequency
 #endif
@@ -47,7 +53,117 @@ void i2c_init(void) {
 #endif
 }
 
+#ifdef I2C_QUEUE_ENABLE
+// Transfer of the queue in progress, driven by the TWI interrupt
+static volatile bool  i2c_async_active = false;
+static volatile bool  i2c_async_reading;
+static uint8_t        i2c_async_address;
+static const uint8_t *i2c_async_tx;
+static uint8_t *      i2c_async_rx;
+static uint16_t       i2c_async_tx_length;
+static uint16_t       i2c_async_rx_length;
+static uint16_t       i2c_async_index;
+
+void i2c_async_start(uint8_t address, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length, uint16_t timeout) {
+    i2c_async_address   = address;
+    i2c_async_tx        = tx;
+    i2c_async_tx_length = tx_length;
+    i2c_async_rx        = rx;
+    i2c_async_rx_length = rx_length;
+    i2c_async_index     = 0;
+    i2c_async_reading   = tx_length == 0;
+    i2c_async_active    = true;
+
+    // wait for the STOP condition of the previous transfer to go out
+    while (TWCR & (1 << TWSTO)) {
+    }
+
+    // transmit START condition, the rest happens in the interrupt
+    TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+}
+
+static void i2c_async_finish(i2c_status_t status) {
+    // transmit STOP condition, with the interrupt off
+    TWCR             = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+    i2c_async_active = false;
+    i2c_queue_complete(status);
+}
+
+void i2c_async_abort(void) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (i2c_async_active) {
+            i2c_async_finish(I2C_STATUS_TIMEOUT);
+        }
+    }
+}
+
+static void i2c_async_interrupt(void) {
+    switch (TW_STATUS & 0xF8) {
+        case TW_START:
+        case TW_REP_START:
+            TWDR = i2c_async_address | (i2c_async_reading ? I2C_READ : I2C_WRITE);
+            TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+            break;
+
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+            if (i2c_async_index < i2c_async_tx_length) {
+                TWDR = i2c_async_tx[i2c_async_index++];
+                TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+            } else if (i2c_async_rx_length) {
+                // transmit repeated START condition for the read
+                i2c_async_reading = true;
+                i2c_async_index   = 0;
+                TWCR              = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+            } else {
+                i2c_async_finish(I2C_STATUS_SUCCESS);
+            }
+            break;
+
+        case TW_MR_DATA_ACK:
+            i2c_async_rx[i2c_async_index++] = TWDR;
+            // fall through
+        case TW_MR_SLA_ACK:
+            // acknowledge all but the last byte
+            TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE) | ((i2c_async_index + 1 < i2c_async_rx_length) << TWEA);
+            break;
+
+        case TW_MR_DATA_NACK:
+            i2c_async_rx[i2c_async_index++] = TWDR;
+            i2c_async_finish(I2C_STATUS_SUCCESS);
+            break;
+
+        default:
+            // not acknowledged, arbitration lost or bus error
+            i2c_async_finish(I2C_STATUS_ERROR);
+            break;
+    }
+}
+
+// Implemented by i2c_slave.c when it is linked in, it shares the TWI interrupt
+__attribute__((weak)) void i2c_slave_interrupt(void) {}
+
+ISR(TWI_vect) {
+    if (i2c_async_active) {
+        i2c_async_interrupt();
+    } else {
+        i2c_slave_interrupt();
+    }
+}
+#endif
+
 i2c_status_t i2c_start(uint8_t address, uint16_t timeout) {
+#ifdef I2C_QUEUE_ENABLE
+    // let the queued transfer in progress finish, and start no other until i2c_stop()
+    i2c_queue_hold();
+    uint16_t queue_timer = timer_read();
+    while (i2c_async_active) {
+        if ((timeout != I2C_TIMEOUT_INFINITE) && ((timer_read() - queue_timer) >= timeout)) {
+            i2c_async_abort();
+        }
+    }
+#endif
+
     // reset TWI control register
     TWCR = 0;
     // transmit START condition
@@ -221,4 +337,8 @@ error:
 void i2c_stop(void) {
     // transmit STOP condition
     TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWSTO);
+
+#ifdef I2C_QUEUE_ENABLE
+    i2c_queue_release();
+#endif
 }
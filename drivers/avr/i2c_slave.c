@@ -41,7 +41,12 @@ void i2c_slave_stop(void) {
     TWCR &= ~((1 << TWEA) | (1 << TWEN));
 }
 
+#ifdef I2C_QUEUE_ENABLE
+// The interrupt handler is in i2c_master.c, which runs queued transfers from it too
+void i2c_slave_interrupt(void) {
+#else
 ISR(TWI_vect) {
+#endif
     uint8_t ack = 1;
 
     switch (TW_STATUS) {
@@ -29,6 +29,10 @@
 #include <string.h>
 #include <hal.h>
 
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
+
 static uint8_t i2c_address;
 
 static const I2CConfig i2cconfig = {
@@ -57,6 +61,77 @@ static i2c_status_t chibios_to_qmk(const msg_t* status) {
     }
 }
 
+#ifdef I2C_QUEUE_ENABLE
+// Queued transfers are made by a thread, which sleeps while the DMA driven I2C driver transfers
+static MUTEX_DECL(i2c_mutex);
+static BSEMAPHORE_DECL(i2c_async_request, true);
+static THD_WORKING_AREA(waI2CQueueThread, 256);
+static thread_t *i2c_async_thread = NULL;
+
+static struct {
+    uint8_t        address;
+    const uint8_t *tx;
+    uint16_t       tx_length;
+    uint8_t *      rx;
+    uint16_t       rx_length;
+    uint16_t       timeout;
+} i2c_async;
+
+static THD_FUNCTION(I2CQueueThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_queue");
+
+    while (true) {
+        chBSemWait(&i2c_async_request);
+
+        chMtxLock(&i2c_mutex);
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t status;
+        if (i2c_async.tx_length) {
+            status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_async.address >> 1), i2c_async.tx, i2c_async.tx_length, i2c_async.rx, i2c_async.rx_length, TIME_MS2I(i2c_async.timeout));
+        } else {
+            status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_async.address >> 1), i2c_async.rx, i2c_async.rx_length, TIME_MS2I(i2c_async.timeout));
+        }
+        chMtxUnlock(&i2c_mutex);
+
+        // starts the next queued transfer, if any
+        i2c_queue_complete(chibios_to_qmk(&status));
+    }
+}
+
+void i2c_async_start(uint8_t address, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length, uint16_t timeout) {
+    i2c_async.address   = address;
+    i2c_async.tx        = tx;
+    i2c_async.tx_length = tx_length;
+    i2c_async.rx        = rx;
+    i2c_async.rx_length = rx_length;
+    i2c_async.timeout   = timeout;
+
+    if (!i2c_async_thread) {
+        i2c_async_thread = chThdCreateStatic(waI2CQueueThread, sizeof(waI2CQueueThread), NORMALPRIO + 1, I2CQueueThread, NULL);
+    }
+    chBSemSignal(&i2c_async_request);
+}
+
+// The I2C driver times the transfer out on its own
+void i2c_async_abort(void) {}
+#endif
+
+// Take the bus over from the queue for a blocking transfer
+static void i2c_lock(void) {
+#ifdef I2C_QUEUE_ENABLE
+    i2c_queue_hold();
+    chMtxLock(&i2c_mutex);
+#endif
+}
+
+static void i2c_unlock(void) {
+#ifdef I2C_QUEUE_ENABLE
+    chMtxUnlock(&i2c_mutex);
+    i2c_queue_release();
+#endif
+}
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -78,26 +153,33 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
+    i2c_lock();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_unlock();
     return I2C_STATUS_SUCCESS;
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
+    i2c_unlock();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
+    i2c_unlock();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -108,14 +190,21 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
     complete_packet[0] = regaddr;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
+    i2c_unlock();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
+    i2c_unlock();
     return chibios_to_qmk(&status);
 }
 
-void i2c_stop(void) { i2cStop(&I2C_DRIVER); }
+void i2c_stop(void) {
+    i2c_lock();
+    i2cStop(&I2C_DRIVER);
+    i2c_unlock();
+}
@@ -15,6 +15,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "DRV2605L.h"
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 #include "print.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -26,10 +29,19 @@ uint8_t DRV2605L_read_register;
 void DRV_write(uint8_t drv_register, uint8_t settings) {
     DRV2605L_transfer_buffer[0] = drv_register;
     DRV2605L_transfer_buffer[1] = settings;
+#ifdef I2C_QUEUE_ENABLE
+    // Feedback is not worth stalling the scan for, but goes ahead of LED and display data
+    i2c_queue_transmit(I2C_PRIORITY_NORMAL, DRV2605L_BASE_ADDRESS << 1, DRV2605L_transfer_buffer, 2, 100, NULL, NULL);
+#else
     i2c_transmit(DRV2605L_BASE_ADDRESS << 1, DRV2605L_transfer_buffer, 2, 100);
+#endif
 }
 
 uint8_t DRV_read(uint8_t regaddress) {
+#ifdef I2C_QUEUE_ENABLE
+    // Read after the writes queued before
+    i2c_queue_flush();
+#endif
     i2c_readReg(DRV2605L_BASE_ADDRESS << 1, regaddress, &DRV2605L_read_register, 1, 100);
 
     return DRV2605L_read_register;
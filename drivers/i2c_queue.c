@@ -0,0 +1,237 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "i2c_queue.h"
+#include "timer.h"
+
+/*
+ * A slot goes from free to pending when a transfer is queued, to active when it is started, and to
+ * done when the platform driver reports it complete. Only i2c_queue_task() makes it free again.
+ *
+ * Starting the next transfer happens in i2c_queue_complete(), in the interrupt handler or thread
+ * of the platform driver, so the bus does not sit idle until the next scan. The main loop only
+ * starts one when nothing is in progress, which is when the driver cannot be completing one.
+ */
+
+// Keeps the compiler from moving accesses to the slot fields across the change of state handing the
+// slot over to the other side
+#define I2C_QUEUE_BARRIER() __asm__ volatile("" ::: "memory")
+
+enum { I2C_SLOT_FREE, I2C_SLOT_PENDING, I2C_SLOT_ACTIVE, I2C_SLOT_DONE };
+
+typedef struct {
+    volatile uint8_t      state;
+    uint8_t               priority;
+    uint8_t               sequence;  // order of queueing, for transfers of the same priority
+    uint8_t               address;
+    uint16_t              tx_length;
+    uint16_t              rx_length;
+    uint16_t              timeout;
+    uint16_t              queued;   // when the transfer was queued
+    uint16_t              started;  // when the transfer was started
+    volatile i2c_status_t status;
+    uint8_t *             rx;
+    i2c_queue_callback_t  callback;
+    void *                context;
+    uint8_t               tx[I2C_QUEUE_TRANSFER_SIZE];
+} i2c_queue_slot_t;
+
+static i2c_queue_slot_t           i2c_queue_slots[I2C_QUEUE_SIZE];
+static i2c_queue_slot_t *volatile i2c_queue_active;
+static volatile bool              i2c_queue_held;
+static uint8_t                    i2c_queue_sequence;
+static i2c_queue_stats_t          i2c_queue_stats;
+
+static void i2c_queue_start_next(void) {
+    i2c_queue_slot_t *next = NULL;
+
+    if (!i2c_queue_held) {
+        for (uint8_t i = 0; i < I2C_QUEUE_SIZE; i++) {
+            i2c_queue_slot_t *slot = &i2c_queue_slots[i];
+            if (slot->state != I2C_SLOT_PENDING) {
+                continue;
+            }
+            I2C_QUEUE_BARRIER();
+            if (!next || slot->priority < next->priority || (slot->priority == next->priority && (int8_t)(slot->sequence - next->sequence) < 0)) {
+                next = slot;
+            }
+        }
+    }
+
+    i2c_queue_active = next;
+    if (next) {
+        next->state   = I2C_SLOT_ACTIVE;
+        next->started = timer_read();
+
+        uint16_t wait = TIMER_DIFF_16(next->started, next->queued);
+        if (wait > i2c_queue_stats.max_wait[next->priority]) {
+            i2c_queue_stats.max_wait[next->priority] = wait;
+        }
+
+        i2c_async_start(next->address, next->tx, next->tx_length, next->rx, next->rx_length, next->timeout);
+    }
+}
+
+static bool i2c_queue_add(i2c_priority_t priority, uint8_t address, uint8_t regaddr, bool has_reg, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length, uint16_t timeout, i2c_queue_callback_t callback, void *context) {
+    i2c_queue_slot_t *slot = NULL;
+
+    if (priority < I2C_PRIORITIES && has_reg + tx_length <= I2C_QUEUE_TRANSFER_SIZE) {
+        for (uint8_t i = 0; i < I2C_QUEUE_SIZE && !slot; i++) {
+            if (i2c_queue_slots[i].state == I2C_SLOT_FREE) {
+                slot = &i2c_queue_slots[i];
+            }
+        }
+    }
+    if (!slot) {
+        i2c_queue_stats.rejected++;
+        return false;
+    }
+
+    slot->priority  = priority;
+    slot->sequence  = i2c_queue_sequence++;
+    slot->address   = address;
+    slot->tx_length = has_reg + tx_length;
+    slot->rx_length = rx_length;
+    slot->timeout   = timeout;
+    slot->queued    = timer_read();
+    slot->rx        = rx;
+    slot->callback  = callback;
+    slot->context   = context;
+    slot->tx[0]     = regaddr;
+    if (tx_length) {
+        memcpy(&slot->tx[has_reg], tx, tx_length);
+    }
+
+    // Last, the driver may pick it up from now on
+    I2C_QUEUE_BARRIER();
+    slot->state = I2C_SLOT_PENDING;
+
+    if (!i2c_queue_active) {
+        i2c_queue_start_next();
+    }
+    return true;
+}
+
+/** \brief Queue a write
+ *
+ * Returns false when the queue is full or the data does not fit in a slot, the transfer is then
+ * not made.
+ */
+bool i2c_queue_transmit(i2c_priority_t priority, uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context) {
+    return i2c_queue_add(priority, address, 0, false, data, length, NULL, 0, timeout, callback, context);
+}
+
+bool i2c_queue_receive(i2c_priority_t priority, uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context) {
+    return i2c_queue_add(priority, address, 0, false, NULL, 0, data, length, timeout, callback, context);
+}
+
+bool i2c_queue_writeReg(i2c_priority_t priority, uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context) {
+    return i2c_queue_add(priority, devaddr, regaddr, true, data, length, NULL, 0, timeout, callback, context);
+}
+
+bool i2c_queue_readReg(i2c_priority_t priority, uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context) {
+    return i2c_queue_add(priority, devaddr, regaddr, true, NULL, 0, data, length, timeout, callback, context);
+}
+
+void i2c_queue_complete(i2c_status_t status) {
+    i2c_queue_slot_t *slot = i2c_queue_active;
+    if (!slot) {
+        return;
+    }
+
+    i2c_queue_stats.busy_time += timer_elapsed(slot->started);
+    if (status == I2C_STATUS_SUCCESS) {
+        i2c_queue_stats.transfers[slot->priority]++;
+        i2c_queue_stats.bytes += slot->tx_length + slot->rx_length;
+    } else {
+        i2c_queue_stats.errors++;
+    }
+
+    slot->status = status;
+    I2C_QUEUE_BARRIER();
+    slot->state = I2C_SLOT_DONE;
+    i2c_queue_start_next();
+}
+
+/** \brief Call the callbacks of the completed transfers, and time out a stuck one
+ */
+void i2c_queue_task(void) {
+    i2c_queue_slot_t *active = i2c_queue_active;
+    if (active && active->timeout != I2C_TIMEOUT_INFINITE && timer_elapsed(active->started) > active->timeout) {
+        i2c_async_abort();
+    }
+
+    for (uint8_t i = 0; i < I2C_QUEUE_SIZE; i++) {
+        i2c_queue_slot_t *slot = &i2c_queue_slots[i];
+        if (slot->state != I2C_SLOT_DONE) {
+            continue;
+        }
+        I2C_QUEUE_BARRIER();
+
+        i2c_queue_callback_t callback = slot->callback;
+        void *               context  = slot->context;
+        i2c_status_t         status   = slot->status;
+        slot->state                   = I2C_SLOT_FREE;
+        if (callback) {
+            callback(status, context);
+        }
+    }
+
+    if (!i2c_queue_active) {
+        i2c_queue_start_next();
+    }
+}
+
+/** \brief Wait until every queued transfer has completed
+ */
+void i2c_queue_flush(void) {
+    while (i2c_queue_busy()) {
+        i2c_queue_task();
+    }
+}
+
+bool i2c_queue_busy(void) {
+    for (uint8_t i = 0; i < I2C_QUEUE_SIZE; i++) {
+        if (i2c_queue_slots[i].state != I2C_SLOT_FREE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t i2c_queue_free(void) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < I2C_QUEUE_SIZE; i++) {
+        count += i2c_queue_slots[i].state == I2C_SLOT_FREE;
+    }
+    return count;
+}
+
+void i2c_queue_hold(void) { i2c_queue_held = true; }
+
+void i2c_queue_release(void) {
+    i2c_queue_held = false;
+    if (!i2c_queue_active) {
+        i2c_queue_start_next();
+    }
+}
+
+bool i2c_queue_transferring(void) { return i2c_queue_active != NULL; }
+
+const i2c_queue_stats_t *i2c_queue_get_stats(void) { return &i2c_queue_stats; }
+
+void i2c_queue_clear_stats(void) { memset(&i2c_queue_stats, 0, sizeof(i2c_queue_stats)); }
@@ -0,0 +1,99 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2c_master.h"
+
+#ifndef I2C_TIMEOUT_INFINITE
+#    define I2C_TIMEOUT_INFINITE (0xFFFF)
+#endif
+
+/*
+ * Queued I2C transfers.
+ *
+ * Drivers sending data nothing waits for, such as LED drivers and displays, queue their transfers
+ * instead of blocking the main loop on them. The platform I2C driver runs the queue in the
+ * background, from the TWI interrupt on AVR and from a thread waiting on the DMA driven I2C driver
+ * on ChibiOS, and starts the next transfer as soon as one has completed.
+ *
+ * The next transfer is the oldest one of the highest priority. The blocking functions of
+ * i2c_master.h, used by the split transport and the I2C EEPROM driver, wait for the transfer in
+ * progress and then go ahead of everything queued.
+ *
+ * Data to write is copied into the queue. Data read is stored in the given buffer, which has to
+ * stay valid until the transfer has completed. Callbacks are called from i2c_queue_task().
+ */
+
+// Transfers that can be queued at once, each takes I2C_QUEUE_TRANSFER_SIZE + 20 bytes of RAM
+#ifndef I2C_QUEUE_SIZE
+#    ifdef __AVR__
+#        define I2C_QUEUE_SIZE 4
+#    else
+#        define I2C_QUEUE_SIZE 16
+#    endif
+#endif
+
+// Largest write that can be queued, register address included: one OLED block and its register
+#ifndef I2C_QUEUE_TRANSFER_SIZE
+#    define I2C_QUEUE_TRANSFER_SIZE 33
+#endif
+
+typedef enum {
+    I2C_PRIORITY_HIGH,
+    I2C_PRIORITY_NORMAL,  // haptic feedback
+    I2C_PRIORITY_BULK,    // LED drivers and displays
+    I2C_PRIORITIES,
+} i2c_priority_t;
+
+typedef void (*i2c_queue_callback_t)(i2c_status_t status, void *context);
+
+typedef struct {
+    uint32_t transfers[I2C_PRIORITIES];  // transfers completed
+    uint32_t bytes;                      // bytes written and read
+    uint32_t busy_time;                  // time a queued transfer was in progress (ms)
+    uint16_t max_wait[I2C_PRIORITIES];   // longest time a transfer waited in the queue (ms)
+    uint16_t errors;                     // transfers that failed or timed out
+    uint16_t rejected;                   // transfers not queued, the queue was full or they were too large
+} i2c_queue_stats_t;
+
+bool    i2c_queue_transmit(i2c_priority_t priority, uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context);
+bool    i2c_queue_receive(i2c_priority_t priority, uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context);
+bool    i2c_queue_writeReg(i2c_priority_t priority, uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context);
+bool    i2c_queue_readReg(i2c_priority_t priority, uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_queue_callback_t callback, void *context);
+void    i2c_queue_task(void);
+void    i2c_queue_flush(void);
+bool    i2c_queue_busy(void);
+uint8_t i2c_queue_free(void);
+
+const i2c_queue_stats_t *i2c_queue_get_stats(void);
+void                     i2c_queue_clear_stats(void);
+
+// For the blocking functions of the platform driver: no queued transfer is started between the two
+void i2c_queue_hold(void);
+void i2c_queue_release(void);
+bool i2c_queue_transferring(void);
+
+// Called by the platform driver when the transfer started by i2c_async_start() has finished,
+// from its interrupt handler or thread
+void i2c_queue_complete(i2c_status_t status);
+
+// Implemented by the platform driver: write tx then read rx, with a repeated start, in the
+// background. i2c_async_abort() ends a transfer that timed out, if the driver does not on its own.
+void i2c_async_start(uint8_t address, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length, uint16_t timeout);
+void i2c_async_abort(void);
@@ -17,6 +17,10 @@
 
 #include "is31fl3731.h"
 #include "i2c_master.h"
+#ifdef I2C_QUEUE_ENABLE
+#    include <string.h>
+#    include "i2c_queue.h"
+#endif
 #include "wait.h"
 
 // This is a 7-bit address, that gets left-shifted and bit 0
@@ -53,6 +57,11 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+// A frame is queued only when the whole of it fits in the queue
+#if defined(I2C_QUEUE_ENABLE) && I2C_QUEUE_SIZE >= 9
+#    define ISSI_QUEUE_FRAMES
+#endif
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
@@ -67,6 +76,31 @@ bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
+#if defined(ISSI_QUEUE_FRAMES) && ISSI_PERSISTENCE > 0
+// Where the PWM transfers of each driver go, and how many more times each of them is tried
+static uint8_t g_pwm_transfer_addr[DRIVER_COUNT];
+static uint8_t g_pwm_transfer_tries[DRIVER_COUNT][9];
+
+// Called from i2c_queue_task() with the 16 bytes of g_pwm_buffer the transfer sent, queues it
+// again when it failed
+static void IS31FL3731_pwm_transfer_done(i2c_status_t status, void *context) {
+    uint16_t offset   = (uint8_t *)context - &g_pwm_buffer[0][0];
+    uint8_t  index    = offset / 144;
+    uint8_t  transfer = offset % 144 / 16;
+
+    if (status == I2C_STATUS_SUCCESS || --g_pwm_transfer_tries[index][transfer] == 0) {
+        return;
+    }
+
+    g_twi_transfer_buffer[0] = 0x24 + transfer * 16;
+    memcpy(&g_twi_transfer_buffer[1], context, 16);
+    if (!i2c_queue_transmit(I2C_PRIORITY_BULK, g_pwm_transfer_addr[index] << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT, IS31FL3731_pwm_transfer_done, context)) {
+        // No room, send the whole frame again on the next update
+        g_pwm_buffer_update_required[index] = true;
+    }
+}
+#endif
+
 // This is the bit pattern in the LED control registers
 // (for matrix A, add one to register for matrix B)
 //
@@ -111,7 +145,16 @@ void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
             g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
         }
 
-#if ISSI_PERSISTENCE > 0
+#if defined(ISSI_QUEUE_FRAMES) && ISSI_PERSISTENCE > 0
+        // Copied into the queue, sent in the background behind the split transport and EEPROM,
+        // and queued again by the callback when it fails
+        uint8_t index                       = (pwm_buffer - &g_pwm_buffer[0][0]) / 144;
+        g_pwm_transfer_addr[index]          = addr;
+        g_pwm_transfer_tries[index][i / 16] = ISSI_PERSISTENCE;
+        i2c_queue_transmit(I2C_PRIORITY_BULK, addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT, IS31FL3731_pwm_transfer_done, &pwm_buffer[i]);
+#elif defined(ISSI_QUEUE_FRAMES)
+        i2c_queue_transmit(I2C_PRIORITY_BULK, addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT, NULL, NULL);
+#elif ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
             if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
         }
@@ -221,6 +264,12 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
+#ifdef ISSI_QUEUE_FRAMES
+    // Send the whole frame on a later update rather than part of it now
+    if (g_pwm_buffer_update_required[index] && i2c_queue_free() < 9) {
+        return;
+    }
+#endif
     if (g_pwm_buffer_update_required[index]) {
         IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
     }
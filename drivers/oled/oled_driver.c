@@ -15,6 +15,9 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "i2c_master.h"
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 #include "oled_driver.h"
 #include OLED_FONT_H
 #include "timer.h"
@@ -87,14 +90,29 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // i2c defines
 #define I2C_CMD 0x00
 #define I2C_DATA 0x40
+#ifdef I2C_QUEUE_ENABLE
+// Commands go out after the blocks already queued, a scroll has to start after them
+#    define I2C_FLUSH() i2c_queue_flush()
+#else
+#    define I2C_FLUSH() ((void)0)
+#endif
 #if defined(__AVR__)
-#    define I2C_TRANSMIT_P(data) i2c_transmit_P((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
+#    define I2C_TRANSMIT_P(data) (I2C_FLUSH(), i2c_transmit_P((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT))
 #else  // defined(__AVR__)
-#    define I2C_TRANSMIT_P(data) i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
+#    define I2C_TRANSMIT_P(data) (I2C_FLUSH(), i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT))
 #endif  // defined(__AVR__)
-#define I2C_TRANSMIT(data) i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
+#define I2C_TRANSMIT(data) (I2C_FLUSH(), i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT))
 #define I2C_WRITE_REG(mode, data, size) i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT)
 
+// Rendering is bulk data: queued behind the split transport and EEPROM, without waiting for it
+#ifdef I2C_QUEUE_ENABLE
+#    define I2C_RENDER_TRANSMIT(data) (i2c_queue_transmit(I2C_PRIORITY_BULK, (OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT, NULL, NULL) ? I2C_STATUS_SUCCESS : I2C_STATUS_ERROR)
+#    define I2C_RENDER_WRITE_REG(mode, data, size) (i2c_queue_writeReg(I2C_PRIORITY_BULK, (OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT, NULL, NULL) ? I2C_STATUS_SUCCESS : I2C_STATUS_ERROR)
+#else
+#    define I2C_RENDER_TRANSMIT(data) I2C_TRANSMIT(data)
+#    define I2C_RENDER_WRITE_REG(mode, data, size) I2C_WRITE_REG(mode, data, size)
+#endif
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 
 // Display buffer's is the same as the OLED memory layout
@@ -281,6 +299,15 @@ void oled_render(void) {
         return;
     }
 
+#ifdef I2C_QUEUE_ENABLE
+    _Static_assert(OLED_BLOCK_SIZE < I2C_QUEUE_TRANSFER_SIZE, "I2C_QUEUE_TRANSFER_SIZE has to hold an OLED block and its register");
+
+    // Render the block later rather than lose half of it
+    if (i2c_queue_free() < 2) {
+        return;
+    }
+#endif
+
     // Find first dirty block
     uint8_t update_start = 0;
     while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
@@ -296,14 +323,14 @@ void oled_render(void) {
     }
 
     // Send column & page position
-    if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
+    if (I2C_RENDER_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
         print("oled_render offset command failed\n");
         return;
     }
 
     if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
         // Send render data chunk as is
-        if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+        if (I2C_RENDER_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
             print("oled_render data failed\n");
             return;
         }
@@ -319,7 +346,7 @@ void oled_render(void) {
         }
 
         // Send render data chunk after rotating
-        if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+        if (I2C_RENDER_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
             print("oled_render90 data failed\n");
             return;
         }
@@ -0,0 +1,174 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "i2c_master.h"
+#include "timer.h"
+
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
+
+void set_time(uint32_t t);
+
+i2c_fake_transfer_t i2c_fake_log[I2C_FAKE_LOG_SIZE];
+uint16_t            i2c_fake_log_count;
+uint8_t             i2c_fake_nack_address;
+bool                i2c_fake_stalled;
+
+static uint32_t             i2c_fake_now;
+static uint32_t             i2c_fake_busy;
+static uint32_t             i2c_fake_blocked;
+static i2c_fake_transfer_t *i2c_fake_active;
+
+void i2c_fake_reset(void) {
+    i2c_fake_log_count    = 0;
+    i2c_fake_nack_address = 0;
+    i2c_fake_stalled      = false;
+    i2c_fake_now          = 0;
+    i2c_fake_busy         = 0;
+    i2c_fake_blocked      = 0;
+    i2c_fake_active       = NULL;
+    set_time(0);
+}
+
+uint32_t i2c_fake_time(void) { return i2c_fake_now; }
+
+uint32_t i2c_fake_busy_time(void) { return i2c_fake_busy; }
+
+uint32_t i2c_fake_blocked_time(void) { return i2c_fake_blocked; }
+
+/** \brief How long a transfer takes on the bus (us)
+ *
+ * Nine clocks per byte, address bytes included, plus the start, repeated start and stop conditions.
+ */
+uint32_t i2c_fake_duration(uint16_t tx_length, uint16_t rx_length) {
+    uint32_t bits = 2;
+    if (tx_length) {
+        bits += (1 + tx_length) * 9;
+    }
+    if (rx_length) {
+        bits += 1 + (1 + rx_length) * 9;
+    }
+    return (bits * 1000000 + I2C_FAKE_CLOCK - 1) / I2C_FAKE_CLOCK;
+}
+
+static void i2c_fake_advance(uint32_t us) {
+    i2c_fake_now += us;
+    set_time(i2c_fake_now / 1000);
+}
+
+static i2c_fake_transfer_t *i2c_fake_begin(uint8_t address, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length, bool queued) {
+    i2c_fake_transfer_t *transfer = &i2c_fake_log[i2c_fake_log_count < I2C_FAKE_LOG_SIZE - 1 ? i2c_fake_log_count++ : i2c_fake_log_count];
+
+    transfer->address   = address;
+    transfer->first     = tx_length ? tx[0] : 0;
+    transfer->queued    = queued;
+    transfer->tx_length = tx_length;
+    transfer->rx_length = rx_length;
+    transfer->start     = i2c_fake_now;
+    transfer->end       = i2c_fake_now + i2c_fake_duration(tx_length, rx_length);
+    transfer->status    = address == i2c_fake_nack_address ? I2C_STATUS_ERROR : I2C_STATUS_SUCCESS;
+
+    for (uint16_t i = 0; i < rx_length && transfer->status == I2C_STATUS_SUCCESS; i++) {
+        rx[i] = transfer->first + i;
+    }
+    return transfer;
+}
+
+#ifdef I2C_QUEUE_ENABLE
+static void i2c_fake_finish(i2c_status_t status) {
+    i2c_fake_transfer_t *transfer = i2c_fake_active;
+
+    transfer->end    = i2c_fake_now;
+    transfer->status = status;
+    i2c_fake_busy += transfer->end - transfer->start;
+    i2c_fake_active = NULL;
+    i2c_queue_complete(status);
+}
+
+void i2c_async_start(uint8_t address, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length, uint16_t timeout) {
+    i2c_fake_active = i2c_fake_begin(address, tx, tx_length, rx, rx_length, true);
+}
+
+void i2c_async_abort(void) {
+    if (i2c_fake_active) {
+        i2c_fake_finish(I2C_STATUS_TIMEOUT);
+    }
+}
+#endif
+
+/** \brief Let the bus and the timer run for us microseconds
+ *
+ * Queued transfers that end in that time complete, at the time they end.
+ */
+void i2c_fake_run(uint32_t us) {
+    uint32_t end = i2c_fake_now + us;
+
+#ifdef I2C_QUEUE_ENABLE
+    while (i2c_fake_active && !i2c_fake_stalled && i2c_fake_active->end <= end) {
+        if (i2c_fake_active->end > i2c_fake_now) {
+            i2c_fake_advance(i2c_fake_active->end - i2c_fake_now);
+        }
+        i2c_fake_finish(i2c_fake_active->status);
+    }
+#endif
+
+    i2c_fake_advance(end - i2c_fake_now);
+}
+
+static i2c_status_t i2c_fake_blocking(uint8_t address, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length, uint16_t timeout) {
+    uint32_t start = i2c_fake_now;
+
+#ifdef I2C_QUEUE_ENABLE
+    // Wait for the queued transfer in progress
+    i2c_queue_hold();
+    while (i2c_fake_active) {
+        if (i2c_fake_stalled) {
+            i2c_fake_advance(timeout * 1000);
+            i2c_async_abort();
+        } else {
+            i2c_fake_run(i2c_fake_active->end - i2c_fake_now);
+        }
+    }
+#endif
+
+    i2c_fake_transfer_t *transfer = i2c_fake_begin(address, tx, tx_length, rx, rx_length, false);
+    i2c_fake_advance(transfer->end - transfer->start);
+    i2c_fake_busy += transfer->end - transfer->start;
+    i2c_fake_blocked += i2c_fake_now - start;
+
+#ifdef I2C_QUEUE_ENABLE
+    i2c_queue_release();
+#endif
+    return transfer->status;
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) { return i2c_fake_blocking(address, data, length, NULL, 0, timeout); }
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) { return i2c_fake_blocking(address, NULL, 0, data, length, timeout); }
+
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    uint8_t packet[length + 1];
+    packet[0] = regaddr;
+    for (uint16_t i = 0; i < length; i++) {
+        packet[i + 1] = data[i];
+    }
+    return i2c_fake_blocking(devaddr, packet, length + 1, NULL, 0, timeout);
+}
+
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) { return i2c_fake_blocking(devaddr, &regaddr, 1, data, length, timeout); }
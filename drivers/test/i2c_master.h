@@ -0,0 +1,76 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Fake I2C bus for the tests.
+ *
+ * Transfers take as long as they would on a bus running at I2C_FAKE_CLOCK, with a microsecond
+ * clock that drives the test timer. Every transfer is logged, so tests can check the order they
+ * went out in and how busy the bus was. Reads return the register address plus the byte offset.
+ */
+
+#define I2C_READ 0x01
+#define I2C_WRITE 0x00
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+#define I2C_TIMEOUT_IMMEDIATE (0)
+#define I2C_TIMEOUT_INFINITE (0xFFFF)
+
+#ifndef I2C_FAKE_CLOCK
+#    define I2C_FAKE_CLOCK 400000
+#endif
+
+#define I2C_FAKE_LOG_SIZE 512
+
+typedef struct {
+    uint8_t      address;
+    uint8_t      first;   // first byte written, the register or command
+    bool         queued;  // made by the queue, not by a blocking function
+    uint16_t     tx_length;
+    uint16_t     rx_length;
+    uint32_t     start;  // us
+    uint32_t     end;    // us
+    i2c_status_t status;
+} i2c_fake_transfer_t;
+
+extern i2c_fake_transfer_t i2c_fake_log[I2C_FAKE_LOG_SIZE];
+extern uint16_t            i2c_fake_log_count;
+extern uint8_t             i2c_fake_nack_address;  // transfers to this address are not acknowledged
+extern bool                i2c_fake_stalled;       // transfers do not end, as with a device holding the clock low
+
+void     i2c_fake_reset(void);
+void     i2c_fake_run(uint32_t us);
+uint32_t i2c_fake_time(void);
+uint32_t i2c_fake_busy_time(void);
+uint32_t i2c_fake_blocked_time(void);
+uint32_t i2c_fake_duration(uint16_t tx_length, uint16_t rx_length);
+
+void         i2c_init(void);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout);
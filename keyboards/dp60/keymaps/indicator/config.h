@@ -22,4 +22,6 @@
 #define RGBLED_NUM  (18+RGB_INDICATOR_NUM)
 
 #define RGB_INDICATOR_PIN B1
+// indicator.c sends the last RGB_INDICATOR_NUM LEDs to their own pin
+#define RGBLIGHT_DISABLE_PARTIAL_UPDATES
 #define RGBLIGHT_LAYERS
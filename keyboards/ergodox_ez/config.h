@@ -88,6 +88,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define RGBLIGHT_HUE_STEP 12
 #define RGBLIGHT_SAT_STEP 255
 #define RGBLIGHT_VAL_STEP 12
+// led_i2c.c splits the strip between the halves
+#define RGBLIGHT_DISABLE_PARTIAL_UPDATES
 
 // Pick one of the modes
 // Defaults to 15 mirror, for legacy behavior
@@ -91,6 +91,8 @@
 #define RGB_DI_PIN B4  // reserved pin for future usage
 #define RGBLED_NUM 20
 #define RGBLIGHT_ANIMATIONS
+// the ring redraws from rgblight when it goes back to the QMK effects
+#define RGBLIGHT_DISABLE_PARTIAL_UPDATES
 
 #define DRIVER_ADDR_1 0b1110100
 #define DRIVER_COUNT 1
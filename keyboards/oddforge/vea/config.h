@@ -39,6 +39,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define RGBLIGHT_ANIMATIONS
 #define RGBLIGHT_SLEEP
 #define RGBLIGHT_EFFECT_KNIGHT_OFFSET 9
+// vea_setleds() splits the strip between the halves
+#define RGBLIGHT_DISABLE_PARTIAL_UPDATES
 
 #define LED_NUM_LOCK_PIN D0
 #define LED_CAPS_LOCK_PIN D1
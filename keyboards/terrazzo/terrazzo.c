@@ -44,6 +44,57 @@ const is31_led g_is31_leds[DRIVER_LED_TOTAL] = {
     {0, C2_15},{0, C2_14},{0, C2_13},{0, C2_12},{0, C2_11},{0, C2_10},{0, C2_9}
 };
 
+/* The LEDs are not under keys. LED_MATRIX_ROWS run across the board and LED_MATRIX_COLS down it,
+ * for the effects that use the LED positions.
+ */
+led_config_t g_led_config = {
+    {
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+        {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    },
+    {
+        {  0,  0}, {  0, 11}, {  0, 21}, {  0, 32}, {  0, 43}, {  0, 53}, {  0, 64},
+        { 16,  0}, { 16, 11}, { 16, 21}, { 16, 32}, { 16, 43}, { 16, 53}, { 16, 64},
+        { 32,  0}, { 32, 11}, { 32, 21}, { 32, 32}, { 32, 43}, { 32, 53}, { 32, 64},
+        { 48,  0}, { 48, 11}, { 48, 21}, { 48, 32}, { 48, 43}, { 48, 53}, { 48, 64},
+        { 64,  0}, { 64, 11}, { 64, 21}, { 64, 32}, { 64, 43}, { 64, 53}, { 64, 64},
+        { 80,  0}, { 80, 11}, { 80, 21}, { 80, 32}, { 80, 43}, { 80, 53}, { 80, 64},
+        { 96,  0}, { 96, 11}, { 96, 21}, { 96, 32}, { 96, 43}, { 96, 53}, { 96, 64},
+        {112,  0}, {112, 11}, {112, 21}, {112, 32}, {112, 43}, {112, 53}, {112, 64},
+        {128,  0}, {128, 11}, {128, 21}, {128, 32}, {128, 43}, {128, 53}, {128, 64},
+        {144,  0}, {144, 11}, {144, 21}, {144, 32}, {144, 43}, {144, 53}, {144, 64},
+        {160,  0}, {160, 11}, {160, 21}, {160, 32}, {160, 43}, {160, 53}, {160, 64},
+        {176,  0}, {176, 11}, {176, 21}, {176, 32}, {176, 43}, {176, 53}, {176, 64},
+        {192,  0}, {192, 11}, {192, 21}, {192, 32}, {192, 43}, {192, 53}, {192, 64},
+        {208,  0}, {208, 11}, {208, 21}, {208, 32}, {208, 43}, {208, 53}, {208, 64},
+        {224,  0}, {224, 11}, {224, 21}, {224, 32}, {224, 43}, {224, 53}, {224, 64},
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4,
+    },
+};
+
 #define TERRAZZO_EFFECT(name)
 #define TERRAZZO_EFFECT_IMPLS
 
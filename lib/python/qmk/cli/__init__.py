@@ -26,6 +26,8 @@ from . import kle2json
 from . import new
 from . import pyformat
 from . import pytest
+from . import sparse_keymap
+from . import trace
 
 # Supported version information
 #
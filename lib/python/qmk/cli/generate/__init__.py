@@ -4,5 +4,6 @@ from . import dfu_header
 from . import docs
 from . import info_json
 from . import layouts
+from . import led_config
 from . import rgb_breathe_table
 from . import rules_mk
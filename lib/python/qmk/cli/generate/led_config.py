@@ -0,0 +1,142 @@
+"""Used by the make system to generate led_config.h from info.json.
+"""
+from milc import cli
+
+from qmk.decorators import automagic_keyboard, automagic_keymap
+from qmk.info import info_json
+from qmk.path import is_keyboard, normpath
+
+led_features = {
+    'rgb_matrix': 'RGB_MATRIX',
+    'led_matrix': 'LED_MATRIX',
+}
+
+NO_KEY = 255
+
+
+def led_config_tables(leds, rows, cols):
+    """Returns the key to LEDs and LED to key tables for an LED layout.
+
+    The LEDs of every key are stored one key after another, in matrix order, so the LEDs of the key at row, col are key_leds[offsets[row * cols + col]:offsets[row * cols + col + 1]].
+
+    Args:
+        leds
+            The LEDs of an rgb_matrix or led_matrix layout in info.json, in LED index order.
+
+        rows, cols
+            The size of the matrix.
+
+    Returns:
+        offsets, key_leds, led_keys
+    """
+    keys = [[] for i in range(rows * cols)]
+    led_keys = []
+
+    for led_index, led in enumerate(leds):
+        if 'matrix' not in led:
+            led_keys.append((NO_KEY, NO_KEY))
+            continue
+
+        row, col = led['matrix']
+        if row >= rows or col >= cols:
+            raise ValueError('Matrix position %s, %s of LED %s is out of bounds' % (row, col, led_index))
+
+        keys[row * cols + col].append(led_index)
+        led_keys.append((row, col))
+
+    offsets = [0]
+    key_leds = []
+    for key in keys:
+        key_leds.extend(key)
+        offsets.append(len(key_leds))
+
+    return offsets, key_leds, led_keys
+
+
+def led_config_initializer(leds, rows, cols):
+    """Returns the lines of a led_config_t initializer for an LED layout: the first LED of every key, and the position and flags of every LED.
+    """
+    matrix_co = [['NO_LED'] * cols for row in range(rows)]
+    for led_index, led in reversed(list(enumerate(leds))):
+        if 'matrix' in led:
+            row, col = led['matrix']
+            matrix_co[row][col] = str(led_index)
+
+    lines = ['{', '    {']
+    lines.extend('        {%s},' % ', '.join(row) for row in matrix_co)
+    lines.append('    },')
+    lines.append('    {%s},' % ', '.join('{%d, %d}' % (led['x'], led['y']) for led in leds))
+    lines.append('    {%s},' % ', '.join(str(led['flags']) for led in leds))
+    lines.append('}')
+
+    return lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-kb', '--keyboard', help='Keyboard to generate led_config.h for.')
+@cli.subcommand('Used by the make system to generate led_config.h from info.json', hidden=True)
+@automagic_keyboard
+@automagic_keymap
+def generate_led_config(cli):
+    """Generates the led_config.h file.
+    """
+    # Determine our keyboard(s)
+    if not cli.config.generate_led_config.keyboard:
+        cli.log.error('Missing parameter: --keyboard')
+        cli.subcommands['info'].print_help()
+        return False
+
+    if not is_keyboard(cli.config.generate_led_config.keyboard):
+        cli.log.error('Invalid keyboard: "%s"', cli.config.generate_led_config.keyboard)
+        return False
+
+    # Build the info.json file
+    kb_info_json = info_json(cli.config.generate_led_config.keyboard)
+
+    # Build the led_config.h file.
+    led_config_h_lines = ['/* This file was generated by `qmk generate-led-config`. Do not edit or copy.' ' */', '', '#pragma once']
+
+    for feature, prefix in led_features.items():
+        leds = kb_info_json.get(feature, {}).get('layout')
+        if not leds:
+            continue
+
+        if 'matrix_size' not in kb_info_json:
+            cli.log.error('%s: No matrix size for the %s layout.', cli.config.generate_led_config.keyboard, feature)
+            return False
+
+        try:
+            offsets, key_leds, led_keys = led_config_tables(leds, kb_info_json['matrix_size']['rows'], kb_info_json['matrix_size']['cols'])
+        except ValueError as e:
+            cli.log.error('%s: %s layout: %s', cli.config.generate_led_config.keyboard, feature, e)
+            return False
+
+        if len(key_leds) > 255:
+            cli.log.error('%s: %s layout has more than 255 LEDs on keys.', cli.config.generate_led_config.keyboard, feature)
+            return False
+
+        led_config_h_lines.append('')
+        led_config_h_lines.append('// clang-format off')
+        led_config_h_lines.append('#define %s_KEY_LED_OFFSETS %s' % (prefix, ', '.join(str(offset) for offset in offsets)))
+        led_config_h_lines.append('#define %s_KEY_LEDS %s' % (prefix, ', '.join(str(led) for led in key_leds) or 'NO_LED'))
+        led_config_h_lines.append('#define %s_LED_KEYS %s' % (prefix, ', '.join('{%d, %d}' % key for key in led_keys)))
+        led_config_h_lines.append('#define %s_KEY_LEDS_MAX %d' % (prefix, max(end - start for start, end in zip(offsets, offsets[1:]))))
+        led_config_h_lines.append('#define %s_LED_CONFIG \\' % prefix)
+        led_config_h_lines.append(' \\\n'.join(led_config_initializer(leds, kb_info_json['matrix_size']['rows'], kb_info_json['matrix_size']['cols'])))
+        led_config_h_lines.append('// clang-format on')
+
+    # Show the results
+    led_config_h = '\n'.join(led_config_h_lines) + '\n'
+
+    if cli.args.output:
+        cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+        if cli.args.output.exists():
+            cli.args.output.replace(cli.args.output.parent / (cli.args.output.name + '.bak'))
+        cli.args.output.write_text(led_config_h)
+
+        if not cli.args.quiet:
+            cli.log.info('Wrote led_config.h to %s.', cli.args.output)
+
+    else:
+        print(led_config_h)
@@ -0,0 +1,94 @@
+"""Compile a keymap into sparse keymap tables.
+"""
+import json
+import os
+
+from milc import cli
+
+import qmk.keymap
+import qmk.path
+from qmk.info import info_json
+
+
+@cli.argument('--no-cpp', arg_only=True, action='store_false', help='Do not use \'cpp\' on keymap.c')
+@cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-kb', '--keyboard', arg_only=True, help='The keyboard\'s name, required for keymap.c files')
+@cli.argument('filename', arg_only=True, type=qmk.path.normpath, help='keymap.c or keymap.json file')
+@cli.subcommand('Creates sparse keymap tables for SPARSE_KEYMAP_ENABLE from a keymap.c or keymap.json file.')
+def sparse_keymap(cli):
+    """Compile a keymap into sparse keymap tables.
+
+    The generated file includes the keymap.c and adds the tables that quantum/sparse_keymap.c reads. Transparent keys are left out, so layers that are mostly KC_TRNS take up a fraction of the flash of the dense keymaps array.
+    """
+    if not cli.args.filename.exists():
+        cli.log.error('Keymap file {fg_cyan}%s{style_reset_all} does not exist!', cli.args.filename)
+        return False
+
+    if cli.args.filename.suffix == '.json':
+        user_keymap = json.loads(cli.args.filename.read_text(encoding='utf-8'))
+        keyboard = cli.args.keyboard or user_keymap['keyboard']
+        layout = user_keymap['layout']
+        layers = user_keymap['layers']
+        layer_names = None
+        keymap_c = qmk.keymap.generate_c(keyboard, layout, layers)
+
+    else:
+        if not cli.args.keyboard:
+            cli.log.error('Missing parameter: --keyboard')
+            return False
+
+        keymap = qmk.keymap.parse_keymap_c(cli.args.filename, use_cpp=cli.args.no_cpp)
+        if not keymap['layers']:
+            cli.log.error('No keymaps array found in {fg_cyan}%s{style_reset_all}. Try to use --no-cpp.', cli.args.filename)
+            return False
+
+        keyboard = cli.args.keyboard
+        layout = keymap['layers'][0]['layout']
+        layers = [layer['keycodes'] for layer in keymap['layers']]
+        keymap_c = str(cli.args.filename)
+        if cli.args.output:
+            keymap_c = os.path.relpath(keymap_c, cli.args.output.parent)
+
+        try:
+            layer_names = qmk.keymap.sparse_layer_names(keymap['layers'])
+        except ValueError as e:
+            cli.log.error(e)
+            return False
+
+    # Find the matrix position of every key in the layout
+    kb_info_json = info_json(keyboard)
+    layout = kb_info_json.get('layout_aliases', {}).get(layout, layout)
+
+    if layout not in kb_info_json['layouts']:
+        cli.log.error('Unknown layout %s for keyboard %s. Layers have to use a LAYOUT macro of the keyboard, not a wrapper around one.', layout, keyboard)
+        return False
+
+    positions = [key.get('matrix') for key in kb_info_json['layouts'][layout]['layout']]
+    if None in positions:
+        cli.log.error('Layout %s of keyboard %s has no matrix positions.', layout, keyboard)
+        return False
+
+    rows = kb_info_json['matrix_size']['rows']
+    cols = kb_info_json['matrix_size']['cols']
+
+    try:
+        sparse_c, dense_size, sparse_size = qmk.keymap.generate_sparse_c(keymap_c, layers, positions, rows, cols, layer_names)
+    except ValueError as e:
+        cli.log.error(e)
+        return False
+
+    if cli.args.output:
+        cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+        cli.args.output.write_text(sparse_c)
+
+        if not cli.args.quiet:
+            cli.log.info('Wrote sparse keymap to %s.', cli.args.output)
+
+    else:
+        print(sparse_c)
+
+    if not cli.args.quiet:
+        cli.log.info('%d layers: dense keymap %d bytes, sparse keymap %d bytes.', len(layers), dense_size, sparse_size)
+
+    return True
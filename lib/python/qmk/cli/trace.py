@@ -0,0 +1,183 @@
+"""Decode the binary event trace sent by EVENT_TRACE_ENABLE over raw HID.
+"""
+import struct
+import sys
+
+from milc import cli
+
+import qmk.path
+
+PACKET_ID = 0xFE
+PACKET_SIZE = 32
+HEADER = struct.Struct('<BBBB')
+RECORD = struct.Struct('<BBHHH')
+RAW_USAGE_PAGE = 0xFF60
+RAW_USAGE = 0x61
+
+# Keep these in sync with quantum/event_trace.h
+EVENT_KEY = 1
+EVENT_TAP = 2
+EVENT_TAP_WAIT = 3
+EVENT_TAP_OVERFLOW = 4
+EVENT_LAYER = 5
+EVENT_KEYBOARD = 6
+EVENT_MOUSE = 7
+EVENT_EXTRA = 8
+EVENT_TAP_SETTLE = 9
+EVENT_USER = 0x80
+
+
+def _keypos(data):
+    return 'r%d c%d' % (data >> 8, data & 0xFF)
+
+
+def _signed(byte):
+    return byte - 256 if byte > 127 else byte
+
+
+def _layers(low, high):
+    state = low | high << 16
+    layers = [str(layer) for layer in range(32) if state & (1 << layer)]
+    return '0x%08X [%s]' % (state, ' '.join(layers))
+
+
+def describe(event_id, arg, data0, data1):
+    """Turn one record into a name and a readable description.
+    """
+    if event_id == EVENT_KEY:
+        return 'key', '%s %s' % (_keypos(data0), 'down' if arg else 'up')
+
+    if event_id == EVENT_TAP:
+        return 'tap', '%s count %d%s' % (_keypos(data0), arg & 0x7F, ' interrupted' if arg & 0x80 else '')
+
+    if event_id == EVENT_TAP_WAIT:
+        return 'tap_wait', '%s depth %d' % (_keypos(data0), arg)
+
+    if event_id == EVENT_TAP_OVERFLOW:
+        return 'tap_overflow', '%s waiting buffer full, tapping key forced' % _keypos(data0)
+
+    if event_id == EVENT_LAYER:
+        return 'default_layer' if arg else 'layer', _layers(data0, data1)
+
+    if event_id == EVENT_KEYBOARD:
+        keys = [data0 & 0xFF, data0 >> 8, data1 & 0xFF, data1 >> 8]
+        return 'keyboard', 'mods 0x%02X keys %s' % (arg, ' '.join('%02X' % key for key in keys))
+
+    if event_id == EVENT_MOUSE:
+        return 'mouse', 'buttons 0x%02X x %d y %d v %d h %d' % (arg, _signed(data0 & 0xFF), _signed(data0 >> 8), _signed(data1 & 0xFF), _signed(data1 >> 8))
+
+    if event_id == EVENT_EXTRA:
+        return 'consumer' if arg else 'system', 'usage 0x%04X' % data0
+
+    if event_id == EVENT_TAP_SETTLE:
+        return 'tap_settle', '%s %s after %d ms' % (_keypos(data0), 'tap' if arg else 'hold', data1)
+
+    name = 'user+%d' % (event_id - EVENT_USER) if event_id >= EVENT_USER else 'unknown(%d)' % event_id
+    return name, 'arg 0x%02X data 0x%04X 0x%04X' % (arg, data0, data1)
+
+
+class TraceDecoder:
+    """Turns trace packets into timeline lines.
+
+    Timestamps on the keyboard are 16 bit milliseconds, they are unwrapped here assuming no gap between two records is longer than 65 seconds.
+    """
+    def __init__(self):
+        self.sequence = None
+        self.last = None
+        self.time = 0
+
+    def _timestamp(self, time):
+        if self.last is not None:
+            self.time += (time - self.last) & 0xFFFF
+        self.last = time
+        return self.time
+
+    def packet(self, packet):
+        """Decode one packet, returns a list of output lines.
+        """
+        lines = []
+
+        if len(packet) < HEADER.size or packet[0] != PACKET_ID:
+            return lines
+
+        _, sequence, dropped, count = HEADER.unpack_from(packet)
+
+        if self.sequence is not None and sequence != (self.sequence + 1) & 0xFF:
+            lines.append('--- %d packet(s) lost ---' % ((sequence - self.sequence - 1) & 0xFF))
+        self.sequence = sequence
+
+        if dropped:
+            lines.append('--- %d record(s) dropped on the keyboard ---' % dropped)
+
+        for index in range(count):
+            offset = HEADER.size + index * RECORD.size
+            if offset + RECORD.size > len(packet):
+                break
+
+            event_id, arg, time, data0, data1 = RECORD.unpack_from(packet, offset)
+            name, description = describe(event_id, arg, data0, data1)
+            lines.append('%10d ms  %-14s %s' % (self._timestamp(time), name, description))
+
+        return lines
+
+
+def _read_file(path):
+    """Yields the packets in a capture file of back to back raw HID reports.
+    """
+    data = path.read_bytes() if path else sys.stdin.buffer.read()
+
+    for offset in range(0, len(data) - PACKET_SIZE + 1, PACKET_SIZE):
+        yield data[offset:offset + PACKET_SIZE]
+
+
+def _read_device(vid, pid):
+    """Yields trace packets from the raw HID interface of a connected keyboard.
+    """
+    try:
+        import hid
+    except ImportError:
+        cli.log.error('Reading from a device needs the {fg_cyan}hid{style_reset_all} python module, install it with {fg_cyan}python3 -m pip install hid{style_reset_all}.')
+        return
+
+    for interface in hid.enumerate(vid, pid):
+        if interface['usage_page'] == RAW_USAGE_PAGE and interface['usage'] == RAW_USAGE:
+            break
+    else:
+        cli.log.error('No raw HID interface found for %04X:%04X.', vid, pid)
+        return
+
+    device = hid.Device(path=interface['path'])
+    cli.log.info('Listening to %s %s.', interface['manufacturer_string'], interface['product_string'])
+
+    try:
+        while True:
+            yield device.read(PACKET_SIZE)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        device.close()
+
+
+def _usb_id(value):
+    vid, pid = value.split(':')
+    return int(vid, 16), int(pid, 16)
+
+
+@cli.argument('filename', nargs='?', arg_only=True, type=qmk.path.normpath, help='A capture of raw HID reports to decode. Reads stdin when neither this nor --device is given.')
+@cli.argument('-d', '--device', arg_only=True, type=_usb_id, help='Read live from the keyboard with this VID:PID, in hex.')
+@cli.subcommand('Decodes the binary event trace of a keyboard built with EVENT_TRACE_ENABLE.')
+def trace(cli):
+    """Print the event trace as a timeline.
+    """
+    if cli.args.filename and not cli.args.filename.exists():
+        cli.log.error('File {fg_cyan}%s{style_reset_all} was not found.', cli.args.filename)
+        return False
+
+    packets = _read_device(*cli.args.device) if cli.args.device else _read_file(cli.args.filename)
+    decoder = TraceDecoder()
+
+    for packet in packets:
+        for line in decoder.packet(bytes(packet)):
+            print(line)
+
+    return True
@@ -30,6 +30,10 @@ __KEYMAP_GOES_HERE__
 """
 
 
+# Keycodes that are left out of a sparse keymap
+TRANSPARENT_KEYCODES = ('KC_TRNS', 'KC_TRANSPARENT', '_______')
+
+
 def template_json(keyboard):
     """Returns a `keymap.json` template for a keyboard.
 
@@ -160,6 +164,130 @@ def generate_c(keyboard, layout, layers):
     return new_keymap
 
 
+def sparse_tables(layers, positions, rows, cols):
+    """Returns the bitmaps, offsets and keycodes of a sparse keymap.
+
+    Args:
+        layers
+            An array of arrays describing the keymap. Each item in the inner array should be a string that is a valid QMK keycode.
+
+        positions
+            The [row, col] matrix position of every key in the LAYOUT macro.
+
+        rows, cols
+            The size of the matrix.
+
+    Returns:
+        A tuple of per layer bitmaps, per layer offsets and a flat list of keycodes, see quantum/sparse_keymap.c.
+    """
+    bitmap_size = (rows * cols + 7) // 8
+    bitmaps = []
+    offsets = []
+    keycodes = []
+
+    for layer_num, layer in enumerate(layers):
+        if len(layer) != len(positions):
+            raise ValueError('Layer %s has %d keys, the layout has %d.' % (layer_num, len(layer), len(positions)))
+
+        matrix = {}
+        for keycode, (row, col) in zip(layer, positions):
+            if _strip_any(keycode) not in TRANSPARENT_KEYCODES:
+                matrix[row * cols + col] = _strip_any(keycode)
+
+        bitmap = [0] * bitmap_size
+        offset = []
+        for byte in range(bitmap_size):
+            offset.append(len(keycodes))
+            for bit in range(8):
+                if byte * 8 + bit in matrix:
+                    bitmap[byte] |= 1 << bit
+                    keycodes.append(matrix[byte * 8 + bit])
+
+        bitmaps.append(bitmap)
+        offsets.append(offset)
+
+    return bitmaps, offsets, keycodes
+
+
+def sparse_layer_names(layers):
+    """Returns the index of every layer of a keymap parsed by parse_keymap_c(), as written in the keymaps array.
+
+    Layer names are only numbers when the keymap went through the C pre-processor. Otherwise they are left to the C compiler, which fails the build on a name it cannot resolve, rather than the layers being guessed from the order they appear. Layers without an index are numbered in order.
+    """
+    names = [str(layer['name']) for layer in layers]
+
+    # The parser names every layer without an index 0
+    if len(layers) > 1 and all(name == '0' for name in names):
+        return [str(layer_num) for layer_num in range(len(layers))]
+
+    for name in names:
+        if names.count(name) > 1:
+            raise ValueError('Layer %s is in the keymaps array more than once, or some layers have no index.' % name)
+
+    return names
+
+
+def generate_sparse_c(keymap_c, layers, positions, rows, cols, layer_names=None):
+    """Returns a C file with the sparse keymap tables for a keymap, and the flash used by the dense and sparse keymaps.
+
+    Args:
+        keymap_c
+            The keymap.c the tables are generated from. Either an include path, or the full text of the keymap.
+
+        layers
+            An array of arrays describing the keymap. Each item in the inner array should be a string that is a valid QMK keycode.
+
+        positions
+            The [row, col] matrix position of every key in the LAYOUT macro.
+
+        rows, cols
+            The size of the matrix.
+
+        layer_names
+            The index of every layer in the keymaps array, as C expressions. The tables are initialized with them, so layer names that cannot be resolved fail the build instead of moving a layer. Defaults to the order of the layers.
+    """
+    bitmaps, offsets, keycodes = sparse_tables(layers, positions, rows, cols)
+    if layer_names is None:
+        layer_names = [str(layer_num) for layer_num in range(len(layers))]
+    dense_size = len(layers) * rows * cols * 2
+    sparse_size = sum(len(bitmap) for bitmap in bitmaps) * 3 + (len(keycodes) + 1) * 2
+
+    if '\n' in keymap_c:
+        keymap_text = keymap_c
+    else:
+        keymap_text = '#include "%s"\n' % keymap_c
+
+    lines = [
+        '/* THIS FILE WAS GENERATED!',
+        ' *',
+        ' * This file was generated by qmk sparse-keymap. Do not edit it directly.',
+        ' *',
+        ' * dense keymap: %d bytes, sparse keymap: %d bytes' % (dense_size, sparse_size),
+        ' */',
+        '',
+        keymap_text,
+        '// clang-format off',
+        'const uint8_t PROGMEM sparse_keymap_bitmaps[][SPARSE_KEYMAP_BITMAP_SIZE] = {',
+    ]
+    lines.extend('    [%s] = {%s},' % (layer_name, ', '.join('0x%02X' % byte for byte in bitmap)) for layer_name, bitmap in zip(layer_names, bitmaps))
+    lines.append('};')
+    lines.append('')
+    lines.append('const uint16_t PROGMEM sparse_keymap_offsets[][SPARSE_KEYMAP_BITMAP_SIZE] = {')
+    lines.extend('    [%s] = {%s},' % (layer_name, ', '.join(str(value) for value in offset)) for layer_name, offset in zip(layer_names, offsets))
+    lines.append('};')
+    lines.append('')
+    lines.append('const uint16_t PROGMEM sparse_keymap_keycodes[] = {')
+    for layer_num, offset in enumerate(offsets):
+        end = offsets[layer_num + 1][0] if layer_num + 1 < len(offsets) else len(keycodes)
+        lines.append('    /* layer %s */ %s' % (layer_names[layer_num], ''.join('%s, ' % keycode for keycode in keycodes[offset[0]:end]).rstrip()))
+    lines.append('    0')  # keeps the array valid when every layer is transparent
+    lines.append('};')
+    lines.append('// clang-format on')
+    lines.append('')
+
+    return '\n'.join(lines), dense_size, sparse_size
+
+
 def write_file(keymap_filename, keymap_content):
     keymap_filename.parent.mkdir(parents=True, exist_ok=True)
     keymap_filename.write_text(keymap_content)
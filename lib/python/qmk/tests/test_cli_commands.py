@@ -1,4 +1,5 @@
 import platform
+import struct
 
 from subprocess import STDOUT, PIPE
 
@@ -219,6 +220,20 @@ def test_c2json_nocpp_stdin():
     assert result.stdout.strip() == '{"keyboard": "handwired/pytest/has_template", "documentation": "This file is a keymap.json file for handwired/pytest/has_template", "keymap": "default", "layout": "LAYOUT", "layers": [["KC_ENTER"]]}'
 
 
+def test_sparse_keymap():
+    result = check_subcommand('sparse-keymap', 'keyboards/handwired/pytest/basic/keymaps/default_json/keymap.json')
+    check_returncode(result)
+    assert 'const uint8_t PROGMEM sparse_keymap_bitmaps[][SPARSE_KEYMAP_BITMAP_SIZE] = {\n    [0] = {0x01},\n};' in result.stdout
+    assert '/* layer 0 */ KC_A,' in result.stdout
+
+
+def test_sparse_keymap_nocpp():
+    result = check_subcommand('sparse-keymap', '--no-cpp', '-kb', 'handwired/pytest/basic', 'keyboards/handwired/pytest/basic/keymaps/default/keymap.c')
+    check_returncode(result)
+    assert 'keyboards/handwired/pytest/basic/keymaps/default/keymap.c"' in result.stdout
+    assert '[0] = {0x01},' in result.stdout
+
+
 def test_clean():
     result = check_subcommand('clean', '-a')
     check_returncode(result)
@@ -259,3 +274,35 @@ def test_generate_layouts():
     result = check_subcommand('generate-layouts', '-kb', 'handwired/pytest/basic')
     check_returncode(result)
     assert '#define LAYOUT_custom(k0A) {' in result.stdout
+
+
+def test_generate_led_config():
+    result = check_subcommand('generate-led-config', '-kb', 'handwired/pytest/basic')
+    check_returncode(result)
+    assert '#define RGB_MATRIX_KEY_LED_OFFSETS 0, 2' in result.stdout
+    assert '#define RGB_MATRIX_KEY_LEDS 0, 1' in result.stdout
+    assert '#define RGB_MATRIX_LED_KEYS {0, 0}, {0, 0}, {255, 255}' in result.stdout
+    assert '#define RGB_MATRIX_KEY_LEDS_MAX 2' in result.stdout
+    assert '{{0, 0}, {224, 0}, {112, 64}}' in result.stdout
+    assert '{4, 4, 2}' in result.stdout
+    assert 'LED_MATRIX_' not in result.stdout
+
+
+def test_trace(tmp_path):
+    def packet(sequence, dropped, *records):
+        data = struct.pack('<BBBB', 0xFE, sequence, dropped, len(records))
+        data += b''.join(struct.pack('<BBHHH', *record) for record in records)
+        return data.ljust(32, b'\0')
+
+    capture = tmp_path / 'trace.bin'
+    capture.write_bytes(packet(0, 0, (1, 1, 65530, 0x0003, 0), (5, 0, 65535, 0x0002, 0)) + packet(2, 3, (0x81, 0x12, 4, 0xABCD, 1)))
+
+    result = check_subcommand('trace', str(capture))
+    check_returncode(result)
+    lines = result.stdout.splitlines()[-5:]
+    assert lines[0] == '         0 ms  key            r0 c3 down'
+    assert lines[1] == '         5 ms  layer          0x00000002 [1]'
+    assert lines[2] == '--- 1 packet(s) lost ---'
+    assert lines[3] == '--- 3 record(s) dropped on the keyboard ---'
+    # The 16 bit timestamps wrap around between the packets
+    assert lines[4] == '        10 ms  user+1         arg 0x12 data 0xABCD 0x0001'
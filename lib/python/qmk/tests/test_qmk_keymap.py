@@ -1,3 +1,7 @@
+from pathlib import Path
+
+import pytest
+
 import qmk.keymap
 
 
@@ -36,4 +40,21 @@ def test_parse_keymap_c():
     assert parsed_keymap_c == {'layers': [{'name': '0', 'layout': 'LAYOUT_ortho_1x1', 'keycodes': ['KC_A']}]}
 
 
+
+def test_sparse_layer_names():
+    assert qmk.keymap.sparse_layer_names([{'name': '_BASE'}, {'name': '_NUM'}, {'name': '_FN'}]) == ['_BASE', '_NUM', '_FN']
+    assert qmk.keymap.sparse_layer_names([{'name': '0'}, {'name': '0'}]) == ['0', '1']
+    with pytest.raises(ValueError):
+        qmk.keymap.sparse_layer_names([{'name': '_BASE'}, {'name': '0'}, {'name': '0'}])
+
+
+def test_sparse_keymap_generated_is_current():
+    """quantum/tests/sparse_keymap_generated.c has to be what `qmk sparse-keymap` makes of sparse_keymap_keymap.c.
+    """
+    keymap = qmk.keymap.parse_keymap_c(Path('quantum/tests/sparse_keymap_keymap.c'), use_cpp=False)
+    layers = [layer['keycodes'] for layer in keymap['layers']]
+    positions = [[row, col] for row in range(5) for col in range(14)]
+    sparse_c, dense_size, sparse_size = qmk.keymap.generate_sparse_c('sparse_keymap_keymap.c', layers, positions, 5, 14, qmk.keymap.sparse_layer_names(keymap['layers']))
+    assert sparse_c == Path('quantum/tests/sparse_keymap_generated.c').read_text(encoding='utf-8')
+
 # FIXME(skullydazed): Add a test for qmk.keymap.write that mocks up an FD.
@@ -0,0 +1,167 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "adaptive_tapping.h"
+#include "eeconfig.h"
+#include "eeprom.h"
+#include "timer.h"
+
+// Taps a key needs before its tapping term is adapted
+#ifndef ADAPTIVE_TAPPING_MIN_SAMPLES
+#    define ADAPTIVE_TAPPING_MIN_SAMPLES 16
+#endif
+
+// Shortest tapping term the model may pick (ms)
+#ifndef ADAPTIVE_TAPPING_TERM_MIN
+#    define ADAPTIVE_TAPPING_TERM_MIN 100
+#endif
+
+// Added on top of mean + 4 * deviation (ms), the mean overlap is used instead when it is longer
+#ifndef ADAPTIVE_TAPPING_MARGIN
+#    define ADAPTIVE_TAPPING_MARGIN 20
+#endif
+
+// Changed statistics are written to EEPROM at most this often (ms)
+#ifndef ADAPTIVE_TAPPING_SAVE_INTERVAL
+#    define ADAPTIVE_TAPPING_SAVE_INTERVAL 600000
+#endif
+
+#define ADAPTIVE_TAPPING_MAGIC 0x7A9E
+
+// Weight of a new sample in the running averages is 1 / 2^ADAPTIVE_TAPPING_GAIN
+#define ADAPTIVE_TAPPING_GAIN 3
+
+_Static_assert(sizeof(adaptive_tapping_key_t) == 8, "EECONFIG_ADAPTIVE_TAPPING_SIZE assumes 8 bytes per key");
+
+static adaptive_tapping_key_t adaptive_tapping_keys[ADAPTIVE_TAPPING_KEYS];
+static bool                   adaptive_tapping_dirty;
+static uint32_t               adaptive_tapping_save_timer;
+
+/** \brief Load the statistics from EEPROM
+ *
+ * Starts from scratch when the EEPROM holds no statistics, or statistics for a different
+ * ADAPTIVE_TAPPING_KEYS.
+ */
+void adaptive_tapping_init(void) {
+    memset(adaptive_tapping_keys, 0, sizeof(adaptive_tapping_keys));
+    if (eeprom_read_word(EECONFIG_ADAPTIVE_TAPPING) == (ADAPTIVE_TAPPING_MAGIC ^ ADAPTIVE_TAPPING_KEYS)) {
+        eeprom_read_block(adaptive_tapping_keys, EECONFIG_ADAPTIVE_TAPPING + 1, sizeof(adaptive_tapping_keys));
+    }
+    adaptive_tapping_dirty      = false;
+    adaptive_tapping_save_timer = timer_read32();
+}
+
+/** \brief Forget everything learned, in RAM and in EEPROM
+ */
+void adaptive_tapping_reset(void) {
+    memset(adaptive_tapping_keys, 0, sizeof(adaptive_tapping_keys));
+    eeprom_update_word(EECONFIG_ADAPTIVE_TAPPING, 0);
+    adaptive_tapping_dirty = false;
+}
+
+/** \brief Write the statistics to EEPROM now
+ */
+void adaptive_tapping_save(void) {
+    eeprom_update_block(adaptive_tapping_keys, EECONFIG_ADAPTIVE_TAPPING + 1, sizeof(adaptive_tapping_keys));
+    eeprom_update_word(EECONFIG_ADAPTIVE_TAPPING, ADAPTIVE_TAPPING_MAGIC ^ ADAPTIVE_TAPPING_KEYS);
+    adaptive_tapping_dirty      = false;
+    adaptive_tapping_save_timer = timer_read32();
+}
+
+/** \brief Save changed statistics every ADAPTIVE_TAPPING_SAVE_INTERVAL
+ *
+ * Statistics change with nearly every tap, saving them right away would wear out the EEPROM.
+ */
+void adaptive_tapping_task(void) {
+    if (adaptive_tapping_dirty && timer_elapsed32(adaptive_tapping_save_timer) >= ADAPTIVE_TAPPING_SAVE_INTERVAL) {
+        adaptive_tapping_save();
+    }
+}
+
+static adaptive_tapping_key_t *adaptive_tapping_find(uint16_t keycode) {
+    for (uint8_t i = 0; i < ADAPTIVE_TAPPING_KEYS; i++) {
+        if (adaptive_tapping_keys[i].keycode == keycode) {
+            return &adaptive_tapping_keys[i];
+        }
+    }
+    return NULL;
+}
+
+// Moves a running average 1 / 2^ADAPTIVE_TAPPING_GAIN of the way to a sample. The step is rounded away
+// from zero, so the average keeps moving until it reaches the sample instead of stalling short of it.
+static int16_t adaptive_tapping_step(int16_t error) {
+    const int16_t round = (1 << ADAPTIVE_TAPPING_GAIN) - 1;
+    return (error < 0 ? error - round : error + round) / (1 << ADAPTIVE_TAPPING_GAIN);
+}
+
+const adaptive_tapping_key_t *adaptive_tapping_get_key(uint16_t keycode) { return keycode ? adaptive_tapping_find(keycode) : NULL; }
+
+/** \brief Add a tap to the statistics of a key
+ *
+ * duration is the time from press to release of the tap, overlap the time another key had been
+ * down when the tap was released, 0 if there was none. When all slots are in use, the key with the
+ * fewest samples makes room.
+ */
+void adaptive_tapping_record_tap(uint16_t keycode, uint16_t duration, uint16_t overlap) {
+    if (!keycode) return;
+
+    adaptive_tapping_key_t *key = adaptive_tapping_find(keycode);
+    if (!key) {
+        key = &adaptive_tapping_keys[0];
+        for (uint8_t i = 1; i < ADAPTIVE_TAPPING_KEYS && key->keycode; i++) {
+            if (!adaptive_tapping_keys[i].keycode || adaptive_tapping_keys[i].samples < key->samples) {
+                key = &adaptive_tapping_keys[i];
+            }
+        }
+        *key = (adaptive_tapping_key_t){.keycode = keycode};
+    }
+
+    if (duration > 2047) duration = 2047;
+    if (overlap > UINT8_MAX) overlap = UINT8_MAX;
+
+    int16_t sample = duration << 4;
+    if (key->samples == 0) {
+        key->tap_mean = sample;
+        key->tap_dev  = sample / 4;
+        key->overlap  = overlap;
+    } else {
+        int16_t error = sample - (int16_t)key->tap_mean;
+        key->tap_mean += adaptive_tapping_step(error);
+        key->tap_dev += adaptive_tapping_step((error < 0 ? -error : error) - (int16_t)key->tap_dev);
+        key->overlap += adaptive_tapping_step((int16_t)overlap - key->overlap);
+    }
+    if (key->samples < UINT8_MAX) key->samples++;
+
+    adaptive_tapping_dirty = true;
+}
+
+/** \brief Tapping term for a key
+ *
+ * Returns term, the configured tapping term, until the key has ADAPTIVE_TAPPING_MIN_SAMPLES taps,
+ * and from then on mean + 4 * deviation plus the margin, kept between ADAPTIVE_TAPPING_TERM_MIN
+ * and term.
+ */
+uint16_t adaptive_tapping_term(uint16_t keycode, uint16_t term) {
+    const adaptive_tapping_key_t *key = adaptive_tapping_get_key(keycode);
+    if (!key || key->samples < ADAPTIVE_TAPPING_MIN_SAMPLES) return term;
+
+    uint16_t margin   = key->overlap > ADAPTIVE_TAPPING_MARGIN ? key->overlap : ADAPTIVE_TAPPING_MARGIN;
+    uint32_t adaptive = (((uint32_t)key->tap_mean + 4 * (uint32_t)key->tap_dev) >> 4) + margin;
+
+    if (adaptive < ADAPTIVE_TAPPING_TERM_MIN) adaptive = ADAPTIVE_TAPPING_TERM_MIN;
+    return adaptive < term ? adaptive : term;
+}
@@ -0,0 +1,54 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Adaptive tapping term.
+ *
+ * Keeps a running mean and mean deviation of how long each tap-hold key is held when it is tapped,
+ * the same estimator TCP uses for its retransmit timeout. Once a key has enough samples, its
+ * tapping term is cut down to mean + 4 * deviation plus a margin, so a hold is decided as soon as
+ * the key is clearly not being tapped, instead of after the full TAPPING_TERM. The term is never
+ * made longer than the configured one.
+ *
+ * A hold that is released before the configured term without any other key being pressed was most
+ * likely a tap that came out as a hold, it is recorded as a tap so the term grows back.
+ */
+
+// Number of keycodes statistics are kept for
+#ifndef ADAPTIVE_TAPPING_KEYS
+#    define ADAPTIVE_TAPPING_KEYS 8
+#endif
+
+typedef struct {
+    uint16_t keycode;   // KC_NO for an unused slot
+    uint16_t tap_mean;  // mean tap duration (ms, 12.4 fixed point)
+    uint16_t tap_dev;   // mean deviation of the tap duration (ms, 12.4 fixed point)
+    uint8_t  overlap;   // mean time another key was held down before the tap was released (ms)
+    uint8_t  samples;   // number of taps seen, saturating at 255
+} adaptive_tapping_key_t;
+
+void                          adaptive_tapping_init(void);
+void                          adaptive_tapping_task(void);
+void                          adaptive_tapping_reset(void);
+void                          adaptive_tapping_save(void);
+void                          adaptive_tapping_record_tap(uint16_t keycode, uint16_t duration, uint16_t overlap);
+uint16_t                      adaptive_tapping_term(uint16_t keycode, uint16_t term);
+const adaptive_tapping_key_t *adaptive_tapping_get_key(uint16_t keycode);
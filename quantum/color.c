@@ -96,6 +96,108 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     return rgb;
 }
 
+// clang-format off
+
+// The sixth of the hue circle each hue is in, h * 6 / 255
+static const uint8_t hue_region[256] PROGMEM = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6,
+};
+
+// clang-format on
+
+/* Converts count colors at once, exactly as hsv_to_rgb_impl does one.
+ *
+ * The hue region comes from a table instead of a division. Where a 32 bit multiply is a single
+ * instruction, the two values that depend on the hue are worked out together, one in each half
+ * of a word. rgb may be the same buffer as hsv.
+ */
+void hsv_to_rgb_batch_impl(const HSV *hsv, RGB *rgb, uint8_t count, bool use_cie) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t h = hsv[i].h;
+        uint8_t s = hsv[i].s;
+        uint8_t v = hsv[i].v;
+#ifdef USE_CIE1931_CURVE
+        if (use_cie) {
+            v = pgm_read_byte(&CIE1931_CURVE[v]);
+        }
+#endif
+
+        if (s == 0) {
+            rgb[i].r = v;
+            rgb[i].g = v;
+            rgb[i].b = v;
+            continue;
+        }
+
+        uint8_t region    = pgm_read_byte(&hue_region[h]);
+        uint8_t remainder = (h * 2 - region * 85) * 3;
+        uint8_t p         = (v * (255 - s)) >> 8;
+        uint8_t q, t;
+#if defined(__AVR__) || defined(COLOR_NO_SWAR)
+        q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+#else
+        // q in the low half, t in the high half, none of the products carry into the other
+        uint32_t qt = (uint32_t)s * (remainder | (uint32_t)(255 - remainder) << 16);
+        qt          = 0x00FF00FF - ((qt >> 8) & 0x00FF00FF);
+        qt          = ((v * qt) >> 8) & 0x00FF00FF;
+        q           = qt;
+        t           = qt >> 16;
+#endif
+
+        switch (region) {
+            case 6:
+            case 0:
+                rgb[i].r = v;
+                rgb[i].g = t;
+                rgb[i].b = p;
+                break;
+            case 1:
+                rgb[i].r = q;
+                rgb[i].g = v;
+                rgb[i].b = p;
+                break;
+            case 2:
+                rgb[i].r = p;
+                rgb[i].g = v;
+                rgb[i].b = t;
+                break;
+            case 3:
+                rgb[i].r = p;
+                rgb[i].g = q;
+                rgb[i].b = v;
+                break;
+            case 4:
+                rgb[i].r = t;
+                rgb[i].g = p;
+                rgb[i].b = v;
+                break;
+            default:
+                rgb[i].r = v;
+                rgb[i].g = p;
+                rgb[i].b = q;
+                break;
+        }
+    }
+}
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint8_t count) { hsv_to_rgb_batch_impl(hsv, rgb, count, false); }
+
 RGB hsv_to_rgb(HSV hsv) {
 #ifdef USE_CIE1931_CURVE
     return hsv_to_rgb_impl(hsv, true);
@@ -50,10 +50,10 @@
 #endif
 
 // If DYNAMIC_KEYMAP_EEPROM_ADDR not explicitly defined in config.h,
-// default it start after VIA_EEPROM_CUSTOM_ADDR+VIA_EEPROM_CUSTOM_SIZE
+// default it start after VIA_EEPROM_KEYFRAMES_ADDR+VIA_EEPROM_KEYFRAMES_SIZE
 #ifndef DYNAMIC_KEYMAP_EEPROM_ADDR
-#    ifdef VIA_EEPROM_CUSTOM_CONFIG_ADDR
-#        define DYNAMIC_KEYMAP_EEPROM_ADDR (VIA_EEPROM_CUSTOM_CONFIG_ADDR + VIA_EEPROM_CUSTOM_CONFIG_SIZE)
+#    ifdef VIA_EEPROM_KEYFRAMES_ADDR
+#        define DYNAMIC_KEYMAP_EEPROM_ADDR (VIA_EEPROM_KEYFRAMES_ADDR + VIA_EEPROM_KEYFRAMES_SIZE)
 #    else
 #        error DYNAMIC_KEYMAP_EEPROM_ADDR not defined
 #    endif
@@ -99,6 +99,7 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    keymap_cache_invalidate();
 }
 
 void dynamic_keymap_reset(void) {
@@ -140,6 +141,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+    keymap_cache_invalidate();
 }
 
 // This overrides the one in quantum/keymap_common.c
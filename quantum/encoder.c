@@ -45,24 +45,63 @@ static uint8_t encoder_resolutions[] = ENCODER_RESOLUTIONS;
 #    define ENCODER_CLOCKWISE false
 #    define ENCODER_COUNTER_CLOCKWISE true
 #endif
-static int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};
+#ifndef ENCODER_VELOCITY_TIMEOUT
+#    define ENCODER_VELOCITY_TIMEOUT 200
+#endif
+
+static const int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};
 
+#if defined(ENCODER_INTERRUPTS) && defined(PROTOCOL_CHIBIOS)
+// timer_read() locks the kernel, which encoder_isr() can not do, so detents are timed by the system tick
+typedef systime_t encoder_time_t;
+#    define ENCODER_TIME() chVTGetSystemTimeX()
+#    define ENCODER_ELAPSED_MS(now, then) TIME_I2MS(chTimeDiffX(then, now))
+#else
+typedef uint16_t encoder_time_t;
+#    define ENCODER_TIME() timer_read()
+#    define ENCODER_ELAPSED_MS(now, then) TIMER_DIFF_16(now, then)
+#endif
+
+#ifdef ENCODER_INTERRUPTS
+// pin state and pulses are owned by encoder_isr(), which only ever increments or decrements the
+// detent counter, so the scan loop can pick up the accumulated steps without disabling interrupts
+static volatile uint8_t        encoder_state[NUMBER_OF_ENCODERS]      = {0};
+static volatile int8_t         encoder_pulses[NUMBER_OF_ENCODERS]     = {0};
+static volatile uint8_t        encoder_ticks[NUMBER_OF_ENCODERS]      = {0};
+static volatile encoder_time_t encoder_ticks_time[NUMBER_OF_ENCODERS] = {0};  // when the last detent was seen
+static volatile uint8_t        encoder_ticks_seen[NUMBER_OF_ENCODERS] = {0};
+
+// lets the tests interrupt encoder_read() between reading the detents and their time
+#    ifndef ENCODER_TICKS_READ_HOOK
+#        define ENCODER_TICKS_READ_HOOK()
+#    endif
+#else
 static uint8_t encoder_state[NUMBER_OF_ENCODERS]  = {0};
 static int8_t  encoder_pulses[NUMBER_OF_ENCODERS] = {0};
+#endif
 
 #ifdef SPLIT_KEYBOARD
 // right half encoders come over as second set of encoders
 static uint8_t encoder_value[NUMBER_OF_ENCODERS * 2] = {0};
+// detents per second, and time of the last detent
+static uint16_t       encoder_velocity[NUMBER_OF_ENCODERS * 2]  = {0};
+static encoder_time_t encoder_last_step[NUMBER_OF_ENCODERS * 2] = {0};
 // row offsets for each hand
 static uint8_t thisHand, thatHand;
 #else
-static uint8_t encoder_value[NUMBER_OF_ENCODERS] = {0};
+static uint8_t        encoder_value[NUMBER_OF_ENCODERS]     = {0};
+static uint16_t       encoder_velocity[NUMBER_OF_ENCODERS]  = {0};
+static encoder_time_t encoder_last_step[NUMBER_OF_ENCODERS] = {0};
 #endif
 
 __attribute__((weak)) void encoder_update_user(int8_t index, bool clockwise) {}
 
 __attribute__((weak)) void encoder_update_kb(int8_t index, bool clockwise) { encoder_update_user(index, clockwise); }
 
+#if defined(ENCODER_INTERRUPTS) && defined(PROTOCOL_CHIBIOS)
+static void encoder_pal_callback(void *arg) { encoder_isr(); }
+#endif
+
 void encoder_init(void) {
 #if defined(SPLIT_KEYBOARD) && defined(ENCODERS_PAD_A_RIGHT) && defined(ENCODERS_PAD_B_RIGHT)
     if (!isLeftHand) {
@@ -81,6 +120,11 @@ void encoder_init(void) {
     }
 #endif
 
+#ifdef SPLIT_KEYBOARD
+    thisHand = isLeftHand ? 0 : NUMBER_OF_ENCODERS;
+    thatHand = NUMBER_OF_ENCODERS - thisHand;
+#endif
+
     for (int i = 0; i < NUMBER_OF_ENCODERS; i++) {
         setPinInputHigh(encoders_pad_a[i]);
         setPinInputHigh(encoders_pad_b[i]);
@@ -88,46 +132,126 @@ void encoder_init(void) {
         encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
     }
 
-#ifdef SPLIT_KEYBOARD
-    thisHand = isLeftHand ? 0 : NUMBER_OF_ENCODERS;
-    thatHand = NUMBER_OF_ENCODERS - thisHand;
+#if defined(ENCODER_INTERRUPTS) && defined(PROTOCOL_CHIBIOS)
+    // requires PAL_USE_CALLBACKS in halconf.h
+    for (int i = 0; i < NUMBER_OF_ENCODERS; i++) {
+        palEnableLineEvent(encoders_pad_a[i], PAL_EVENT_MODE_BOTH_EDGES);
+        palEnableLineEvent(encoders_pad_b[i], PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallback(encoders_pad_a[i], encoder_pal_callback, NULL);
+        palSetLineCallback(encoders_pad_b[i], encoder_pal_callback, NULL);
+    }
 #endif
 }
 
-static bool encoder_update(int8_t index, uint8_t state) {
-    bool    changed = false;
-    uint8_t i       = index;
-
+// decodes one pin sample, returns +1/-1 once a full detent has been seen
+static int8_t encoder_decode(uint8_t i) {
 #ifdef ENCODER_RESOLUTIONS
     int8_t resolution = encoder_resolutions[i];
 #else
     int8_t resolution = ENCODER_RESOLUTION;
 #endif
+    int8_t step   = 0;
+    int8_t pulses = encoder_pulses[i];
 
-#ifdef SPLIT_KEYBOARD
-    index += thisHand;
-#endif
-    encoder_pulses[i] += encoder_LUT[state & 0xF];
-    if (encoder_pulses[i] >= resolution) {
+    encoder_state[i] = (encoder_state[i] << 2) | (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
+    pulses += encoder_LUT[encoder_state[i] & 0xF];
+    if (pulses >= resolution) {
+        step = 1;
+    }
+    if (pulses <= -resolution) {  // direction is arbitrary here, but this clockwise
+        step = -1;
+    }
+    encoder_pulses[i] = pulses % resolution;
+    return step;
+}
+
+static void encoder_velocity_update(uint8_t index, int8_t steps, encoder_time_t now) {
+    uint32_t elapsed = ENCODER_ELAPSED_MS(now, encoder_last_step[index]);
+    uint8_t  count   = steps < 0 ? -steps : steps;
+
+    encoder_last_step[index] = now;
+    // after a pause the encoder turned at least this fast, rather than not at all
+    if (encoder_velocity[index] == 0 || elapsed > ENCODER_VELOCITY_TIMEOUT) {
+        elapsed                 = ENCODER_VELOCITY_TIMEOUT;
+        encoder_velocity[index] = 0;
+    }
+    uint32_t instant = (uint32_t)count * 1000 / (elapsed ? elapsed : 1);
+    // smooth over the last few detents so a single bouncy edge does not spike the estimate
+    if (encoder_velocity[index]) instant = (encoder_velocity[index] + instant) / 2;
+    encoder_velocity[index] = instant < UINT16_MAX ? instant : UINT16_MAX;
+}
+
+// the velocity drops to 0 once an encoder has been still for ENCODER_VELOCITY_TIMEOUT
+static void encoder_velocity_expire(uint8_t index) {
+    if (encoder_velocity[index] && ENCODER_ELAPSED_MS(ENCODER_TIME(), encoder_last_step[index]) >= ENCODER_VELOCITY_TIMEOUT) {
+        encoder_velocity[index] = 0;
+    }
+}
+
+// applies accumulated detents to an encoder, index includes the hand offset
+static bool encoder_apply(uint8_t index, int8_t delta, encoder_time_t now) {
+    if (delta == 0) return false;
+    encoder_velocity_update(index, delta, now);
+    while (delta > 0) {
+        delta--;
         encoder_value[index]++;
-        changed = true;
         encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
     }
-    if (encoder_pulses[i] <= -resolution) {  // direction is arbitrary here, but this clockwise
+    while (delta < 0) {
+        delta++;
         encoder_value[index]--;
-        changed = true;
         encoder_update_kb(index, ENCODER_CLOCKWISE);
     }
-    encoder_pulses[i] %= resolution;
-    return changed;
+    return true;
 }
 
+uint16_t encoder_get_velocity(uint8_t index) {
+    encoder_velocity_expire(index);
+    return encoder_velocity[index];
+}
+
+#ifdef ENCODER_INTERRUPTS
+void encoder_isr(void) {
+    for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
+        int8_t step = encoder_decode(i);
+        // the scan loop takes the difference as an int8_t, so drop detents beyond what it can tell apart
+        int8_t pending = encoder_ticks[i] - encoder_ticks_seen[i];
+        if ((step > 0 && pending < INT8_MAX) || (step < 0 && pending > -INT8_MAX)) {
+            encoder_ticks_time[i] = ENCODER_TIME();
+            encoder_ticks[i] += step;
+        }
+    }
+}
+#endif
+
 bool encoder_read(void) {
     bool changed = false;
     for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
-        encoder_state[i] <<= 2;
-        encoder_state[i] |= (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
-        changed |= encoder_update(i, encoder_state[i]);
+        uint8_t index = i;
+#ifdef SPLIT_KEYBOARD
+        index += thisHand;
+#endif
+#ifdef ENCODER_INTERRUPTS
+        // the ISR always changes the detents along with their time, so when the detents are the same
+        // after reading the time, the two belong together and the time was not read halfway through
+        uint8_t        ticks;
+        encoder_time_t now;
+        do {
+            ticks = encoder_ticks[i];
+            now   = encoder_ticks_time[i];
+            ENCODER_TICKS_READ_HOOK();
+        } while (ticks != encoder_ticks[i]);
+        int8_t delta          = ticks - encoder_ticks_seen[i];
+        encoder_ticks_seen[i] = ticks;
+#else
+        int8_t         delta = encoder_decode(i);
+        encoder_time_t now   = ENCODER_TIME();
+#endif
+        changed |= encoder_apply(index, delta, now);
+    }
+    // expire the velocity of still encoders, remote ones included, before the timer wraps around
+    for (uint8_t index = 0; index < sizeof(encoder_velocity) / sizeof(encoder_velocity[0]); index++) {
+        encoder_velocity_expire(index);
     }
     return changed;
 }
@@ -142,18 +266,7 @@ void encoder_update_raw(uint8_t* slave_state) {
     for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
         uint8_t index = i + thatHand;
         int8_t  delta = slave_state[i] - encoder_value[index];
-        while (delta > 0) {
-            delta--;
-            encoder_value[index]++;
-            changed = true;
-            encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
-        }
-        while (delta < 0) {
-            delta++;
-            encoder_value[index]--;
-            changed = true;
-            encoder_update_kb(index, ENCODER_CLOCKWISE);
-        }
+        changed |= encoder_apply(index, delta, ENCODER_TIME());
     }
 
     // Update the last encoder input time -- handled external to encoder_read() when we're running a split
@@ -25,6 +25,12 @@ bool encoder_read(void);
 void encoder_update_kb(int8_t index, bool clockwise);
 void encoder_update_user(int8_t index, bool clockwise);
 
+uint16_t encoder_get_velocity(uint8_t index);
+
+#ifdef ENCODER_INTERRUPTS
+void encoder_isr(void);
+#endif
+
 #ifdef SPLIT_KEYBOARD
 void encoder_state_raw(uint8_t* slave_state);
 void encoder_update_raw(uint8_t* slave_state);
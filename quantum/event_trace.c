@@ -0,0 +1,103 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "event_trace.h"
+#include "raw_hid.h"
+#include "ring_buffer.h"
+#include "timer.h"
+#if defined(PROTOCOL_LUFA) || defined(PROTOCOL_CHIBIOS)
+#    include "protocol/usb_descriptor.h"
+#elif defined(PROTOCOL_ARM_ATSAM)
+#    include "protocol/arm_atsam/usb/udi_device_epsize.h"
+#elif defined(PROTOCOL_VUSB)
+#    error "EVENT_TRACE_ENABLE is not supported with V-USB, its Raw HID reports are too small"
+#endif
+
+// The trace shares the Raw HID interface, and VIA would take trace packets for commands
+#ifdef VIA_ENABLE
+#    error "EVENT_TRACE_ENABLE can not be combined with VIA_ENABLE"
+#endif
+
+#ifndef EVENT_TRACE_BUFFER_SIZE
+#    define EVENT_TRACE_BUFFER_SIZE 64
+#endif
+
+#ifndef EVENT_TRACE_PACKET_SIZE
+#    define EVENT_TRACE_PACKET_SIZE RAW_EPSIZE
+#endif
+
+// A partially filled packet is sent once its oldest record is this old (ms)
+#ifndef EVENT_TRACE_FLUSH_TIMEOUT
+#    define EVENT_TRACE_FLUSH_TIMEOUT 10
+#endif
+
+#define EVENT_TRACE_HEADER_SIZE 4
+#define EVENT_TRACE_RECORDS_PER_PACKET ((EVENT_TRACE_PACKET_SIZE - EVENT_TRACE_HEADER_SIZE) / sizeof(event_trace_record_t))
+
+_Static_assert(EVENT_TRACE_RECORDS_PER_PACKET > 0, "EVENT_TRACE_PACKET_SIZE is too small to hold a record");
+
+RING_BUFFER_DEFINE(event_trace_ring, event_trace_record_t, EVENT_TRACE_BUFFER_SIZE)
+
+static event_trace_ring_t event_trace_records;
+static bool               event_trace_enabled = true;
+static uint8_t            event_trace_sequence;
+static uint8_t            event_trace_dropped;
+
+void event_trace_enable(void) { event_trace_enabled = true; }
+
+void event_trace_disable(void) {
+    event_trace_enabled = false;
+    event_trace_ring_clear(&event_trace_records);
+}
+
+bool event_trace_is_enabled(void) { return event_trace_enabled; }
+
+void event_trace(uint8_t id, uint8_t arg, uint16_t data0, uint16_t data1) {
+    if (!event_trace_enabled) return;
+
+    event_trace_record_t record = {.id = id, .arg = arg, .time = timer_read(), .data = {data0, data1}};
+    if (!event_trace_ring_push(&event_trace_records, record) && event_trace_dropped < UINT8_MAX) {
+        event_trace_dropped++;
+    }
+}
+
+/** \brief Send buffered trace records
+ *
+ * Sends at most one packet per call, so a burst of events is spread over several scans instead of
+ * stalling one of them.
+ */
+void event_trace_task(void) {
+    event_trace_record_t oldest;
+    if (!event_trace_ring_peek(&event_trace_records, &oldest)) return;
+
+    if (event_trace_ring_count(&event_trace_records) < EVENT_TRACE_RECORDS_PER_PACKET && timer_elapsed(oldest.time) < EVENT_TRACE_FLUSH_TIMEOUT) {
+        return;
+    }
+
+    uint8_t              packet[EVENT_TRACE_PACKET_SIZE] = {0};
+    event_trace_record_t records[EVENT_TRACE_RECORDS_PER_PACKET];
+    uint8_t              count = event_trace_ring_pop_bulk(&event_trace_records, records, EVENT_TRACE_RECORDS_PER_PACKET);
+
+    packet[0] = EVENT_TRACE_PACKET_ID;
+    packet[1] = event_trace_sequence++;
+    packet[2] = event_trace_dropped;
+    packet[3] = count;
+    memcpy(&packet[EVENT_TRACE_HEADER_SIZE], records, count * sizeof(event_trace_record_t));
+
+    event_trace_dropped = 0;
+    raw_hid_send(packet, sizeof(packet));
+}
@@ -0,0 +1,76 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Binary event trace, streamed over raw HID.
+ *
+ * Every event is an 8 byte record (id, one byte argument, 16 bit timestamp, two 16 bit words) that
+ * is pushed into a ring buffer and sent to the host in batches. Nothing is formatted on the
+ * keyboard, `qmk trace` turns the records back into a readable timeline.
+ *
+ * Packet layout (RAW_EPSIZE bytes, all values little endian):
+ *   [0]    EVENT_TRACE_PACKET_ID
+ *   [1]    sequence number, incremented for every packet
+ *   [2]    number of records dropped since the previous packet, saturating at 255
+ *   [3]    number of records that follow
+ *   [4..]  records
+ */
+
+#ifndef EVENT_TRACE_PACKET_ID
+#    define EVENT_TRACE_PACKET_ID 0xFE
+#endif
+
+// Keep these in sync with lib/python/qmk/cli/trace.py
+enum event_trace_id {
+    EVENT_TRACE_KEY = 1,       // arg: pressed, data: row << 8 | col, 0
+    EVENT_TRACE_TAP,           // arg: tap count | interrupted << 7, data: row << 8 | col, 0
+    EVENT_TRACE_TAP_WAIT,      // arg: waiting buffer depth, data: row << 8 | col, 0
+    EVENT_TRACE_TAP_OVERFLOW,  // arg: 0, data: row << 8 | col, 0
+    EVENT_TRACE_LAYER,         // arg: 0 for layer_state, 1 for default_layer_state, data: state low, state high
+    EVENT_TRACE_KEYBOARD,      // arg: mods, data: first four key bytes
+    EVENT_TRACE_MOUSE,         // arg: buttons, data: x | y << 8, v | h << 8
+    EVENT_TRACE_EXTRA,         // arg: 0 for system, 1 for consumer, data: usage, 0
+    EVENT_TRACE_TAP_SETTLE,    // arg: 1 for tap, 0 for hold, data: row << 8 | col, ms since press
+    EVENT_TRACE_USER = 0x80,   // ids from here on are free for keymaps
+};
+
+typedef struct {
+    uint8_t  id;
+    uint8_t  arg;
+    uint16_t time;
+    uint16_t data[2];
+} __attribute__((packed)) event_trace_record_t;
+
+#ifdef EVENT_TRACE_ENABLE
+
+#    define EVENT_TRACE(id, arg, data0, data1) event_trace((id), (arg), (data0), (data1))
+
+void event_trace(uint8_t id, uint8_t arg, uint16_t data0, uint16_t data1);
+void event_trace_task(void);
+void event_trace_enable(void);
+void event_trace_disable(void);
+bool event_trace_is_enabled(void);
+
+#else
+
+#    define EVENT_TRACE(id, arg, data0, data1)
+
+#endif
@@ -15,15 +15,16 @@
  */
 
 #include "keycode_config.h"
+#include "progmem.h"
 
 extern keymap_config_t keymap_config;
 
-/** \brief keycode_config
+/** \brief keycode_config_compute
  *
  * This function is used to check a specific keycode against the bootmagic config,
  * and will return the corrected keycode, when appropriate.
  */
-uint16_t keycode_config(uint16_t keycode) {
+static uint16_t keycode_config_compute(uint16_t keycode) {
     switch (keycode) {
         case KC_CAPSLOCK:
         case KC_LOCKING_CAPS:
@@ -113,13 +114,12 @@ uint16_t keycode_config(uint16_t keycode) {
     }
 }
 
-/** \brief mod_config
+/** \brief mod_config_compute
  *
  *  This function checks the mods passed to it against the bootmagic config,
  *  and will remove or replace mods, based on that.
  */
-
-uint8_t mod_config(uint8_t mod) {
+static uint8_t mod_config_compute(uint8_t mod) {
     if (keymap_config.swap_lalt_lgui) {
         if ((mod & MOD_RGUI) == MOD_LGUI) {
             mod &= ~MOD_LGUI;
@@ -163,3 +163,78 @@ uint8_t mod_config(uint8_t mod) {
 
     return mod;
 }
+
+/* The swaps above only ever touch the keycodes listed here and the five mod bits, so their result is
+ * kept in small tables that are rebuilt when keymap_config changes, instead of being worked out for
+ * every key event.
+ */
+static const uint8_t PROGMEM keycode_config_keys[] = {
+    KC_CAPSLOCK, KC_LOCKING_CAPS, KC_LCTL, KC_LALT, KC_LGUI, KC_RCTL, KC_RALT, KC_RGUI, KC_GRAVE, KC_ESC, KC_BSLASH, KC_BSPACE,
+};
+
+#define KEYCODE_CONFIG_KEY_COUNT (sizeof(keycode_config_keys) / sizeof(keycode_config_keys[0]))
+#define MOD_CONFIG_MASK 0x1F
+
+static uint16_t keycode_config_raw;
+static bool     keycode_config_valid    = false;
+static bool     keycode_config_identity = true;
+static uint8_t  keycode_config_remap[KEYCODE_CONFIG_KEY_COUNT];
+static uint8_t  mod_config_remap[MOD_CONFIG_MASK + 1];
+
+/** \brief keycode_config_update
+ *
+ * Rebuilds the remap tables if keymap_config has changed since they were last built.
+ */
+static void keycode_config_update(void) {
+    if (keycode_config_valid && keycode_config_raw == keymap_config.raw) {
+        return;
+    }
+
+    keycode_config_identity = true;
+    for (uint8_t i = 0; i < KEYCODE_CONFIG_KEY_COUNT; i++) {
+        uint8_t keycode         = pgm_read_byte(&keycode_config_keys[i]);
+        keycode_config_remap[i] = keycode_config_compute(keycode);
+        if (keycode_config_remap[i] != keycode) {
+            keycode_config_identity = false;
+        }
+    }
+    for (uint8_t mod = 0; mod <= MOD_CONFIG_MASK; mod++) {
+        mod_config_remap[mod] = mod_config_compute(mod);
+    }
+
+    keycode_config_raw   = keymap_config.raw;
+    keycode_config_valid = true;
+}
+
+/** \brief keycode_config
+ *
+ * This function is used to check a specific keycode against the bootmagic config,
+ * and will return the corrected keycode, when appropriate.
+ */
+uint16_t keycode_config(uint16_t keycode) {
+    if (keycode > 0xFF) {
+        return keycode;
+    }
+
+    keycode_config_update();
+    if (keycode_config_identity) {
+        return keycode;
+    }
+
+    for (uint8_t i = 0; i < KEYCODE_CONFIG_KEY_COUNT; i++) {
+        if (pgm_read_byte(&keycode_config_keys[i]) == keycode) {
+            return keycode_config_remap[i];
+        }
+    }
+    return keycode;
+}
+
+/** \brief mod_config
+ *
+ *  This function checks the mods passed to it against the bootmagic config,
+ *  and will remove or replace mods, based on that.
+ */
+uint8_t mod_config(uint8_t mod) {
+    keycode_config_update();
+    return (mod & ~MOD_CONFIG_MASK) | mod_config_remap[mod & MOD_CONFIG_MASK];
+}
@@ -54,3 +54,12 @@ uint16_t keymap_function_id_to_action(uint16_t function_id);
 
 extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
 extern const uint16_t fn_actions[];
+
+#ifdef SPARSE_KEYMAP_ENABLE
+#    define SPARSE_KEYMAP_BITMAP_SIZE ((MATRIX_ROWS * MATRIX_COLS + 7) / 8)
+
+// generated by `qmk sparse-keymap`
+extern const uint8_t  sparse_keymap_bitmaps[][SPARSE_KEYMAP_BITMAP_SIZE];
+extern const uint16_t sparse_keymap_offsets[][SPARSE_KEYMAP_BITMAP_SIZE];
+extern const uint16_t sparse_keymap_keycodes[];
+#endif
@@ -43,56 +43,115 @@ extern keymap_config_t keymap_config;
 /* converts key to action */
 action_t action_for_key(uint8_t layer, keypos_t key) {
     // 16bit keycodes - important
-    uint16_t keycode = keymap_key_to_keycode(layer, key);
+    return action_for_keycode(keymap_key_to_keycode(layer, key));
+}
 
-    // keycode remapping
-    keycode = keycode_config(keycode);
+/* Keycode kinds, one per high byte of a keycode
+ *
+ * Every QK_* range starts and ends on a 256 keycode boundary, so the high byte alone decides how a
+ * keycode is decoded. Ranges of disabled features are left at KEYCODE_KIND_NONE.
+ */
+enum keycode_kind {
+    KEYCODE_KIND_NONE = 0,
+    KEYCODE_KIND_BASIC,
+    KEYCODE_KIND_MODS,
+    KEYCODE_KIND_FUNCTION,
+    KEYCODE_KIND_MACRO,
+    KEYCODE_KIND_LAYER_TAP,
+    KEYCODE_KIND_TO,
+    KEYCODE_KIND_MOMENTARY,
+    KEYCODE_KIND_DEF_LAYER,
+    KEYCODE_KIND_TOGGLE_LAYER,
+    KEYCODE_KIND_ONE_SHOT_LAYER,
+    KEYCODE_KIND_ONE_SHOT_MOD,
+    KEYCODE_KIND_LAYER_TAP_TOGGLE,
+    KEYCODE_KIND_LAYER_MOD,
+    KEYCODE_KIND_MOD_TAP,
+    KEYCODE_KIND_SWAP_HANDS,
+};
 
-    action_t action = {};
-    uint8_t  action_layer, when, mod;
+#define KEYCODE_KIND_RANGE(min, max) [(min) >> 8 ...(max) >> 8]
 
-    (void)action_layer;
-    (void)when;
-    (void)mod;
+static const uint8_t PROGMEM keycode_kinds[256] = {
+    [QK_BASIC >> 8]                          = KEYCODE_KIND_BASIC,
+    KEYCODE_KIND_RANGE(QK_MODS, QK_MODS_MAX) = KEYCODE_KIND_MODS,
+#ifndef NO_ACTION_FUNCTION
+    KEYCODE_KIND_RANGE(QK_FUNCTION, QK_FUNCTION_MAX) = KEYCODE_KIND_FUNCTION,
+#endif
+#ifndef NO_ACTION_MACRO
+    KEYCODE_KIND_RANGE(QK_MACRO, QK_MACRO_MAX) = KEYCODE_KIND_MACRO,
+#endif
+#ifndef NO_ACTION_LAYER
+    KEYCODE_KIND_RANGE(QK_LAYER_TAP, QK_LAYER_TAP_MAX)               = KEYCODE_KIND_LAYER_TAP,
+    KEYCODE_KIND_RANGE(QK_TO, QK_TO_MAX)                             = KEYCODE_KIND_TO,
+    KEYCODE_KIND_RANGE(QK_MOMENTARY, QK_MOMENTARY_MAX)               = KEYCODE_KIND_MOMENTARY,
+    KEYCODE_KIND_RANGE(QK_DEF_LAYER, QK_DEF_LAYER_MAX)               = KEYCODE_KIND_DEF_LAYER,
+    KEYCODE_KIND_RANGE(QK_TOGGLE_LAYER, QK_TOGGLE_LAYER_MAX)         = KEYCODE_KIND_TOGGLE_LAYER,
+    KEYCODE_KIND_RANGE(QK_LAYER_TAP_TOGGLE, QK_LAYER_TAP_TOGGLE_MAX) = KEYCODE_KIND_LAYER_TAP_TOGGLE,
+    KEYCODE_KIND_RANGE(QK_LAYER_MOD, QK_LAYER_MOD_MAX)               = KEYCODE_KIND_LAYER_MOD,
+#endif
+#ifndef NO_ACTION_ONESHOT
+    KEYCODE_KIND_RANGE(QK_ONE_SHOT_LAYER, QK_ONE_SHOT_LAYER_MAX) = KEYCODE_KIND_ONE_SHOT_LAYER,
+    KEYCODE_KIND_RANGE(QK_ONE_SHOT_MOD, QK_ONE_SHOT_MOD_MAX)     = KEYCODE_KIND_ONE_SHOT_MOD,
+#endif
+#ifndef NO_ACTION_TAPPING
+    KEYCODE_KIND_RANGE(QK_MOD_TAP, QK_MOD_TAP_MAX) = KEYCODE_KIND_MOD_TAP,
+#endif
+#ifdef SWAP_HANDS_ENABLE
+    KEYCODE_KIND_RANGE(QK_SWAP_HANDS, QK_SWAP_HANDS_MAX) = KEYCODE_KIND_SWAP_HANDS,
+#endif
+};
 
+/* converts a basic keycode (0x00 - 0xFF) to action */
+static uint16_t action_for_basic_keycode(uint8_t keycode) {
     switch (keycode) {
         case KC_A ... KC_EXSEL:
         case KC_LCTRL ... KC_RGUI:
-            action.code = ACTION_KEY(keycode);
-            break;
+            return ACTION_KEY(keycode);
 #ifdef EXTRAKEY_ENABLE
         case KC_SYSTEM_POWER ... KC_SYSTEM_WAKE:
-            action.code = ACTION_USAGE_SYSTEM(KEYCODE2SYSTEM(keycode));
-            break;
+            return ACTION_USAGE_SYSTEM(KEYCODE2SYSTEM(keycode));
         case KC_AUDIO_MUTE ... KC_BRIGHTNESS_DOWN:
-            action.code = ACTION_USAGE_CONSUMER(KEYCODE2CONSUMER(keycode));
-            break;
+            return ACTION_USAGE_CONSUMER(KEYCODE2CONSUMER(keycode));
 #endif
 #ifdef MOUSEKEY_ENABLE
         case KC_MS_UP ... KC_MS_ACCEL2:
-            action.code = ACTION_MOUSEKEY(keycode);
-            break;
+            return ACTION_MOUSEKEY(keycode);
 #endif
         case KC_TRNS:
-            action.code = ACTION_TRANSPARENT;
+            return ACTION_TRANSPARENT;
+#ifndef NO_ACTION_FUNCTION
+        case KC_FN0 ... KC_FN31:
+            return keymap_function_id_to_action(FN_INDEX(keycode));
+#endif
+        default:
+            return ACTION_NO;
+    }
+}
+
+/* converts keycode to action */
+action_t action_for_keycode(uint16_t keycode) {
+    action_t action;
+
+    switch (pgm_read_byte(&keycode_kinds[keycode >> 8])) {
+        case KEYCODE_KIND_BASIC:
+            // keycode remapping, only basic keycodes are affected
+            action.code = action_for_basic_keycode(keycode_config(keycode));
             break;
-        case QK_MODS ... QK_MODS_MAX:;
+        case KEYCODE_KIND_MODS:
             // Has a modifier
             // Split it up
             action.code = ACTION_MODS_KEY(keycode >> 8, keycode & 0xFF);  // adds modifier to key
             break;
 #ifndef NO_ACTION_FUNCTION
-        case KC_FN0 ... KC_FN31:
-            action.code = keymap_function_id_to_action(FN_INDEX(keycode));
-            break;
-        case QK_FUNCTION ... QK_FUNCTION_MAX:;
+        case KEYCODE_KIND_FUNCTION:
             // Is a shortcut for function action_layer, pull last 12bits
             // This means we have 4,096 FN macros at our disposal
             action.code = keymap_function_id_to_action((int)keycode & 0xFFF);
             break;
 #endif
 #ifndef NO_ACTION_MACRO
-        case QK_MACRO ... QK_MACRO_MAX:
+        case KEYCODE_KIND_MACRO:
             if (keycode & 0x800)  // tap macros have upper bit set
                 action.code = ACTION_MACRO_TAP(keycode & 0xFF);
             else
@@ -100,65 +159,49 @@ action_t action_for_key(uint8_t layer, keypos_t key) {
             break;
 #endif
 #ifndef NO_ACTION_LAYER
-        case QK_LAYER_TAP ... QK_LAYER_TAP_MAX:
+        case KEYCODE_KIND_LAYER_TAP:
             action.code = ACTION_LAYER_TAP_KEY((keycode >> 0x8) & 0xF, keycode & 0xFF);
             break;
-        case QK_TO ... QK_TO_MAX:;
+        case KEYCODE_KIND_TO:
             // Layer set "GOTO"
-            when         = (keycode >> 0x4) & 0x3;
-            action_layer = keycode & 0xF;
-            action.code  = ACTION_LAYER_SET(action_layer, when);
+            action.code = ACTION_LAYER_SET(keycode & 0xF, (keycode >> 0x4) & 0x3);
             break;
-        case QK_MOMENTARY ... QK_MOMENTARY_MAX:;
-            // Momentary action_layer
-            action_layer = keycode & 0xFF;
-            action.code  = ACTION_LAYER_MOMENTARY(action_layer);
+        case KEYCODE_KIND_MOMENTARY:
+            action.code = ACTION_LAYER_MOMENTARY(keycode & 0xFF);
             break;
-        case QK_DEF_LAYER ... QK_DEF_LAYER_MAX:;
-            // Set default action_layer
-            action_layer = keycode & 0xFF;
-            action.code  = ACTION_DEFAULT_LAYER_SET(action_layer);
+        case KEYCODE_KIND_DEF_LAYER:
+            action.code = ACTION_DEFAULT_LAYER_SET(keycode & 0xFF);
             break;
-        case QK_TOGGLE_LAYER ... QK_TOGGLE_LAYER_MAX:;
-            // Set toggle
-            action_layer = keycode & 0xFF;
-            action.code  = ACTION_LAYER_TOGGLE(action_layer);
+        case KEYCODE_KIND_TOGGLE_LAYER:
+            action.code = ACTION_LAYER_TOGGLE(keycode & 0xFF);
+            break;
+        case KEYCODE_KIND_LAYER_TAP_TOGGLE:
+            action.code = ACTION_LAYER_TAP_TOGGLE(keycode & 0xFF);
+            break;
+        case KEYCODE_KIND_LAYER_MOD:
+            action.code = ACTION_LAYER_MODS((keycode >> 4) & 0xF, mod_config(keycode & 0xF));
             break;
 #endif
 #ifndef NO_ACTION_ONESHOT
-        case QK_ONE_SHOT_LAYER ... QK_ONE_SHOT_LAYER_MAX:;
+        case KEYCODE_KIND_ONE_SHOT_LAYER:
             // OSL(action_layer) - One-shot action_layer
-            action_layer = keycode & 0xFF;
-            action.code  = ACTION_LAYER_ONESHOT(action_layer);
+            action.code = ACTION_LAYER_ONESHOT(keycode & 0xFF);
             break;
-        case QK_ONE_SHOT_MOD ... QK_ONE_SHOT_MOD_MAX:;
+        case KEYCODE_KIND_ONE_SHOT_MOD:
             // OSM(mod) - One-shot mod
-            mod         = mod_config(keycode & 0xFF);
-            action.code = ACTION_MODS_ONESHOT(mod);
-            break;
-#endif
-#ifndef NO_ACTION_LAYER
-        case QK_LAYER_TAP_TOGGLE ... QK_LAYER_TAP_TOGGLE_MAX:
-            action.code = ACTION_LAYER_TAP_TOGGLE(keycode & 0xFF);
-            break;
-        case QK_LAYER_MOD ... QK_LAYER_MOD_MAX:
-            mod          = mod_config(keycode & 0xF);
-            action_layer = (keycode >> 4) & 0xF;
-            action.code  = ACTION_LAYER_MODS(action_layer, mod);
+            action.code = ACTION_MODS_ONESHOT(mod_config(keycode & 0xFF));
             break;
 #endif
 #ifndef NO_ACTION_TAPPING
-        case QK_MOD_TAP ... QK_MOD_TAP_MAX:
-            mod         = mod_config((keycode >> 0x8) & 0x1F);
-            action.code = ACTION_MODS_TAP_KEY(mod, keycode & 0xFF);
+        case KEYCODE_KIND_MOD_TAP:
+            action.code = ACTION_MODS_TAP_KEY(mod_config((keycode >> 0x8) & 0x1F), keycode & 0xFF);
             break;
 #endif
 #ifdef SWAP_HANDS_ENABLE
-        case QK_SWAP_HANDS ... QK_SWAP_HANDS_MAX:
+        case KEYCODE_KIND_SWAP_HANDS:
             action.code = ACTION(ACT_SWAP_HANDS, keycode & 0xff);
             break;
 #endif
-
         default:
             action.code = ACTION_NO;
             break;
@@ -176,11 +219,13 @@ __attribute__((weak)) const macro_t *action_get_macro(keyrecord_t *record, uint8
 /* Function */
 __attribute__((weak)) void action_function(keyrecord_t *record, uint8_t id, uint8_t opt) {}
 
+#ifndef SPARSE_KEYMAP_ENABLE
 // translates key to keycode
 __attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
     // Read entire word (16bits)
     return pgm_read_word(&keymaps[(layer)][(key.row)][(key.col)]);
 }
+#endif
 
 // translates function id to action
 __attribute__((weak)) uint16_t keymap_function_id_to_action(uint16_t function_id) {
@@ -27,18 +27,52 @@
 #include <string.h>
 #include <math.h>
 
-led_eeconfig_t led_matrix_eeconfig;
+#include <lib/lib8tion/lib8tion.h>
 
-#ifndef MAX
-#    define MAX(X, Y) ((X) > (Y) ? (X) : (Y))
+#ifndef LED_MATRIX_CENTER
+const point_t k_led_matrix_center = {112, 32};
+#else
+const point_t k_led_matrix_center = LED_MATRIX_CENTER;
 #endif
 
-#ifndef MIN
-#    define MIN(a, b) ((a) < (b) ? (a) : (b))
+// Generic effect runners, on brightness values
+#define LIGHTING_COLOR_T uint8_t
+#define LIGHTING_BASE_COLOR led_matrix_eeconfig.val
+#define LIGHTING_VAL(value) (value)
+#define LIGHTING_SET_COLOR(i, value) led_matrix_set_index_value(i, value)
+#define LIGHTING_CONFIG led_matrix_eeconfig
+#define LIGHTING_TIMER g_led_timer
+#define LIGHTING_CENTER k_led_matrix_center
+#define LIGHTING_BASE_HSV ((HSV){0, 0, led_matrix_eeconfig.val})
+#define LIGHTING_COLOR_FROM_HSV(hsv) ((hsv).v)
+
+#include "lighting_matrix_runners/effect_runner_dx_dy_dist.h"
+#include "lighting_matrix_runners/effect_runner_dx_dy.h"
+#include "lighting_matrix_runners/effect_runner_i.h"
+#include "lighting_matrix_runners/effect_runner_sin_cos_i.h"
+#include "lighting_matrix_runners/effect_runner_reactive.h"
+#include "lighting_matrix_runners/effect_runner_reactive_splash.h"
+
+// ------------------------------------------
+// -----Begin led effect includes macros-----
+#define LED_MATRIX_EFFECT(name)
+#define LED_MATRIX_CUSTOM_EFFECT_IMPLS
+#define LIGHTING_EFFECT_IMPLS
+
+#include "led_matrix_animations/led_matrix_effects.inc"
+
+#undef LIGHTING_EFFECT_IMPLS
+#undef LED_MATRIX_CUSTOM_EFFECT_IMPLS
+#undef LED_MATRIX_EFFECT
+// -----End led effect includes macros-------
+// ------------------------------------------
+
+#if defined(LED_DISABLE_AFTER_TIMEOUT) && !defined(LED_DISABLE_TIMEOUT)
+#    define LED_DISABLE_TIMEOUT (LED_DISABLE_AFTER_TIMEOUT * 60000UL)
 #endif
 
-#ifndef LED_DISABLE_AFTER_TIMEOUT
-#    define LED_DISABLE_AFTER_TIMEOUT 0
+#ifndef LED_DISABLE_TIMEOUT
+#    define LED_DISABLE_TIMEOUT 0
 #endif
 
 #ifndef LED_DISABLE_WHEN_USB_SUSPENDED
@@ -49,20 +83,68 @@ led_eeconfig_t led_matrix_eeconfig;
 #    define EECONFIG_LED_MATRIX EECONFIG_RGBLIGHT
 #endif
 
-#if !defined(LED_MATRIX_MAXIMUM_BRIGHTNESS) || LED_MATRIX_MAXIMUM_BRIGHTNESS > 255
-#    define LED_MATRIX_MAXIMUM_BRIGHTNESS 255
+#if !defined(LED_MATRIX_MAXIMUM_BRIGHTNESS) || LED_MATRIX_MAXIMUM_BRIGHTNESS > UINT8_MAX
+#    undef LED_MATRIX_MAXIMUM_BRIGHTNESS
+#    define LED_MATRIX_MAXIMUM_BRIGHTNESS UINT8_MAX
 #endif
 
-bool g_suspend_state = false;
+#if !defined(LED_MATRIX_VAL_STEP)
+#    define LED_MATRIX_VAL_STEP 8
+#endif
+
+#if !defined(LED_MATRIX_SPD_STEP)
+#    define LED_MATRIX_SPD_STEP 16
+#endif
+
+#if !defined(LED_MATRIX_STARTUP_MODE)
+#    define LED_MATRIX_STARTUP_MODE LED_MATRIX_UNIFORM_BRIGHTNESS
+#endif
+
+#if !defined(LED_MATRIX_STARTUP_VAL)
+#    define LED_MATRIX_STARTUP_VAL LED_MATRIX_MAXIMUM_BRIGHTNESS
+#endif
+
+#if !defined(LED_MATRIX_STARTUP_SPD)
+#    define LED_MATRIX_STARTUP_SPD UINT8_MAX / 2
+#endif
 
-// Global tick at 20 Hz
-uint32_t g_tick = 0;
+// globals
+bool           g_suspend_state = false;
+led_eeconfig_t led_matrix_eeconfig;  // TODO: would like to prefix this with g_ for global consistancy, do this in another pr
+uint32_t       g_led_timer;
+
+// The lighting core, shared with RGB Matrix
+#define LIGHTING_NAME "led matrix"
+#define LIGHTING_LED_FLUSH_LIMIT LED_MATRIX_LED_FLUSH_LIMIT
+#define LIGHTING_LED_PROCESS_LIMIT (LED_MATRIX_LED_PROCESS_LIMIT)
+#define LIGHTING_DISABLE_TIMEOUT LED_DISABLE_TIMEOUT
+#define LIGHTING_DISABLE_WHEN_USB_SUSPENDED LED_DISABLE_WHEN_USB_SUSPENDED
+#if defined(LED_MATRIX_KEYRELEASES)
+#    define LIGHTING_KEYRELEASES
+#elif defined(LED_MATRIX_KEYPRESSES)
+#    define LIGHTING_KEYPRESSES
+#endif
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+#    define LIGHTING_RENDER_BUDGET_US LED_MATRIX_RENDER_BUDGET_US
+#    define LIGHTING_RENDER_BACKOFF_BUDGET_US LED_MATRIX_RENDER_BACKOFF_BUDGET_US
+#    define LIGHTING_RENDER_BACKOFF_MS LED_MATRIX_RENDER_BACKOFF_MS
+#    define LIGHTING_RENDER_TIMER LED_MATRIX_RENDER_TIMER
+#    define LIGHTING_RENDER_TIMER_PER_US LED_MATRIX_RENDER_TIMER_PER_US
+#endif
 
-// Ticks since this key was last hit.
-uint8_t g_key_hit[DRIVER_LED_TOTAL];
+#ifdef LED_MATRIX_KEY_LEDS
+#    define LIGHTING_KEY_LED_OFFSETS LED_MATRIX_KEY_LED_OFFSETS
+#    define LIGHTING_KEY_LEDS LED_MATRIX_KEY_LEDS
+#    define LIGHTING_LED_KEYS LED_MATRIX_LED_KEYS
+#    define LIGHTING_KEY_LEDS_MAX LED_MATRIX_KEY_LEDS_MAX
+#endif
 
-// Ticks since any key was last hit.
-uint32_t g_any_key_hit = 0;
+#include "lighting_matrix_core.h"
+
+#ifdef LED_MATRIX_LED_CONFIG
+// Generated from the led_matrix layout in info.json by `qmk generate-led-config`
+led_config_t g_led_config = LED_MATRIX_LED_CONFIG;
+#endif
 
 uint32_t eeconfig_read_led_matrix(void) { return eeprom_read_dword(EECONFIG_LED_MATRIX); }
 
@@ -71,9 +153,9 @@ void eeconfig_update_led_matrix(uint32_t config_value) { eeprom_update_dword(EEC
 void eeconfig_update_led_matrix_default(void) {
     dprintf("eeconfig_update_led_matrix_default\n");
     led_matrix_eeconfig.enable = 1;
-    led_matrix_eeconfig.mode   = LED_MATRIX_UNIFORM_BRIGHTNESS;
-    led_matrix_eeconfig.val    = 128;
-    led_matrix_eeconfig.speed  = 0;
+    led_matrix_eeconfig.mode   = LED_MATRIX_STARTUP_MODE;
+    led_matrix_eeconfig.val    = LED_MATRIX_STARTUP_VAL;
+    led_matrix_eeconfig.speed  = LED_MATRIX_STARTUP_SPD;
     eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
 }
 
@@ -85,105 +167,83 @@ void eeconfig_debug_led_matrix(void) {
     dprintf("led_matrix_eeconfig.speed = %d\n", led_matrix_eeconfig.speed);
 }
 
-uint8_t g_last_led_hit[LED_HITS_TO_REMEMBER] = {255};
-uint8_t g_last_led_count                     = 0;
+__attribute__((weak)) uint8_t led_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i) { return 0; }
 
-uint8_t map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) {
-    uint8_t led_count = 0;
+uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) {
+#ifdef LED_MATRIX_KEY_LEDS
+    return lighting_key_map_leds(row, column, led_i);
+#else
+    uint8_t led_count = led_matrix_map_row_column_to_led_kb(row, column, led_i);
     uint8_t led_index = g_led_config.matrix_co[row][column];
     if (led_index != NO_LED) {
         led_i[led_count] = led_index;
         led_count++;
     }
     return led_count;
+#endif
 }
 
+bool led_matrix_map_led_to_row_column(uint8_t led, uint8_t *row, uint8_t *column) { return lighting_map_led_to_row_column(led, row, column); }
+
 void led_matrix_update_pwm_buffers(void) { led_matrix_driver.flush(); }
 
 void led_matrix_set_index_value(int index, uint8_t value) { led_matrix_driver.set_value(index, value); }
 
 void led_matrix_set_index_value_all(uint8_t value) { led_matrix_driver.set_value_all(value); }
 
-bool process_led_matrix(uint16_t keycode, keyrecord_t *record) {
-    if (record->event.pressed) {
-        uint8_t led[8];
-        uint8_t led_count = map_row_column_to_led(record->event.key.row, record->event.key.col, led);
-        if (led_count > 0) {
-            for (uint8_t i = LED_HITS_TO_REMEMBER; i > 1; i--) {
-                g_last_led_hit[i - 1] = g_last_led_hit[i - 2];
-            }
-            g_last_led_hit[0] = led[0];
-            g_last_led_count  = MIN(LED_HITS_TO_REMEMBER, g_last_led_count + 1);
-        }
-        for (uint8_t i = 0; i < led_count; i++) g_key_hit[led[i]] = 0;
-        g_any_key_hit = 0;
-    } else {
-#ifdef LED_MATRIX_KEYRELEASES
-        uint8_t led[8];
-        uint8_t led_count = map_row_column_to_led(record->event.key.row, record->event.key.col, led);
-        for (uint8_t i = 0; i < led_count; i++) g_key_hit[led[i]] = 255;
-
-        g_any_key_hit = 255;
+void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
+#ifndef LED_MATRIX_SPLIT
+    if (!is_keyboard_master()) return;
 #endif
-    }
-    return true;
+    lighting_process(row, col, pressed);
 }
 
-void led_matrix_set_suspend_state(bool state) { g_suspend_state = state; }
-
-// All LEDs off
-void led_matrix_all_off(void) { led_matrix_set_index_value_all(0); }
-
-// Uniform brightness
-void led_matrix_uniform_brightness(void) { led_matrix_set_index_value_all(LED_MATRIX_MAXIMUM_BRIGHTNESS / BACKLIGHT_LEVELS * led_matrix_eeconfig.val); }
-
-void led_matrix_custom(void) {}
-
-void led_matrix_task(void) {
-    if (!led_matrix_eeconfig.enable) {
-        led_matrix_all_off();
-        led_matrix_indicators();
-        return;
-    }
-
-    g_tick++;
-
-    if (g_any_key_hit < 0xFFFFFFFF) {
-        g_any_key_hit++;
+static bool led_matrix_none(effect_params_t *params) {
+    if (!params->init) {
+        return false;
     }
 
-    for (int led = 0; led < DRIVER_LED_TOTAL; led++) {
-        if (g_key_hit[led] < 255) {
-            if (g_key_hit[led] == 254) g_last_led_count = MAX(g_last_led_count - 1, 0);
-            g_key_hit[led]++;
-        }
-    }
+    led_matrix_set_index_value_all(0);
+    return false;
+}
 
-    // Ideally we would also stop sending zeros to the LED driver PWM buffers
-    // while suspended and just do a software shutdown. This is a cheap hack for now.
-    bool    suspend_backlight = ((g_suspend_state && LED_DISABLE_WHEN_USB_SUSPENDED) || (LED_DISABLE_AFTER_TIMEOUT > 0 && g_any_key_hit > LED_DISABLE_AFTER_TIMEOUT * 60 * 20));
-    uint8_t effect            = suspend_backlight ? 0 : led_matrix_eeconfig.mode;
+static bool lighting_render_effect(uint8_t effect, effect_params_t *params) {
+    bool rendering = false;
 
-    // this gets ticked at 20 Hz.
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
-        case LED_MATRIX_UNIFORM_BRIGHTNESS:
-            led_matrix_uniform_brightness();
-            break;
-        default:
-            led_matrix_custom();
+        case LED_MATRIX_NONE:
+            rendering = led_matrix_none(params);
             break;
-    }
 
-    if (!suspend_backlight) {
-        led_matrix_indicators();
+// ---------------------------------------------
+// -----Begin led effect switch case macros-----
+#define LED_MATRIX_EFFECT(name, ...) \
+    case LED_MATRIX_##name:          \
+        rendering = name(params);    \
+        break;
+#include "led_matrix_animations/led_matrix_effects.inc"
+#undef LED_MATRIX_EFFECT
+            // -----End led effect switch case macros-------
+            // ---------------------------------------------
     }
+    return rendering;
+}
+
+static void lighting_render_done(void) {}
 
-    // Tell the LED driver to update its state
-    led_matrix_driver.flush();
+static void lighting_indicators(effect_params_t *params) {
+    led_matrix_indicators();
+    led_matrix_indicators_advanced(params);
 }
 
+static void lighting_update_pwm_buffers(void) { led_matrix_update_pwm_buffers(); }
+
+static uint8_t lighting_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) { return led_matrix_map_row_column_to_led(row, column, led_i); }
+
+void led_matrix_task(void) { lighting_task(); }
+
 void led_matrix_indicators(void) {
     led_matrix_indicators_kb();
     led_matrix_indicators_user();
@@ -193,33 +253,20 @@ __attribute__((weak)) void led_matrix_indicators_kb(void) {}
 
 __attribute__((weak)) void led_matrix_indicators_user(void) {}
 
-// void led_matrix_set_indicator_index(uint8_t *index, uint8_t row, uint8_t column)
-// {
-//  if (row >= MATRIX_ROWS)
-//  {
-//      // Special value, 255=none, 254=all
-//      *index = row;
-//  }
-//  else
-//  {
-//      // This needs updated to something like
-//      // uint8_t led[8];
-//      // uint8_t led_count = map_row_column_to_led(row, column, led);
-//      // for(uint8_t i = 0; i < led_count; i++)
-//      map_row_column_to_led(row, column, index);
-//  }
-// }
+void led_matrix_indicators_advanced(effect_params_t *params) {
+    // the LEDs the effect just rendered
+    led_matrix_indicators_advanced_kb(params->led_min, params->led_max);
+    led_matrix_indicators_advanced_user(params->led_min, params->led_max);
+}
+
+__attribute__((weak)) void led_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max) {}
+
+__attribute__((weak)) void led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {}
 
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
-    // Wait half a second for the driver to finish initializing
-    wait_ms(500);
-
-    // clear the key hits
-    for (int led = 0; led < DRIVER_LED_TOTAL; led++) {
-        g_key_hit[led] = 255;
-    }
+    lighting_init();
 
     if (!eeconfig_is_enabled()) {
         dprintf("led_matrix_init_drivers eeconfig is not enabled.\n");
@@ -228,121 +275,145 @@ void led_matrix_init(void) {
     }
 
     led_matrix_eeconfig.raw = eeconfig_read_led_matrix();
-
     if (!led_matrix_eeconfig.mode) {
         dprintf("led_matrix_init_drivers led_matrix_eeconfig.mode = 0. Write default values to EEPROM.\n");
         eeconfig_update_led_matrix_default();
-        led_matrix_eeconfig.raw = eeconfig_read_led_matrix();
     }
-
     eeconfig_debug_led_matrix();  // display current eeprom values
 }
 
-// Deals with the messy details of incrementing an integer
-static uint8_t increment(uint8_t value, uint8_t step, uint8_t min, uint8_t max) {
-    int16_t new_value = value;
-    new_value += step;
-    return MIN(MAX(new_value, min), max);
+void led_matrix_set_suspend_state(bool state) {
+    if (LED_DISABLE_WHEN_USB_SUSPENDED && state) {
+        led_matrix_set_index_value_all(0);  // turn off all LEDs when suspending
+    }
+    g_suspend_state = state;
 }
 
-static uint8_t decrement(uint8_t value, uint8_t step, uint8_t min, uint8_t max) {
-    int16_t new_value = value;
-    new_value -= step;
-    return MIN(MAX(new_value, min), max);
-}
+bool led_matrix_get_suspend_state(void) { return g_suspend_state; }
 
-// void *backlight_get_custom_key_value_eeprom_address(uint8_t led) {
-//     // 3 bytes per value
-//     return EECONFIG_LED_MATRIX + (led * 3);
-// }
-
-// void backlight_get_key_value(uint8_t led, uint8_t *value) {
-//     void *address = backlight_get_custom_key_value_eeprom_address(led);
-//     value = eeprom_read_byte(address);
-// }
-
-// void backlight_set_key_value(uint8_t row, uint8_t column, uint8_t value) {
-//     uint8_t led[8];
-//     uint8_t led_count = map_row_column_to_led(row, column, led);
-//     for(uint8_t i = 0; i < led_count; i++) {
-//         if (led[i] < DRIVER_LED_TOTAL) {
-//             void *address = backlight_get_custom_key_value_eeprom_address(led[i]);
-//             eeprom_update_byte(address, value);
-//         }
-//     }
-// }
-
-uint32_t led_matrix_get_tick(void) { return g_tick; }
-
-void led_matrix_toggle(void) {
+uint32_t led_matrix_get_tick(void) { return g_led_timer; }
+
+void led_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     led_matrix_eeconfig.enable ^= 1;
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
+    lighting_task_state = STARTING;
+    if (write_to_eeprom) {
+        eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
+    }
+    dprintf("led matrix toggle [%s]: led_matrix_eeconfig.enable = %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.enable);
 }
+void led_matrix_toggle_noeeprom(void) { led_matrix_toggle_eeprom_helper(false); }
+void led_matrix_toggle(void) { led_matrix_toggle_eeprom_helper(true); }
 
 void led_matrix_enable(void) {
-    led_matrix_eeconfig.enable = 1;
+    led_matrix_enable_noeeprom();
     eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
 }
 
-void led_matrix_enable_noeeprom(void) { led_matrix_eeconfig.enable = 1; }
+void led_matrix_enable_noeeprom(void) {
+    if (!led_matrix_eeconfig.enable) lighting_task_state = STARTING;
+    led_matrix_eeconfig.enable = 1;
+}
 
 void led_matrix_disable(void) {
-    led_matrix_eeconfig.enable = 0;
+    led_matrix_disable_noeeprom();
     eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
 }
 
-void led_matrix_disable_noeeprom(void) { led_matrix_eeconfig.enable = 0; }
-
-void led_matrix_step(void) {
-    led_matrix_eeconfig.mode++;
-    if (led_matrix_eeconfig.mode >= LED_MATRIX_EFFECT_MAX) {
-        led_matrix_eeconfig.mode = 1;
-    }
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
+void led_matrix_disable_noeeprom(void) {
+    if (led_matrix_eeconfig.enable) lighting_task_state = STARTING;
+    led_matrix_eeconfig.enable = 0;
 }
 
-void led_matrix_step_reverse(void) {
-    led_matrix_eeconfig.mode--;
-    if (led_matrix_eeconfig.mode < 1) {
+uint8_t led_matrix_is_enabled(void) { return led_matrix_eeconfig.enable; }
+
+void led_matrix_mode(uint8_t mode, bool eeprom_write) {
+    if (!led_matrix_eeconfig.enable) {
+        return;
+    }
+    if (mode < 1) {
+        led_matrix_eeconfig.mode = 1;
+    } else if (mode >= LED_MATRIX_EFFECT_MAX) {
         led_matrix_eeconfig.mode = LED_MATRIX_EFFECT_MAX - 1;
+    } else {
+        led_matrix_eeconfig.mode = mode;
     }
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
+    lighting_task_state = STARTING;
+    if (eeprom_write) {
+        eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
+    }
+    dprintf("led matrix mode [%s]: %u\n", (eeprom_write) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.mode);
 }
+void led_matrix_mode_noeeprom(uint8_t mode) { led_matrix_mode(mode, false); }
 
-void led_matrix_increase_val(void) {
-    led_matrix_eeconfig.val = increment(led_matrix_eeconfig.val, 8, 0, LED_MATRIX_MAXIMUM_BRIGHTNESS);
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
-}
+uint8_t led_matrix_get_mode(void) { return led_matrix_eeconfig.mode; }
 
-void led_matrix_decrease_val(void) {
-    led_matrix_eeconfig.val = decrement(led_matrix_eeconfig.val, 8, 0, LED_MATRIX_MAXIMUM_BRIGHTNESS);
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
+void led_matrix_step_helper(bool write_to_eeprom) {
+    uint8_t mode = led_matrix_eeconfig.mode + 1;
+    led_matrix_mode((mode < LED_MATRIX_EFFECT_MAX) ? mode : 1, write_to_eeprom);
 }
+void led_matrix_step_noeeprom(void) { led_matrix_step_helper(false); }
+void led_matrix_step(void) { led_matrix_step_helper(true); }
 
-void led_matrix_increase_speed(void) {
-    led_matrix_eeconfig.speed = increment(led_matrix_eeconfig.speed, 1, 0, 3);
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);  // EECONFIG needs to be increased to support this
+void led_matrix_step_reverse_helper(bool write_to_eeprom) {
+    uint8_t mode = led_matrix_eeconfig.mode - 1;
+    led_matrix_mode((mode < 1) ? LED_MATRIX_EFFECT_MAX - 1 : mode, write_to_eeprom);
 }
+void led_matrix_step_reverse_noeeprom(void) { led_matrix_step_reverse_helper(false); }
+void led_matrix_step_reverse(void) { led_matrix_step_reverse_helper(true); }
 
-void led_matrix_decrease_speed(void) {
-    led_matrix_eeconfig.speed = decrement(led_matrix_eeconfig.speed, 1, 0, 3);
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);  // EECONFIG needs to be increased to support this
+void led_matrix_set_value_eeprom_helper(uint8_t val, bool write_to_eeprom) {
+    if (!led_matrix_eeconfig.enable) {
+        return;
+    }
+    led_matrix_eeconfig.val = (val > LED_MATRIX_MAXIMUM_BRIGHTNESS) ? LED_MATRIX_MAXIMUM_BRIGHTNESS : val;
+    if (write_to_eeprom) {
+        eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
+    }
+    dprintf("led matrix set val [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.val);
 }
+void led_matrix_set_value_noeeprom(uint8_t val) { led_matrix_set_value_eeprom_helper(val, false); }
+void led_matrix_set_value(uint8_t val) { led_matrix_set_value_eeprom_helper(val, true); }
 
-void led_matrix_mode(uint8_t mode, bool eeprom_write) {
-    led_matrix_eeconfig.mode = mode;
-    if (eeprom_write) {
+uint8_t led_matrix_get_val(void) { return led_matrix_eeconfig.val; }
+
+void led_matrix_increase_val_helper(bool write_to_eeprom) { led_matrix_set_value_eeprom_helper(qadd8(led_matrix_eeconfig.val, LED_MATRIX_VAL_STEP), write_to_eeprom); }
+void led_matrix_increase_val_noeeprom(void) { led_matrix_increase_val_helper(false); }
+void led_matrix_increase_val(void) { led_matrix_increase_val_helper(true); }
+
+void led_matrix_decrease_val_helper(bool write_to_eeprom) { led_matrix_set_value_eeprom_helper(qsub8(led_matrix_eeconfig.val, LED_MATRIX_VAL_STEP), write_to_eeprom); }
+void led_matrix_decrease_val_noeeprom(void) { led_matrix_decrease_val_helper(false); }
+void led_matrix_decrease_val(void) { led_matrix_decrease_val_helper(true); }
+
+void led_matrix_set_speed_eeprom_helper(uint8_t speed, bool write_to_eeprom) {
+    led_matrix_eeconfig.speed = speed;
+    if (write_to_eeprom) {
         eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
     }
+    dprintf("led matrix set speed [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.speed);
 }
+void led_matrix_set_speed_noeeprom(uint8_t speed) { led_matrix_set_speed_eeprom_helper(speed, false); }
+void led_matrix_set_speed(uint8_t speed) { led_matrix_set_speed_eeprom_helper(speed, true); }
 
-uint8_t led_matrix_get_mode(void) { return led_matrix_eeconfig.mode; }
+uint8_t led_matrix_get_speed(void) { return led_matrix_eeconfig.speed; }
 
-void led_matrix_set_value_noeeprom(uint8_t val) { led_matrix_eeconfig.val = val; }
+void led_matrix_increase_speed_helper(bool write_to_eeprom) { led_matrix_set_speed_eeprom_helper(qadd8(led_matrix_eeconfig.speed, LED_MATRIX_SPD_STEP), write_to_eeprom); }
+void led_matrix_increase_speed_noeeprom(void) { led_matrix_increase_speed_helper(false); }
+void led_matrix_increase_speed(void) { led_matrix_increase_speed_helper(true); }
 
-void led_matrix_set_value(uint8_t val) {
-    led_matrix_set_value_noeeprom(val);
-    eeconfig_update_led_matrix(led_matrix_eeconfig.raw);
-}
+void led_matrix_decrease_speed_helper(bool write_to_eeprom) { led_matrix_set_speed_eeprom_helper(qsub8(led_matrix_eeconfig.speed, LED_MATRIX_SPD_STEP), write_to_eeprom); }
+void led_matrix_decrease_speed_noeeprom(void) { led_matrix_decrease_speed_helper(false); }
+void led_matrix_decrease_speed(void) { led_matrix_decrease_speed_helper(true); }
+
+led_flags_t led_matrix_get_flags(void) { return lighting_effect_params.flags; }
+
+void led_matrix_set_flags(led_flags_t flags) { lighting_effect_params.flags = flags; }
 
-void backlight_set(uint8_t val) { led_matrix_set_value(val); }
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+lighting_render_stats_t led_matrix_get_render_stats(void) { return lighting_render_stats; }
+#endif  // LED_MATRIX_RENDER_BUDGET_US
+
+// The backlight levels, from off to LED_MATRIX_MAXIMUM_BRIGHTNESS
+void backlight_set(uint8_t level) {
+    if (level > BACKLIGHT_LEVELS) level = BACKLIGHT_LEVELS;
+    led_matrix_set_value_noeeprom((uint16_t)LED_MATRIX_MAXIMUM_BRIGHTNESS * level / BACKLIGHT_LEVELS);
+}
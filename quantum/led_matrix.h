@@ -19,34 +19,133 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "led_matrix_types.h"
+#include "quantum.h"
+
+#ifdef LIGHTING_KEYFRAMES_ENABLED
+#    include "lighting_keyframes.h"
+#endif
 
 #ifndef BACKLIGHT_ENABLE
 #    error You must define BACKLIGHT_ENABLE with LED_MATRIX_ENABLE
 #endif
 
+#ifndef LED_MATRIX_LED_FLUSH_LIMIT
+#    define LED_MATRIX_LED_FLUSH_LIMIT 16
+#endif
+
+#ifndef LED_MATRIX_LED_PROCESS_LIMIT
+#    define LED_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
+#endif
+
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+#    ifndef LED_MATRIX_RENDER_BACKOFF_BUDGET_US
+#        define LED_MATRIX_RENDER_BACKOFF_BUDGET_US (LED_MATRIX_RENDER_BUDGET_US / 4)
+#    endif
+#    ifndef LED_MATRIX_RENDER_BACKOFF_MS
+#        define LED_MATRIX_RENDER_BACKOFF_MS 50
+#    endif
+// A free running 32-bit counter and how fast it counts. Only the differences are used, so
+// wrapping around is fine.
+#    if defined(LED_MATRIX_RENDER_TIMER_US)
+#        define LED_MATRIX_RENDER_TIMER() LED_MATRIX_RENDER_TIMER_US()
+#        define LED_MATRIX_RENDER_TIMER_PER_US 1
+#    elif !defined(LED_MATRIX_RENDER_TIMER)
+#        if defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT == TRUE && defined(STM32_SYSCLK)
+#            define LED_MATRIX_RENDER_TIMER() chSysGetRealtimeCounterX()
+#            define LED_MATRIX_RENDER_TIMER_PER_US (STM32_SYSCLK / 1000000)
+#        else
+#            error "LED_MATRIX_RENDER_BUDGET_US needs a microsecond timer, define LED_MATRIX_RENDER_TIMER_US() for this board"
+#        endif
+#    endif
+#endif
+
+#define LED_MATRIX_USE_LIMITS(min, max) LIGHTING_USE_LIMITS(min, max)
+
+#define LED_MATRIX_INDICATOR_SET_VALUE(i, v) \
+    if (i >= led_min && i <= led_max) {     \
+        led_matrix_set_index_value(i, v);   \
+    }
+
+#define LED_MATRIX_TEST_LED_FLAGS() LIGHTING_TEST_LED_FLAGS()
+
+// The effects shared with RGB Matrix, see lighting_matrix_animations/
+#define LIGHTING_EFFECT(name) LED_MATRIX_EFFECT(name)
+
+#ifdef DISABLE_LED_MATRIX_BAND_VAL
+#    define DISABLE_LIGHTING_BAND_VAL
+#endif
+#ifdef DISABLE_LED_MATRIX_BAND_PINWHEEL_VAL
+#    define DISABLE_LIGHTING_BAND_PINWHEEL_VAL
+#endif
+#ifdef DISABLE_LED_MATRIX_BAND_SPIRAL_VAL
+#    define DISABLE_LIGHTING_BAND_SPIRAL_VAL
+#endif
+#ifdef DISABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_SIMPLE
+#endif
+#ifdef DISABLE_LED_MATRIX_SOLID_REACTIVE_WIDE
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_WIDE
+#endif
+#ifdef DISABLE_LED_MATRIX_SOLID_REACTIVE_MULTIWIDE
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_MULTIWIDE
+#endif
+#ifdef DISABLE_LED_MATRIX_SOLID_REACTIVE_CROSS
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_CROSS
+#endif
+#ifdef DISABLE_LED_MATRIX_SOLID_REACTIVE_MULTICROSS
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_MULTICROSS
+#endif
+#ifdef DISABLE_LED_MATRIX_SOLID_SPLASH
+#    define DISABLE_LIGHTING_SOLID_SPLASH
+#endif
+#ifdef DISABLE_LED_MATRIX_SOLID_MULTISPLASH
+#    define DISABLE_LIGHTING_SOLID_MULTISPLASH
+#endif
+
 enum led_matrix_effects {
-    LED_MATRIX_UNIFORM_BRIGHTNESS = 1,
-    // All new effects go above this line
+    LED_MATRIX_NONE = 0,
+
+// --------------------------------------
+// -----Begin led effect enum macros-----
+#define LED_MATRIX_EFFECT(name, ...) LED_MATRIX_##name,
+#include "led_matrix_animations/led_matrix_effects.inc"
+#undef LED_MATRIX_EFFECT
+    // --------------------------------------
+    // -----End led effect enum macros-------
+
     LED_MATRIX_EFFECT_MAX
 };
 
+void eeconfig_update_led_matrix_default(void);
+
+uint8_t led_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i);
+uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i);
+bool    led_matrix_map_led_to_row_column(uint8_t led, uint8_t *row, uint8_t *column);
+
 void led_matrix_set_index_value(int index, uint8_t value);
 void led_matrix_set_index_value_all(uint8_t value);
 
+void process_led_matrix(uint8_t row, uint8_t col, bool pressed);
+
+void led_matrix_task(void);
+
 // This runs after another backlight effect and replaces
-// colors already set
+// values already set
 void led_matrix_indicators(void);
 void led_matrix_indicators_kb(void);
 void led_matrix_indicators_user(void);
 
+void led_matrix_indicators_advanced(effect_params_t *params);
+void led_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
+void led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
+
 void led_matrix_init(void);
-void led_matrix_setup_drivers(void);
 
 void led_matrix_set_suspend_state(bool state);
-void led_matrix_set_indicator_state(uint8_t state);
-
-void led_matrix_task(void);
+bool led_matrix_get_suspend_state(void);
 
 // This should not be called from an interrupt
 // (eg. from a timer interrupt).
@@ -54,26 +153,41 @@ void led_matrix_task(void);
 // If the buffer is dirty, it will update the driver with the buffer.
 void led_matrix_update_pwm_buffers(void);
 
-bool process_led_matrix(uint16_t keycode, keyrecord_t *record);
-
 uint32_t led_matrix_get_tick(void);
 
-void    led_matrix_toggle(void);
-void    led_matrix_enable(void);
-void    led_matrix_enable_noeeprom(void);
-void    led_matrix_disable(void);
-void    led_matrix_disable_noeeprom(void);
-void    led_matrix_step(void);
-void    led_matrix_step_reverse(void);
-void    led_matrix_increase_val(void);
-void    led_matrix_decrease_val(void);
-void    led_matrix_increase_speed(void);
-void    led_matrix_decrease_speed(void);
-void    led_matrix_mode(uint8_t mode, bool eeprom_write);
-void    led_matrix_mode_noeeprom(uint8_t mode);
-uint8_t led_matrix_get_mode(void);
-void    led_matrix_set_value(uint8_t mode);
-void    led_matrix_set_value_noeeprom(uint8_t mode);
+void        led_matrix_toggle(void);
+void        led_matrix_toggle_noeeprom(void);
+void        led_matrix_enable(void);
+void        led_matrix_enable_noeeprom(void);
+void        led_matrix_disable(void);
+void        led_matrix_disable_noeeprom(void);
+uint8_t     led_matrix_is_enabled(void);
+void        led_matrix_step(void);
+void        led_matrix_step_noeeprom(void);
+void        led_matrix_step_reverse(void);
+void        led_matrix_step_reverse_noeeprom(void);
+void        led_matrix_increase_val(void);
+void        led_matrix_increase_val_noeeprom(void);
+void        led_matrix_decrease_val(void);
+void        led_matrix_decrease_val_noeeprom(void);
+void        led_matrix_set_speed(uint8_t speed);
+void        led_matrix_set_speed_noeeprom(uint8_t speed);
+uint8_t     led_matrix_get_speed(void);
+void        led_matrix_increase_speed(void);
+void        led_matrix_increase_speed_noeeprom(void);
+void        led_matrix_decrease_speed(void);
+void        led_matrix_decrease_speed_noeeprom(void);
+void        led_matrix_mode(uint8_t mode, bool eeprom_write);
+void        led_matrix_mode_noeeprom(uint8_t mode);
+uint8_t     led_matrix_get_mode(void);
+void        led_matrix_set_value(uint8_t mode);
+void        led_matrix_set_value_noeeprom(uint8_t mode);
+uint8_t     led_matrix_get_val(void);
+led_flags_t led_matrix_get_flags(void);
+void        led_matrix_set_flags(led_flags_t flags);
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+lighting_render_stats_t led_matrix_get_render_stats(void);
+#endif
 
 typedef struct {
     /* Perform any initialisation required for the other driver functions to work. */
@@ -91,4 +205,9 @@ extern const led_matrix_driver_t led_matrix_driver;
 
 extern led_eeconfig_t led_matrix_eeconfig;
 
+extern bool         g_suspend_state;
+extern uint32_t     g_led_timer;
 extern led_config_t g_led_config;
+#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+extern last_hit_t g_last_hit_tracker;
+#endif
@@ -19,39 +19,20 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#if defined(__GNUC__)
-#    define PACKED __attribute__((__packed__))
-#else
-#    define PACKED
+#if defined(LED_MATRIX_KEYPRESSES) || defined(LED_MATRIX_KEYRELEASES)
+#    define LED_MATRIX_KEYREACTIVE_ENABLED
+#    define LIGHTING_KEYREACTIVE_ENABLED
 #endif
 
-#if defined(_MSC_VER)
-#    pragma pack(push, 1)
+#ifdef LED_MATRIX_KEYFRAME_EFFECTS
+#    define LIGHTING_KEYFRAMES_ENABLED
 #endif
 
-// Last led hit
-#ifndef LED_HITS_TO_REMEMBER
-#    define LED_HITS_TO_REMEMBER 8
-#endif  // LED_HITS_TO_REMEMBER
-
-typedef struct PACKED {
-    uint8_t x;
-    uint8_t y;
-} point_t;
-
-#define LED_FLAG_ALL 0xFF
-#define LED_FLAG_NONE 0x00
-#define LED_FLAG_MODIFIER 0x01
-#define LED_FLAG_KEYLIGHT 0x04
-#define LED_FLAG_INDICATOR 0x08
+#include "lighting_matrix_types.h"
 
-#define NO_LED 255
-
-typedef struct PACKED {
-    uint8_t matrix_co[MATRIX_ROWS][MATRIX_COLS];
-    point_t point[DRIVER_LED_TOTAL];
-    uint8_t flags[DRIVER_LED_TOTAL];
-} led_config_t;
+#if defined(_MSC_VER)
+#    pragma pack(push, 1)
+#endif
 
 typedef union {
     uint32_t raw;
@@ -0,0 +1,222 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lighting_keyframes.h"
+#include <lib/lib8tion/lib8tion.h>
+
+#define LK_KEYFRAME_SIZE 4
+
+/** \brief Checks that a program can be run
+ *
+ * Programs come from EEPROM and the host, run() trusts what this lets through.
+ */
+bool lighting_keyframes_validate(const uint8_t *program, uint16_t size) {
+    const uint8_t *end   = program + size;
+    uint8_t        times = 0;
+
+    if (size < 2 || program[0] != LK_VERSION) {
+        return false;
+    }
+    for (const uint8_t *op = program + 1; op < end;) {
+        switch (*op) {
+            case LK_END:
+                return true;
+            case LK_TIME:
+                if (end - op < 3 || (op[1] | op[2]) == 0 || ++times > LIGHTING_KEYFRAMES_MAX_TIMES) {
+                    return false;
+                }
+                op += 3;
+                break;
+            case LK_OFFSET:
+                if (end - op < 3 || op[1] >= LK_SOURCE_MAX) {
+                    return false;
+                }
+                op += 3;
+                break;
+            case LK_EASE:
+                if (end - op < 2 || op[1] >= LK_EASE_MAX) {
+                    return false;
+                }
+                op += 2;
+                break;
+            case LK_GRADIENT: {
+                if (end - op < 3 || (op[1] & LK_HSV) == 0 || (op[1] & ~(LK_HSV | LK_RELATIVE)) != 0 || op[2] == 0) {
+                    return false;
+                }
+                uint8_t count = op[2];
+                if (end - op < 3 + count * LK_KEYFRAME_SIZE) {
+                    return false;
+                }
+                for (uint8_t k = 1; k < count; k++) {
+                    if (op[3 + k * LK_KEYFRAME_SIZE] <= op[3 + (k - 1) * LK_KEYFRAME_SIZE]) {
+                        return false;
+                    }
+                }
+                op += 3 + count * LK_KEYFRAME_SIZE;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    // No LK_END
+    return false;
+}
+
+/** \brief Works out the phases of the LK_TIME operations for a frame
+ *
+ * time is in ms. At speed 127 a period takes as long as it says, at 255 it runs twice as fast and
+ * takes half as long.
+ */
+void lighting_keyframes_frame(lighting_keyframes_frame_t *frame, const uint8_t *program, uint32_t time, uint8_t speed, HSV base, uint8_t center_x, uint8_t center_y) {
+    uint8_t times = 0;
+
+    frame->base     = base;
+    frame->center_x = center_x;
+    frame->center_y = center_y;
+    for (const uint8_t *op = program + 1; *op != LK_END;) {
+        switch (*op) {
+            case LK_TIME: {
+                // In 1/128 ms at the default speed, where it fits in 32 bits
+                uint32_t period       = (uint32_t)(op[1] | op[2] << 8) << 7;
+                uint32_t t            = (time % period) * (speed + 1) % period;
+                frame->phase[times++] = t * 256 / period;
+                op += 3;
+                break;
+            }
+            case LK_OFFSET:
+                op += 3;
+                break;
+            case LK_EASE:
+                op += 2;
+                break;
+            case LK_GRADIENT:
+                op += 3 + op[2] * LK_KEYFRAME_SIZE;
+                break;
+        }
+    }
+}
+
+static uint8_t lighting_keyframes_source(const lighting_keyframes_frame_t *frame, uint8_t source, uint8_t x, uint8_t y, uint8_t index) {
+    int16_t dx = x - frame->center_x;
+    int16_t dy = y - frame->center_y;
+
+    switch (source) {
+        case LK_SOURCE_X:
+            return x;
+        case LK_SOURCE_Y:
+            return y;
+        case LK_SOURCE_DIST:
+            return sqrt16(dx * dx + dy * dy);
+        case LK_SOURCE_ANGLE:
+            return atan2_8(dy, dx);
+        default:
+            return index;
+    }
+}
+
+// a * b / 255, so that 255 leaves a as it is
+static uint8_t lighting_keyframes_scale(uint8_t a, uint8_t b) { return (a * (b + 1)) >> 8; }
+
+static uint8_t lighting_keyframes_ease(uint8_t curve, uint8_t phase) {
+    switch (curve) {
+        case LK_EASE_IN:
+            return lighting_keyframes_scale(phase, phase);
+        case LK_EASE_OUT:
+            return 255 - lighting_keyframes_scale(255 - phase, 255 - phase);
+        case LK_EASE_IN_OUT:
+            return ease8InOutQuad(phase);
+        case LK_EASE_CUBIC:
+            return ease8InOutCubic(phase);
+        case LK_EASE_SINE:
+            return sin8(phase - 64);
+        case LK_EASE_TRIANGLE:
+            return triwave8(phase);
+        default:
+            return phase;
+    }
+}
+
+// From a by blend / 256 of delta, rounded
+static uint8_t lighting_keyframes_lerp(uint8_t a, int16_t delta, uint8_t blend) { return a + ((delta * blend + 128) >> 8); }
+
+// Blends the keyframes of an LK_GRADIENT at phase into color
+static void lighting_keyframes_gradient(const uint8_t *op, uint8_t phase, HSV *color) {
+    uint8_t        channels = op[1];
+    const uint8_t *a        = op + 3;
+    const uint8_t *b        = a;
+    uint8_t        blend    = 0;
+
+    for (uint8_t k = 1; k < op[2] && phase > b[0]; k++) {
+        a = b;
+        b += LK_KEYFRAME_SIZE;
+    }
+    if (phase >= b[0]) {
+        a = b;  // on a keyframe, or past the last one
+    } else if (a != b) {
+        uint8_t span = b[0] - a[0];
+        blend        = ((phase - a[0]) * 256 + span / 2) / span;
+    }
+
+    HSV key = {
+        .h = lighting_keyframes_lerp(a[1], (uint8_t)(b[1] - a[1]), blend),
+        .s = lighting_keyframes_lerp(a[2], b[2] - a[2], blend),
+        .v = lighting_keyframes_lerp(a[3], b[3] - a[3], blend),
+    };
+    if (channels & LK_RELATIVE) {
+        if (channels & LK_HUE) color->h += key.h;
+        if (channels & LK_SAT) color->s = lighting_keyframes_scale(color->s, key.s);
+        if (channels & LK_VAL) color->v = lighting_keyframes_scale(color->v, key.v);
+    } else {
+        if (channels & LK_HUE) color->h = key.h;
+        if (channels & LK_SAT) color->s = key.s;
+        if (channels & LK_VAL) color->v = key.v;
+    }
+}
+
+/** \brief Runs a program for an LED
+ *
+ * The program has to have passed lighting_keyframes_validate(), and frame to have been worked out
+ * by lighting_keyframes_frame() from it.
+ */
+HSV lighting_keyframes_run(const uint8_t *program, const lighting_keyframes_frame_t *frame, uint8_t x, uint8_t y, uint8_t index) {
+    HSV     color = {frame->base.h, frame->base.s, UINT8_MAX};
+    uint8_t phase = 0;
+    uint8_t times = 0;
+
+    for (const uint8_t *op = program + 1; *op != LK_END;) {
+        switch (*op) {
+            case LK_TIME:
+                phase = frame->phase[times++];
+                op += 3;
+                break;
+            case LK_OFFSET:
+                phase += (lighting_keyframes_source(frame, op[1], x, y, index) * (int8_t)op[2]) >> 4;
+                op += 3;
+                break;
+            case LK_EASE:
+                phase = lighting_keyframes_ease(op[1], phase);
+                op += 2;
+                break;
+            case LK_GRADIENT:
+                lighting_keyframes_gradient(op, phase, &color);
+                op += 3 + op[2] * LK_KEYFRAME_SIZE;
+                break;
+        }
+    }
+    color.v = lighting_keyframes_scale(color.v, frame->base.v);
+    return color;
+}
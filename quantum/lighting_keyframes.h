@@ -0,0 +1,111 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "color.h"
+
+/*
+ * Keyframe animations are small programs run for every LED of a frame, which work out its color
+ * from the time and where the LED is. They are bytes rather than C, so they can be changed without
+ * building the firmware.
+ *
+ * A program is LK_VERSION followed by operations, and ends with LK_END. Each LED starts with a
+ * phase of 0 and the color of the config at full brightness, and the operations move the phase
+ * and set the color from it:
+ *
+ *   LK_TIME, period (2 bytes, little endian)
+ *       Sets the phase to how far the animation is through its period, in ms at the default speed.
+ *   LK_OFFSET, source, amount
+ *       Adds source * amount / 16 to the phase, amount is signed. The sources are LK_SOURCE_*.
+ *   LK_EASE, curve
+ *       Puts the phase through an easing curve, one of LK_EASE_*.
+ *   LK_GRADIENT, channels, count, count keyframes of position, hue, saturation and value
+ *       Sets the channels of the color to the keyframes at the phase, blended between the keyframes
+ *       either side of it. Positions go up from keyframe to keyframe, hue always goes up from one to
+ *       the next. With LK_RELATIVE the hue is added to the color and the saturation and value scale
+ *       it.
+ *
+ * The value the program ends with is scaled by the brightness of the config.
+ */
+
+#define LK_VERSION 0x01
+
+enum lighting_keyframes_ops {
+    LK_END = 0,
+    LK_TIME,
+    LK_OFFSET,
+    LK_EASE,
+    LK_GRADIENT,
+};
+
+enum lighting_keyframes_sources {
+    LK_SOURCE_X = 0,  // the position of the LED, across
+    LK_SOURCE_Y,      // down
+    LK_SOURCE_DIST,   // how far it is from the center
+    LK_SOURCE_ANGLE,  // the angle around the center
+    LK_SOURCE_INDEX,  // the LED index
+    LK_SOURCE_MAX,
+};
+
+enum lighting_keyframes_curves {
+    LK_EASE_LINEAR = 0,
+    LK_EASE_IN,        // quadratic, starting slowly
+    LK_EASE_OUT,       // quadratic, ending slowly
+    LK_EASE_IN_OUT,    // quadratic, both
+    LK_EASE_CUBIC,     // cubic, both
+    LK_EASE_SINE,      // up and back down over the phase
+    LK_EASE_TRIANGLE,  // up and back down in straight lines
+    LK_EASE_MAX,
+};
+
+#define LK_HUE 0x01
+#define LK_SAT 0x02
+#define LK_VAL 0x04
+#define LK_HSV (LK_HUE | LK_SAT | LK_VAL)
+#define LK_RELATIVE 0x80
+
+#define LK_PERIOD(ms) ((ms)&0xFF), ((ms) >> 8)
+
+#ifndef LIGHTING_KEYFRAMES_MAX_TIMES
+#    define LIGHTING_KEYFRAMES_MAX_TIMES 4
+#endif
+
+#ifndef LIGHTING_KEYFRAMES_SIZE
+#    define LIGHTING_KEYFRAMES_SIZE 64
+#endif
+
+// What a frame of a program works out once, for all the LEDs
+typedef struct {
+    uint8_t phase[LIGHTING_KEYFRAMES_MAX_TIMES];  // of each LK_TIME
+    HSV     base;
+    uint8_t center_x;
+    uint8_t center_y;
+} lighting_keyframes_frame_t;
+
+bool lighting_keyframes_validate(const uint8_t *program, uint16_t size);
+void lighting_keyframes_frame(lighting_keyframes_frame_t *frame, const uint8_t *program, uint32_t time, uint8_t speed, HSV base, uint8_t center_x, uint8_t center_y);
+HSV  lighting_keyframes_run(const uint8_t *program, const lighting_keyframes_frame_t *frame, uint8_t x, uint8_t y, uint8_t index);
+
+// The program RGB Matrix and LED Matrix run, kept in EEPROM where there is room
+const uint8_t *lighting_keyframes_get_program(void);
+void           lighting_keyframes_load(void);
+void           lighting_keyframes_save(void);
+void           lighting_keyframes_reset(void);
+void           lighting_keyframes_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
+void           lighting_keyframes_set_buffer(uint16_t offset, uint16_t size, const uint8_t *data);
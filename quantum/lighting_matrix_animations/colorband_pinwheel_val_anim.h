@@ -0,0 +1,13 @@
+#ifndef DISABLE_LIGHTING_BAND_PINWHEEL_VAL
+LIGHTING_EFFECT(BAND_PINWHEEL_VAL)
+#    ifdef LIGHTING_EFFECT_IMPLS
+
+static LIGHTING_COLOR_T BAND_PINWHEEL_VAL_math(LIGHTING_COLOR_T color, int16_t dx, int16_t dy, uint8_t time) {
+    LIGHTING_VAL(color) = scale8(LIGHTING_VAL(color) - time - atan2_8(dy, dx) * 3, LIGHTING_VAL(color));
+    return color;
+}
+
+bool BAND_PINWHEEL_VAL(effect_params_t* params) { return effect_runner_dx_dy(params, &BAND_PINWHEEL_VAL_math); }
+
+#    endif  // LIGHTING_EFFECT_IMPLS
+#endif      // DISABLE_LIGHTING_BAND_PINWHEEL_VAL
@@ -0,0 +1,13 @@
+#ifndef DISABLE_LIGHTING_BAND_SPIRAL_VAL
+LIGHTING_EFFECT(BAND_SPIRAL_VAL)
+#    ifdef LIGHTING_EFFECT_IMPLS
+
+static LIGHTING_COLOR_T BAND_SPIRAL_VAL_math(LIGHTING_COLOR_T color, int16_t dx, int16_t dy, uint8_t dist, uint8_t time) {
+    LIGHTING_VAL(color) = scale8(LIGHTING_VAL(color) + dist - time - atan2_8(dy, dx), LIGHTING_VAL(color));
+    return color;
+}
+
+bool BAND_SPIRAL_VAL(effect_params_t* params) { return effect_runner_dx_dy_dist(params, &BAND_SPIRAL_VAL_math); }
+
+#    endif  // LIGHTING_EFFECT_IMPLS
+#endif      // DISABLE_LIGHTING_BAND_SPIRAL_VAL
@@ -0,0 +1,14 @@
+#ifndef DISABLE_LIGHTING_BAND_VAL
+LIGHTING_EFFECT(BAND_VAL)
+#    ifdef LIGHTING_EFFECT_IMPLS
+
+static LIGHTING_COLOR_T BAND_VAL_math(LIGHTING_COLOR_T color, uint8_t i, uint8_t time) {
+    int16_t v           = LIGHTING_VAL(color) - abs(scale8(g_led_config.point[i].x, 228) + 28 - time) * 8;
+    LIGHTING_VAL(color) = scale8(v < 0 ? 0 : v, LIGHTING_VAL(color));
+    return color;
+}
+
+bool BAND_VAL(effect_params_t* params) { return effect_runner_i(params, &BAND_VAL_math); }
+
+#    endif  // LIGHTING_EFFECT_IMPLS
+#endif      // DISABLE_LIGHTING_BAND_VAL
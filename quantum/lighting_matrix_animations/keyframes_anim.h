@@ -0,0 +1,26 @@
+#ifdef LIGHTING_KEYFRAMES_ENABLED
+LIGHTING_EFFECT(KEYFRAMES)
+#    ifdef LIGHTING_EFFECT_IMPLS
+
+bool KEYFRAMES(effect_params_t* params) {
+    static lighting_keyframes_frame_t frame;
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    // Without a valid program, as while one is being uploaded, the LEDs are off
+    const uint8_t* program = lighting_keyframes_get_program();
+    if (params->iter == 0 && program) {
+        lighting_keyframes_frame(&frame, program, LIGHTING_TIMER, LIGHTING_CONFIG.speed, LIGHTING_BASE_HSV, LIGHTING_CENTER.x, LIGHTING_CENTER.y);
+    }
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        HSV hsv = {0, 0, 0};
+        if (program) {
+            hsv = lighting_keyframes_run(program, &frame, g_led_config.point[i].x, g_led_config.point[i].y, i);
+        }
+        LIGHTING_SET_COLOR(i, LIGHTING_COLOR_FROM_HSV(hsv));
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
+
+#    endif  // LIGHTING_EFFECT_IMPLS
+#endif      // LIGHTING_KEYFRAMES_ENABLED
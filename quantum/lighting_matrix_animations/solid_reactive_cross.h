@@ -0,0 +1,38 @@
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+#    if !defined(DISABLE_LIGHTING_SOLID_REACTIVE_CROSS) || !defined(DISABLE_LIGHTING_SOLID_REACTIVE_MULTICROSS)
+
+#        ifndef DISABLE_LIGHTING_SOLID_REACTIVE_CROSS
+LIGHTING_EFFECT(SOLID_REACTIVE_CROSS)
+#        endif
+
+#        ifndef DISABLE_LIGHTING_SOLID_REACTIVE_MULTICROSS
+LIGHTING_EFFECT(SOLID_REACTIVE_MULTICROSS)
+#        endif
+
+#        ifdef LIGHTING_EFFECT_IMPLS
+
+static LIGHTING_COLOR_T SOLID_REACTIVE_CROSS_math(LIGHTING_COLOR_T color, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick + dist;
+    dx              = dx < 0 ? dx * -1 : dx;
+    dy              = dy < 0 ? dy * -1 : dy;
+    dx              = dx * 16 > 255 ? 255 : dx * 16;
+    dy              = dy * 16 > 255 ? 255 : dy * 16;
+    effect += dx > dy ? dy : dx;
+    if (effect > 255) effect = 255;
+    LIGHTING_VAL(color) = qadd8(LIGHTING_VAL(color), 255 - effect);
+    return color;
+}
+
+static reactive_splash_reach_t SOLID_REACTIVE_CROSS_reach(uint16_t tick) { return reactive_splash_disk(tick > 254 ? -1 : 254 - tick); }
+
+#            ifndef DISABLE_LIGHTING_SOLID_REACTIVE_CROSS
+bool SOLID_REACTIVE_CROSS(effect_params_t* params) { return effect_runner_reactive_splash_culled(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_CROSS_math, &SOLID_REACTIVE_CROSS_reach); }
+#            endif
+
+#            ifndef DISABLE_LIGHTING_SOLID_REACTIVE_MULTICROSS
+bool SOLID_REACTIVE_MULTICROSS(effect_params_t* params) { return effect_runner_reactive_splash_culled(0, params, &SOLID_REACTIVE_CROSS_math, &SOLID_REACTIVE_CROSS_reach); }
+#            endif
+
+#        endif  // LIGHTING_EFFECT_IMPLS
+#    endif      // !defined(DISABLE_LIGHTING_SOLID_REACTIVE_CROSS) || !defined(DISABLE_LIGHTING_SOLID_REACTIVE_MULTICROSS)
+#endif          // LIGHTING_KEYREACTIVE_ENABLED
@@ -0,0 +1,15 @@
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+#    ifndef DISABLE_LIGHTING_SOLID_REACTIVE_SIMPLE
+LIGHTING_EFFECT(SOLID_REACTIVE_SIMPLE)
+#        ifdef LIGHTING_EFFECT_IMPLS
+
+static LIGHTING_COLOR_T SOLID_REACTIVE_SIMPLE_math(LIGHTING_COLOR_T color, uint16_t offset) {
+    LIGHTING_VAL(color) = scale8(255 - offset, LIGHTING_VAL(color));
+    return color;
+}
+
+bool SOLID_REACTIVE_SIMPLE(effect_params_t* params) { return effect_runner_reactive(params, &SOLID_REACTIVE_SIMPLE_math); }
+
+#        endif  // LIGHTING_EFFECT_IMPLS
+#    endif      // DISABLE_LIGHTING_SOLID_REACTIVE_SIMPLE
+#endif          // LIGHTING_KEYREACTIVE_ENABLED
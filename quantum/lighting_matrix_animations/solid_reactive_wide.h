@@ -0,0 +1,33 @@
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+#    if !defined(DISABLE_LIGHTING_SOLID_REACTIVE_WIDE) || !defined(DISABLE_LIGHTING_SOLID_REACTIVE_MULTIWIDE)
+
+#        ifndef DISABLE_LIGHTING_SOLID_REACTIVE_WIDE
+LIGHTING_EFFECT(SOLID_REACTIVE_WIDE)
+#        endif
+
+#        ifndef DISABLE_LIGHTING_SOLID_REACTIVE_MULTIWIDE
+LIGHTING_EFFECT(SOLID_REACTIVE_MULTIWIDE)
+#        endif
+
+#        ifdef LIGHTING_EFFECT_IMPLS
+
+static LIGHTING_COLOR_T SOLID_REACTIVE_WIDE_math(LIGHTING_COLOR_T color, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick + dist * 5;
+    if (effect > 255) effect = 255;
+    LIGHTING_VAL(color) = qadd8(LIGHTING_VAL(color), 255 - effect);
+    return color;
+}
+
+static reactive_splash_reach_t SOLID_REACTIVE_WIDE_reach(uint16_t tick) { return reactive_splash_disk(tick > 254 ? -1 : (254 - tick) / 5); }
+
+#            ifndef DISABLE_LIGHTING_SOLID_REACTIVE_WIDE
+bool SOLID_REACTIVE_WIDE(effect_params_t* params) { return effect_runner_reactive_splash_culled(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_math, &SOLID_REACTIVE_WIDE_reach); }
+#            endif
+
+#            ifndef DISABLE_LIGHTING_SOLID_REACTIVE_MULTIWIDE
+bool SOLID_REACTIVE_MULTIWIDE(effect_params_t* params) { return effect_runner_reactive_splash_culled(0, params, &SOLID_REACTIVE_WIDE_math, &SOLID_REACTIVE_WIDE_reach); }
+#            endif
+
+#        endif  // LIGHTING_EFFECT_IMPLS
+#    endif      // !defined(DISABLE_LIGHTING_SOLID_REACTIVE_WIDE) || !defined(DISABLE_LIGHTING_SOLID_REACTIVE_MULTIWIDE)
+#endif          // LIGHTING_KEYREACTIVE_ENABLED
@@ -0,0 +1,33 @@
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+#    if !defined(DISABLE_LIGHTING_SOLID_SPLASH) || !defined(DISABLE_LIGHTING_SOLID_MULTISPLASH)
+
+#        ifndef DISABLE_LIGHTING_SOLID_SPLASH
+LIGHTING_EFFECT(SOLID_SPLASH)
+#        endif
+
+#        ifndef DISABLE_LIGHTING_SOLID_MULTISPLASH
+LIGHTING_EFFECT(SOLID_MULTISPLASH)
+#        endif
+
+#        ifdef LIGHTING_EFFECT_IMPLS
+
+LIGHTING_COLOR_T SOLID_SPLASH_math(LIGHTING_COLOR_T color, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick - dist;
+    if (effect > 255) effect = 255;
+    LIGHTING_VAL(color) = qadd8(LIGHTING_VAL(color), 255 - effect);
+    return color;
+}
+
+reactive_splash_reach_t SOLID_SPLASH_reach(uint16_t tick) { return reactive_splash_wave(tick, 255); }
+
+#            ifndef DISABLE_LIGHTING_SOLID_SPLASH
+bool SOLID_SPLASH(effect_params_t* params) { return effect_runner_reactive_splash_culled(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_math, &SOLID_SPLASH_reach); }
+#            endif
+
+#            ifndef DISABLE_LIGHTING_SOLID_MULTISPLASH
+bool SOLID_MULTISPLASH(effect_params_t* params) { return effect_runner_reactive_splash_culled(0, params, &SOLID_SPLASH_math, &SOLID_SPLASH_reach); }
+#            endif
+
+#        endif  // LIGHTING_EFFECT_IMPLS
+#    endif      // !defined(DISABLE_LIGHTING_SPLASH) && !defined(DISABLE_LIGHTING_MULTISPLASH)
+#endif          // LIGHTING_KEYREACTIVE_ENABLED
@@ -0,0 +1,522 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+ * The core LED Matrix and RGB Matrix are built on: key hits, timers, and the task that renders a
+ * frame over as many iterations as it takes and then flushes it. led_matrix.c and rgb_matrix.c
+ * each include it once, after defining
+ *
+ *   LIGHTING_CONFIG                       their config, with enable, mode and speed
+ *   LIGHTING_TIMER                        the timer their effects run on
+ *   LIGHTING_NAME                         the name of the feature, for debug output
+ *   LIGHTING_LED_FLUSH_LIMIT              the shortest time between frames
+ *   LIGHTING_LED_PROCESS_LIMIT            how many LEDs to render in an iteration
+ *   LIGHTING_DISABLE_TIMEOUT              after how long without a key the LEDs go out, 0 for never
+ *   LIGHTING_DISABLE_WHEN_USB_SUSPENDED   whether the LEDs go out while suspended
+ *   LIGHTING_KEYPRESSES, LIGHTING_KEYRELEASES
+ *   LIGHTING_RENDER_BUDGET_US, LIGHTING_RENDER_BACKOFF_BUDGET_US, LIGHTING_RENDER_BACKOFF_MS,
+ *   LIGHTING_RENDER_TIMER() and
+ *   LIGHTING_RENDER_TIMER_PER_US          to render by time rather than by LED count
+ *   LIGHTING_KEY_LED_OFFSETS, LIGHTING_KEY_LEDS, LIGHTING_LED_KEYS and
+ *   LIGHTING_KEY_LEDS_MAX                 tables of the LEDs on each key, to map keys and LEDs both ways
+ *   LIGHTING_FACTORY_TEST()               drawn instead of an effect for mode UINT8_MAX
+ *
+ * and the functions declared below, after including it.
+ */
+
+#ifndef MAX
+#    define MAX(X, Y) ((X) > (Y) ? (X) : (Y))
+#endif
+
+#ifndef MIN
+#    define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+/*
+ * lighting_render_effect() renders the LEDs from params->led_min to params->led_max and returns
+ * whether the effect goes on, lighting_render_done() is called after each render iteration, before
+ * the indicators.
+ */
+static bool    lighting_render_effect(uint8_t effect, effect_params_t *params);
+static void    lighting_render_done(void);
+static void    lighting_indicators(effect_params_t *params);
+static void    lighting_update_pwm_buffers(void);
+static uint8_t lighting_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i);
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+last_hit_t g_last_hit_tracker;
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
+
+// internals
+static uint8_t              lighting_last_enable   = UINT8_MAX;
+static uint8_t              lighting_last_effect   = UINT8_MAX;
+static effect_params_t      lighting_effect_params = {0, 0xFF};
+static lighting_task_states lighting_task_state    = SYNCING;
+#if LIGHTING_DISABLE_TIMEOUT > 0
+static uint32_t lighting_anykey_timer;
+#endif  // LIGHTING_DISABLE_TIMEOUT > 0
+#ifdef LIGHTING_RENDER_BUDGET_US
+static uint16_t                lighting_render_led_cost;  // estimate, in 1/16 us
+static uint32_t                lighting_render_key_timer;
+static uint32_t                lighting_render_stats_timer;
+static uint16_t                lighting_render_frames;
+static uint16_t                lighting_render_overruns;
+static lighting_render_stats_t lighting_render_stats;
+#endif  // LIGHTING_RENDER_BUDGET_US
+
+// double buffers
+static uint32_t lighting_timer_buffer;
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+// Ring of hits from the oldest at head on, copied in order into g_last_hit_tracker for each frame
+static struct {
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint8_t  reach[LED_HITS_TO_REMEMBER];  // distance to the farthest corner of the board
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+} last_hit_buffer;
+static point_t led_point_min;
+static point_t led_point_max;
+
+static void lighting_add_hit(uint8_t led) {
+    uint8_t index;
+    if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+        index = last_hit_buffer.head + last_hit_buffer.count++;
+        if (index >= LED_HITS_TO_REMEMBER) index -= LED_HITS_TO_REMEMBER;
+    } else {
+        // Full, the newest takes the place of the oldest
+        index = last_hit_buffer.head;
+        if (++last_hit_buffer.head >= LED_HITS_TO_REMEMBER) last_hit_buffer.head = 0;
+    }
+
+    point_t point = g_led_config.point[led];
+    uint8_t dx    = MAX(point.x - led_point_min.x, led_point_max.x - point.x);
+    uint8_t dy    = MAX(point.y - led_point_min.y, led_point_max.y - point.y);
+
+    last_hit_buffer.x[index]     = point.x;
+    last_hit_buffer.y[index]     = point.y;
+    last_hit_buffer.index[index] = led;
+    last_hit_buffer.reach[index] = sqrt16(MIN((uint32_t)dx * dx + dy * dy, UINT16_MAX));
+    last_hit_buffer.tick[index]  = 0;
+}
+
+// Whether no effect can show the hit anymore: the reactive effects stop showing it at 65535 / speed,
+// and the splash effects when it is 255 past the whole board
+static bool lighting_hit_expired(uint8_t index, uint16_t tick) {
+    uint8_t speed = LIGHTING_CONFIG.speed;
+    if (tick == UINT16_MAX) return true;
+    if (!speed) return false;
+    return tick >= UINT16_MAX / speed && scale16by8(tick, speed) > 255 + last_hit_buffer.reach[index];
+}
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
+
+#ifdef LIGHTING_KEYFRAMES_ENABLED
+#    if !defined(LIGHTING_KEYFRAMES_EEPROM_ADDR) && defined(VIA_ENABLE)
+#        include "via.h"
+#        define LIGHTING_KEYFRAMES_EEPROM_ADDR VIA_EEPROM_KEYFRAMES_ADDR
+#    endif
+
+// A rainbow going left to right, for when there is no program in EEPROM
+#    ifndef LIGHTING_KEYFRAMES_DEFAULT
+#        define LIGHTING_KEYFRAMES_DEFAULT LK_VERSION, LK_TIME, LK_PERIOD(4000), LK_OFFSET, LK_SOURCE_X, 16, LK_GRADIENT, LK_HUE, 2, 0, 0, 255, 255, 255, 255, 255, 255, LK_END
+#    endif
+
+static const uint8_t lighting_keyframes_default[] PROGMEM = {LIGHTING_KEYFRAMES_DEFAULT};
+_Static_assert(sizeof(lighting_keyframes_default) <= LIGHTING_KEYFRAMES_SIZE, "LIGHTING_KEYFRAMES_DEFAULT does not fit in LIGHTING_KEYFRAMES_SIZE");
+
+// The program is run from RAM, set_buffer() changes it right away and save() keeps it
+static uint8_t lighting_keyframes_program[LIGHTING_KEYFRAMES_SIZE];
+static bool    lighting_keyframes_valid;
+
+static void lighting_keyframes_load_default(void) {
+    memset(lighting_keyframes_program, 0, sizeof(lighting_keyframes_program));
+    memcpy_P(lighting_keyframes_program, lighting_keyframes_default, sizeof(lighting_keyframes_default));
+    lighting_keyframes_valid = lighting_keyframes_validate(lighting_keyframes_program, sizeof(lighting_keyframes_program));
+}
+
+const uint8_t *lighting_keyframes_get_program(void) { return lighting_keyframes_valid ? lighting_keyframes_program : NULL; }
+
+void lighting_keyframes_load(void) {
+#    ifdef LIGHTING_KEYFRAMES_EEPROM_ADDR
+    eeprom_read_block(lighting_keyframes_program, (void *)LIGHTING_KEYFRAMES_EEPROM_ADDR, sizeof(lighting_keyframes_program));
+    lighting_keyframes_valid = lighting_keyframes_validate(lighting_keyframes_program, sizeof(lighting_keyframes_program));
+    if (lighting_keyframes_valid) return;
+#    endif
+    lighting_keyframes_load_default();
+}
+
+void lighting_keyframes_save(void) {
+#    ifdef LIGHTING_KEYFRAMES_EEPROM_ADDR
+    eeprom_update_block(lighting_keyframes_program, (void *)LIGHTING_KEYFRAMES_EEPROM_ADDR, sizeof(lighting_keyframes_program));
+#    endif
+}
+
+void lighting_keyframes_reset(void) {
+    lighting_keyframes_load_default();
+    lighting_keyframes_save();
+}
+
+void lighting_keyframes_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    for (uint16_t i = 0; i < size; i++) {
+        data[i] = offset + i < LIGHTING_KEYFRAMES_SIZE ? lighting_keyframes_program[offset + i] : 0x00;
+    }
+}
+
+// Programs are uploaded in pieces, so until the last piece is in one may not be valid, and shows nothing
+void lighting_keyframes_set_buffer(uint16_t offset, uint16_t size, const uint8_t *data) {
+    for (uint16_t i = 0; i < size && offset + i < LIGHTING_KEYFRAMES_SIZE; i++) {
+        lighting_keyframes_program[offset + i] = data[i];
+    }
+    lighting_keyframes_valid = lighting_keyframes_validate(lighting_keyframes_program, sizeof(lighting_keyframes_program));
+}
+#endif  // LIGHTING_KEYFRAMES_ENABLED
+
+#ifdef LIGHTING_KEY_LEDS
+/*
+ * The LEDs of every key one key after another, in matrix order, and the key every LED is on,
+ * generated from info.json by `qmk generate-led-config`. The LEDs of the key at row, column start
+ * at lighting_key_leds[lighting_key_led_offsets[row * MATRIX_COLS + column]] and end where the
+ * next key's start.
+ */
+static const uint8_t lighting_key_led_offsets[] PROGMEM = {LIGHTING_KEY_LED_OFFSETS};
+static const uint8_t lighting_key_leds[] PROGMEM        = {LIGHTING_KEY_LEDS};
+static const uint8_t lighting_led_keys[][2] PROGMEM     = {LIGHTING_LED_KEYS};
+_Static_assert(sizeof(lighting_key_led_offsets) == MATRIX_ROWS * MATRIX_COLS + 1, "LIGHTING_KEY_LED_OFFSETS does not match the matrix size");
+_Static_assert(sizeof(lighting_led_keys) == DRIVER_LED_TOTAL * 2, "LIGHTING_LED_KEYS does not match DRIVER_LED_TOTAL");
+// Callers map a key into a buffer of LED_HITS_TO_REMEMBER LEDs
+#    ifndef LIGHTING_KEY_LEDS_MAX
+#        error "The LED tables need the most LEDs on any one key, LIGHTING_KEY_LEDS_MAX"
+#    endif
+_Static_assert(LIGHTING_KEY_LEDS_MAX <= LED_HITS_TO_REMEMBER, "A key has more LEDs than LED_HITS_TO_REMEMBER");
+
+static uint8_t lighting_key_map_leds(uint8_t row, uint8_t column, uint8_t *led_i) {
+    uint16_t key   = row * MATRIX_COLS + column;
+    uint8_t  start = pgm_read_byte(&lighting_key_led_offsets[key]);
+    uint8_t  count = pgm_read_byte(&lighting_key_led_offsets[key + 1]) - start;
+
+    memcpy_P(led_i, &lighting_key_leds[start], count);
+    return count;
+}
+#endif  // LIGHTING_KEY_LEDS
+
+// The key an LED is on, false for LEDs that are not on a key
+static bool lighting_map_led_to_row_column(uint8_t led, uint8_t *row, uint8_t *column) {
+#ifdef LIGHTING_KEY_LEDS
+    *row    = pgm_read_byte(&lighting_led_keys[led][0]);
+    *column = pgm_read_byte(&lighting_led_keys[led][1]);
+    return *row != NO_LED;
+#else
+    uint8_t leds[LED_HITS_TO_REMEMBER];
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
+            uint8_t led_count = lighting_map_row_column_to_led(r, c, leds);
+            for (uint8_t i = 0; i < led_count; i++) {
+                if (leds[i] == led) {
+                    *row    = r;
+                    *column = c;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+#endif  // LIGHTING_KEY_LEDS
+}
+
+static void lighting_init(void) {
+#ifdef LIGHTING_KEYFRAMES_ENABLED
+    lighting_keyframes_load();
+#endif  // LIGHTING_KEYFRAMES_ENABLED
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+    g_last_hit_tracker.count = 0;
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
+        g_last_hit_tracker.tick[i] = UINT16_MAX;
+    }
+
+    last_hit_buffer.head  = 0;
+    last_hit_buffer.count = 0;
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
+        last_hit_buffer.tick[i] = UINT16_MAX;
+    }
+
+    led_point_min = led_point_max = g_led_config.point[0];
+    for (uint8_t i = 1; i < DRIVER_LED_TOTAL; ++i) {
+        led_point_min.x = MIN(led_point_min.x, g_led_config.point[i].x);
+        led_point_min.y = MIN(led_point_min.y, g_led_config.point[i].y);
+        led_point_max.x = MAX(led_point_max.x, g_led_config.point[i].x);
+        led_point_max.y = MAX(led_point_max.y, g_led_config.point[i].y);
+    }
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
+}
+
+static void lighting_process(uint8_t row, uint8_t col, bool pressed) {
+#if LIGHTING_DISABLE_TIMEOUT > 0
+    lighting_anykey_timer = 0;
+#endif  // LIGHTING_DISABLE_TIMEOUT > 0
+#ifdef LIGHTING_RENDER_BUDGET_US
+    lighting_render_key_timer = sync_timer_read32();
+#endif  // LIGHTING_RENDER_BUDGET_US
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+    uint8_t led[LED_HITS_TO_REMEMBER];
+    uint8_t led_count = 0;
+
+#    if defined(LIGHTING_KEYRELEASES)
+    if (!pressed)
+#    elif defined(LIGHTING_KEYPRESSES)
+    if (pressed)
+#    endif  // defined(LIGHTING_KEYRELEASES)
+    {
+        led_count = lighting_map_row_column_to_led(row, col, led);
+    }
+
+    for (uint8_t i = 0; i < led_count; i++) {
+        lighting_add_hit(led[i]);
+    }
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
+}
+
+static void lighting_task_timers(void) {
+#if defined(LIGHTING_KEYREACTIVE_ENABLED) || LIGHTING_DISABLE_TIMEOUT > 0
+    uint32_t deltaTime = sync_timer_elapsed32(lighting_timer_buffer);
+#endif  // defined(LIGHTING_KEYREACTIVE_ENABLED) || LIGHTING_DISABLE_TIMEOUT > 0
+    lighting_timer_buffer = sync_timer_read32();
+
+    // Update double buffer timers
+#if LIGHTING_DISABLE_TIMEOUT > 0
+    if (lighting_anykey_timer < UINT32_MAX) {
+        if (UINT32_MAX - deltaTime < lighting_anykey_timer) {
+            lighting_anykey_timer = UINT32_MAX;
+        } else {
+            lighting_anykey_timer += deltaTime;
+        }
+    }
+#endif  // LIGHTING_DISABLE_TIMEOUT > 0
+
+    // Update double buffer last hit timers
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+    uint8_t index = last_hit_buffer.head;
+    for (uint8_t i = 0; i < last_hit_buffer.count; ++i) {
+        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[index]) {
+            last_hit_buffer.tick[index] = UINT16_MAX;
+        } else {
+            last_hit_buffer.tick[index] += deltaTime;
+        }
+        if (++index >= LED_HITS_TO_REMEMBER) index = 0;
+    }
+
+    // The oldest hits go first, so they expire from the head
+    while (last_hit_buffer.count && lighting_hit_expired(last_hit_buffer.head, last_hit_buffer.tick[last_hit_buffer.head])) {
+        last_hit_buffer.count--;
+        if (++last_hit_buffer.head >= LED_HITS_TO_REMEMBER) last_hit_buffer.head = 0;
+    }
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
+}
+
+static void lighting_task_sync(void) {
+    // next task
+    if (sync_timer_elapsed32(LIGHTING_TIMER) >= LIGHTING_LED_FLUSH_LIMIT) lighting_task_state = STARTING;
+}
+
+static void lighting_task_start(void) {
+    // reset iter
+    lighting_effect_params.iter = 0;
+
+    // update double buffers
+    LIGHTING_TIMER = lighting_timer_buffer;
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+    uint8_t index            = last_hit_buffer.head;
+    g_last_hit_tracker.count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; ++i) {
+        g_last_hit_tracker.x[i]     = last_hit_buffer.x[index];
+        g_last_hit_tracker.y[i]     = last_hit_buffer.y[index];
+        g_last_hit_tracker.index[i] = last_hit_buffer.index[index];
+        g_last_hit_tracker.tick[i]  = last_hit_buffer.tick[index];
+        if (++index >= LED_HITS_TO_REMEMBER) index = 0;
+    }
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
+
+    // next task
+    lighting_task_state = RENDERING;
+}
+
+#ifdef LIGHTING_RENDER_BUDGET_US
+// Less time for the LEDs while keys are being pressed, so they go out sooner
+static uint16_t lighting_render_budget(void) {
+    if (sync_timer_elapsed32(lighting_render_key_timer) < LIGHTING_RENDER_BACKOFF_MS) {
+        return LIGHTING_RENDER_BACKOFF_BUDGET_US;
+    }
+    return LIGHTING_RENDER_BUDGET_US;
+}
+
+// As many LEDs as the current effect renders in the budget, at least one
+static void lighting_render_limits(uint16_t budget) {
+    uint8_t  led_min = lighting_effect_params.iter ? lighting_effect_params.led_max : 0;
+    uint32_t count   = (uint32_t)budget * 16 / lighting_render_led_cost;
+    if (count < 1) count = 1;
+    if (count > DRIVER_LED_TOTAL - led_min) count = DRIVER_LED_TOTAL - led_min;
+
+    lighting_effect_params.led_min = led_min;
+    lighting_effect_params.led_max = led_min + count;
+}
+
+static void lighting_render_measure(uint16_t budget, uint32_t elapsed) {
+    uint8_t count = lighting_effect_params.led_max - lighting_effect_params.led_min;
+    if (elapsed > budget) lighting_render_overruns++;
+    if (!count) return;
+
+    // Moving average over about four iterations. Rounding away from the current estimate gets it
+    // all the way to a steady cost.
+    uint32_t sample = elapsed * 16 / count;
+    if (sample > UINT16_MAX) sample = UINT16_MAX;
+    int32_t delta = (int32_t)sample - lighting_render_led_cost;
+    int32_t cost  = lighting_render_led_cost + (delta > 0 ? (delta + 3) / 4 : (delta - 3) / 4);
+
+    lighting_render_led_cost = cost < 1 ? 1 : cost;
+}
+
+static void lighting_render_report(void) {
+    lighting_render_frames++;
+
+    uint32_t elapsed = sync_timer_elapsed32(lighting_render_stats_timer);
+    if (elapsed < 1000) return;
+
+    lighting_render_stats.fps      = (uint32_t)lighting_render_frames * 1000 / elapsed;
+    lighting_render_stats.overruns = lighting_render_overruns;
+    lighting_render_stats.led_cost = lighting_render_led_cost;
+    lighting_render_frames         = 0;
+    lighting_render_overruns       = 0;
+    lighting_render_stats_timer    = sync_timer_read32();
+    dprintf(LIGHTING_NAME ": %u fps, %u overruns, %u/16 us per LED\n", lighting_render_stats.fps, lighting_render_stats.overruns, lighting_render_stats.led_cost);
+}
+#else
+// A fixed number of LEDs in each iteration
+static void lighting_render_limits(void) {
+#    if LIGHTING_LED_PROCESS_LIMIT > 0 && LIGHTING_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+    uint8_t led_min = LIGHTING_LED_PROCESS_LIMIT * lighting_effect_params.iter;
+    uint8_t led_max = led_min + LIGHTING_LED_PROCESS_LIMIT;
+    if (led_max > DRIVER_LED_TOTAL) led_max = DRIVER_LED_TOTAL;
+#    else
+    uint8_t led_min = 0;
+    uint8_t led_max = DRIVER_LED_TOTAL;
+#    endif
+    lighting_effect_params.led_min = led_min;
+    lighting_effect_params.led_max = led_max;
+}
+#endif  // LIGHTING_RENDER_BUDGET_US
+
+static void lighting_task_render(uint8_t effect) {
+    lighting_effect_params.init = (effect != lighting_last_effect) || (LIGHTING_CONFIG.enable != lighting_last_enable);
+
+#ifdef LIGHTING_FACTORY_TEST
+    // Factory default magic value, drawn in one go and flushed as it is
+    if (effect == UINT8_MAX) {
+        LIGHTING_FACTORY_TEST();
+        lighting_task_state = FLUSHING;
+        return;
+    }
+#endif  // LIGHTING_FACTORY_TEST
+
+#ifdef LIGHTING_RENDER_BUDGET_US
+    // A new effect starts out at the fixed limit, until its cost is known
+    if (lighting_effect_params.init && lighting_effect_params.iter == 0) {
+        uint32_t cost            = (uint32_t)LIGHTING_RENDER_BUDGET_US * 16 / LIGHTING_LED_PROCESS_LIMIT;
+        lighting_render_led_cost = cost > UINT16_MAX ? UINT16_MAX : cost < 1 ? 1 : cost;
+    }
+    uint16_t budget = lighting_render_budget();
+    lighting_render_limits(budget);
+    uint32_t render_start = LIGHTING_RENDER_TIMER();
+#else
+    lighting_render_limits();
+#endif  // LIGHTING_RENDER_BUDGET_US
+
+    // each effect can opt to do calculations
+    // and/or request PWM buffer updates.
+    bool rendering = lighting_render_effect(effect, &lighting_effect_params);
+
+    lighting_render_done();
+
+#ifdef LIGHTING_RENDER_BUDGET_US
+    lighting_render_measure(budget, (uint32_t)(LIGHTING_RENDER_TIMER() - render_start) / LIGHTING_RENDER_TIMER_PER_US);
+#endif  // LIGHTING_RENDER_BUDGET_US
+
+    lighting_effect_params.iter++;
+
+    // next task
+    if (!rendering) {
+        lighting_task_state = FLUSHING;
+        if (!lighting_effect_params.init && effect == 0) {
+            // We only need to flush once if the LEDs are off
+            lighting_task_state = SYNCING;
+        }
+    }
+}
+
+static void lighting_task_flush(uint8_t effect) {
+    // update last trackers after the first full render so we can init over several frames
+    lighting_last_effect = effect;
+    lighting_last_enable = LIGHTING_CONFIG.enable;
+
+    // update pwm buffers
+    lighting_update_pwm_buffers();
+
+#ifdef LIGHTING_RENDER_BUDGET_US
+    lighting_render_report();
+#endif  // LIGHTING_RENDER_BUDGET_US
+
+    // next task
+    lighting_task_state = SYNCING;
+}
+
+static void lighting_task(void) {
+    lighting_task_timers();
+
+    // Ideally we would also stop sending zeros to the LED driver PWM buffers
+    // while suspended and just do a software shutdown. This is a cheap hack for now.
+    bool suspend_backlight =
+#if LIGHTING_DISABLE_WHEN_USB_SUSPENDED == true
+        g_suspend_state ||
+#endif  // LIGHTING_DISABLE_WHEN_USB_SUSPENDED == true
+#if LIGHTING_DISABLE_TIMEOUT > 0
+        (lighting_anykey_timer > (uint32_t)LIGHTING_DISABLE_TIMEOUT) ||
+#endif  // LIGHTING_DISABLE_TIMEOUT > 0
+        false;
+
+    uint8_t effect = suspend_backlight || !LIGHTING_CONFIG.enable ? 0 : LIGHTING_CONFIG.mode;
+
+    switch (lighting_task_state) {
+        case STARTING:
+            lighting_task_start();
+            break;
+        case RENDERING:
+            lighting_task_render(effect);
+            if (effect) {
+                lighting_indicators(&lighting_effect_params);
+            }
+            break;
+        case FLUSHING:
+            lighting_task_flush(effect);
+            break;
+        case SYNCING:
+            lighting_task_sync();
+            break;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+typedef LIGHTING_COLOR_T (*dx_dy_f)(LIGHTING_COLOR_T color, int16_t dx, int16_t dy, uint8_t time);
+
+bool effect_runner_dx_dy(effect_params_t* params, dx_dy_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_CONFIG.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        int16_t dx = g_led_config.point[i].x - LIGHTING_CENTER.x;
+        int16_t dy = g_led_config.point[i].y - LIGHTING_CENTER.y;
+        LIGHTING_SET_COLOR(i, effect_func(LIGHTING_BASE_COLOR, dx, dy, time));
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
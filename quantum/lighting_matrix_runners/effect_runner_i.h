@@ -0,0 +1,14 @@
+#pragma once
+
+typedef LIGHTING_COLOR_T (*i_f)(LIGHTING_COLOR_T color, uint8_t i, uint8_t time);
+
+bool effect_runner_i(effect_params_t* params, i_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_CONFIG.speed / 4);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        LIGHTING_SET_COLOR(i, effect_func(LIGHTING_BASE_COLOR, i, time));
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+
+typedef LIGHTING_COLOR_T (*reactive_f)(LIGHTING_COLOR_T color, uint16_t offset);
+
+bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    // a speed of 0, left over in the EEPROM from the old 0-3 range of the LED Matrix, counts as 1
+    uint16_t max_tick = 65535 / (LIGHTING_CONFIG.speed ? LIGHTING_CONFIG.speed : 1);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        uint16_t tick = max_tick;
+        // Reverse search to find most recent key hit
+        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
+            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
+                tick = g_last_hit_tracker.tick[j];
+                break;
+            }
+        }
+
+        uint16_t offset = scale16by8(tick, LIGHTING_CONFIG.speed);
+        LIGHTING_SET_COLOR(i, effect_func(LIGHTING_BASE_COLOR, offset));
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
+
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
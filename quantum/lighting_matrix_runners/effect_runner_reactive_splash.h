@@ -0,0 +1,87 @@
+#pragma once
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+
+typedef LIGHTING_COLOR_T (*reactive_splash_f)(LIGHTING_COLOR_T color, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+
+// Distances from a hit at which it changes the color of an LED, none when min > max
+typedef struct {
+    uint8_t min;
+    uint8_t max;
+} reactive_splash_reach_t;
+
+typedef reactive_splash_reach_t (*reactive_splash_reach_f)(uint16_t tick);
+
+// A wave 255 wide travelling out from the hit, at most max_dist from it
+static inline reactive_splash_reach_t reactive_splash_wave(uint16_t tick, uint8_t max_dist) {
+    reactive_splash_reach_t reach = {0, max_dist};
+    if (tick > 254 + 255) {
+        return (reactive_splash_reach_t){1, 0};
+    }
+    if (tick > 254) {
+        reach.min = tick - 254;
+    }
+    if (tick < reach.max) {
+        reach.max = tick;
+    }
+    return reach;
+}
+
+// A disk around the hit
+static inline reactive_splash_reach_t reactive_splash_disk(int16_t radius) {
+    if (radius < 0) {
+        return (reactive_splash_reach_t){1, 0};
+    }
+    return (reactive_splash_reach_t){0, radius > 255 ? 255 : radius};
+}
+
+/*
+ * Runs effect_func for every hit from start on, and every LED the hit can reach at its tick. Hits
+ * that reach no LED are dropped before going over the LEDs, the others are skipped for the LEDs
+ * out of their reach, from dx and dy where that is enough to tell, without the square root. The
+ * newest hit is always run, effects may take the color from it.
+ */
+bool effect_runner_reactive_splash_culled(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t                 count = 0;
+    uint8_t                 hit[LED_HITS_TO_REMEMBER];
+    uint16_t                tick[LED_HITS_TO_REMEMBER];
+    reactive_splash_reach_t reach[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+        hit[count]   = j;
+        tick[count]  = scale16by8(g_last_hit_tracker.tick[j], LIGHTING_CONFIG.speed);
+        reach[count] = (reach_func && j + 1 < g_last_hit_tracker.count) ? reach_func(tick[count]) : (reactive_splash_reach_t){0, 255};
+        if (reach[count].min <= reach[count].max) {
+            count++;
+        }
+    }
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        LIGHTING_COLOR_T color = LIGHTING_BASE_COLOR;
+        LIGHTING_VAL(color)    = 0;
+        for (uint8_t k = 0; k < count; k++) {
+            int16_t dx  = g_led_config.point[i].x - g_last_hit_tracker.x[hit[k]];
+            int16_t dy  = g_led_config.point[i].y - g_last_hit_tracker.y[hit[k]];
+            int16_t adx = dx < 0 ? -dx : dx;
+            int16_t ady = dy < 0 ? -dy : dy;
+            // The distance is at least the larger of the two, and at most their sum
+            if ((adx > ady ? adx : ady) > reach[k].max || adx + ady < reach[k].min) {
+                continue;
+            }
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist > reach[k].max || dist < reach[k].min) {
+                continue;
+            }
+            color = effect_func(color, dx, dy, dist, tick[k]);
+        }
+        LIGHTING_VAL(color) = scale8(LIGHTING_VAL(color), LIGHTING_VAL(LIGHTING_BASE_COLOR));
+        LIGHTING_SET_COLOR(i, color);
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
+
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) { return effect_runner_reactive_splash_culled(start, params, effect_func, NULL); }
+
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
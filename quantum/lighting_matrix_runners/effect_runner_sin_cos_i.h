@@ -0,0 +1,16 @@
+#pragma once
+
+typedef LIGHTING_COLOR_T (*sin_cos_i_f)(LIGHTING_COLOR_T color, int8_t sin, int8_t cos, uint8_t i, uint8_t time);
+
+bool effect_runner_sin_cos_i(effect_params_t* params, sin_cos_i_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint16_t time      = scale16by8(LIGHTING_TIMER, LIGHTING_CONFIG.speed / 4);
+    int8_t   cos_value = cos8(time) - 128;
+    int8_t   sin_value = sin8(time) - 128;
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        LIGHTING_SET_COLOR(i, effect_func(LIGHTING_BASE_COLOR, cos_value, sin_value, i, time));
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
@@ -0,0 +1,104 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Types shared by LED Matrix and RGB Matrix. rgb_matrix_types.h and led_matrix_types.h define
+ * LIGHTING_KEYREACTIVE_ENABLED before including this, when their feature reacts to keys, and
+ * LIGHTING_KEYFRAMES_ENABLED when it runs keyframe animations.
+ */
+
+#if defined(__GNUC__)
+#    define PACKED __attribute__((__packed__))
+#else
+#    define PACKED
+#endif
+
+#if defined(_MSC_VER)
+#    pragma pack(push, 1)
+#endif
+
+// Last led hit
+#ifndef LED_HITS_TO_REMEMBER
+#    define LED_HITS_TO_REMEMBER 8
+#endif  // LED_HITS_TO_REMEMBER
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+typedef struct PACKED {
+    uint8_t  count;
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+} last_hit_t;
+#endif  // LIGHTING_KEYREACTIVE_ENABLED
+
+typedef enum lighting_task_states { STARTING, RENDERING, FLUSHING, SYNCING } lighting_task_states;
+
+typedef uint8_t led_flags_t;
+
+typedef struct PACKED {
+    uint8_t     iter;
+    led_flags_t flags;
+    bool        init;
+    uint8_t     led_min;  // LEDs to render in this iteration
+    uint8_t     led_max;
+} effect_params_t;
+
+typedef struct PACKED {
+    uint8_t x;
+    uint8_t y;
+} point_t;
+
+#define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
+#define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
+
+#define LED_FLAG_ALL 0xFF
+#define LED_FLAG_NONE 0x00
+#define LED_FLAG_MODIFIER 0x01
+#define LED_FLAG_UNDERGLOW 0x02
+#define LED_FLAG_KEYLIGHT 0x04
+#define LED_FLAG_INDICATOR 0x08
+
+#define NO_LED 255
+
+// The LEDs for an effect to render in this iteration, picked by the lighting core
+#define LIGHTING_USE_LIMITS(min, max) \
+    uint8_t min = params->led_min;    \
+    uint8_t max = params->led_max;
+
+#define LIGHTING_TEST_LED_FLAGS() \
+    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+
+typedef struct PACKED {
+    uint8_t matrix_co[MATRIX_ROWS][MATRIX_COLS];
+    point_t point[DRIVER_LED_TOTAL];
+    uint8_t flags[DRIVER_LED_TOTAL];
+} led_config_t;
+
+typedef struct PACKED {
+    uint16_t fps;
+    uint16_t overruns;  // render iterations over the budget
+    uint16_t led_cost;  // time to render an LED of the current effect, in 1/16 us
+} lighting_render_stats_t;
+
+#if defined(_MSC_VER)
+#    pragma pack(pop)
+#endif
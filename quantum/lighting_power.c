@@ -0,0 +1,69 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lighting_power.h"
+#include "timer.h"
+
+void lighting_power_init(lighting_power_t *power, uint8_t leds, uint16_t budget_ma, bool release) {
+    power->load      = 0;
+    power->scale     = LIGHTING_POWER_SCALE_MAX;
+    power->target    = LIGHTING_POWER_SCALE_MAX;
+    power->budget_ma = budget_ma;
+    power->timer     = timer_read();
+    power->leds      = leds;
+    power->release   = release;
+}
+
+/** \brief Estimates the current of the LEDs for a load
+ *
+ * The load is the sum of the channels of every LED, before scaling.
+ */
+uint16_t lighting_power_estimate_ma(const lighting_power_t *power, uint32_t load) {
+    uint32_t ma = (uint32_t)power->leds * LIGHTING_POWER_IDLE_UA / 1000 + load * LIGHTING_POWER_MA_PER_CHANNEL / 255;
+    return ma > UINT16_MAX ? UINT16_MAX : ma;
+}
+
+// The current the LEDs are estimated to draw, as they are scaled
+uint16_t lighting_power_draw_ma(const lighting_power_t *power) { return lighting_power_estimate_ma(power, (power->load * (power->scale >> 4)) >> 12); }
+
+/** \brief Works out the scale for the next frame from the load of this one
+ *
+ * Called at the end of each frame.
+ */
+void lighting_power_frame(lighting_power_t *power) {
+    uint32_t idle_ma    = (uint32_t)power->leds * LIGHTING_POWER_IDLE_UA / 1000;
+    uint32_t channel_ma = power->load * LIGHTING_POWER_MA_PER_CHANNEL;  // times 255
+    uint16_t elapsed    = timer_elapsed(power->timer);
+
+    power->timer = timer_read();
+    if (power->budget_ma <= idle_ma) {
+        power->target = 0;
+    } else if (channel_ma <= (power->budget_ma - idle_ma) * 255) {
+        power->target = LIGHTING_POWER_SCALE_MAX;
+    } else {
+        // Rounded down so the LEDs stay within the budget, divided in two steps to fit in 32 bits
+        uint32_t budget = (power->budget_ma - idle_ma) * 255 * 256;
+        uint32_t high   = budget / channel_ma;
+        power->target   = high << 8 | ((budget - high * channel_ma) << 8) / channel_ma;
+    }
+
+    if (power->target <= power->scale || !power->release) {
+        power->scale = power->target;
+    } else {
+        uint32_t rise = (uint32_t)elapsed * LIGHTING_POWER_SCALE_MAX / LIGHTING_POWER_RELEASE_MS;
+        power->scale  = rise >= power->target - power->scale ? power->target : power->scale + rise;
+    }
+}
@@ -0,0 +1,69 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Keeps the LEDs of RGB Matrix and rgblight to a current budget. The current is estimated from what
+ * the LEDs are set to: each channel draws in proportion to its value, and each LED a little when
+ * it is off. The load, the sum of the channels, is kept up to date as LEDs change, and at the end
+ * of each frame the scale for the channels is worked out from it. The scale drops right away when
+ * the LEDs would draw more than the budget, and comes back up over LIGHTING_POWER_RELEASE_MS, so
+ * that effects which go from dark to bright and back do not pump.
+ */
+
+// The current of one channel of an LED at full brightness
+#ifndef LIGHTING_POWER_MA_PER_CHANNEL
+#    define LIGHTING_POWER_MA_PER_CHANNEL 20
+#endif
+
+// The current of an LED that is off, in uA
+#ifndef LIGHTING_POWER_IDLE_UA
+#    define LIGHTING_POWER_IDLE_UA 1000
+#endif
+
+// How long the scale takes to come back up from 0 to full
+#ifndef LIGHTING_POWER_RELEASE_MS
+#    define LIGHTING_POWER_RELEASE_MS 500
+#endif
+
+#define LIGHTING_POWER_SCALE_MAX 65536
+
+typedef struct {
+    uint32_t load;       // the sum of the channels of the LEDs, as they were set before scaling
+    uint32_t scale;      // what the channels are scaled by, out of LIGHTING_POWER_SCALE_MAX
+    uint32_t target;     // the scale that keeps the load to the budget
+    uint16_t budget_ma;  // for the LEDs, the rest of the board not included
+    uint16_t timer;      // of the last frame
+    uint8_t  leds;
+    bool     release;  // whether the scale comes back up slowly, or right away
+} lighting_power_t;
+
+void     lighting_power_init(lighting_power_t *power, uint8_t leds, uint16_t budget_ma, bool release);
+void     lighting_power_frame(lighting_power_t *power);
+uint16_t lighting_power_estimate_ma(const lighting_power_t *power, uint32_t load);
+uint16_t lighting_power_draw_ma(const lighting_power_t *power);
+
+// An LED went from one load to another, the loads being the sums of its channels
+static inline void lighting_power_change(lighting_power_t *power, uint16_t from, uint16_t to) { power->load += (int32_t)to - from; }
+
+// Whether the scale is on its way back up
+static inline bool lighting_power_releasing(const lighting_power_t *power) { return power->scale < power->target; }
+
+static inline uint8_t lighting_power_scale8(const lighting_power_t *power, uint8_t channel) { return ((uint32_t)channel * power->scale) >> 16; }
@@ -207,6 +207,153 @@ static uint8_t wheel_unit(void) {
 #        endif /* #ifndef MK_KINETIC_SPEED */
 #    endif     /* #ifndef MK_COMBINED */
 
+#    ifdef MK_INERTIA
+
+/*
+ * Inertia movement algorithm
+ *
+ *  speed(r) = I + (B - I) * (r / T)^2
+ *
+ * r: ramp position in milliseconds, grows by 1 per millisecond while a direction is held and
+ *    shrinks by F per millisecond after release (or while braking against the other direction)
+ * I: initial speed in pixels per second
+ * B: maximum speed in pixels per second, reached at r = T
+ * F: friction
+ *
+ * Distance is the integral of the speed over time, evaluated in closed form, so the total
+ * movement only depends on how long the keys have been held and not on how often reports are
+ * sent, as long as no report is capped at MOUSEKEY_MOVE_MAX. Fractions of a pixel are carried
+ * over to the next report.
+ */
+#        define INERTIA_UNIT ((int32_t)1000 * MOUSEKEY_INERTIA_FRICTION * 256)
+
+static int8_t   inertia_held[2]  = {0, 0};
+static int16_t  inertia_ramp[2]  = {0, 0};
+static int32_t  inertia_carry[2] = {0, 0};
+static uint16_t inertia_timer    = 0;
+
+/* distance in milli-pixels covered while the ramp climbs from 0 to r */
+static uint32_t inertia_distance(uint16_t r) {
+    uint32_t u  = ((uint32_t)r << 15) / MOUSEKEY_INERTIA_TIME_TO_MAX;
+    uint32_t u3 = (((u * u) >> 15) * u) >> 15;
+
+    return (uint32_t)MOUSEKEY_INERTIA_INITIAL_SPEED * r + (((((uint32_t)(MOUSEKEY_INERTIA_MAX_SPEED - MOUSEKEY_INERTIA_INITIAL_SPEED) * u3) >> 8) * MOUSEKEY_INERTIA_TIME_TO_MAX / 3) >> 7);
+}
+
+/* advance one axis by elapsed milliseconds, returns distance in milli-pixels * friction */
+static int32_t inertia_advance(uint8_t axis, uint16_t elapsed) {
+    int8_t  dir      = inertia_held[axis];
+    int16_t r        = inertia_ramp[axis];
+    int32_t distance = 0;
+
+    while (elapsed) {
+        uint16_t a = r < 0 ? -r : r;
+
+        if (dir && (r == 0 || (r > 0) == (dir > 0))) {
+            if (a >= MOUSEKEY_INERTIA_TIME_TO_MAX) {
+                distance += dir * (int32_t)MOUSEKEY_INERTIA_MAX_SPEED * elapsed * MOUSEKEY_INERTIA_FRICTION;
+                break;
+            }
+            uint16_t n = MOUSEKEY_INERTIA_TIME_TO_MAX - a;
+            if (n > elapsed) n = elapsed;
+            distance += dir * (int32_t)(inertia_distance(a + n) - inertia_distance(a)) * MOUSEKEY_INERTIA_FRICTION;
+            r += dir * (int16_t)n;
+            elapsed -= n;
+        } else if (r) {
+            uint16_t n = (a + MOUSEKEY_INERTIA_FRICTION - 1) / MOUSEKEY_INERTIA_FRICTION;
+            if (n > elapsed) n = elapsed;
+            uint16_t b = n * MOUSEKEY_INERTIA_FRICTION < a ? a - n * MOUSEKEY_INERTIA_FRICTION : 0;
+            distance += (r > 0 ? 1 : -1) * (int32_t)(inertia_distance(a) - inertia_distance(b));
+            r = r > 0 ? b : -b;
+            elapsed -= n;
+        } else {
+            break;
+        }
+    }
+
+    inertia_ramp[axis] = r;
+    return distance;
+}
+
+/* scale is 256 for full speed, returns whole pixels and keeps the remainder */
+static int8_t inertia_move(uint8_t axis, uint16_t elapsed, uint16_t scale) {
+    inertia_carry[axis] += inertia_advance(axis, elapsed) * scale;
+
+    int32_t pixels = inertia_carry[axis] / INERTIA_UNIT;
+    if (pixels > MOUSEKEY_MOVE_MAX) pixels = MOUSEKEY_MOVE_MAX;
+    if (pixels < -MOUSEKEY_MOVE_MAX) pixels = -MOUSEKEY_MOVE_MAX;
+    inertia_carry[axis] -= pixels * INERTIA_UNIT;
+    // only a fraction of a pixel is carried, what did not fit in the report is dropped
+    if (inertia_carry[axis] > INERTIA_UNIT - 1) inertia_carry[axis] = INERTIA_UNIT - 1;
+    if (inertia_carry[axis] < -(INERTIA_UNIT - 1)) inertia_carry[axis] = -(INERTIA_UNIT - 1);
+    return pixels;
+}
+
+static bool inertia_active(void) { return inertia_held[0] || inertia_held[1] || inertia_ramp[0] || inertia_ramp[1]; }
+
+static void inertia_task(void) {
+    if (!inertia_active()) {
+        inertia_timer = timer_read();
+        return;
+    }
+
+    uint16_t elapsed = timer_elapsed(inertia_timer);
+    if (elapsed < MOUSEKEY_INERTIA_INTERVAL) return;
+    inertia_timer += elapsed;
+    if (elapsed > MOUSEKEY_INERTIA_MAX_ELAPSED) elapsed = MOUSEKEY_INERTIA_MAX_ELAPSED;
+
+    uint16_t scale = 256;
+    if (mousekey_accel & (1 << 0)) {
+        scale = 64;
+    } else if (mousekey_accel & (1 << 1)) {
+        scale = 128;
+    } else if (mousekey_accel & (1 << 2)) {
+        for (uint8_t axis = 0; axis < 2; axis++) {
+            if (inertia_held[axis]) inertia_ramp[axis] = inertia_held[axis] * MOUSEKEY_INERTIA_TIME_TO_MAX;
+        }
+    }
+
+    /* diagonal move [1/sqrt(2)] */
+    if ((inertia_held[0] || inertia_ramp[0]) && (inertia_held[1] || inertia_ramp[1])) {
+        scale = (scale * 181) >> 8;
+    }
+
+    mouse_report.x = inertia_move(0, elapsed, scale);
+    mouse_report.y = inertia_move(1, elapsed, scale);
+}
+
+static bool inertia_on(uint8_t code) {
+    if (!inertia_active()) inertia_timer = timer_read();
+
+    if (code == KC_MS_UP)
+        inertia_held[1] = -1;
+    else if (code == KC_MS_DOWN)
+        inertia_held[1] = 1;
+    else if (code == KC_MS_LEFT)
+        inertia_held[0] = -1;
+    else if (code == KC_MS_RIGHT)
+        inertia_held[0] = 1;
+    else
+        return false;
+    return true;
+}
+
+static bool inertia_off(uint8_t code) {
+    if (code == KC_MS_UP && inertia_held[1] < 0)
+        inertia_held[1] = 0;
+    else if (code == KC_MS_DOWN && inertia_held[1] > 0)
+        inertia_held[1] = 0;
+    else if (code == KC_MS_LEFT && inertia_held[0] < 0)
+        inertia_held[0] = 0;
+    else if (code == KC_MS_RIGHT && inertia_held[0] > 0)
+        inertia_held[0] = 0;
+    else
+        return IS_MOUSEKEY_MOVE(code);
+    return true;
+}
+
+#    endif /* #ifdef MK_INERTIA */
+
 void mousekey_task(void) {
     // report cursor and scroll movement independently
     report_mouse_t const tmpmr = mouse_report;
@@ -216,6 +363,9 @@ void mousekey_task(void) {
     mouse_report.v = 0;
     mouse_report.h = 0;
 
+#    ifdef MK_INERTIA
+    inertia_task();
+#    else
     if ((tmpmr.x || tmpmr.y) && timer_elapsed(last_timer_c) > (mousekey_repeat ? mk_interval : mk_delay * 10)) {
         if (mousekey_repeat != UINT8_MAX) mousekey_repeat++;
         if (tmpmr.x != 0) mouse_report.x = move_unit() * ((tmpmr.x > 0) ? 1 : -1);
@@ -233,6 +383,7 @@ void mousekey_task(void) {
             }
         }
     }
+#    endif /* #ifdef MK_INERTIA */
     if ((tmpmr.v || tmpmr.h) && timer_elapsed(last_timer_w) > (mousekey_wheel_repeat ? mk_wheel_interval : mk_wheel_delay * 10)) {
         if (mousekey_wheel_repeat != UINT8_MAX) mousekey_wheel_repeat++;
         if (tmpmr.v != 0) mouse_report.v = wheel_unit() * ((tmpmr.v > 0) ? 1 : -1);
@@ -256,6 +407,9 @@ void mousekey_task(void) {
 }
 
 void mousekey_on(uint8_t code) {
+#    ifdef MK_INERTIA
+    if (inertia_on(code)) return;
+#    endif /* #ifdef MK_INERTIA */
 #    ifdef MK_KINETIC_SPEED
     if (mouse_timer == 0) {
         mouse_timer = timer_read();
@@ -289,6 +443,9 @@ void mousekey_on(uint8_t code) {
 }
 
 void mousekey_off(uint8_t code) {
+#    ifdef MK_INERTIA
+    if (inertia_off(code)) return;
+#    endif /* #ifdef MK_INERTIA */
     if (code == KC_MS_UP && mouse_report.y < 0)
         mouse_report.y = 0;
     else if (code == KC_MS_DOWN && mouse_report.y > 0)
@@ -466,6 +623,11 @@ void mousekey_clear(void) {
     mousekey_repeat       = 0;
     mousekey_wheel_repeat = 0;
     mousekey_accel        = 0;
+#if !defined(MK_3_SPEED) && defined(MK_INERTIA)
+    inertia_held[0]  = inertia_held[1]  = 0;
+    inertia_ramp[0]  = inertia_ramp[1]  = 0;
+    inertia_carry[0] = inertia_carry[1] = 0;
+#endif
 }
 
 static void mousekey_debug(void) {
@@ -103,6 +103,31 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        define MOUSEKEY_WHEEL_DECELERATED_MOVEMENTS 8
 #    endif
 
+#    ifndef MOUSEKEY_INERTIA_INTERVAL
+#        define MOUSEKEY_INERTIA_INTERVAL 1
+#    endif
+#    ifndef MOUSEKEY_INERTIA_INITIAL_SPEED
+#        define MOUSEKEY_INERTIA_INITIAL_SPEED 120
+#    endif
+#    ifndef MOUSEKEY_INERTIA_MAX_SPEED
+#        define MOUSEKEY_INERTIA_MAX_SPEED 1600
+#    elif MOUSEKEY_INERTIA_MAX_SPEED > 4000
+#        error MOUSEKEY_INERTIA_MAX_SPEED needs to be at most 4000
+#    endif
+#    ifndef MOUSEKEY_INERTIA_TIME_TO_MAX
+#        define MOUSEKEY_INERTIA_TIME_TO_MAX 600
+#    elif MOUSEKEY_INERTIA_TIME_TO_MAX < 1 || MOUSEKEY_INERTIA_TIME_TO_MAX > 2000
+#        error MOUSEKEY_INERTIA_TIME_TO_MAX needs to be between 1 and 2000
+#    endif
+#    ifndef MOUSEKEY_INERTIA_FRICTION
+#        define MOUSEKEY_INERTIA_FRICTION 3
+#    elif MOUSEKEY_INERTIA_FRICTION < 1 || MOUSEKEY_INERTIA_FRICTION > 8
+#        error MOUSEKEY_INERTIA_FRICTION needs to be between 1 and 8
+#    endif
+#    ifndef MOUSEKEY_INERTIA_MAX_ELAPSED
+#        define MOUSEKEY_INERTIA_MAX_ELAPSED 100
+#    endif
+
 #else /* #ifndef MK_3_SPEED */
 
 #    ifndef MK_C_OFFSET_UNMOD
@@ -7,4 +7,8 @@ void process_audio_noteon(uint8_t note);
 void process_audio_noteoff(uint8_t note);
 void process_audio_all_notes_off(void);
 
+// Keycodes and events process_audio() acts on, see process_range.h
+#define PROCESS_AUDIO_KEYCODES(RANGE) RANGE(AU_ON, AU_TOG) RANGE(MUV_IN, MUV_DE)
+#define PROCESS_AUDIO_EVENTS PROCESS_ON_PRESS
+
 void audio_on_user(void);
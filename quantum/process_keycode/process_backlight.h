@@ -19,3 +19,7 @@
 #include "quantum.h"
 
 bool process_backlight(uint16_t keycode, keyrecord_t *record);
+
+// Keycodes and events process_backlight() acts on, see process_range.h
+#define PROCESS_BACKLIGHT_KEYCODES(RANGE) RANGE(BL_ON, BL_BRTG)
+#define PROCESS_BACKLIGHT_EVENTS PROCESS_ON_PRESS
@@ -59,8 +59,7 @@ static inline void dump_key_buffer(bool emit) {
     if (emit) {
         for (uint8_t i = 0; i < buffer_size; i++) {
 #ifdef COMBO_ALLOW_ACTION_KEYS
-            const action_t action = store_or_get_action(key_buffer[i].event.pressed, key_buffer[i].event.key);
-            process_action(&(key_buffer[i]), action);
+            process_action(&(key_buffer[i]), key_buffer[i].action);
 #else
             register_code16(key_buffer[i]);
             send_keyboard_report();
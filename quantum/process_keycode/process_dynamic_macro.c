@@ -108,6 +108,8 @@ void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_poi
      */
     if (*macro_pointer - direction != macro2_end) {
         **macro_pointer = *record;
+        // played back long after, when the keymap generation may have wrapped around to the same value
+        (*macro_pointer)->resolved_layer = 0;
         *macro_pointer += direction;
     } else {
         dynamic_macro_record_key_user(direction, record);
@@ -18,3 +18,7 @@
 #include "quantum.h"
 
 bool process_grave_esc(uint16_t keycode, keyrecord_t *record);
+
+// Keycodes and events process_grave_esc() acts on, see process_range.h
+#define PROCESS_GRAVE_ESC_KEYCODES(RANGE) RANGE(GRAVE_ESC, GRAVE_ESC)
+#define PROCESS_GRAVE_ESC_EVENTS PROCESS_ON_ANY
@@ -5,6 +5,10 @@
 
 bool process_joystick(uint16_t keycode, keyrecord_t *record);
 
+// Keycodes and events process_joystick() acts on, see process_range.h
+#define PROCESS_JOYSTICK_KEYCODES(RANGE) RANGE(JS_BUTTON0, JS_BUTTON_MAX)
+#define PROCESS_JOYSTICK_EVENTS PROCESS_ON_ANY
+
 void joystick_task(void);
 
 bool process_joystick_analogread(void);
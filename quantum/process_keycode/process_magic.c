@@ -167,7 +167,8 @@ bool process_magic(uint16_t keycode, keyrecord_t *record) {
                 }
 
                 eeconfig_update_keymap(keymap_config.raw);
-                clear_keyboard();  // clear to prevent stuck keys
+                keymap_cache_invalidate();  // the swaps change what keys resolve to
+                clear_keyboard();           // clear to prevent stuck keys
 
                 return false;
         }
@@ -18,3 +18,7 @@
 #include "quantum.h"
 
 bool process_magic(uint16_t keycode, keyrecord_t *record);
+
+// Keycodes and events process_magic() acts on, see process_range.h
+#define PROCESS_MAGIC_KEYCODES(RANGE) RANGE(MAGIC_SWAP_CONTROL_CAPSLOCK, MAGIC_TOGGLE_ALT_GUI) RANGE(MAGIC_SWAP_LCTL_LGUI, MAGIC_EE_HANDS_RIGHT)
+#define PROCESS_MAGIC_EVENTS PROCESS_ON_PRESS
@@ -26,6 +26,11 @@ void process_midi_basic_noteon(uint8_t note) { midi_send_noteon(&midi_device, 0,
 
 void process_midi_basic_noteoff(uint8_t note) { midi_send_noteoff(&midi_device, 0, note, 0); }
 
+// Same as above, sent when timer_read() reaches time, return false when the schedule is full
+bool process_midi_basic_noteon_at(uint8_t note, uint16_t time) { return midi_queue_schedule_message(time, 3, MIDI_NOTEON, note, 127); }
+
+bool process_midi_basic_noteoff_at(uint8_t note, uint16_t time) { return midi_queue_schedule_message(time, 3, MIDI_NOTEOFF, note, 0); }
+
 void process_midi_all_notes_off(void) { midi_send_cc(&midi_device, 0, 0x7B, 0); }
 
 #    endif  // MIDI_BASIC
@@ -239,6 +244,7 @@ bool process_midi(uint16_t keycode, keyrecord_t *record) {
 
 void midi_task(void) {
     midi_device_process(&midi_device);
+    midi_queue_task();
 #    ifdef MIDI_ADVANCED
     if (timer_elapsed(midi_modulation_timer) < midi_config.modulation_interval) return;
     midi_modulation_timer = timer_read();
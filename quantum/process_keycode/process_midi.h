@@ -23,6 +23,8 @@
 #    ifdef MIDI_BASIC
 void process_midi_basic_noteon(uint8_t note);
 void process_midi_basic_noteoff(uint8_t note);
+bool process_midi_basic_noteon_at(uint8_t note, uint16_t time);
+bool process_midi_basic_noteoff_at(uint8_t note, uint16_t time);
 void process_midi_all_notes_off(void);
 #    endif
 
@@ -45,6 +47,10 @@ extern midi_config_t midi_config;
 void midi_init(void);
 bool process_midi(uint16_t keycode, keyrecord_t *record);
 
+// Keycodes and events process_midi() acts on, see process_range.h
+#        define PROCESS_MIDI_KEYCODES(RANGE) RANGE(MIDI_TONE_MIN, MI_BENDU)
+#        define PROCESS_MIDI_EVENTS PROCESS_ON_ANY
+
 #        define MIDI_INVALID_NOTE 0xFF
 #        define MIDI_TONE_COUNT (MIDI_TONE_MAX - MIDI_TONE_MIN + 1)
 
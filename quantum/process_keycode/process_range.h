@@ -0,0 +1,48 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Keycode range gating for the handlers called from process_record_quantum().
+ *
+ * A handler that only acts on its own keycodes declares them, and the events it wants, next to its
+ * prototype:
+ *
+ *     #define PROCESS_BACKLIGHT_KEYCODES(RANGE) RANGE(BL_ON, BL_BRTG)
+ *     #define PROCESS_BACKLIGHT_EVENTS PROCESS_ON_PRESS
+ *
+ * process_record_quantum() then calls it as PROCESS_IN_RANGE(BACKLIGHT, process_backlight), which
+ * only makes the call for a keycode in one of the ranges and an event the handler wants, and
+ * otherwise carries on as if the handler had returned true. All bounds are compile time constants,
+ * so each range costs a single unsigned compare.
+ *
+ * Handlers that look at every key, such as combos, leader or auto shift, are called as before.
+ */
+
+#define PROCESS_ON_PRESS (1 << 0)
+#define PROCESS_ON_RELEASE (1 << 1)
+#define PROCESS_ON_ANY (PROCESS_ON_PRESS | PROCESS_ON_RELEASE)
+
+#define PROCESS_KEYCODE_IN_RANGE(keycode, min, max) ((uint16_t)((keycode) - (min)) <= (uint16_t)((max) - (min)))
+
+// These expect the keycode and record in variables named keycode and record, as in process_record_quantum()
+#define PROCESS_OR_KEYCODE_IN_RANGE(min, max) || PROCESS_KEYCODE_IN_RANGE(keycode, min, max)
+#define PROCESS_WANTS(name) ((false PROCESS_##name##_KEYCODES(PROCESS_OR_KEYCODE_IN_RANGE)) && (PROCESS_##name##_EVENTS & (record->event.pressed ? PROCESS_ON_PRESS : PROCESS_ON_RELEASE)))
+#define PROCESS_IN_RANGE(name, handler) (!PROCESS_WANTS(name) || handler(keycode, record))
@@ -18,3 +18,11 @@
 #include "quantum.h"
 
 bool process_rgb(const uint16_t keycode, const keyrecord_t *record);
+
+// Keycodes and events process_rgb() acts on, see process_range.h
+#define PROCESS_RGB_KEYCODES(RANGE) RANGE(RGB_TOG, RGB_MODE_RGBTEST)
+#ifndef SPLIT_KEYBOARD
+#    define PROCESS_RGB_EVENTS PROCESS_ON_PRESS
+#else
+#    define PROCESS_RGB_EVENTS PROCESS_ON_RELEASE
+#endif
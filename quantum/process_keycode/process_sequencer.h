@@ -19,3 +19,7 @@
 #include "quantum.h"
 
 bool process_sequencer(uint16_t keycode, keyrecord_t *record);
+
+// Keycodes and events process_sequencer() acts on, see process_range.h
+#define PROCESS_SEQUENCER_KEYCODES(RANGE) RANGE(SQ_ON, SEQUENCER_TRACK_MAX)
+#define PROCESS_SEQUENCER_EVENTS PROCESS_ON_PRESS
@@ -23,5 +23,9 @@ typedef enum { STENO_MODE_BOLT, STENO_MODE_GEMINI } steno_mode_t;
 bool     process_steno(uint16_t keycode, keyrecord_t *record);
 void     steno_init(void);
 void     steno_set_mode(steno_mode_t mode);
+
+// Keycodes and events process_steno() acts on, see process_range.h
+#define PROCESS_STENO_KEYCODES(RANGE) RANGE(QK_STENO, QK_STENO_MAX)
+#define PROCESS_STENO_EVENTS PROCESS_ON_ANY
 uint8_t *steno_get_state(void);
 uint8_t *steno_get_chord(void);
@@ -88,6 +88,11 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record);
 void matrix_scan_tap_dance(void);
 void reset_tap_dance(qk_tap_dance_state_t *state);
 
+// Keycodes and events process_tap_dance() acts on, see process_range.h. Other keys interrupt a
+// tap dance through preprocess_tap_dance().
+#    define PROCESS_TAP_DANCE_KEYCODES(RANGE) RANGE(QK_TAP_DANCE, QK_TAP_DANCE_MAX)
+#    define PROCESS_TAP_DANCE_EVENTS PROCESS_ON_ANY
+
 void qk_tap_dance_pair_on_each_tap(qk_tap_dance_state_t *state, void *user_data);
 void qk_tap_dance_pair_finished(qk_tap_dance_state_t *state, void *user_data);
 void qk_tap_dance_pair_reset(qk_tap_dance_state_t *state, void *user_data);
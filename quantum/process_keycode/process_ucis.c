@@ -22,6 +22,7 @@ void qk_ucis_start(void) {
     qk_ucis_state.count       = 0;
     qk_ucis_state.in_progress = true;
 
+    unicode_queue_flush();
     qk_ucis_start_user();
 }
 
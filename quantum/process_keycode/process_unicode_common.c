@@ -16,6 +16,7 @@
 
 #include "process_unicode_common.h"
 #include "eeprom.h"
+#include "ring_buffer.h"
 #include <ctype.h>
 #include <string.h>
 
@@ -186,6 +187,7 @@ void register_unicode(uint32_t code_point) {
         return;
     }
 
+    unicode_queue_flush();
     unicode_input_start();
     if (code_point > 0xFFFF && unicode_config.input_mode == UC_MAC) {
         // Convert code point to UTF-16 surrogate pair on macOS
@@ -206,6 +208,7 @@ void send_unicode_hex_string(const char *str) {
         return;
     }
 
+    unicode_queue_flush();
     while (*str) {
         // Find the next code point (token) in the string
         for (; *str == ' '; str++);    // Skip leading spaces
@@ -274,6 +277,328 @@ void send_unicode_string(const char *str) {
     }
 }
 
+/*
+ * Queued Unicode output
+ *
+ * queue_unicode() and queue_unicode_string() only put code points in a queue, unicode_task() then
+ * sends them from the scan loop, one report per call, without blocking. When a code point comes
+ * up, all its reports are worked out at once: the start sequence of the input mode, the hex digits
+ * and the finish sequence. Digits roll into each other, the report that releases one digit presses
+ * the next, with a release in between only when the same digit repeats. Mods and Caps Lock are
+ * saved and restored once per run of queued code points instead of once per code point, and on
+ * macOS the Option key stays down for the whole run.
+ *
+ * Key events are held back while a run is typed, so they neither end up in the middle of it nor
+ * change the mods it restores. They are processed in order once it has finished.
+ *
+ * The queue always uses the built-in start and finish sequences, overriding unicode_input_start()
+ * and unicode_input_finish() only changes register_unicode() and the send_unicode_* functions.
+ */
+
+typedef struct {
+    uint8_t mods;
+    uint8_t key;
+} unicode_report_t;
+
+// Caps Lock, start sequence, a surrogate pair and the finish sequence
+#define UNICODE_REPORTS_MAX 16
+
+RING_BUFFER_DEFINE(unicode_queue, uint32_t, UNICODE_QUEUE_SIZE)
+
+static unicode_queue_t  unicode_queue;
+static unicode_report_t unicode_reports[UNICODE_REPORTS_MAX];
+static uint8_t          unicode_report_count;
+static uint8_t          unicode_report_next;
+static uint8_t          unicode_delay_at;  // report to wait UNICODE_TYPE_DELAY before, UINT8_MAX for none
+static uint16_t         unicode_delay_timer;
+static bool             unicode_delaying;
+static bool             unicode_running;  // a run has been started and not finished yet
+static bool             unicode_ending;   // the reports are those finishing the run
+static uint8_t          unicode_run_mode;
+static uint8_t          unicode_run_mods;
+static bool             unicode_run_caps_lock;
+static unicode_report_t unicode_sent;  // mods and key held by the last report sent
+static keyrecord_t      unicode_held[UNICODE_QUEUE_HELD_EVENTS];
+static uint8_t          unicode_held_count;
+static bool             unicode_releasing;  // the held events are being processed
+
+// Mods a keycode sends, the way register_code16() does
+static uint8_t unicode_keycode_mods(uint16_t keycode) {
+    if (IS_MOD(keycode)) {
+        return MOD_BIT(keycode);
+    }
+    if (keycode < QK_MODS || keycode > QK_MODS_MAX) {
+        return 0;
+    }
+    uint8_t mods = (keycode >> 8) & 0x0F;
+    return (keycode & QK_RMODS_MIN) ? mods << 4 : mods;
+}
+
+static void unicode_add_report(uint8_t mods, uint16_t keycode) {
+    unicode_report_t *report = &unicode_reports[unicode_report_count++];
+    report->mods             = mods | unicode_keycode_mods(keycode);
+    report->key              = IS_MOD(keycode) ? KC_NO : keycode & 0xFF;
+}
+
+// Same reports as tap_code16(): mods, key, key up, mods up
+static void unicode_add_tap(uint8_t mods, uint16_t keycode) {
+    uint8_t key_mods = mods | unicode_keycode_mods(keycode);
+    if (!IS_MOD(keycode) && key_mods != mods) {
+        unicode_add_report(key_mods, KC_NO);
+    }
+    unicode_add_report(mods, keycode);
+    if (!IS_MOD(keycode) && key_mods != mods) {
+        unicode_add_report(key_mods, KC_NO);
+    }
+    unicode_add_report(mods, KC_NO);
+}
+
+// Same digits as register_hex32(), at least four. Digit releases are added by unicode_task().
+static void unicode_add_hex(uint8_t mods, uint32_t hex) {
+    int8_t i = 7;
+    while (i > 3 && !((hex >> (i * 4)) & 0xF)) {
+        i--;
+    }
+    for (; i >= 0; i--) {
+        unicode_add_report(mods, hex_to_keycode(hex >> (i * 4)));
+    }
+}
+
+// Works out the reports for the next code point in the queue, false if there is none
+static bool unicode_prepare_code_point(void) {
+    uint8_t  mode = unicode_running ? unicode_run_mode : unicode_config.input_mode;
+    uint32_t code_point;
+    do {
+        if (!unicode_queue_pop(&unicode_queue, &code_point)) {
+            return false;
+        }
+    } while (code_point > 0x10FFFF || (code_point > 0xFFFF && mode == UC_WIN));
+
+    unicode_report_count = unicode_report_next = 0;
+    unicode_delay_at                           = UINT8_MAX;
+
+    if (!unicode_running) {
+        unicode_running       = true;
+        unicode_run_mode      = mode;
+        unicode_run_caps_lock = host_keyboard_led_state().caps_lock;
+        unicode_run_mods      = get_mods();
+        clear_mods();
+
+        if (mode == UC_LNX && unicode_run_caps_lock) {
+            unicode_add_tap(0, KC_CAPS);
+        }
+        if (mode == UC_MAC) {
+            // Held until the end of the run, UNICODE_KEY_MAC has to be a modifier for that
+            unicode_add_report(0, UNICODE_KEY_MAC);
+            unicode_delay_at = unicode_report_count;
+        }
+    }
+
+    uint8_t mods = 0;
+    switch (mode) {
+        case UC_MAC:
+            mods = unicode_keycode_mods(UNICODE_KEY_MAC);
+            break;
+        case UC_LNX:
+            unicode_add_tap(0, UNICODE_KEY_LNX);
+            break;
+        case UC_WIN:
+            mods = MOD_BIT(KC_LALT);
+            unicode_add_report(mods, KC_NO);
+            unicode_add_tap(mods, KC_PPLS);
+            break;
+        case UC_WINC:
+            unicode_add_tap(0, UNICODE_KEY_WINC);
+            unicode_add_tap(0, KC_U);
+            break;
+    }
+    if (mode != UC_MAC) {
+        unicode_delay_at = unicode_report_count;
+    }
+
+    if (code_point > 0xFFFF && mode == UC_MAC) {
+        // Convert code point to UTF-16 surrogate pair on macOS
+        code_point -= 0x10000;
+        unicode_add_hex(mods, (code_point >> 10) + 0xD800);
+        unicode_add_hex(mods, (code_point & 0x3FF) + 0xDC00);
+    } else {
+        unicode_add_hex(mods, code_point);
+    }
+
+    switch (mode) {
+        case UC_LNX:
+            unicode_add_tap(0, KC_SPC);
+            break;
+        case UC_WINC:
+            unicode_add_tap(0, KC_ENTER);
+            break;
+        case UC_WIN:
+        case UC_BSD:
+            unicode_add_report(0, KC_NO);
+            break;
+    }
+    return true;
+}
+
+// Works out the reports that finish the run once the queue has run dry
+static void unicode_prepare_end(void) {
+    unicode_report_count = unicode_report_next = 0;
+    unicode_delay_at                           = UINT8_MAX;
+
+    if (unicode_run_mode == UC_MAC) {
+        unicode_add_report(0, KC_NO);
+    }
+    if (unicode_run_mode == UC_LNX && unicode_run_caps_lock) {
+        unicode_add_tap(0, KC_CAPS);
+    }
+    unicode_ending = true;
+}
+
+static void unicode_send(unicode_report_t report) {
+    if (unicode_sent.key) {
+        del_key(unicode_sent.key);
+    }
+    if (report.key) {
+        add_key(report.key);
+    }
+    set_mods(report.mods);
+    send_keyboard_report();
+    unicode_sent = report;
+}
+
+// Processes the held events in order, up to one that queues more output
+static void unicode_release_held(void) {
+    if (unicode_releasing) {
+        return;
+    }
+    unicode_releasing = true;
+    uint8_t released  = 0;
+    while (released < unicode_held_count && unicode_queue_empty(&unicode_queue)) {
+        process_record(&unicode_held[released++]);
+    }
+    unicode_held_count -= released;
+    memmove(unicode_held, &unicode_held[released], unicode_held_count * sizeof(keyrecord_t));
+    unicode_releasing = false;
+}
+
+/** \brief Send the next report of the queued Unicode output
+ *
+ * Called from the scan loop. Sends at most one report, reports that would not change anything are
+ * skipped.
+ */
+void unicode_task(void) {
+    if (unicode_delaying) {
+        if (timer_elapsed(unicode_delay_timer) < UNICODE_TYPE_DELAY) {
+            return;
+        }
+        unicode_delaying = false;
+    }
+
+    while (true) {
+        if (unicode_report_next == unicode_report_count) {
+            if (!unicode_ending && unicode_prepare_code_point()) {
+                continue;
+            }
+            if (!unicode_running) {
+                unicode_release_held();
+                return;
+            }
+            if (!unicode_ending) {
+                unicode_prepare_end();
+                continue;
+            }
+            unicode_running = unicode_ending = false;
+            set_mods(unicode_run_mods);  // Reregister previously set mods
+            return;
+        }
+
+        if (unicode_report_next == unicode_delay_at) {
+            unicode_delay_at    = UINT8_MAX;
+            unicode_delaying    = true;
+            unicode_delay_timer = timer_read();
+            return;
+        }
+
+        unicode_report_t report = unicode_reports[unicode_report_next];
+        if (!report.key && !unicode_sent.key && report.mods == unicode_sent.mods) {
+            unicode_report_next++;
+            continue;
+        }
+        if (report.key && report.key == unicode_sent.key) {
+            // The same key again, release it first
+            report.key = KC_NO;
+        } else {
+            unicode_report_next++;
+        }
+        unicode_send(report);
+        return;
+    }
+}
+
+bool unicode_queue_busy(void) { return unicode_running || !unicode_queue_empty(&unicode_queue) || (unicode_held_count && !unicode_releasing); }
+
+/** \brief Hold back a key event while the queue is typing
+ *
+ * Called first thing from process_record_quantum(), returns false for an event held back.
+ */
+bool process_unicode_queue_hold(keyrecord_t *record) {
+    if (unicode_releasing || !unicode_queue_busy()) {
+        return true;
+    }
+    if (unicode_held_count == UNICODE_QUEUE_HELD_EVENTS) {
+        // No room, finish typing and the held events, then this one
+        unicode_queue_flush();
+        return true;
+    }
+    unicode_held[unicode_held_count++] = *record;
+    return false;
+}
+
+static void unicode_queue_step(void) {
+    if (unicode_delaying) {
+        wait_ms(1);
+    }
+#if TAP_CODE_DELAY > 0
+    wait_ms(TAP_CODE_DELAY);
+#endif
+    unicode_task();
+}
+
+/** \brief Send everything queued before returning
+ */
+void unicode_queue_flush(void) {
+    while (unicode_queue_busy()) {
+        unicode_queue_step();
+    }
+}
+
+/** \brief Queue a code point to be sent by unicode_task()
+ *
+ * Blocks only if the queue is full, until enough has been sent to make room.
+ */
+void queue_unicode(uint32_t code_point) {
+    while (!unicode_queue_push(&unicode_queue, code_point)) {
+        unicode_queue_step();
+    }
+}
+
+/** \brief Queue a UTF-8 string to be sent by unicode_task()
+ */
+void queue_unicode_string(const char *str) {
+    if (!str) {
+        return;
+    }
+
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+
+        if (code_point >= 0) {
+            queue_unicode(code_point);
+        }
+    }
+}
+
 // clang-format off
 
 static void audio_helper(void) {
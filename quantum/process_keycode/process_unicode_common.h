@@ -49,6 +49,16 @@
 #    define UNICODE_TYPE_DELAY 10
 #endif
 
+// Code points queue_unicode() can buffer (power of two, one slot is kept free)
+#ifndef UNICODE_QUEUE_SIZE
+#    define UNICODE_QUEUE_SIZE 16
+#endif
+
+// Key events held back while the queue is typing, more wait for it to finish
+#ifndef UNICODE_QUEUE_HELD_EVENTS
+#    define UNICODE_QUEUE_HELD_EVENTS 8
+#endif
+
 // Deprecated aliases
 #if !defined(UNICODE_KEY_MAC) && defined(UNICODE_KEY_OSX)
 #    define UNICODE_KEY_MAC UNICODE_KEY_OSX
@@ -93,8 +103,28 @@ void register_unicode(uint32_t code_point);
 void send_unicode_hex_string(const char *str);
 void send_unicode_string(const char *str);
 
+void queue_unicode(uint32_t code_point);
+void queue_unicode_string(const char *str);
+bool unicode_queue_busy(void);
+void unicode_queue_flush(void);
+void unicode_task(void);
+bool process_unicode_queue_hold(keyrecord_t *record);
+
 bool process_unicode_common(uint16_t keycode, keyrecord_t *record);
 
+// Keycodes and events process_unicode_common() acts on, see process_range.h
+#if defined(UNICODE_ENABLE)
+#    define PROCESS_UNICODE_COMMON_KEYCODES(RANGE) RANGE(UNICODE_MODE_FORWARD, UNICODE_MODE_WINC) RANGE(QK_UNICODE, QK_UNICODE_MAX)
+#    define PROCESS_UNICODE_COMMON_EVENTS PROCESS_ON_PRESS
+#elif defined(UNICODEMAP_ENABLE)
+#    define PROCESS_UNICODE_COMMON_KEYCODES(RANGE) RANGE(UNICODE_MODE_FORWARD, UNICODE_MODE_WINC) RANGE(QK_UNICODEMAP, QK_UNICODEMAP_PAIR_MAX)
+#    define PROCESS_UNICODE_COMMON_EVENTS PROCESS_ON_PRESS
+#else
+// UCIS reads every key while it is active
+#    define PROCESS_UNICODE_COMMON_KEYCODES(RANGE) RANGE(0, 0xFFFF)
+#    define PROCESS_UNICODE_COMMON_EVENTS PROCESS_ON_ANY
+#endif
+
 #define UC_BSPC UC(0x0008)
 #define UC_SPC UC(0x0020)
 
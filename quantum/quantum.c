@@ -15,6 +15,7 @@
  */
 
 #include "quantum.h"
+#include "process_range.h"
 
 #ifdef BLUETOOTH_ENABLE
 #    include "outputselect.h"
@@ -142,8 +143,50 @@ void reset_keyboard(void) {
     bootloader_jump();
 }
 
-/* Convert record into usable keycode via the contained event. */
-uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) { return get_event_keycode(record->event, update_layer_cache); }
+/* Convert record into usable keycode. The keycode, action and source layer are
+ * cached in the record, and only looked up again once the layer state or the
+ * layer cache has changed. A press resolves against the current layer state
+ * even before it updates the layer cache, a release reads the layer cache.
+ */
+uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) {
+    keyevent_t event  = record->event;
+    bool       cached = (record->resolved_layer & RECORD_RESOLVED) && record->resolved_generation == keymap_generation;
+    uint8_t    layer;
+
+#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+    if (disable_action_cache) {
+        cached = false;
+        layer  = layer_switch_get_layer(event.key);
+    } else if (cached) {
+        layer = record->resolved_layer & ~RECORD_RESOLVED;
+    } else if (event.pressed) {
+        layer = layer_switch_get_layer(event.key);
+    } else {
+        layer = read_source_layers_cache(event.key);
+    }
+
+    if (event.pressed && update_layer_cache && !disable_action_cache) {
+        update_source_layers_cache(event.key, layer);
+    }
+#else
+    layer = cached ? record->resolved_layer & ~RECORD_RESOLVED : layer_switch_get_layer(event.key);
+#endif
+
+    if (!cached) {
+        record->keycode = keymap_key_to_keycode(layer, event.key);
+        record->action  = action_for_keycode(record->keycode);
+    }
+#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+    if (disable_action_cache) {
+        // not valid once the layer cache is back in use
+        record->resolved_layer = 0;
+        return record->keycode;
+    }
+#endif
+    record->resolved_layer      = RECORD_RESOLVED | layer;
+    record->resolved_generation = keymap_generation;
+    return record->keycode;
+}
 
 /* Convert event into usable keycode. Checks the layer cache to ensure that it
  * retains the correct keycode after a layer change, if the key is still pressed.
@@ -171,7 +214,7 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
 
 /* Get keycode, and then call keyboard function */
 void post_process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, false);
+    uint16_t keycode = record->keycode;
     post_process_record_kb(keycode, record);
 }
 
@@ -179,7 +222,7 @@ void post_process_record_quantum(keyrecord_t *record) {
     then processes internal quantum keycodes, and then processes
     ACTIONs.                                                      */
 bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
+    uint16_t keycode = record->keycode;
 
     // This is how you use actions here
     // if (keycode == KC_LEAD) {
@@ -189,6 +232,13 @@ bool process_record_quantum(keyrecord_t *record) {
     //   return false;
     // }
 
+#if defined(UNICODE_ENABLE) || defined(UNICODEMAP_ENABLE) || defined(UCIS_ENABLE)
+    // Held back while queued Unicode output is typed, processed from the start once it is done
+    if (!process_unicode_queue_hold(record)) {
+        return false;
+    }
+#endif
+
 #ifdef VELOCIKEY_ENABLE
     if (velocikey_enabled() && record->event.pressed) {
         velocikey_accelerate();
@@ -205,6 +255,9 @@ bool process_record_quantum(keyrecord_t *record) {
     preprocess_tap_dance(keycode, record);
 #endif
 
+    /* Handlers called through PROCESS_IN_RANGE() are skipped unless the keycode is one of theirs,
+     * the others see every key. Either way they run in this order.
+     */
     if (!(
 #if defined(KEY_LOCK_ENABLE)
             // Must run first to be able to mask key_up events.
@@ -221,32 +274,32 @@ bool process_record_quantum(keyrecord_t *record) {
             process_haptic(keycode, record) &&
 #endif  // HAPTIC_ENABLE
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+            PROCESS_IN_RANGE(VIA, process_record_via) &&
 #endif
             process_record_kb(keycode, record) &&
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+            PROCESS_IN_RANGE(SEQUENCER, process_sequencer) &&
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+            PROCESS_IN_RANGE(MIDI, process_midi) &&
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+            PROCESS_IN_RANGE(AUDIO, process_audio) &&
 #endif
 #ifdef BACKLIGHT_ENABLE
-            process_backlight(keycode, record) &&
+            PROCESS_IN_RANGE(BACKLIGHT, process_backlight) &&
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+            PROCESS_IN_RANGE(STENO, process_steno) &&
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
             process_music(keycode, record) &&
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+            PROCESS_IN_RANGE(TAP_DANCE, process_tap_dance) &&
 #endif
 #if defined(UNICODE_ENABLE) || defined(UNICODEMAP_ENABLE) || defined(UCIS_ENABLE)
-            process_unicode_common(keycode, record) &&
+            PROCESS_IN_RANGE(UNICODE_COMMON, process_unicode_common) &&
 #endif
 #ifdef LEADER_ENABLE
             process_leader(keycode, record) &&
@@ -267,16 +320,16 @@ bool process_record_quantum(keyrecord_t *record) {
             process_space_cadet(keycode, record) &&
 #endif
 #ifdef MAGIC_KEYCODE_ENABLE
-            process_magic(keycode, record) &&
+            PROCESS_IN_RANGE(MAGIC, process_magic) &&
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+            PROCESS_IN_RANGE(GRAVE_ESC, process_grave_esc) &&
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+            PROCESS_IN_RANGE(RGB, process_rgb) &&
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+            PROCESS_IN_RANGE(JOYSTICK, process_joystick) &&
 #endif
             true)) {
         return false;
@@ -434,6 +487,10 @@ void matrix_scan_quantum() {
     matrix_scan_sequencer();
 #endif
 
+#if defined(UNICODE_ENABLE) || defined(UNICODEMAP_ENABLE) || defined(UCIS_ENABLE)
+    unicode_task();
+#endif
+
 #ifdef TAP_DANCE_ENABLE
     matrix_scan_tap_dance();
 #endif
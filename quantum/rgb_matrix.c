@@ -25,6 +25,14 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifndef MAX
+#    define MAX(X, Y) ((X) > (Y) ? (X) : (Y))
+#endif
+
+#ifndef MIN
+#    define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -33,18 +41,31 @@ const point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 
 __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) { return hsv_to_rgb(hsv); }
 
-// Generic effect runners
-#include "rgb_matrix_runners/effect_runner_dx_dy_dist.h"
-#include "rgb_matrix_runners/effect_runner_dx_dy.h"
-#include "rgb_matrix_runners/effect_runner_i.h"
-#include "rgb_matrix_runners/effect_runner_sin_cos_i.h"
-#include "rgb_matrix_runners/effect_runner_reactive.h"
-#include "rgb_matrix_runners/effect_runner_reactive_splash.h"
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) { hsv_to_rgb_batch(hsv, rgb, count); }
+
+// Generic effect runners, on HSV colors
+#define LIGHTING_COLOR_T HSV
+#define LIGHTING_BASE_COLOR rgb_matrix_config.hsv
+#define LIGHTING_VAL(color) ((color).v)
+#define LIGHTING_SET_COLOR(i, color) rgb_matrix_set_hsv(i, color)
+#define LIGHTING_CONFIG rgb_matrix_config
+#define LIGHTING_TIMER g_rgb_timer
+#define LIGHTING_CENTER k_rgb_matrix_center
+#define LIGHTING_BASE_HSV rgb_matrix_config.hsv
+#define LIGHTING_COLOR_FROM_HSV(hsv) (hsv)
+
+#include "lighting_matrix_runners/effect_runner_dx_dy_dist.h"
+#include "lighting_matrix_runners/effect_runner_dx_dy.h"
+#include "lighting_matrix_runners/effect_runner_i.h"
+#include "lighting_matrix_runners/effect_runner_sin_cos_i.h"
+#include "lighting_matrix_runners/effect_runner_reactive.h"
+#include "lighting_matrix_runners/effect_runner_reactive_splash.h"
 
 // ------------------------------------------
 // -----Begin rgb effect includes macros-----
 #define RGB_MATRIX_EFFECT(name)
 #define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#define LIGHTING_EFFECT_IMPLS
 
 #include "rgb_matrix_animations/rgb_matrix_effects.inc"
 #ifdef RGB_MATRIX_CUSTOM_KB
@@ -54,6 +75,7 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) { return hsv_to_rgb(hsv
 #    include "rgb_matrix_user.inc"
 #endif
 
+#undef LIGHTING_EFFECT_IMPLS
 #undef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 #undef RGB_MATRIX_EFFECT
 // -----End rgb effect includes macros-------
@@ -123,25 +145,48 @@ rgb_config_t rgb_matrix_config;  // TODO: would like to prefix this with g_ for
 uint32_t     g_rgb_timer;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
+uint8_t g_rgb_led_buffer[DRIVER_LED_TOTAL]           = {0};
 #endif  // RGB_MATRIX_FRAMEBUFFER_EFFECTS
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-last_hit_t g_last_hit_tracker;
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
-
-// internals
-static uint8_t         rgb_last_enable   = UINT8_MAX;
-static uint8_t         rgb_last_effect   = UINT8_MAX;
-static effect_params_t rgb_effect_params = {0, 0xFF};
-static rgb_task_states rgb_task_state    = SYNCING;
-#if RGB_DISABLE_TIMEOUT > 0
-static uint32_t rgb_anykey_timer;
-#endif  // RGB_DISABLE_TIMEOUT > 0
-
-// double buffers
-static uint32_t rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_HSV_BATCH
+static HSV     rgb_hsv_buffer[DRIVER_LED_TOTAL];
+static uint8_t rgb_hsv_pending[(DRIVER_LED_TOTAL + 7) / 8];  // LEDs set since the last flush
+#endif  // RGB_MATRIX_HSV_BATCH
+
+// The lighting core, shared with LED Matrix
+#define LIGHTING_NAME "rgb matrix"
+#define LIGHTING_LED_FLUSH_LIMIT RGB_MATRIX_LED_FLUSH_LIMIT
+#define LIGHTING_LED_PROCESS_LIMIT (RGB_MATRIX_LED_PROCESS_LIMIT)
+#define LIGHTING_DISABLE_TIMEOUT RGB_DISABLE_TIMEOUT
+#define LIGHTING_DISABLE_WHEN_USB_SUSPENDED RGB_DISABLE_WHEN_USB_SUSPENDED
+#if defined(RGB_MATRIX_KEYRELEASES)
+#    define LIGHTING_KEYRELEASES
+#elif defined(RGB_MATRIX_KEYPRESSES)
+#    define LIGHTING_KEYPRESSES
+#endif
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+#    define LIGHTING_RENDER_BUDGET_US RGB_MATRIX_RENDER_BUDGET_US
+#    define LIGHTING_RENDER_BACKOFF_BUDGET_US RGB_MATRIX_RENDER_BACKOFF_BUDGET_US
+#    define LIGHTING_RENDER_BACKOFF_MS RGB_MATRIX_RENDER_BACKOFF_MS
+#    define LIGHTING_RENDER_TIMER RGB_MATRIX_RENDER_TIMER
+#    define LIGHTING_RENDER_TIMER_PER_US RGB_MATRIX_RENDER_TIMER_PER_US
+#endif
+
+#ifdef RGB_MATRIX_KEY_LEDS
+#    define LIGHTING_KEY_LED_OFFSETS RGB_MATRIX_KEY_LED_OFFSETS
+#    define LIGHTING_KEY_LEDS RGB_MATRIX_KEY_LEDS
+#    define LIGHTING_LED_KEYS RGB_MATRIX_LED_KEYS
+#    define LIGHTING_KEY_LEDS_MAX RGB_MATRIX_KEY_LEDS_MAX
+#endif
+
+void rgb_matrix_test(void);
+#define LIGHTING_FACTORY_TEST rgb_matrix_test
+
+#include "lighting_matrix_core.h"
+
+#ifdef RGB_MATRIX_LED_CONFIG
+// Generated from the rgb_matrix layout in info.json by `qmk generate-led-config`
+led_config_t g_led_config = RGB_MATRIX_LED_CONFIG;
+#endif
 
 void eeconfig_read_rgb_matrix(void) { eeprom_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
 
@@ -169,6 +214,9 @@ void eeconfig_debug_rgb_matrix(void) {
 __attribute__((weak)) uint8_t rgb_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i) { return 0; }
 
 uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) {
+#ifdef RGB_MATRIX_KEY_LEDS
+    return lighting_key_map_leds(row, column, led_i);
+#else
     uint8_t led_count = rgb_matrix_map_row_column_to_led_kb(row, column, led_i);
     uint8_t led_index = g_led_config.matrix_co[row][column];
     if (led_index != NO_LED) {
@@ -176,52 +224,105 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
         led_count++;
     }
     return led_count;
+#endif
 }
 
-void rgb_matrix_update_pwm_buffers(void) { rgb_matrix_driver.flush(); }
+bool rgb_matrix_map_led_to_row_column(uint8_t led, uint8_t *row, uint8_t *column) { return lighting_map_led_to_row_column(led, row, column); }
 
-void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) { rgb_matrix_driver.set_color(index, red, green, blue); }
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+static lighting_power_t rgb_matrix_power;
+static RGB              rgb_matrix_power_colors[DRIVER_LED_TOTAL];  // as they were set, before scaling
 
-void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) { rgb_matrix_driver.set_color_all(red, green, blue); }
+static void rgb_matrix_power_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    // The drivers ignore LEDs they do not have, indicator code can rely on that
+    if (index < 0 || index >= DRIVER_LED_TOTAL) return;
 
-void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
-#ifndef RGB_MATRIX_SPLIT
-    if (!is_keyboard_master()) return;
+    RGB *color = &rgb_matrix_power_colors[index];
+    lighting_power_change(&rgb_matrix_power, color->r + color->g + color->b, red + green + blue);
+    *color = (RGB){.r = red, .g = green, .b = blue};
+}
 #endif
-#if RGB_DISABLE_TIMEOUT > 0
-    rgb_anykey_timer = 0;
-#endif  // RGB_DISABLE_TIMEOUT > 0
-
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t led[LED_HITS_TO_REMEMBER];
-    uint8_t led_count = 0;
-
-#    if defined(RGB_MATRIX_KEYRELEASES)
-    if (!pressed)
-#    elif defined(RGB_MATRIX_KEYPRESSES)
-    if (pressed)
-#    endif  // defined(RGB_MATRIX_KEYRELEASES)
-    {
-        led_count = rgb_matrix_map_row_column_to_led(row, col, led);
+
+void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+    uint32_t scale = rgb_matrix_power.scale;
+    lighting_power_frame(&rgb_matrix_power);
+    if (rgb_matrix_power.scale != scale) {
+        // Sets every LED again at the new scale, so the frame is within the budget when it is shown
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            RGB color = rgb_matrix_power_colors[i];
+            rgb_matrix_driver.set_color(i, lighting_power_scale8(&rgb_matrix_power, color.r), lighting_power_scale8(&rgb_matrix_power, color.g), lighting_power_scale8(&rgb_matrix_power, color.b));
+        }
     }
+#endif
+    rgb_matrix_driver.flush();
+}
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);  // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count--;
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+    rgb_matrix_power_set_color(index, red, green, blue);
+    red   = lighting_power_scale8(&rgb_matrix_power, red);
+    green = lighting_power_scale8(&rgb_matrix_power, green);
+    blue  = lighting_power_scale8(&rgb_matrix_power, blue);
+#endif
+    rgb_matrix_driver.set_color(index, red, green, blue);
+}
+
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        rgb_matrix_power_set_color(i, red, green, blue);
     }
+    red   = lighting_power_scale8(&rgb_matrix_power, red);
+    green = lighting_power_scale8(&rgb_matrix_power, green);
+    blue  = lighting_power_scale8(&rgb_matrix_power, blue);
+#endif
+    rgb_matrix_driver.set_color_all(red, green, blue);
+}
+
+void rgb_matrix_set_hsv(int index, HSV hsv) {
+#ifdef RGB_MATRIX_HSV_BATCH
+    rgb_hsv_buffer[index] = hsv;
+    rgb_hsv_pending[index / 8] |= 1 << (index % 8);
+#else
+    RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+    rgb_matrix_set_color(index, rgb.r, rgb.g, rgb.b);
+#endif
+}
 
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+// Converts the LEDs set with rgb_matrix_set_hsv, in runs of consecutive ones
+void rgb_matrix_flush_hsv(void) {
+#ifdef RGB_MATRIX_HSV_BATCH
+    RGB      rgb[16];
+    uint16_t i = 0;
+    while (i < DRIVER_LED_TOTAL) {
+        if (!rgb_hsv_pending[i / 8]) {
+            i = (i / 8 + 1) * 8;
+            continue;
+        }
+        if (!(rgb_hsv_pending[i / 8] & (1 << (i % 8)))) {
+            i++;
+            continue;
+        }
+
+        uint8_t start = i;
+        while (i < DRIVER_LED_TOTAL && i - start < sizeof(rgb) / sizeof(rgb[0]) && (rgb_hsv_pending[i / 8] & (1 << (i % 8)))) {
+            i++;
+        }
+        rgb_matrix_hsv_to_rgb_batch(&rgb_hsv_buffer[start], rgb, i - start);
+        for (uint8_t j = start; j < i; j++) {
+            rgb_matrix_set_color(j, rgb[j - start].r, rgb[j - start].g, rgb[j - start].b);
+        }
     }
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
+    memset(rgb_hsv_pending, 0, sizeof(rgb_hsv_pending));
+#endif
+}
+
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
+#ifndef RGB_MATRIX_SPLIT
+    if (!is_keyboard_master()) return;
+#endif
+    lighting_process(row, col, pressed);
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && !defined(DISABLE_RGB_MATRIX_TYPING_HEATMAP)
     if (rgb_matrix_config.mode == RGB_MATRIX_TYPING_HEATMAP) {
@@ -263,79 +364,29 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
-static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_DISABLE_TIMEOUT > 0
-    uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif  // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_DISABLE_TIMEOUT > 0
-    rgb_timer_buffer = sync_timer_read32();
-
-    // Update double buffer timers
-#if RGB_DISABLE_TIMEOUT > 0
-    if (rgb_anykey_timer < UINT32_MAX) {
-        if (UINT32_MAX - deltaTime < rgb_anykey_timer) {
-            rgb_anykey_timer = UINT32_MAX;
-        } else {
-            rgb_anykey_timer += deltaTime;
-        }
-    }
-#endif  // RGB_DISABLE_TIMEOUT > 0
-
-    // Update double buffer last hit timers
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
-}
-
-static void rgb_task_sync(void) {
-    // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
-}
-
-static void rgb_task_start(void) {
-    // reset iter
-    rgb_effect_params.iter = 0;
-
-    // update double buffers
-    g_rgb_timer = rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    rgb_task_state = RENDERING;
-}
-
-static void rgb_task_render(uint8_t effect) {
-    bool rendering         = false;
-    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+static bool lighting_render_effect(uint8_t effect, effect_params_t *params) {
+    bool rendering = false;
 
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
         case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
+            rendering = rgb_matrix_none(params);
             break;
 
 // ---------------------------------------------
 // -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
+#define RGB_MATRIX_EFFECT(name, ...) \
+    case RGB_MATRIX_##name:          \
+        rendering = name(params);    \
         break;
 #include "rgb_matrix_animations/rgb_matrix_effects.inc"
 #undef RGB_MATRIX_EFFECT
 
 #if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
+#    define RGB_MATRIX_EFFECT(name, ...) \
+        case RGB_MATRIX_CUSTOM_##name:   \
+            rendering = name(params);    \
             break;
 #    ifdef RGB_MATRIX_CUSTOM_KB
 #        include "rgb_matrix_kb.inc"
@@ -347,74 +398,22 @@ static void rgb_task_render(uint8_t effect) {
 #endif
             // -----End rgb effect switch case macros-------
             // ---------------------------------------------
-
-        // Factory default magic value
-        case UINT8_MAX: {
-            rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
     }
+    return rendering;
+}
 
-    rgb_effect_params.iter++;
+static void lighting_render_done(void) { rgb_matrix_flush_hsv(); }
 
-    // next task
-    if (!rendering) {
-        rgb_task_state = FLUSHING;
-        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
-            // We only need to flush once if we are RGB_MATRIX_NONE
-            rgb_task_state = SYNCING;
-        }
-    }
+static void lighting_indicators(effect_params_t *params) {
+    rgb_matrix_indicators();
+    rgb_matrix_indicators_advanced(params);
 }
 
-static void rgb_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    rgb_last_effect = effect;
-    rgb_last_enable = rgb_matrix_config.enable;
+static void lighting_update_pwm_buffers(void) { rgb_matrix_update_pwm_buffers(); }
 
-    // update pwm buffers
-    rgb_matrix_update_pwm_buffers();
+static uint8_t lighting_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) { return rgb_matrix_map_row_column_to_led(row, column, led_i); }
 
-    // next task
-    rgb_task_state = SYNCING;
-}
-
-void rgb_matrix_task(void) {
-    rgb_task_timers();
-
-    // Ideally we would also stop sending zeros to the LED driver PWM buffers
-    // while suspended and just do a software shutdown. This is a cheap hack for now.
-    bool suspend_backlight =
-#if RGB_DISABLE_WHEN_USB_SUSPENDED == true
-        g_suspend_state ||
-#endif  // RGB_DISABLE_WHEN_USB_SUSPENDED == true
-#if RGB_DISABLE_TIMEOUT > 0
-        (rgb_anykey_timer > (uint32_t)RGB_DISABLE_TIMEOUT) ||
-#endif  // RGB_DISABLE_TIMEOUT > 0
-        false;
-
-    uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
-
-    switch (rgb_task_state) {
-        case STARTING:
-            rgb_task_start();
-            break;
-        case RENDERING:
-            rgb_task_render(effect);
-            if (effect) {
-                rgb_matrix_indicators();
-                rgb_matrix_indicators_advanced(&rgb_effect_params);
-            }
-            break;
-        case FLUSHING:
-            rgb_task_flush(effect);
-            break;
-        case SYNCING:
-            rgb_task_sync();
-            break;
-    }
-}
+void rgb_matrix_task(void) { lighting_task(); }
 
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
@@ -426,21 +425,9 @@ __attribute__((weak)) void rgb_matrix_indicators_kb(void) {}
 __attribute__((weak)) void rgb_matrix_indicators_user(void) {}
 
 void rgb_matrix_indicators_advanced(effect_params_t *params) {
-    /* special handling is needed for "params->iter", since it's already been incremented.
-     * Could move the invocations to rgb_task_render, but then it's missing a few checks
-     * and not sure which would be better. Otherwise, this should be called from
-     * rgb_task_render, right before the iter++ line.
-     */
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
-    uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
-    uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
-#else
-    uint8_t min = 0;
-    uint8_t max = DRIVER_LED_TOTAL;
-#endif
-    rgb_matrix_indicators_advanced_kb(min, max);
-    rgb_matrix_indicators_advanced_user(min, max);
+    // the LEDs the effect just rendered
+    rgb_matrix_indicators_advanced_kb(params->led_min, params->led_max);
+    rgb_matrix_indicators_advanced_user(params->led_min, params->led_max);
 }
 
 __attribute__((weak)) void rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max) {}
@@ -449,18 +436,12 @@ __attribute__((weak)) void rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+    lighting_power_init(&rgb_matrix_power, DRIVER_LED_TOTAL, RGB_MATRIX_POWER_BUDGET_MA, true);
+    memset(rgb_matrix_power_colors, 0, sizeof(rgb_matrix_power_colors));
+#endif
 
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
+    lighting_init();
 
     if (!eeconfig_is_enabled()) {
         dprintf("rgb_matrix_init_drivers eeconfig is not enabled.\n");
@@ -487,7 +468,7 @@ bool rgb_matrix_get_suspend_state(void) { return g_suspend_state; }
 
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     rgb_matrix_config.enable ^= 1;
-    rgb_task_state = STARTING;
+    lighting_task_state = STARTING;
     if (write_to_eeprom) {
         eeconfig_update_rgb_matrix();
     }
@@ -502,7 +483,7 @@ void rgb_matrix_enable(void) {
 }
 
 void rgb_matrix_enable_noeeprom(void) {
-    if (!rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (!rgb_matrix_config.enable) lighting_task_state = STARTING;
     rgb_matrix_config.enable = 1;
 }
 
@@ -512,7 +493,7 @@ void rgb_matrix_disable(void) {
 }
 
 void rgb_matrix_disable_noeeprom(void) {
-    if (rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (rgb_matrix_config.enable) lighting_task_state = STARTING;
     rgb_matrix_config.enable = 0;
 }
 
@@ -529,7 +510,7 @@ void rgb_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     } else {
         rgb_matrix_config.mode = mode;
     }
-    rgb_task_state = STARTING;
+    lighting_task_state = STARTING;
     if (write_to_eeprom) {
         eeconfig_update_rgb_matrix();
     }
@@ -618,6 +599,18 @@ void rgb_matrix_decrease_speed_helper(bool write_to_eeprom) { rgb_matrix_set_spe
 void rgb_matrix_decrease_speed_noeeprom(void) { rgb_matrix_decrease_speed_helper(false); }
 void rgb_matrix_decrease_speed(void) { rgb_matrix_decrease_speed_helper(true); }
 
-led_flags_t rgb_matrix_get_flags(void) { return rgb_effect_params.flags; }
+led_flags_t rgb_matrix_get_flags(void) { return lighting_effect_params.flags; }
+
+void rgb_matrix_set_flags(led_flags_t flags) { lighting_effect_params.flags = flags; }
+
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+rgb_render_stats_t rgb_matrix_get_render_stats(void) { return lighting_render_stats; }
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
+
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+void rgb_matrix_set_power_budget(uint16_t budget_ma) { rgb_matrix_power.budget_ma = budget_ma; }
+
+uint16_t rgb_matrix_get_power_budget(void) { return rgb_matrix_power.budget_ma; }
 
-void rgb_matrix_set_flags(led_flags_t flags) { rgb_effect_params.flags = flags; }
+uint16_t rgb_matrix_get_power_draw_ma(void) { return lighting_power_draw_ma(&rgb_matrix_power); }
+#endif  // RGB_MATRIX_POWER_BUDGET_MA
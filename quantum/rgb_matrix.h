@@ -25,6 +25,14 @@
 #include "quantum.h"
 #include "rgblight_list.h"
 
+#ifdef LIGHTING_KEYFRAMES_ENABLED
+#    include "lighting_keyframes.h"
+#endif
+
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+#    include "lighting_power.h"
+#endif
+
 #ifdef IS31FL3731
 #    include "is31fl3731.h"
 #elif defined(IS31FL3733)
@@ -45,7 +53,40 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+// Effects set HSV colors into a frame buffer that is converted to RGB in one go after each render
+// iteration. It takes 3 bytes of RAM per LED, so AVR boards have to ask for it.
+#if !defined(__AVR__) && !defined(RGB_MATRIX_DISABLE_HSV_BATCH) && !defined(RGB_MATRIX_HSV_BATCH)
+#    define RGB_MATRIX_HSV_BATCH
+#endif
+
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+#    ifndef RGB_MATRIX_RENDER_BACKOFF_BUDGET_US
+#        define RGB_MATRIX_RENDER_BACKOFF_BUDGET_US (RGB_MATRIX_RENDER_BUDGET_US / 4)
+#    endif
+#    ifndef RGB_MATRIX_RENDER_BACKOFF_MS
+#        define RGB_MATRIX_RENDER_BACKOFF_MS 50
+#    endif
+// A free running 32-bit counter and how fast it counts. Only the differences are used, so
+// wrapping around is fine.
+#    if defined(RGB_MATRIX_RENDER_TIMER_US)
+#        define RGB_MATRIX_RENDER_TIMER() RGB_MATRIX_RENDER_TIMER_US()
+#        define RGB_MATRIX_RENDER_TIMER_PER_US 1
+#    elif !defined(RGB_MATRIX_RENDER_TIMER)
+#        if defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT == TRUE && defined(STM32_SYSCLK)
+#            define RGB_MATRIX_RENDER_TIMER() chSysGetRealtimeCounterX()
+#            define RGB_MATRIX_RENDER_TIMER_PER_US (STM32_SYSCLK / 1000000)
+#        else
+#            error "RGB_MATRIX_RENDER_BUDGET_US needs a microsecond timer, define RGB_MATRIX_RENDER_TIMER_US() for this board"
+#        endif
+#    endif
+#endif
+
+#if defined(RGB_MATRIX_RENDER_BUDGET_US)
+// The render scheduler picks the LEDs for each iteration
+#    define RGB_MATRIX_USE_LIMITS(min, max) \
+        uint8_t min = params->led_min;      \
+        uint8_t max = params->led_max;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
 #    define RGB_MATRIX_USE_LIMITS(min, max)                        \
         uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
         uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;          \
@@ -64,6 +105,40 @@
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+// The effects shared with LED Matrix, see lighting_matrix_animations/
+#define LIGHTING_EFFECT(name) RGB_MATRIX_EFFECT(name)
+
+#ifdef DISABLE_RGB_MATRIX_BAND_VAL
+#    define DISABLE_LIGHTING_BAND_VAL
+#endif
+#ifdef DISABLE_RGB_MATRIX_BAND_PINWHEEL_VAL
+#    define DISABLE_LIGHTING_BAND_PINWHEEL_VAL
+#endif
+#ifdef DISABLE_RGB_MATRIX_BAND_SPIRAL_VAL
+#    define DISABLE_LIGHTING_BAND_SPIRAL_VAL
+#endif
+#ifdef DISABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_SIMPLE
+#endif
+#ifdef DISABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_WIDE
+#endif
+#ifdef DISABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_MULTIWIDE
+#endif
+#ifdef DISABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_CROSS
+#endif
+#ifdef DISABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
+#    define DISABLE_LIGHTING_SOLID_REACTIVE_MULTICROSS
+#endif
+#ifdef DISABLE_RGB_MATRIX_SOLID_SPLASH
+#    define DISABLE_LIGHTING_SOLID_SPLASH
+#endif
+#ifdef DISABLE_RGB_MATRIX_SOLID_MULTISPLASH
+#    define DISABLE_LIGHTING_SOLID_MULTISPLASH
+#endif
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -94,10 +169,14 @@ void eeconfig_update_rgb_matrix(void);
 
 uint8_t rgb_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i);
 uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i);
+bool    rgb_matrix_map_led_to_row_column(uint8_t led, uint8_t *row, uint8_t *column);
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+void rgb_matrix_set_hsv(int index, HSV hsv);
+void rgb_matrix_flush_hsv(void);
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
@@ -157,6 +236,14 @@ void        rgb_matrix_decrease_speed(void);
 void        rgb_matrix_decrease_speed_noeeprom(void);
 led_flags_t rgb_matrix_get_flags(void);
 void        rgb_matrix_set_flags(led_flags_t flags);
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+rgb_render_stats_t rgb_matrix_get_render_stats(void);
+#endif
+#ifdef RGB_MATRIX_POWER_BUDGET_MA
+void     rgb_matrix_set_power_budget(uint16_t budget_ma);
+uint16_t rgb_matrix_get_power_budget(void);
+uint16_t rgb_matrix_get_power_draw_ma(void);
+#endif
 
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_update_rgb_matrix
@@ -224,4 +311,5 @@ extern last_hit_t g_last_hit_tracker;
 #endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
+extern uint8_t g_rgb_led_buffer[DRIVER_LED_TOTAL];
 #endif
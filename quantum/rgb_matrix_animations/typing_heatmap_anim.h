@@ -6,80 +6,78 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #            define RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS 25
 #        endif
 
-void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
-    uint8_t m_row = row - 1;
-    uint8_t p_row = row + 1;
-    uint8_t m_col = col - 1;
-    uint8_t p_col = col + 1;
+// Distance from a pressed key over which its neighbors heat up
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SPREAD
+#            define RGB_MATRIX_TYPING_HEATMAP_SPREAD 40
+#        endif
 
-    if (m_col < col) g_rgb_frame_buffer[row][m_col] = qadd8(g_rgb_frame_buffer[row][m_col], 16);
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
-    if (p_col < MATRIX_COLS) g_rgb_frame_buffer[row][p_col] = qadd8(g_rgb_frame_buffer[row][p_col], 16);
+// Most a neighbor heats up by, the pressed key itself heats up by 32
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
+#            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
+#        endif
 
-    if (p_row < MATRIX_ROWS) {
-        if (m_col < col) g_rgb_frame_buffer[p_row][m_col] = qadd8(g_rgb_frame_buffer[p_row][m_col], 13);
-        g_rgb_frame_buffer[p_row][col] = qadd8(g_rgb_frame_buffer[p_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[p_row][p_col] = qadd8(g_rgb_frame_buffer[p_row][p_col], 13);
+static void typing_heatmap_add(uint8_t hit) {
+    point_t point = g_led_config.point[hit];
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        uint8_t dx = point.x > g_led_config.point[i].x ? point.x - g_led_config.point[i].x : g_led_config.point[i].x - point.x;
+        uint8_t dy = point.y > g_led_config.point[i].y ? point.y - g_led_config.point[i].y : g_led_config.point[i].y - point.y;
+        if (dx > RGB_MATRIX_TYPING_HEATMAP_SPREAD || dy > RGB_MATRIX_TYPING_HEATMAP_SPREAD) continue;
+
+        uint8_t amount;
+        if (i == hit) {
+            amount = 32;
+        } else {
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist > RGB_MATRIX_TYPING_HEATMAP_SPREAD) continue;
+            amount = RGB_MATRIX_TYPING_HEATMAP_SPREAD - dist;
+            if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+        }
+        g_rgb_led_buffer[i] = qadd8(g_rgb_led_buffer[i], amount);
     }
+}
 
-    if (m_row < row) {
-        if (m_col < col) g_rgb_frame_buffer[m_row][m_col] = qadd8(g_rgb_frame_buffer[m_row][m_col], 13);
-        g_rgb_frame_buffer[m_row][col] = qadd8(g_rgb_frame_buffer[m_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[m_row][p_col] = qadd8(g_rgb_frame_buffer[m_row][p_col], 13);
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    uint8_t led[LED_HITS_TO_REMEMBER];
+    uint8_t led_count = rgb_matrix_map_row_column_to_led(row, col, led);
+    for (uint8_t i = 0; i < led_count; i++) {
+        typing_heatmap_add(led[i]);
     }
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
+// The time the heatmap values were last decreased up to, in steps of the delay.
+static uint32_t heatmap_decrease_timer;
+// How much to decrease the heatmap values by during this update.
+static uint8_t heatmap_decrease;
 
 bool TYPING_HEATMAP(effect_params_t* params) {
-    // Modified version of RGB_MATRIX_USE_LIMITS to work off of matrix row / col size
-    uint8_t led_min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;
-    uint8_t led_max = led_min + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (led_max > sizeof(g_rgb_frame_buffer)) led_max = sizeof(g_rgb_frame_buffer);
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
-        memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        memset(g_rgb_led_buffer, 0, sizeof g_rgb_led_buffer);
+        heatmap_decrease_timer = g_rgb_timer;
     }
 
     // The heatmap animation might run in several iterations depending on
     // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
+    // timer when the animation starts. The values go down by one for every
+    // delay that passed, however often the frames come.
     if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
-
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
-        }
+        uint32_t steps = (g_rgb_timer - heatmap_decrease_timer) / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+        heatmap_decrease_timer += steps * RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+        heatmap_decrease = steps > UINT8_MAX ? UINT8_MAX : steps;
     }
 
     // Render heatmap & decrease
-    for (int i = led_min; i < led_max; i++) {
-        uint8_t row = i % MATRIX_ROWS;
-        uint8_t col = i / MATRIX_ROWS;
-        uint8_t val = g_rgb_frame_buffer[row][col];
-
-        // set the pixel colour
-        uint8_t led[LED_HITS_TO_REMEMBER];
-        uint8_t led_count = rgb_matrix_map_row_column_to_led(row, col, led);
-        for (uint8_t j = 0; j < led_count; ++j) {
-            if (!HAS_ANY_FLAGS(g_led_config.flags[led[j]], params->flags)) continue;
-
-            HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-            RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-            rgb_matrix_set_color(led[j], rgb.r, rgb.g, rgb.b);
-        }
+    for (uint8_t i = led_min; i < led_max; i++) {
+        uint8_t val         = g_rgb_led_buffer[i];
+        g_rgb_led_buffer[i] = qsub8(val, heatmap_decrease);
+        RGB_MATRIX_TEST_LED_FLAGS();
 
-        if (decrease_heatmap_values) {
-            g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-        }
+        HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        rgb_matrix_set_hsv(i, hsv);
     }
-
-    return led_max < sizeof(g_rgb_frame_buffer);
+    return led_max < DRIVER_LED_TOTAL;
 }
 
 #    endif  // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
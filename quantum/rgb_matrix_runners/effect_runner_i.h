@@ -1,15 +0,0 @@
-#pragma once
-
-typedef HSV (*i_f)(HSV hsv, uint8_t i, uint8_t time);
-
-bool effect_runner_i(effect_params_t* params, i_f effect_func) {
-    RGB_MATRIX_USE_LIMITS(led_min, led_max);
-
-    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 4);
-    for (uint8_t i = led_min; i < led_max; i++) {
-        RGB_MATRIX_TEST_LED_FLAGS();
-        RGB rgb = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, i, time));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
-    }
-    return led_max < DRIVER_LED_TOTAL;
-}
@@ -132,6 +132,20 @@ LED_TYPE led[RGBLED_NUM];
 #    define LED_ARRAY led
 #endif
 
+#ifndef RGBLIGHT_CUSTOM_DRIVER
+#    ifndef RGBLIGHT_DISABLE_PARTIAL_UPDATES
+// The LEDs as last sent to the driver, in strip order and converted to RGBW. It takes another
+// RGBLED_NUM * sizeof(LED_TYPE) bytes of RAM: led[] can not stand in for it, as the effects write
+// led[] directly and it is mapped, scaled and converted on the way out.
+static LED_TYPE led_out[RGBLED_NUM];
+#    endif
+static bool led_out_stale = true;  // send every LED next time, whether it changed or not
+#endif
+
+#ifdef RGBLIGHT_POWER_BUDGET_MA
+static lighting_power_t rgblight_power;
+#endif
+
 #ifdef RGBLIGHT_LAYERS
 rgblight_segment_t const *const *rgblight_layers = NULL;
 #endif
@@ -141,6 +155,21 @@ rgblight_ranges_t rgblight_ranges = {0, RGBLED_NUM, 0, RGBLED_NUM, RGBLED_NUM};
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.clipping_start_pos = start_pos;
     rgblight_ranges.clipping_num_leds  = num_leds;
+#ifndef RGBLIGHT_CUSTOM_DRIVER
+    led_out_stale = true;
+#endif
+}
+
+/** \brief Sends every LED to the driver
+ *
+ * rgblight_set() only sends the LEDs that changed, so call this when the strip may have lost what it
+ * was sent, such as after it was powered down.
+ */
+void rgblight_refresh(void) {
+#ifndef RGBLIGHT_CUSTOM_DRIVER
+    led_out_stale = true;
+#endif
+    rgblight_set();
 }
 
 void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds) {
@@ -248,6 +277,10 @@ void rgblight_init(void) {
 
     eeconfig_debug_rgblight();  // display current eeprom values
 
+#ifdef RGBLIGHT_POWER_BUDGET_MA
+    lighting_power_init(&rgblight_power, rgblight_ranges.clipping_num_leds, RGBLIGHT_POWER_BUDGET_MA, true);
+#endif
+
     rgblight_timer_init();  // setup the timer
 
     if (rgblight_config.enable) {
@@ -775,6 +808,8 @@ void rgblight_wakeup(void) {
         rgblight_set();
     }
 #    endif
+    // the strip may have been powered down while suspended
+    rgblight_refresh();
 
     rgblight_timer_enable();
 }
@@ -785,9 +820,22 @@ __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num
 
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
+/** \brief Sends the LEDs to the driver
+ *
+ * Only the LEDs that changed since the last call are mapped and converted, and the driver is sent
+ * the strip up to the last of them. The LEDs are on a chain, which keeps what it was last sent past
+ * that. Define RGBLIGHT_DISABLE_PARTIAL_UPDATES to send the whole strip every time, for drivers
+ * that need it.
+ */
 void rgblight_set(void) {
-    LED_TYPE *start_led;
-    uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
+#    ifdef RGBLIGHT_DISABLE_PARTIAL_UPDATES
+    // Built on the stack and sent whole, nothing is kept between calls
+    LED_TYPE led_out[RGBLED_NUM];
+    led_out_stale = true;
+#    endif
+    LED_TYPE *start_led = led_out + rgblight_ranges.clipping_start_pos;
+    uint8_t   num_leds  = rgblight_ranges.clipping_num_leds;
+    uint8_t   dirty_end = 0;
 
     if (!rgblight_config.enable) {
         for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
@@ -812,25 +860,62 @@ void rgblight_set(void) {
     }
 #    endif
 
-#    ifdef RGBLIGHT_LED_MAP
-    LED_TYPE led0[RGBLED_NUM];
-    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
-        led0[i] = led[pgm_read_byte(&led_map[i])];
+#    ifdef RGBLIGHT_POWER_BUDGET_MA
+    // The whole strip is walked below anyway, so the load is summed rather than kept per LED
+    rgblight_power.load = 0;
+    rgblight_power.leds = num_leds;
+    for (uint8_t i = 0; i < num_leds; i++) {
+#        ifdef RGBLIGHT_LED_MAP
+        LED_TYPE *color = &led[pgm_read_byte(&led_map[rgblight_ranges.clipping_start_pos + i])];
+#        else
+        LED_TYPE *color = &led[rgblight_ranges.clipping_start_pos + i];
+#        endif
+        rgblight_power.load += color->r + color->g + color->b;
     }
-    start_led = led0 + rgblight_ranges.clipping_start_pos;
-#    else
-    start_led = led + rgblight_ranges.clipping_start_pos;
+    lighting_power_frame(&rgblight_power);
 #    endif
 
-#    ifdef RGBW
     for (uint8_t i = 0; i < num_leds; i++) {
-        convert_rgb_to_rgbw(&start_led[i]);
-    }
+#    ifdef RGBLIGHT_LED_MAP
+        LED_TYPE color = led[pgm_read_byte(&led_map[rgblight_ranges.clipping_start_pos + i])];
+#    else
+        LED_TYPE color = led[rgblight_ranges.clipping_start_pos + i];
+#    endif
+#    ifdef RGBLIGHT_POWER_BUDGET_MA
+        color.r = lighting_power_scale8(&rgblight_power, color.r);
+        color.g = lighting_power_scale8(&rgblight_power, color.g);
+        color.b = lighting_power_scale8(&rgblight_power, color.b);
 #    endif
-    rgblight_call_driver(start_led, num_leds);
+#    ifdef RGBW
+        convert_rgb_to_rgbw(&color);
+#    endif
+        if (led_out_stale || memcmp(&color, &start_led[i], sizeof(LED_TYPE)) != 0) {
+            start_led[i] = color;
+            dirty_end    = i + 1;
+        }
+    }
+
+    if (led_out_stale) {
+        dirty_end     = num_leds;
+        led_out_stale = false;
+    }
+    if (dirty_end > 0) {
+        rgblight_call_driver(start_led, dirty_end);
+    }
 }
 #endif
 
+#ifdef RGBLIGHT_POWER_BUDGET_MA
+void rgblight_set_power_budget(uint16_t budget_ma) {
+    rgblight_power.budget_ma = budget_ma;
+    rgblight_set();
+}
+
+uint16_t rgblight_get_power_budget(void) { return rgblight_power.budget_ma; }
+
+uint16_t rgblight_get_power_draw_ma(void) { return lighting_power_draw_ma(&rgblight_power); }
+#endif
+
 #ifdef RGBLIGHT_SPLIT
 /* for split keyboard master side */
 uint8_t rgblight_get_change_flags(void) { return rgblight_status.change_flags; }
@@ -1048,6 +1133,13 @@ void rgblight_task(void) {
 #    ifdef RGBLIGHT_LAYER_BLINK
     rgblight_unblink_layers();
 #    endif
+
+#    ifdef RGBLIGHT_POWER_BUDGET_MA
+    // Static modes do not send the LEDs again by themselves
+    if (lighting_power_releasing(&rgblight_power) && timer_elapsed(rgblight_power.timer) >= RGBLIGHT_POWER_INTERVAL) {
+        rgblight_set();
+    }
+#    endif
 }
 
 #endif /* RGBLIGHT_USE_TIMER */
@@ -101,6 +101,14 @@
 #    define RGBLIGHT_USE_TIMER
 #endif
 
+// The power limit brings the brightness back up from rgblight_task()
+#ifdef RGBLIGHT_POWER_BUDGET_MA
+#    ifdef RGBLIGHT_CUSTOM_DRIVER
+#        error "RGBLIGHT_POWER_BUDGET_MA needs rgblight to send the LEDs, it does not work with RGBLIGHT_CUSTOM_DRIVER"
+#    endif
+#    define RGBLIGHT_USE_TIMER
+#endif
+
 // clang-format on
 
 #define _RGBM_SINGLE_STATIC(sym) RGBLIGHT_MODE_##sym,
@@ -169,6 +177,9 @@ enum RGBLIGHT_EFFECT_MODE {
 #    ifndef RGBLIGHT_LIMIT_VAL
 #        define RGBLIGHT_LIMIT_VAL 255
 #    endif
+#    ifndef RGBLIGHT_POWER_INTERVAL
+#        define RGBLIGHT_POWER_INTERVAL 16
+#    endif
 
 #    define RGBLED_TIMER_TOP F_CPU / (256 * 64)
 // #define RGBLED_TIMER_TOP 0xFF10
@@ -179,6 +190,9 @@ enum RGBLIGHT_EFFECT_MODE {
 #    include "ws2812.h"
 #    include "color.h"
 #    include "rgblight_list.h"
+#    ifdef RGBLIGHT_POWER_BUDGET_MA
+#        include "lighting_power.h"
+#    endif
 
 #    if defined(__AVR__)
 #        include <avr/pgmspace.h>
@@ -284,8 +298,16 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, LED_TYPE *led1);
 
 /* === Low level Functions === */
 void rgblight_set(void);
+void rgblight_refresh(void);
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
 
+#    ifdef RGBLIGHT_POWER_BUDGET_MA
+/*   power limit */
+void     rgblight_set_power_budget(uint16_t budget_ma);
+uint16_t rgblight_get_power_budget(void);
+uint16_t rgblight_get_power_draw_ma(void);
+#    endif
+
 /* === Effects and Animations Functions === */
 /*   effect range setting */
 void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds);
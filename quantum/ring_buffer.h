@@ -1,44 +1,143 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
 #pragma once
 
-#include <util/atomic.h>
+/*
+ * Lock-free single producer, single consumer ring buffer.
+ *
+ * One side (typically an interrupt handler) only ever pushes and the other side only ever pops.
+ * The head index is only written by the producer and the tail index only by the consumer, and
+ * each is published with release semantics after the data it covers, so neither side needs to
+ * disable interrupts. The indices are 8 bit, which every supported MCU reads and writes
+ * atomically, so a ring holds at most 256 slots. One slot is kept free to tell a full ring from
+ * an empty one. The size has to be a power of two so wrapping is a mask.
+ *
+ * RING_BUFFER_DEFINE(name, type, size) defines the ring type name_t and these functions:
+ *
+ *   Producer side:
+ *     bool    name_push(name_t *ring, type item)
+ *     uint8_t name_push_bulk(name_t *ring, const type *items, uint8_t count)
+ *     uint8_t name_free(name_t *ring)
+ *
+ *   Consumer side:
+ *     bool    name_pop(name_t *ring, type *item)
+ *     bool    name_peek(name_t *ring, type *item)
+ *     bool    name_peek_at(name_t *ring, uint8_t index, type *item)
+ *     uint8_t name_pop_bulk(name_t *ring, type *items, uint8_t count)
+ *     uint8_t name_count(name_t *ring)
+ *     bool    name_empty(name_t *ring)
+ *     void    name_clear(name_t *ring)
+ *
+ *   Either side, before the other one is running:
+ *     void    name_init(name_t *ring)
+ *
+ * A zero initialised ring is empty, so static rings do not need name_init().
+ */
+
 #include <stdint.h>
 #include <stdbool.h>
 
-#ifndef RBUF_SIZE
-#    define RBUF_SIZE 32
+typedef struct {
+    uint8_t head;  // next slot to write, owned by the producer
+    uint8_t tail;  // next slot to read, owned by the consumer
+} ring_buffer_index_t;
+
+// number of slots the consumer may read
+static inline uint8_t ring_buffer_readable(ring_buffer_index_t *idx, uint8_t mask) { return (uint8_t)(__atomic_load_n(&idx->head, __ATOMIC_ACQUIRE) - idx->tail) & mask; }
+
+// number of slots the producer may write
+static inline uint8_t ring_buffer_writable(ring_buffer_index_t *idx, uint8_t mask) { return mask - ((uint8_t)(idx->head - __atomic_load_n(&idx->tail, __ATOMIC_ACQUIRE)) & mask); }
+
+// publish count written slots to the consumer
+static inline void ring_buffer_commit_write(ring_buffer_index_t *idx, uint8_t mask, uint8_t count) { __atomic_store_n(&idx->head, (uint8_t)(idx->head + count) & mask, __ATOMIC_RELEASE); }
+
+// hand count read slots back to the producer
+static inline void ring_buffer_commit_read(ring_buffer_index_t *idx, uint8_t mask, uint8_t count) { __atomic_store_n(&idx->tail, (uint8_t)(idx->tail + count) & mask, __ATOMIC_RELEASE); }
+
+// drop everything the consumer has not read yet
+static inline void ring_buffer_discard(ring_buffer_index_t *idx) { __atomic_store_n(&idx->tail, __atomic_load_n(&idx->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE); }
+
+#ifdef __cplusplus
+#    define RING_BUFFER_STATIC_ASSERT static_assert
+#else
+#    define RING_BUFFER_STATIC_ASSERT _Static_assert
 #endif
 
-static uint8_t     rbuf[RBUF_SIZE];
-static uint8_t     rbuf_head = 0;
-static uint8_t     rbuf_tail = 0;
-static inline bool rbuf_enqueue(uint8_t data) {
-    bool ret = false;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        uint8_t next = (rbuf_head + 1) % RBUF_SIZE;
-        if (next != rbuf_tail) {
-            rbuf[rbuf_head] = data;
-            rbuf_head       = next;
-            ret             = true;
-        }
+#define RING_BUFFER_DEFINE(name, type, size)                                                                                               \
+    RING_BUFFER_STATIC_ASSERT((size) >= 2 && (size) <= 256 && ((size) & ((size)-1)) == 0, #name " size must be a power of two up to 256"); \
+                                                                                                                                           \
+    typedef struct {                                                                                                                       \
+        ring_buffer_index_t idx;                                                                                                           \
+        type                buf[size];                                                                                                     \
+    } name##_t;                                                                                                                            \
+                                                                                                                                           \
+    static inline void name##_init(name##_t *ring) { ring->idx.head = ring->idx.tail = 0; }                                                \
+                                                                                                                                           \
+    static inline uint8_t name##_count(name##_t *ring) { return ring_buffer_readable(&ring->idx, (size)-1); }                              \
+                                                                                                                                           \
+    static inline bool name##_empty(name##_t *ring) { return name##_count(ring) == 0; }                                                    \
+                                                                                                                                           \
+    static inline uint8_t name##_free(name##_t *ring) { return ring_buffer_writable(&ring->idx, (size)-1); }                               \
+                                                                                                                                           \
+    static inline void name##_clear(name##_t *ring) { ring_buffer_discard(&ring->idx); }                                                   \
+                                                                                                                                           \
+    static inline bool name##_push(name##_t *ring, type item) {                                                                            \
+        if (!ring_buffer_writable(&ring->idx, (size)-1)) return false;                                                                     \
+        ring->buf[ring->idx.head] = item;                                                                                                  \
+        ring_buffer_commit_write(&ring->idx, (size)-1, 1);                                                                                 \
+        return true;                                                                                                                       \
+    }                                                                                                                                      \
+                                                                                                                                           \
+    static inline bool name##_peek(name##_t *ring, type *item) {                                                                           \
+        if (!ring_buffer_readable(&ring->idx, (size)-1)) return false;                                                                     \
+        *item = ring->buf[ring->idx.tail];                                                                                                 \
+        return true;                                                                                                                       \
+    }                                                                                                                                      \
+                                                                                                                                           \
+    static inline bool name##_peek_at(name##_t *ring, uint8_t index, type *item) {                                                         \
+        if (index >= ring_buffer_readable(&ring->idx, (size)-1)) return false;                                                             \
+        *item = ring->buf[(uint8_t)(ring->idx.tail + index) & ((size)-1)];                                                                 \
+        return true;                                                                                                                       \
+    }                                                                                                                                      \
+                                                                                                                                           \
+    static inline bool name##_pop(name##_t *ring, type *item) {                                                                            \
+        if (!name##_peek(ring, item)) return false;                                                                                        \
+        ring_buffer_commit_read(&ring->idx, (size)-1, 1);                                                                                  \
+        return true;                                                                                                                       \
+    }                                                                                                                                      \
+                                                                                                                                           \
+    static inline uint8_t name##_push_bulk(name##_t *ring, const type *items, uint8_t count) {                                             \
+        uint8_t room = ring_buffer_writable(&ring->idx, (size)-1);                                                                         \
+        uint8_t head = ring->idx.head;                                                                                                     \
+        if (count > room) count = room;                                                                                                    \
+        for (uint8_t i = 0; i < count; i++) {                                                                                              \
+            ring->buf[(uint8_t)(head + i) & ((size)-1)] = items[i];                                                                        \
+        }                                                                                                                                  \
+        ring_buffer_commit_write(&ring->idx, (size)-1, count);                                                                             \
+        return count;                                                                                                                      \
+    }                                                                                                                                      \
+                                                                                                                                           \
+    static inline uint8_t name##_pop_bulk(name##_t *ring, type *items, uint8_t count) {                                                    \
+        uint8_t avail = ring_buffer_readable(&ring->idx, (size)-1);                                                                        \
+        uint8_t tail  = ring->idx.tail;                                                                                                    \
+        if (count > avail) count = avail;                                                                                                  \
+        for (uint8_t i = 0; i < count; i++) {                                                                                              \
+            items[i] = ring->buf[(uint8_t)(tail + i) & ((size)-1)];                                                                        \
+        }                                                                                                                                  \
+        ring_buffer_commit_read(&ring->idx, (size)-1, count);                                                                              \
+        return count;                                                                                                                      \
     }
-    return ret;
-}
-static inline uint8_t rbuf_dequeue(void) {
-    uint8_t val = 0;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        if (rbuf_head != rbuf_tail) {
-            val       = rbuf[rbuf_tail];
-            rbuf_tail = (rbuf_tail + 1) % RBUF_SIZE;
-        }
-    }
-
-    return val;
-}
-static inline bool rbuf_has_data(void) {
-    bool has_data;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { has_data = (rbuf_head != rbuf_tail); }
-    return has_data;
-}
-static inline void rbuf_clear(void) {
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { rbuf_head = rbuf_tail = 0; }
-}
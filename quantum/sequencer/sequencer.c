@@ -32,17 +32,20 @@ sequencer_config_t sequencer_config = {
     SQ_RES_4,  // resolution
 };
 
-sequencer_state_t sequencer_internal_state = {0, 0, 0, 0, SEQUENCER_PHASE_ATTACK};
+sequencer_state_t sequencer_internal_state = {0, 0, 0, 0, false};
+
+static sequencer_stats_t sequencer_stats;
 
 bool is_sequencer_on(void) { return sequencer_config.enabled; }
 
 void sequencer_on(void) {
     dprintln("sequencer on");
-    sequencer_config.enabled               = true;
-    sequencer_internal_state.current_track = 0;
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.timer         = timer_read();
-    sequencer_internal_state.phase         = SEQUENCER_PHASE_ATTACK;
+    sequencer_config.enabled              = true;
+    sequencer_internal_state.current_step = 0;
+    sequencer_internal_state.next_step    = 0;
+    sequencer_internal_state.timer        = timer_read();
+    sequencer_internal_state.queued       = false;
+    sequencer_clear_stats();
 }
 
 void sequencer_off(void) {
@@ -161,54 +164,29 @@ void sequencer_decrease_resolution(void) { sequencer_set_resolution(sequencer_co
 
 uint8_t sequencer_get_current_step(void) { return sequencer_internal_state.current_step; }
 
-void sequencer_phase_attack(void) {
-    dprintf("sequencer: step %d\n", sequencer_internal_state.current_step);
-    dprintf("sequencer: time %d\n", timer_read());
+const sequencer_stats_t *sequencer_get_stats(void) { return &sequencer_stats; }
 
-    if (sequencer_internal_state.current_track == 0) {
-        sequencer_internal_state.timer = timer_read();
-    }
+void sequencer_clear_stats(void) { sequencer_stats = (sequencer_stats_t){0}; }
 
-    if (timer_elapsed(sequencer_internal_state.timer) < sequencer_internal_state.current_track * SEQUENCER_TRACK_THROTTLE) {
-        return;
-    }
+static void sequencer_queue_step(uint8_t step, uint16_t deadline) {
+    dprintf("sequencer: step %d at %u\n", step, deadline);
 
 #if defined(MIDI_ENABLE) || defined(MIDI_MOCKED)
-    if (is_sequencer_step_on_for_track(sequencer_internal_state.current_step, sequencer_internal_state.current_track)) {
-        process_midi_basic_noteon(midi_compute_note(sequencer_config.track_notes[sequencer_internal_state.current_track]));
-    }
-#endif
-
-    if (sequencer_internal_state.current_track < SEQUENCER_TRACKS - 1) {
-        sequencer_internal_state.current_track++;
-    } else {
-        sequencer_internal_state.phase = SEQUENCER_PHASE_RELEASE;
-    }
-}
+    for (uint8_t track = 0; track < SEQUENCER_TRACKS; track++) {
+        if (!is_sequencer_step_on_for_track(step, track)) {
+            continue;
+        }
 
-void sequencer_phase_release(void) {
-    if (timer_elapsed(sequencer_internal_state.timer) < SEQUENCER_PHASE_RELEASE_TIMEOUT + sequencer_internal_state.current_track * SEQUENCER_TRACK_THROTTLE) {
-        return;
-    }
-#if defined(MIDI_ENABLE) || defined(MIDI_MOCKED)
-    if (is_sequencer_step_on_for_track(sequencer_internal_state.current_step, sequencer_internal_state.current_track)) {
-        process_midi_basic_noteoff(midi_compute_note(sequencer_config.track_notes[sequencer_internal_state.current_track]));
+        uint16_t note   = midi_compute_note(sequencer_config.track_notes[track]);
+        uint16_t attack = deadline + track * SEQUENCER_TRACK_THROTTLE;
+        if (!process_midi_basic_noteon_at(note, attack)) {
+            sequencer_stats.dropped++;
+        }
+        if (!process_midi_basic_noteoff_at(note, attack + SEQUENCER_PHASE_RELEASE_TIMEOUT)) {
+            sequencer_stats.dropped++;
+        }
     }
 #endif
-    if (sequencer_internal_state.current_track > 0) {
-        sequencer_internal_state.current_track--;
-    } else {
-        sequencer_internal_state.phase = SEQUENCER_PHASE_PAUSE;
-    }
-}
-
-void sequencer_phase_pause(void) {
-    if (timer_elapsed(sequencer_internal_state.timer) < sequencer_get_step_duration()) {
-        return;
-    }
-
-    sequencer_internal_state.current_step = (sequencer_internal_state.current_step + 1) % SEQUENCER_STEPS;
-    sequencer_internal_state.phase        = SEQUENCER_PHASE_ATTACK;
 }
 
 void matrix_scan_sequencer(void) {
@@ -216,16 +194,45 @@ void matrix_scan_sequencer(void) {
         return;
     }
 
-    if (sequencer_internal_state.phase == SEQUENCER_PHASE_PAUSE) {
-        sequencer_phase_pause();
-    }
+    uint16_t now      = timer_read();
+    uint16_t duration = sequencer_get_step_duration();
+
+    while (true) {
+        if (!sequencer_internal_state.queued) {
+            int16_t lateness = (int16_t)(now - sequencer_internal_state.timer);
+            if (lateness < -SEQUENCER_LOOKAHEAD) {
+                break;
+            }
+
+            if (lateness >= (int16_t)duration) {
+                // Too late to play anything but the current step, keep the sequence on the beat
+                uint16_t missed = lateness / duration;
+                sequencer_stats.missed += missed;
+                sequencer_internal_state.next_step = (sequencer_internal_state.next_step + missed) % SEQUENCER_STEPS;
+                sequencer_internal_state.timer += missed * duration;
+                continue;
+            }
+
+            sequencer_queue_step(sequencer_internal_state.next_step, sequencer_internal_state.timer);
+            sequencer_internal_state.queued = true;
+            sequencer_stats.steps++;
+            if (lateness > 0) {
+                sequencer_stats.late++;
+                sequencer_stats.total_lateness += lateness;
+                if (lateness > sequencer_stats.max_lateness) {
+                    sequencer_stats.max_lateness = lateness;
+                }
+            }
+        }
 
-    if (sequencer_internal_state.phase == SEQUENCER_PHASE_RELEASE) {
-        sequencer_phase_release();
-    }
+        if (!timer_expired(now, sequencer_internal_state.timer)) {
+            break;
+        }
 
-    if (sequencer_internal_state.phase == SEQUENCER_PHASE_ATTACK) {
-        sequencer_phase_attack();
+        sequencer_internal_state.current_step = sequencer_internal_state.next_step;
+        sequencer_internal_state.next_step    = (sequencer_internal_state.next_step + 1) % SEQUENCER_STEPS;
+        sequencer_internal_state.timer += duration;
+        sequencer_internal_state.queued = false;
     }
 }
 
@@ -38,6 +38,11 @@
 #    define SEQUENCER_PHASE_RELEASE_TIMEOUT 30
 #endif
 
+// How long before its deadline the MIDI events of a step are queued (ms)
+#ifndef SEQUENCER_LOOKAHEAD
+#    define SEQUENCER_LOOKAHEAD 20
+#endif
+
 /**
  * Make sure that the items of this enumeration follow the powers of 2, separated by a ternary variant.
  * Check the implementation of `get_step_duration` for further explanation.
@@ -53,23 +58,40 @@ typedef struct {
 } sequencer_config_t;
 
 /**
- * Because Digital Audio Workstations get overwhelmed when too many MIDI signals are sent concurrently,
- * We use a "phase" state machine to delay some of the events.
+ * Steps are played from deadlines rather than from the time the scan loop gets around to them:
+ * the deadline of each step is the one of the previous step plus the step duration, so a slow scan
+ * loop cannot make the sequence drift.
+ *
+ * SEQUENCER_LOOKAHEAD ms before its deadline, all the MIDI events of a step are queued with the time
+ * they are due:
+ *  - t=track * SEQUENCER_TRACK_THROTTLE ms, the note on signal of the track,
+ *  - t=SEQUENCER_PHASE_RELEASE_TIMEOUT + track * SEQUENCER_TRACK_THROTTLE ms, its note off signal.
+ * The tracks are spread out because Digital Audio Workstations get overwhelmed when too many MIDI
+ * signals are sent concurrently.
+ * The queued events are sent by midi_task() from the scan loop, on the first scan after they are
+ * due, so a note can still be late by up to the length of a scan.
+ *
+ * A step queued after its deadline is played right away and counted as late. When the scan loop
+ * falls more than a whole step behind, the steps it missed are skipped so the sequence stays on the
+ * beat.
  */
-typedef enum sequencer_phase_t {
-    SEQUENCER_PHASE_ATTACK,   // t=0ms, send the MIDI note on signal
-    SEQUENCER_PHASE_RELEASE,  // t=SEQUENCER_PHASE_RELEASE_TIMEOUT ms, send the MIDI note off signal
-    SEQUENCER_PHASE_PAUSE     // t=step duration ms, loop
-} sequencer_phase_t;
-
 typedef struct {
-    uint8_t           active_tracks;
-    uint8_t           current_track;
-    uint8_t           current_step;
-    uint16_t          timer;
-    sequencer_phase_t phase;
+    uint8_t  active_tracks;
+    uint8_t  current_step;  // step being played
+    uint8_t  next_step;     // step to queue next
+    uint16_t timer;         // deadline of next_step
+    bool     queued;        // next_step is queued and waiting for its deadline
 } sequencer_state_t;
 
+typedef struct {
+    uint16_t steps;           // steps queued
+    uint16_t late;            // steps queued after their deadline
+    uint16_t missed;          // steps skipped because the scan loop fell a whole step behind
+    uint16_t dropped;         // note events the MIDI output had no room for
+    uint16_t max_lateness;    // longest time a step was queued after its deadline (ms)
+    uint32_t total_lateness;  // sum of the lateness of the late steps (ms)
+} sequencer_stats_t;
+
 extern sequencer_config_t sequencer_config;
 
 // We expose the internal state to make the feature more "unit-testable"
@@ -113,6 +135,9 @@ void                   sequencer_decrease_resolution(void);
 
 uint8_t sequencer_get_current_step(void);
 
+const sequencer_stats_t *sequencer_get_stats(void);
+void                     sequencer_clear_stats(void);
+
 uint16_t sequencer_get_beat_duration(void);
 uint16_t sequencer_get_step_duration(void);
 
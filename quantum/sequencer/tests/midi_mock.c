@@ -19,8 +19,29 @@
 uint16_t last_noteon  = 0;
 uint16_t last_noteoff = 0;
 
+midi_mock_event_t midi_mock_events[MIDI_MOCK_EVENTS];
+uint8_t           midi_mock_event_count = 0;
+
 uint16_t midi_compute_note(uint16_t keycode) { return keycode; }
 
 void process_midi_basic_noteon(uint16_t note) { last_noteon = note; }
 
 void process_midi_basic_noteoff(uint16_t note) { last_noteoff = note; }
+
+static bool midi_mock_schedule(uint16_t note, uint16_t time, bool on) {
+    if (midi_mock_event_count == MIDI_MOCK_EVENTS) {
+        return false;
+    }
+    midi_mock_events[midi_mock_event_count++] = (midi_mock_event_t){note, time, on};
+    return true;
+}
+
+bool process_midi_basic_noteon_at(uint16_t note, uint16_t time) {
+    last_noteon = note;
+    return midi_mock_schedule(note, time, true);
+}
+
+bool process_midi_basic_noteoff_at(uint16_t note, uint16_t time) {
+    last_noteoff = note;
+    return midi_mock_schedule(note, time, false);
+}
@@ -16,11 +16,26 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#define MIDI_MOCK_EVENTS 64
+
+typedef struct {
+    uint16_t note;
+    uint16_t time;
+    bool     on;
+} midi_mock_event_t;
+
 extern uint16_t last_noteon;
 extern uint16_t last_noteoff;
 
+// Events scheduled with process_midi_basic_note*_at(), in the order they were scheduled
+extern midi_mock_event_t midi_mock_events[MIDI_MOCK_EVENTS];
+extern uint8_t           midi_mock_event_count;
+
 uint16_t midi_compute_note(uint16_t keycode);
 void     process_midi_basic_noteon(uint16_t note);
 void     process_midi_basic_noteoff(uint16_t note);
+bool     process_midi_basic_noteon_at(uint16_t note, uint16_t time);
+bool     process_midi_basic_noteoff_at(uint16_t note, uint16_t time);
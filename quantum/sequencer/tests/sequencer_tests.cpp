@@ -15,6 +15,7 @@
  */
 
 #include "gtest/gtest.h"
+#include <vector>
 
 extern "C" {
 #include "sequencer.h"
@@ -44,12 +45,14 @@ class SequencerTest : public ::testing::Test {
         config_copy.resolution = sequencer_config.resolution;
 
         state_copy.active_tracks = sequencer_internal_state.active_tracks;
-        state_copy.current_track = sequencer_internal_state.current_track;
         state_copy.current_step  = sequencer_internal_state.current_step;
+        state_copy.next_step     = sequencer_internal_state.next_step;
         state_copy.timer         = sequencer_internal_state.timer;
+        state_copy.queued        = sequencer_internal_state.queued;
 
-        last_noteon  = 0;
-        last_noteoff = 0;
+        last_noteon           = 0;
+        last_noteoff          = 0;
+        midi_mock_event_count = 0;
 
         set_time(0);
     }
@@ -69,13 +72,33 @@ class SequencerTest : public ::testing::Test {
         sequencer_config.resolution = config_copy.resolution;
 
         sequencer_internal_state.active_tracks = state_copy.active_tracks;
-        sequencer_internal_state.current_track = state_copy.current_track;
         sequencer_internal_state.current_step  = state_copy.current_step;
+        sequencer_internal_state.next_step     = state_copy.next_step;
         sequencer_internal_state.timer         = state_copy.timer;
+        sequencer_internal_state.queued        = state_copy.queued;
     }
 
-    sequencer_config_t config_copy;
-    sequencer_state_t  state_copy;
+    // Scans at the given time and returns the note on events scheduled by that scan, all the
+    // events scheduled so far are kept in events
+    std::vector<midi_mock_event_t> scanAt(uint32_t time) {
+        std::vector<midi_mock_event_t> noteons;
+
+        set_time(time);
+        matrix_scan_sequencer();
+        for (uint8_t i = 0; i < midi_mock_event_count; i++) {
+            events.push_back(midi_mock_events[i]);
+            if (midi_mock_events[i].on) {
+                noteons.push_back(midi_mock_events[i]);
+            }
+        }
+        midi_mock_event_count = 0;
+
+        return noteons;
+    }
+
+    sequencer_config_t             config_copy;
+    sequencer_state_t              state_copy;
+    std::vector<midi_mock_event_t> events;
 };
 
 TEST_F(SequencerTest, TestOffByDefault) { EXPECT_EQ(is_sequencer_on(), false); }
@@ -364,7 +387,6 @@ TEST_F(SequencerTest, TestGetStepDuration120) {
 }
 
 void setUpMatrixScanSequencerTest(void) {
-    sequencer_config.enabled    = true;
     sequencer_config.tempo      = 120;
     sequencer_config.resolution = SQ_RES_16;
 
@@ -381,210 +403,275 @@ void setUpMatrixScanSequencerTest(void) {
     // Turn on some steps
     sequencer_config.steps[0] = (1 << 0);
     sequencer_config.steps[2] = (1 << 1) + (1 << 0);
+
+    // Start playing at t=0
+    sequencer_on();
 }
 
+// One 16th at tempo=120 lasts 125ms
+#define STEP_DURATION 125
+
 TEST_F(SequencerTest, TestMatrixScanSequencerShouldAttackFirstTrackOfFirstStep) {
     setUpMatrixScanSequencerTest();
 
     matrix_scan_sequencer();
     EXPECT_EQ(last_noteon, MI_C);
-    EXPECT_EQ(last_noteoff, 0);
+    ASSERT_EQ(midi_mock_event_count, 2);
+    EXPECT_EQ(midi_mock_events[0].note, MI_C);
+    EXPECT_EQ(midi_mock_events[0].time, 0);
+    EXPECT_TRUE(midi_mock_events[0].on);
+    EXPECT_EQ(sequencer_internal_state.current_step, 0);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldAttackSecondTrackAfterFirstTrackOfFirstStep) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldQueueReleaseAfterTimeout) {
     setUpMatrixScanSequencerTest();
 
     matrix_scan_sequencer();
-    EXPECT_EQ(sequencer_internal_state.current_step, 0);
-    EXPECT_EQ(sequencer_internal_state.current_track, 1);
-    EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_ATTACK);
+    EXPECT_EQ(last_noteoff, MI_C);
+    ASSERT_EQ(midi_mock_event_count, 2);
+    EXPECT_EQ(midi_mock_events[1].note, MI_C);
+    EXPECT_EQ(midi_mock_events[1].time, SEQUENCER_PHASE_RELEASE_TIMEOUT);
+    EXPECT_FALSE(midi_mock_events[1].on);
 }
 
 TEST_F(SequencerTest, TestMatrixScanSequencerShouldNotAttackInactiveTrackFirstStep) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = 1;
-
-    // Wait some time after the first track has been attacked
-    advance_time(SEQUENCER_TRACK_THROTTLE);
-
-    matrix_scan_sequencer();
-    EXPECT_EQ(last_noteon, 0);
-    EXPECT_EQ(last_noteoff, 0);
+    scanAt(0);
+    scanAt(SEQUENCER_TRACKS * SEQUENCER_TRACK_THROTTLE + SEQUENCER_PHASE_RELEASE_TIMEOUT);
+    ASSERT_EQ(events.size(), 2);
+    for (auto event : events) {
+        EXPECT_EQ(event.note, MI_C);
+    }
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldAttackThirdTrackAfterSecondTrackOfFirstStep) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldThrottleTracks) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = 1;
+    sequencer_internal_state.next_step = 2;
 
-    // Wait some time after the second track has been attacked
-    advance_time(2 * SEQUENCER_TRACK_THROTTLE);
-
-    matrix_scan_sequencer();
-    EXPECT_EQ(sequencer_internal_state.current_step, 0);
-    EXPECT_EQ(sequencer_internal_state.current_track, 2);
-    EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_ATTACK);
+    std::vector<midi_mock_event_t> noteons = scanAt(0);
+    ASSERT_EQ(noteons.size(), 2);
+    EXPECT_EQ(noteons[0].note, MI_C);
+    EXPECT_EQ(noteons[0].time, 0);
+    EXPECT_EQ(noteons[1].note, MI_D);
+    EXPECT_EQ(noteons[1].time, SEQUENCER_TRACK_THROTTLE);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldEnterReleasePhaseAfterLastTrackHasBeenProcessedFirstStep) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldReleaseEveryTrackAfterTimeout) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = SEQUENCER_TRACKS - 1;
-
-    // Wait until all notes have been attacked
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-
-    matrix_scan_sequencer();
-    EXPECT_EQ(last_noteon, 0);
-    EXPECT_EQ(last_noteoff, 0);
-    EXPECT_EQ(sequencer_internal_state.current_step, 0);
-    EXPECT_EQ(sequencer_internal_state.current_track, SEQUENCER_TRACKS - 1);
-    EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_RELEASE);
+    sequencer_config.steps[0] = 0xFF;
+
+    scanAt(0);
+    ASSERT_EQ(events.size(), 2 * SEQUENCER_TRACKS);
+    for (uint8_t track = 0; track < SEQUENCER_TRACKS; track++) {
+        midi_mock_event_t noteon  = events[2 * track];
+        midi_mock_event_t noteoff = events[2 * track + 1];
+        EXPECT_TRUE(noteon.on);
+        EXPECT_FALSE(noteoff.on);
+        EXPECT_EQ(noteon.note, sequencer_config.track_notes[track]);
+        EXPECT_EQ(noteoff.note, sequencer_config.track_notes[track]);
+        EXPECT_EQ(noteon.time, track * SEQUENCER_TRACK_THROTTLE);
+        EXPECT_EQ(noteoff.time, track * SEQUENCER_TRACK_THROTTLE + SEQUENCER_PHASE_RELEASE_TIMEOUT);
+    }
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldReleaseBackwards) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldQueueNextStepWithinLookahead) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = SEQUENCER_TRACKS - 1;
-    sequencer_internal_state.phase         = SEQUENCER_PHASE_RELEASE;
+    sequencer_config.steps[1] = (1 << 0);
 
-    // Wait until all notes have been attacked
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the release timeout
-    advance_time(SEQUENCER_PHASE_RELEASE_TIMEOUT);
+    scanAt(0);
+    EXPECT_EQ(scanAt(STEP_DURATION - SEQUENCER_LOOKAHEAD - 1).size(), 0);
 
-    matrix_scan_sequencer();
+    std::vector<midi_mock_event_t> noteons = scanAt(STEP_DURATION - SEQUENCER_LOOKAHEAD);
+    ASSERT_EQ(noteons.size(), 1);
+    EXPECT_EQ(noteons[0].time, STEP_DURATION);
+    EXPECT_EQ(sequencer_internal_state.current_step, 0);
+
+    // The step is only current once it plays
+    scanAt(STEP_DURATION - 1);
     EXPECT_EQ(sequencer_internal_state.current_step, 0);
-    EXPECT_EQ(sequencer_internal_state.current_track, SEQUENCER_TRACKS - 2);
-    EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_RELEASE);
+    EXPECT_EQ(scanAt(STEP_DURATION).size(), 0);
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldNotReleaseInactiveTrackFirstStep) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldProcessSecondStepAfterStepDuration) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = SEQUENCER_TRACKS - 1;
-    sequencer_internal_state.phase         = SEQUENCER_PHASE_RELEASE;
+    scanAt(0);
+    EXPECT_EQ(sequencer_internal_state.current_step, 0);
+
+    scanAt(STEP_DURATION);
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
 
-    // Wait until all notes have been attacked
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the release timeout
-    advance_time(SEQUENCER_PHASE_RELEASE_TIMEOUT);
+    // Step 2 is queued ahead of its deadline
+    scanAt(2 * STEP_DURATION - SEQUENCER_LOOKAHEAD);
+    EXPECT_EQ(sequencer_internal_state.current_step, 1);
+    EXPECT_EQ(scanAt(2 * STEP_DURATION).size(), 0);
+    EXPECT_EQ(sequencer_internal_state.current_step, 2);
 
-    matrix_scan_sequencer();
-    EXPECT_EQ(last_noteon, 0);
-    EXPECT_EQ(last_noteoff, 0);
+    ASSERT_EQ(events.size(), 6);
+    EXPECT_EQ(events[2].note, MI_C);
+    EXPECT_EQ(events[2].time, 2 * STEP_DURATION);
+    EXPECT_EQ(events[4].note, MI_D);
+    EXPECT_EQ(events[4].time, 2 * STEP_DURATION + SEQUENCER_TRACK_THROTTLE);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldReleaseFirstTrackFirstStep) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldLoopOnceSequenceIsOver) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = 0;
-    sequencer_internal_state.phase         = SEQUENCER_PHASE_RELEASE;
+    sequencer_internal_state.next_step = SEQUENCER_STEPS - 1;
 
-    // Wait until all notes have been attacked
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the release timeout
-    advance_time(SEQUENCER_PHASE_RELEASE_TIMEOUT);
-    // + all the other notes have been released
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
+    scanAt(0);
+    EXPECT_EQ(sequencer_internal_state.current_step, SEQUENCER_STEPS - 1);
 
-    matrix_scan_sequencer();
-    EXPECT_EQ(last_noteon, 0);
-    EXPECT_EQ(last_noteoff, MI_C);
+    std::vector<midi_mock_event_t> noteons = scanAt(STEP_DURATION);
+    EXPECT_EQ(sequencer_internal_state.current_step, 0);
+    ASSERT_EQ(noteons.size(), 1);
+    EXPECT_EQ(noteons[0].note, MI_C);
+    EXPECT_EQ(noteons[0].time, STEP_DURATION);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldEnterPausePhaseAfterRelease) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldNotDriftWithSlowScans) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = 0;
-    sequencer_internal_state.phase         = SEQUENCER_PHASE_RELEASE;
+    for (uint8_t step = 0; step < SEQUENCER_STEPS; step++) {
+        sequencer_config.steps[step] = (1 << 0);
+    }
 
-    // Wait until all notes have been attacked
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the release timeout
-    advance_time(SEQUENCER_PHASE_RELEASE_TIMEOUT);
-    // + all the other notes have been released
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
+    // A scan every 7ms never lands on a deadline, but it is always within the lookahead
+    std::vector<midi_mock_event_t> noteons;
+    for (uint32_t time = 0; time < 64 * STEP_DURATION; time += 7) {
+        for (auto noteon : scanAt(time)) {
+            noteons.push_back(noteon);
+        }
+    }
 
-    matrix_scan_sequencer();
-    EXPECT_EQ(sequencer_internal_state.current_step, 0);
-    EXPECT_EQ(sequencer_internal_state.current_track, 0);
-    EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_PAUSE);
+    ASSERT_GE(noteons.size(), 64);
+    for (uint16_t i = 0; i < noteons.size(); i++) {
+        EXPECT_EQ(noteons[i].time, i * STEP_DURATION);
+    }
+    EXPECT_EQ(sequencer_get_stats()->late, 0);
+    EXPECT_EQ(sequencer_get_stats()->missed, 0);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldProcessFirstTrackOfSecondStepAfterPause) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldPlayLateStepRightAway) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 0;
-    sequencer_internal_state.current_track = 0;
-    sequencer_internal_state.phase         = SEQUENCER_PHASE_PAUSE;
+    sequencer_config.steps[1] = (1 << 0);
 
-    // Wait until all notes have been attacked
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the release timeout
-    advance_time(SEQUENCER_PHASE_RELEASE_TIMEOUT);
-    // + all the other notes have been released
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the step duration (one 16th at tempo=120 lasts 125ms)
-    advance_time(125);
+    for (uint32_t time = 0; time < 100; time++) {
+        scanAt(time);
+    }
+    EXPECT_EQ(events.size(), 2);
 
-    matrix_scan_sequencer();
+    // The loop stalls from t=100 to t=140, past the lookahead and the deadline of step 1
+    std::vector<midi_mock_event_t> noteons = scanAt(140);
+    ASSERT_EQ(noteons.size(), 1);
+    EXPECT_EQ(noteons[0].time, STEP_DURATION);
     EXPECT_EQ(sequencer_internal_state.current_step, 1);
-    EXPECT_EQ(sequencer_internal_state.current_track, 1);
-    EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_ATTACK);
+
+    const sequencer_stats_t *stats = sequencer_get_stats();
+    EXPECT_EQ(stats->late, 1);
+    EXPECT_EQ(stats->max_lateness, 140 - STEP_DURATION);
+    EXPECT_EQ(stats->total_lateness, 140 - STEP_DURATION);
+    EXPECT_EQ(stats->missed, 0);
+
+    // The next step is back on time
+    noteons = scanAt(2 * STEP_DURATION - SEQUENCER_LOOKAHEAD);
+    ASSERT_EQ(noteons.size(), 2);
+    EXPECT_EQ(noteons[0].time, 2 * STEP_DURATION);
+    EXPECT_EQ(sequencer_get_stats()->late, 1);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldProcessSecondTrackTooEarly) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldSkipStepsMissedByStalledLoop) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 2;
-    sequencer_internal_state.current_track = 1;
+    sequencer_config.steps[3] = (1 << 2);
+    sequencer_config.steps[4] = (1 << 3);
+
+    scanAt(0);
+    events.clear();
 
-    matrix_scan_sequencer();
-    EXPECT_EQ(last_noteon, 0);
-    EXPECT_EQ(last_noteoff, 0);
+    // Stalled for more than two steps, steps 1 and 2 are skipped, step 3 is played late
+    std::vector<midi_mock_event_t> noteons = scanAt(3 * STEP_DURATION + 10);
+    ASSERT_EQ(noteons.size(), 1);
+    EXPECT_EQ(noteons[0].note, MI_E);
+    EXPECT_EQ(noteons[0].time, 3 * STEP_DURATION + 2 * SEQUENCER_TRACK_THROTTLE);
+    EXPECT_EQ(sequencer_internal_state.current_step, 3);
+
+    const sequencer_stats_t *stats = sequencer_get_stats();
+    EXPECT_EQ(stats->steps, 2);
+    EXPECT_EQ(stats->missed, 2);
+    EXPECT_EQ(stats->late, 1);
+    EXPECT_EQ(stats->max_lateness, 10);
+
+    // And the sequence carries on from there on the beat
+    noteons = scanAt(4 * STEP_DURATION);
+    ASSERT_EQ(noteons.size(), 1);
+    EXPECT_EQ(noteons[0].note, MI_F);
+    EXPECT_EQ(noteons[0].time, 4 * STEP_DURATION + 3 * SEQUENCER_TRACK_THROTTLE);
+    EXPECT_EQ(sequencer_internal_state.current_step, 4);
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldProcessSecondTrackOnTime) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldStayOnBeatInOverloadedLoop) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = 2;
-    sequencer_internal_state.current_track = 1;
+    for (uint8_t step = 0; step < SEQUENCER_STEPS; step++) {
+        sequencer_config.steps[step] = (1 << 0);
+    }
 
-    // Wait until first track has been attacked
-    advance_time(SEQUENCER_TRACK_THROTTLE);
+    // Scans take 1 to 40ms, as with heavy RGB or OLED work, over 20s
+    const uint32_t                 duration = 20000;
+    uint32_t                       seed     = 1;
+    uint32_t                       time     = 0;
+    uint32_t                       last     = 0;
+    uint16_t                       max_gap  = 0;
+    std::vector<midi_mock_event_t> noteons;
+    while (time < duration) {
+        for (auto noteon : scanAt(time)) {
+            noteons.push_back(noteon);
+        }
+        last         = time;
+        seed         = seed * 1103515245 + 12345;
+        uint16_t gap = 1 + (seed >> 16) % 40;
+        max_gap      = gap > max_gap ? gap : max_gap;
+        time += gap;
+    }
 
-    matrix_scan_sequencer();
-    EXPECT_EQ(last_noteon, MI_D);
-    EXPECT_EQ(last_noteoff, 0);
+    // Every step up to the lookahead of the last scan has been queued
+    const sequencer_stats_t *stats = sequencer_get_stats();
+    ASSERT_EQ(noteons.size(), stats->steps);
+    EXPECT_EQ(stats->steps, (last + SEQUENCER_LOOKAHEAD) / STEP_DURATION + 1);
+    EXPECT_EQ(stats->missed, 0);
+    EXPECT_GT(stats->late, 0);
+    EXPECT_LE(stats->max_lateness, max_gap - SEQUENCER_LOOKAHEAD);
+
+    // Every step is timestamped with its deadline, however late the loop got to it
+    for (uint16_t i = 0; i < noteons.size(); i++) {
+        EXPECT_EQ(noteons[i].time, (uint16_t)(i * STEP_DURATION));
+    }
 }
 
-TEST_F(SequencerTest, TestMatrixScanSequencerShouldLoopOnceSequenceIsOver) {
+TEST_F(SequencerTest, TestMatrixScanSequencerShouldCountDroppedEvents) {
     setUpMatrixScanSequencerTest();
 
-    sequencer_internal_state.current_step  = SEQUENCER_STEPS - 1;
-    sequencer_internal_state.current_track = 0;
-    sequencer_internal_state.phase         = SEQUENCER_PHASE_PAUSE;
+    midi_mock_event_count = MIDI_MOCK_EVENTS;
+    matrix_scan_sequencer();
+    EXPECT_EQ(sequencer_get_stats()->dropped, 2);
+    midi_mock_event_count = 0;
+}
 
-    // Wait until all notes have been attacked
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the release timeout
-    advance_time(SEQUENCER_PHASE_RELEASE_TIMEOUT);
-    // + all the other notes have been released
-    advance_time((SEQUENCER_TRACKS - 1) * SEQUENCER_TRACK_THROTTLE);
-    // + the step duration (one 16th at tempo=120 lasts 125ms)
-    advance_time(125);
+TEST_F(SequencerTest, TestSequencerOnShouldClearStats) {
+    setUpMatrixScanSequencerTest();
 
-    matrix_scan_sequencer();
-    EXPECT_EQ(sequencer_internal_state.current_step, 0);
-    EXPECT_EQ(sequencer_internal_state.current_track, 1);
-    EXPECT_EQ(sequencer_internal_state.phase, SEQUENCER_PHASE_ATTACK);
+    scanAt(STEP_DURATION / 2);
+    EXPECT_EQ(sequencer_get_stats()->steps, 1);
+    EXPECT_EQ(sequencer_get_stats()->late, 1);
+
+    sequencer_on();
+    EXPECT_EQ(sequencer_get_stats()->steps, 0);
+    EXPECT_EQ(sequencer_get_stats()->late, 0);
 }
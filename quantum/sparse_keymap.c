@@ -0,0 +1,51 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keymap.h"
+#include "progmem.h"
+
+/*
+ * Sparse keymap lookup.
+ *
+ * `qmk sparse-keymap` turns the keymaps array into three tables:
+ *   sparse_keymap_bitmaps   one bit per matrix position and layer, set if the key is not KC_TRNS
+ *   sparse_keymap_keycodes  the keycodes of all set bits, layer by layer in matrix order
+ *   sparse_keymap_offsets   for every bitmap byte, the index of its first keycode
+ *
+ * A key on layer N is transparent if its bit is clear, otherwise its keycode is found at the
+ * offset of its bitmap byte plus the number of bits set below it in that byte.
+ */
+
+#define SPARSE_KEYMAP_INDEX(key) ((uint16_t)(key).row * MATRIX_COLS + (key).col)
+
+bool keymap_key_is_transparent(uint8_t layer, keypos_t key) {
+    uint16_t index = SPARSE_KEYMAP_INDEX(key);
+    return !(pgm_read_byte(&sparse_keymap_bitmaps[layer][index / 8]) & (1 << (index % 8)));
+}
+
+// translates key to keycode
+__attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    uint16_t index = SPARSE_KEYMAP_INDEX(key);
+    uint8_t  bits  = pgm_read_byte(&sparse_keymap_bitmaps[layer][index / 8]);
+    uint8_t  mask  = 1 << (index % 8);
+
+    if (!(bits & mask)) {
+        return KC_TRNS;
+    }
+
+    uint16_t offset = pgm_read_word(&sparse_keymap_offsets[layer][index / 8]) + __builtin_popcount(bits & (mask - 1));
+    return pgm_read_word(&sparse_keymap_keycodes[offset]);
+}
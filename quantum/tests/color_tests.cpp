@@ -0,0 +1,123 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C" {
+#include "color.h"
+
+RGB hsv_to_rgb_impl(HSV hsv, bool use_cie);
+}
+
+namespace {
+
+// Every hue for one saturation and value, in the order they are converted in
+void fill_hues(HSV *hsv, uint8_t s, uint8_t v) {
+    for (int h = 0; h < 256; h++) {
+        hsv[h] = {(uint8_t)h, s, v};
+    }
+}
+
+// Compares every color, count of them at a time
+void expect_same_as_single(bool use_cie, uint8_t count) {
+    HSV hsv[256];
+    RGB rgb[256];
+    for (int s = 0; s < 256; s++) {
+        for (int v = 0; v < 256; v++) {
+            fill_hues(hsv, s, v);
+            for (int h = 0; h < 256; h += count) {
+                uint8_t n = h + count > 256 ? 256 - h : count;
+                if (use_cie) {
+                    hsv_to_rgb_batch(&hsv[h], &rgb[h], n);
+                } else {
+                    hsv_to_rgb_nocie_batch(&hsv[h], &rgb[h], n);
+                }
+            }
+            for (int h = 0; h < 256; h++) {
+                RGB expected = hsv_to_rgb_impl(hsv[h], use_cie);
+                ASSERT_EQ(rgb[h].r, expected.r) << "h " << h << " s " << s << " v " << v;
+                ASSERT_EQ(rgb[h].g, expected.g) << "h " << h << " s " << s << " v " << v;
+                ASSERT_EQ(rgb[h].b, expected.b) << "h " << h << " s " << s << " v " << v;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(Color, BatchMatchesSingleWithCie) { expect_same_as_single(true, 255); }
+
+TEST(Color, BatchMatchesSingleWithoutCie) { expect_same_as_single(false, 255); }
+
+TEST(Color, BatchOfOneMatchesSingle) { expect_same_as_single(true, 1); }
+
+TEST(Color, BatchLeavesTheRestAlone) {
+    HSV hsv[4] = {{0, 255, 255}, {85, 255, 255}, {170, 255, 255}, {0, 255, 255}};
+    RGB rgb[4] = {};
+    rgb[3].r   = 1;
+    rgb[3].g   = 2;
+    rgb[3].b   = 3;
+
+    hsv_to_rgb_nocie_batch(hsv, rgb, 3);
+    EXPECT_EQ(rgb[0].r, 255);
+    EXPECT_EQ(rgb[1].g, 255);
+    EXPECT_EQ(rgb[2].b, 255);
+    EXPECT_EQ(rgb[3].r, 1);
+    EXPECT_EQ(rgb[3].g, 2);
+    EXPECT_EQ(rgb[3].b, 3);
+
+    hsv_to_rgb_nocie_batch(hsv, rgb, 0);
+    EXPECT_EQ(rgb[0].r, 255);
+}
+
+TEST(Color, Benchmark) {
+    using clock = std::chrono::steady_clock;
+
+    // A frame of a rainbow effect: every hue, full saturation, varied value
+    std::vector<HSV> hsv(1 << 16);
+    std::vector<RGB> rgb(hsv.size());
+    for (size_t i = 0; i < hsv.size(); i++) {
+        hsv[i] = {(uint8_t)(i * 7), (uint8_t)(255 - (i >> 12)), (uint8_t)(i >> 8)};
+    }
+
+    unsigned sum   = 0;
+    auto     start = clock::now();
+    for (int r = 0; r < 20; r++) {
+        for (size_t i = 0; i < hsv.size(); i++) {
+            rgb[i] = hsv_to_rgb(hsv[i]);
+        }
+        sum += rgb[hsv.size() - 1 - r].r;
+    }
+    auto single = clock::now() - start;
+
+    start = clock::now();
+    for (int r = 0; r < 20; r++) {
+        for (size_t i = 0; i < hsv.size(); i += 16) {
+            hsv_to_rgb_batch(&hsv[i], &rgb[i], 16);
+        }
+        sum += rgb[hsv.size() - 1 - r].r;
+    }
+    auto batch = clock::now() - start;
+
+    double colors = 20.0 * hsv.size();
+    printf("%-10s %10s\n", "", "ns/color");
+    printf("%-10s %10.2f\n", "single", std::chrono::duration<double, std::nano>(single).count() / colors);
+    printf("%-10s %10.2f\n", "batch", std::chrono::duration<double, std::nano>(batch).count() / colors);
+    EXPECT_GT(sum, 0u);
+}
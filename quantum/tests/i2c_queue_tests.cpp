@@ -0,0 +1,358 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <vector>
+
+extern "C" {
+#include "i2c_master.h"
+#include "i2c_queue.h"
+#include "timer.h"
+}
+
+namespace {
+
+const uint8_t SPLIT_ADDRESS  = 0x10;
+const uint8_t EEPROM_ADDRESS = 0xA0;
+const uint8_t HAPTIC_ADDRESS = 0xB4;
+const uint8_t OLED_ADDRESS   = 0x78;
+const uint8_t ISSI_ADDRESS   = 0xE8;
+
+struct Completion {
+    i2c_status_t status;
+    int          id;
+};
+std::vector<Completion> completions;
+
+void record(i2c_status_t status, void *context) { completions.push_back({status, (int)(intptr_t)context}); }
+
+void *id(int n) { return (void *)(intptr_t)n; }
+
+}  // namespace
+
+class I2CQueue : public testing::Test {
+   public:
+    I2CQueue() {
+        i2c_fake_reset();
+        i2c_queue_clear_stats();
+        completions.clear();
+    }
+
+    ~I2CQueue() {
+        // Leave the queue empty for the next test
+        i2c_fake_stalled = false;
+        while (i2c_queue_busy()) {
+            i2c_fake_run(1000);
+            i2c_queue_task();
+        }
+    }
+
+    void run(uint32_t us) {
+        i2c_fake_run(us);
+        i2c_queue_task();
+    }
+
+    bool queue_bulk(uint8_t reg, int n) {
+        uint8_t data[16] = {0};
+        return i2c_queue_writeReg(I2C_PRIORITY_BULK, ISSI_ADDRESS, reg, data, sizeof(data), 100, record, id(n));
+    }
+
+    std::vector<uint8_t> sent_registers() {
+        std::vector<uint8_t> registers;
+        for (uint16_t i = 0; i < i2c_fake_log_count; i++) {
+            registers.push_back(i2c_fake_log[i].first);
+        }
+        return registers;
+    }
+};
+
+TEST_F(I2CQueue, QueuedTransfersRunInTheBackground) {
+    EXPECT_TRUE(queue_bulk(0x24, 0));
+    EXPECT_TRUE(queue_bulk(0x34, 1));
+    EXPECT_TRUE(queue_bulk(0x44, 2));
+
+    // Nothing waited for the bus, the first transfer is on it
+    EXPECT_EQ(i2c_fake_time(), 0);
+    EXPECT_EQ(i2c_fake_log_count, 1);
+    EXPECT_TRUE(i2c_queue_transferring());
+
+    run(5000);
+    ASSERT_EQ(i2c_fake_log_count, 3);
+    EXPECT_EQ(i2c_fake_blocked_time(), 0);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(i2c_fake_log[i].queued);
+        EXPECT_EQ(i2c_fake_log[i].tx_length, 17);
+        EXPECT_EQ(i2c_fake_log[i].end - i2c_fake_log[i].start, i2c_fake_duration(17, 0));
+    }
+    // Back to back, without waiting for the main loop
+    EXPECT_EQ(i2c_fake_log[1].start, i2c_fake_log[0].end);
+    EXPECT_EQ(i2c_fake_log[2].start, i2c_fake_log[1].end);
+
+    ASSERT_EQ(completions.size(), 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(completions[i].status, I2C_STATUS_SUCCESS);
+        EXPECT_EQ(completions[i].id, i);
+    }
+    EXPECT_FALSE(i2c_queue_busy());
+    EXPECT_EQ(i2c_queue_get_stats()->transfers[I2C_PRIORITY_BULK], 3);
+    EXPECT_EQ(i2c_queue_get_stats()->bytes, 3 * 17);
+}
+
+TEST_F(I2CQueue, CallbacksAreCalledFromTheTask) {
+    queue_bulk(0x24, 0);
+    i2c_fake_run(5000);
+    EXPECT_TRUE(completions.empty());
+    i2c_queue_task();
+    EXPECT_EQ(completions.size(), 1);
+}
+
+TEST_F(I2CQueue, HigherPriorityGoesFirst) {
+    queue_bulk(0x24, 0);
+    queue_bulk(0x34, 1);
+    queue_bulk(0x44, 2);
+    uint8_t effect = 1;
+    i2c_queue_writeReg(I2C_PRIORITY_NORMAL, HAPTIC_ADDRESS, 0x04, &effect, 1, 100, record, id(3));
+    i2c_queue_writeReg(I2C_PRIORITY_HIGH, HAPTIC_ADDRESS, 0x0C, &effect, 1, 100, record, id(4));
+    queue_bulk(0x54, 5);
+
+    run(10000);
+    // The first bulk transfer was already on the bus, the others keep their order
+    EXPECT_EQ(sent_registers(), (std::vector<uint8_t>{0x24, 0x0C, 0x04, 0x34, 0x44, 0x54}));
+    EXPECT_EQ(i2c_queue_get_stats()->transfers[I2C_PRIORITY_HIGH], 1);
+    EXPECT_EQ(i2c_queue_get_stats()->transfers[I2C_PRIORITY_NORMAL], 1);
+    EXPECT_EQ(i2c_queue_get_stats()->transfers[I2C_PRIORITY_BULK], 4);
+}
+
+TEST_F(I2CQueue, SameOrderAcrossTheSequenceWrap) {
+    for (int i = 0; i < 250; i++) {
+        queue_bulk(0, i);
+        run(1000);
+    }
+    queue_bulk(0x24, 0);
+    queue_bulk(0x34, 1);
+    queue_bulk(0x44, 2);
+    queue_bulk(0x54, 3);
+    queue_bulk(0x64, 4);
+    queue_bulk(0x74, 5);
+    queue_bulk(0x84, 6);
+    i2c_fake_log_count = 0;
+    // The first is on the bus already
+    run(5000);
+    EXPECT_EQ(sent_registers(), (std::vector<uint8_t>{0x34, 0x44, 0x54, 0x64, 0x74, 0x84}));
+}
+
+TEST_F(I2CQueue, BlockingTransferGoesAheadOfTheQueue) {
+    queue_bulk(0x24, 0);
+    queue_bulk(0x34, 1);
+    queue_bulk(0x44, 2);
+    run(100);
+
+    uint8_t data[4];
+    EXPECT_EQ(i2c_readReg(EEPROM_ADDRESS, 0x20, data, sizeof(data), 100), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(data[0], 0x20);
+    EXPECT_EQ(data[3], 0x23);
+
+    // It waited for the transfer in progress only
+    EXPECT_EQ(i2c_fake_blocked_time(), i2c_fake_duration(17, 0) - 100 + i2c_fake_duration(1, 4));
+    EXPECT_EQ(i2c_fake_log_count, 3);
+    EXPECT_FALSE(i2c_fake_log[1].queued);
+    EXPECT_EQ(i2c_fake_log[1].address, EEPROM_ADDRESS);
+
+    // The queue went on after it
+    EXPECT_TRUE(i2c_queue_transferring());
+    EXPECT_EQ(i2c_fake_log[2].start, i2c_fake_log[1].end);
+    run(5000);
+    EXPECT_EQ(sent_registers(), (std::vector<uint8_t>{0x24, 0x20, 0x34, 0x44}));
+}
+
+TEST_F(I2CQueue, QueuedReadFillsTheBuffer) {
+    uint8_t data[6] = {0};
+    EXPECT_TRUE(i2c_queue_readReg(I2C_PRIORITY_NORMAL, HAPTIC_ADDRESS, 0x00, data, sizeof(data), 100, record, id(7)));
+    run(1000);
+
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_SUCCESS);
+    EXPECT_EQ(completions[0].id, 7);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(data[i], i);
+    }
+    EXPECT_EQ(i2c_fake_log[0].tx_length, 1);
+    EXPECT_EQ(i2c_fake_log[0].rx_length, 6);
+    EXPECT_EQ(i2c_queue_get_stats()->bytes, 7);
+}
+
+TEST_F(I2CQueue, NotAcknowledgedIsAnError) {
+    i2c_fake_nack_address = OLED_ADDRESS;
+    uint8_t data[2]       = {0x00, 0xAF};
+    i2c_queue_transmit(I2C_PRIORITY_BULK, OLED_ADDRESS, data, sizeof(data), 100, record, id(0));
+    queue_bulk(0x24, 1);
+    run(5000);
+
+    ASSERT_EQ(completions.size(), 2);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_ERROR);
+    EXPECT_EQ(completions[1].status, I2C_STATUS_SUCCESS);
+    EXPECT_EQ(i2c_queue_get_stats()->errors, 1);
+    EXPECT_EQ(i2c_queue_get_stats()->transfers[I2C_PRIORITY_BULK], 1);
+}
+
+TEST_F(I2CQueue, RejectsWhenFullOrTooLarge) {
+    for (int i = 0; i < I2C_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(queue_bulk(i, i));
+    }
+    EXPECT_EQ(i2c_queue_free(), 0);
+    EXPECT_FALSE(queue_bulk(0xFF, 99));
+    EXPECT_EQ(i2c_queue_get_stats()->rejected, 1);
+
+    run(1000);
+    EXPECT_GT(i2c_queue_free(), 0);
+
+    uint8_t data[I2C_QUEUE_TRANSFER_SIZE] = {0};
+    EXPECT_TRUE(i2c_queue_transmit(I2C_PRIORITY_BULK, OLED_ADDRESS, data, I2C_QUEUE_TRANSFER_SIZE, 100, NULL, NULL));
+    EXPECT_FALSE(i2c_queue_writeReg(I2C_PRIORITY_BULK, OLED_ADDRESS, 0x40, data, I2C_QUEUE_TRANSFER_SIZE, 100, NULL, NULL));
+    EXPECT_EQ(i2c_queue_get_stats()->rejected, 2);
+}
+
+TEST_F(I2CQueue, StalledTransferTimesOut) {
+    i2c_fake_stalled = true;
+    queue_bulk(0x24, 0);
+    queue_bulk(0x34, 1);
+
+    run(50000);
+    EXPECT_TRUE(completions.empty());
+
+    run(60000);
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_TIMEOUT);
+    EXPECT_EQ(completions[0].id, 0);
+    EXPECT_EQ(i2c_queue_get_stats()->errors, 1);
+
+    // The next one went out
+    i2c_fake_stalled = false;
+    run(1000);
+    ASSERT_EQ(completions.size(), 2);
+    EXPECT_EQ(completions[1].status, I2C_STATUS_SUCCESS);
+    EXPECT_EQ(i2c_fake_log[1].first, 0x34);
+}
+
+TEST_F(I2CQueue, BlockingTransferAbortsStalledOne) {
+    i2c_fake_stalled = true;
+    queue_bulk(0x24, 0);
+    uint8_t data[2];
+    EXPECT_EQ(i2c_readReg(EEPROM_ADDRESS, 0x00, data, sizeof(data), 10), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(i2c_fake_log[0].status, I2C_STATUS_TIMEOUT);
+    run(0);
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_TIMEOUT);
+}
+
+/*
+ * A second of a split keyboard with an OLED and an IS31FL3731 on the bus, each scan taking 1ms of
+ * CPU time besides the bus. Every scan reads the other half, a fourth of them send an OLED block
+ * and a tenth of them a whole LED frame. Made with the blocking functions, and again with the OLED
+ * and LED transfers queued.
+ */
+namespace {
+
+struct Result {
+    uint32_t scans;
+    uint32_t blocked;      // us
+    uint32_t max_blocked;  // us, in one scan
+    uint32_t busy;         // us
+    uint32_t elapsed;      // us
+    uint32_t sent;         // OLED blocks and LED frames
+};
+
+Result run_keyboard(bool queued) {
+    uint8_t oled_command[7] = {0x00, 0x21, 0, 127, 0x22, 0, 3};
+    uint8_t oled_data[33]   = {0x40};
+    uint8_t leds[16]        = {0};
+    uint8_t split[8];
+    Result  result = {};
+
+    while (i2c_fake_time() < 1000000) {
+        uint32_t blocked = i2c_fake_blocked_time();
+
+        i2c_readReg(SPLIT_ADDRESS, 0x00, split, sizeof(split), 100);
+
+        if (result.scans % 4 == 0) {
+            if (!queued) {
+                i2c_transmit(OLED_ADDRESS, oled_command, sizeof(oled_command), 100);
+                i2c_transmit(OLED_ADDRESS, oled_data, sizeof(oled_data), 100);
+                result.sent++;
+            } else if (i2c_queue_free() >= 2) {
+                i2c_queue_transmit(I2C_PRIORITY_BULK, OLED_ADDRESS, oled_command, sizeof(oled_command), 100, NULL, NULL);
+                i2c_queue_transmit(I2C_PRIORITY_BULK, OLED_ADDRESS, oled_data, sizeof(oled_data), 100, NULL, NULL);
+                result.sent++;
+            }
+        }
+        if (result.scans % 10 == 0) {
+            if (!queued) {
+                for (uint8_t i = 0; i < 9; i++) {
+                    i2c_writeReg(ISSI_ADDRESS, 0x24 + i * 16, leds, sizeof(leds), 100);
+                }
+                result.sent++;
+            } else if (i2c_queue_free() >= 9) {
+                for (uint8_t i = 0; i < 9; i++) {
+                    i2c_queue_writeReg(I2C_PRIORITY_BULK, ISSI_ADDRESS, 0x24 + i * 16, leds, sizeof(leds), 100, NULL, NULL);
+                }
+                result.sent++;
+            }
+        }
+        i2c_queue_task();
+
+        blocked = i2c_fake_blocked_time() - blocked;
+        if (blocked > result.max_blocked) {
+            result.max_blocked = blocked;
+        }
+        i2c_fake_run(1000);
+        result.scans++;
+    }
+
+    result.blocked = i2c_fake_blocked_time();
+    result.busy    = i2c_fake_busy_time();
+    result.elapsed = i2c_fake_time();
+    return result;
+}
+
+void print(const char *name, const Result &result) {
+    printf("%-10s %6u %10.1f %12u %9.1f%% %6u\n", name, result.scans, (double)result.blocked / result.scans, result.max_blocked, 100.0 * result.busy / result.elapsed, result.sent);
+}
+
+}  // namespace
+
+TEST_F(I2CQueue, BusUtilisation) {
+    Result blocking = run_keyboard(false);
+    while (i2c_queue_busy()) run(1000);
+
+    i2c_fake_reset();
+    i2c_queue_clear_stats();
+    Result queued = run_keyboard(true);
+
+    printf("%-10s %6s %10s %12s %10s %6s\n", "", "scans", "blocked/us", "max blocked", "bus busy", "sent");
+    print("blocking", blocking);
+    print("queued", queued);
+
+    // The main loop only waits for the split transport, behind one transfer at most
+    EXPECT_LE(queued.max_blocked, i2c_fake_duration(sizeof(uint8_t) * 33, 0) + i2c_fake_duration(1, 8));
+    EXPECT_LT(queued.blocked / queued.scans * 2, blocking.blocked / blocking.scans);
+    EXPECT_GT(queued.scans, blocking.scans);
+
+    // Everything got sent, at a scan rate the blocking keyboard does not reach
+    EXPECT_EQ(i2c_queue_get_stats()->rejected, 0);
+    EXPECT_GE(queued.sent * 1000 / queued.scans, blocking.sent * 1000 / blocking.scans);
+    EXPECT_GT(queued.busy * 100 / queued.elapsed, blocking.busy * 100 / blocking.elapsed);
+}
@@ -0,0 +1,109 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+extern "C" {
+#include "keymap.h"
+#include "action.h"
+#include "keycode_config.h"
+
+keymap_config_t keymap_config;
+
+const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS] = {{{KC_NO}}};
+
+// The default reads fn_actions, which is empty here
+uint16_t keymap_function_id_to_action(uint16_t function_id) { return function_id ^ 0xA5A5; }
+
+uint16_t reference_keycode_config(uint16_t keycode);
+uint8_t  reference_mod_config(uint8_t mod);
+action_t reference_action_for_keycode(uint16_t keycode);
+}
+
+// Every combination of the bootmagic bits, nkro left out as it does not affect keycodes
+static const uint16_t keymap_config_bits = 0x037F;
+
+class KeycodeDecode : public ::testing::Test {
+   protected:
+    void SetUp() override { keymap_config.raw = 0; }
+};
+
+TEST_F(KeycodeDecode, AllKeycodesMatchReference) {
+    const uint16_t configs[] = {0x0000, 0x0001, 0x0006, 0x0014, 0x0068, 0x0300, 0x037F};
+
+    for (uint16_t config : configs) {
+        keymap_config.raw = config;
+        for (uint32_t keycode = 0; keycode <= 0xFFFF; keycode++) {
+            ASSERT_EQ(action_for_keycode(keycode).code, reference_action_for_keycode(keycode).code) << "keycode 0x" << std::hex << keycode << " keymap_config 0x" << config;
+        }
+    }
+}
+
+TEST_F(KeycodeDecode, RemapMatchesReferenceForEveryConfig) {
+    for (uint16_t config = 0; config <= keymap_config_bits; config++) {
+        if (config & ~keymap_config_bits) continue;
+
+        keymap_config.raw = config;
+        for (uint16_t value = 0; value <= 0xFF; value++) {
+            ASSERT_EQ(keycode_config(value), reference_keycode_config(value)) << "keycode 0x" << std::hex << value << " keymap_config 0x" << config;
+            ASSERT_EQ(mod_config(value), reference_mod_config(value)) << "mods 0x" << std::hex << value << " keymap_config 0x" << config;
+        }
+    }
+}
+
+TEST_F(KeycodeDecode, RemapFollowsKeymapConfigChanges) {
+    EXPECT_EQ(keycode_config(KC_GRAVE), KC_GRAVE);
+    EXPECT_EQ(mod_config(MOD_LALT), MOD_LALT);
+
+    keymap_config.swap_grave_esc = true;
+    keymap_config.swap_lalt_lgui = true;
+    EXPECT_EQ(keycode_config(KC_GRAVE), KC_ESC);
+    EXPECT_EQ(mod_config(MOD_LALT), MOD_LGUI);
+
+    keymap_config.swap_grave_esc = false;
+    keymap_config.swap_lalt_lgui = false;
+    EXPECT_EQ(keycode_config(KC_GRAVE), KC_GRAVE);
+    EXPECT_EQ(mod_config(MOD_LALT), MOD_LALT);
+}
+
+template <typename F>
+static double ns_per_keycode(F decode) {
+    const int         rounds = 20;
+    volatile uint16_t sink   = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (uint32_t keycode = 0; keycode <= 0xFFFF; keycode++) {
+            sink = sink + decode(keycode).code;
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (rounds * 0x10000);
+}
+
+TEST_F(KeycodeDecode, Benchmark) {
+    const uint16_t configs[] = {0x0000, 0x037F};
+
+    for (uint16_t config : configs) {
+        keymap_config.raw = config;
+        double table      = ns_per_keycode(action_for_keycode);
+        double reference  = ns_per_keycode(reference_action_for_keycode);
+        std::cout << "keymap_config 0x" << std::hex << config << std::dec << std::fixed << std::setprecision(2) << ": table " << table << " ns, reference " << reference << " ns per keycode" << std::endl;
+    }
+}
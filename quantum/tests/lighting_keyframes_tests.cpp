@@ -0,0 +1,258 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C" {
+#include "lighting_keyframes.h"
+}
+
+namespace {
+
+// Renders programs the way the KEYFRAMES effect does, for a board of points
+class Renderer {
+   public:
+    explicit Renderer(std::vector<uint8_t> program, HSV base = {0, 255, 255}) : program_(program), base_(base) {}
+
+    bool valid() const { return lighting_keyframes_validate(program_.data(), program_.size()); }
+
+    void frame(uint32_t time, uint8_t speed = 127) { lighting_keyframes_frame(&frame_, program_.data(), time, speed, base_, 112, 32); }
+
+    HSV at(uint8_t x, uint8_t y, uint8_t index = 0) const { return lighting_keyframes_run(program_.data(), &frame_, x, y, index); }
+
+   private:
+    std::vector<uint8_t>       program_;
+    HSV                        base_;
+    lighting_keyframes_frame_t frame_;
+};
+
+// With a period of 256 ms at the default speed the phase is the time
+#define LK_PHASE_IS_TIME LK_TIME, LK_PERIOD(256)
+
+const std::vector<uint8_t> rainbow = {LK_VERSION, LK_PHASE_IS_TIME, LK_OFFSET, LK_SOURCE_X, 16, LK_GRADIENT, LK_HUE, 2, 0, 0, 255, 255, 255, 255, 255, 255, LK_END};
+
+// A spiral of color over a breathing glow, using every operation
+const std::vector<uint8_t> spiral = {
+    LK_VERSION,
+    LK_TIME, LK_PERIOD(3000), LK_OFFSET, LK_SOURCE_ANGLE, 16, LK_OFFSET, LK_SOURCE_DIST, (uint8_t)-8,
+    LK_GRADIENT, LK_HUE | LK_SAT, 3, 0, 0, 255, 0, 100, 85, 200, 0, 200, 170, 255, 0,
+    LK_TIME, LK_PERIOD(1500), LK_OFFSET, LK_SOURCE_INDEX, 4, LK_EASE, LK_EASE_SINE,
+    LK_GRADIENT, LK_VAL | LK_RELATIVE, 2, 0, 0, 0, 64, 255, 0, 0, 255,
+    LK_END,
+};
+
+uint32_t fnv1a(uint32_t hash, uint8_t byte) { return (hash ^ byte) * 16777619u; }
+
+}  // namespace
+
+TEST(LightingKeyframes, ValidatesPrograms) {
+    EXPECT_TRUE(Renderer(rainbow).valid());
+    EXPECT_TRUE(Renderer(spiral).valid());
+    EXPECT_TRUE(Renderer({LK_VERSION, LK_END}).valid());
+    // Trailing bytes after the end are left alone
+    EXPECT_TRUE(Renderer({LK_VERSION, LK_END, 0xFF, 0xFF}).valid());
+
+    EXPECT_FALSE(Renderer({}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION + 1, LK_END}).valid());
+    EXPECT_FALSE(Renderer({0xFF, 0xFF, 0xFF, 0xFF}).valid());
+    // No end
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_EASE, LK_EASE_LINEAR}).valid());
+    // Unknown operation, source, curve and channels
+    EXPECT_FALSE(Renderer({LK_VERSION, 0x7F, LK_END}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_OFFSET, LK_SOURCE_MAX, 16, LK_END}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_EASE, LK_EASE_MAX, LK_END}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_GRADIENT, 0, 1, 0, 0, 0, 0, LK_END}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_GRADIENT, LK_HUE | 0x40, 1, 0, 0, 0, 0, LK_END}).valid());
+    // A period of 0, and more periods than a frame keeps
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_TIME, 0, 0, LK_END}).valid());
+    std::vector<uint8_t> times = {LK_VERSION};
+    for (int i = 0; i <= LIGHTING_KEYFRAMES_MAX_TIMES; i++) {
+        times.insert(times.end(), {LK_TIME, 1, 0});
+    }
+    times.push_back(LK_END);
+    EXPECT_FALSE(Renderer(times).valid());
+    // Gradients with no keyframes, keyframes out of order, or running off the end
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_GRADIENT, LK_HUE, 0, LK_END}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_GRADIENT, LK_HUE, 2, 100, 0, 0, 0, 100, 0, 0, 0, LK_END}).valid());
+    EXPECT_FALSE(Renderer({LK_VERSION, LK_GRADIENT, LK_HUE, 2, 0, 0, 0, 0, 100, 0, 0}).valid());
+}
+
+TEST(LightingKeyframes, TimeSetsThePhase) {
+    Renderer renderer({LK_VERSION, LK_TIME, LK_PERIOD(1000), LK_GRADIENT, LK_HUE, 2, 0, 0, 0, 0, 255, 255, 0, 0, LK_END});
+
+    renderer.frame(0);
+    EXPECT_EQ(renderer.at(0, 0).h, 0);
+    renderer.frame(500);
+    EXPECT_EQ(renderer.at(0, 0).h, 128);
+    // It wraps
+    renderer.frame(10500);
+    EXPECT_EQ(renderer.at(0, 0).h, 128);
+    // Twice as fast at full speed, never still at 0
+    renderer.frame(250, 255);
+    EXPECT_EQ(renderer.at(0, 0).h, 128);
+    renderer.frame(500, 0);
+    EXPECT_EQ(renderer.at(0, 0).h, 1);
+}
+
+TEST(LightingKeyframes, GradientBlendsBetweenKeyframes) {
+    Renderer renderer({LK_VERSION, LK_PHASE_IS_TIME, LK_GRADIENT, LK_HSV, 3, 64, 10, 0, 0, 128, 30, 200, 100, 192, 250, 255, 255, LK_END});
+
+    // Before the first keyframe and after the last they hold
+    renderer.frame(0);
+    EXPECT_EQ(renderer.at(0, 0).h, 10);
+    EXPECT_EQ(renderer.at(0, 0).v, 0);
+    renderer.frame(255);
+    EXPECT_EQ(renderer.at(0, 0).h, 250);
+    EXPECT_EQ(renderer.at(0, 0).s, 255);
+    EXPECT_EQ(renderer.at(0, 0).v, 255);
+
+    // On a keyframe it is that keyframe
+    renderer.frame(128);
+    EXPECT_EQ(renderer.at(0, 0).h, 30);
+    EXPECT_EQ(renderer.at(0, 0).s, 200);
+    EXPECT_EQ(renderer.at(0, 0).v, 100);
+
+    // Half way
+    renderer.frame(96);
+    EXPECT_NEAR(renderer.at(0, 0).h, 20, 1);
+    EXPECT_NEAR(renderer.at(0, 0).s, 100, 1);
+    EXPECT_NEAR(renderer.at(0, 0).v, 50, 1);
+
+    // It never goes back
+    uint8_t last = 0;
+    for (uint32_t t = 0; t < 256; t++) {
+        renderer.frame(t);
+        EXPECT_GE(renderer.at(0, 0).v, last) << t;
+        last = renderer.at(0, 0).v;
+    }
+}
+
+TEST(LightingKeyframes, HueGoesForwardThroughRed) {
+    Renderer renderer({LK_VERSION, LK_PHASE_IS_TIME, LK_GRADIENT, LK_HUE, 2, 0, 200, 0, 0, 255, 40, 0, 0, LK_END});
+
+    renderer.frame(128);
+    EXPECT_NEAR(renderer.at(0, 0).h, 248, 1);
+}
+
+TEST(LightingKeyframes, RelativeChannelsScaleTheConfig) {
+    Renderer renderer({LK_VERSION, LK_GRADIENT, LK_HUE | LK_VAL | LK_RELATIVE, 1, 0, 16, 0, 128, LK_END}, {100, 200, 128});
+
+    renderer.frame(0);
+    HSV hsv = renderer.at(0, 0);
+    EXPECT_EQ(hsv.h, 116);
+    EXPECT_EQ(hsv.s, 200);
+    // Scaled by the program, then by the brightness of the config
+    EXPECT_NEAR(hsv.v, 64, 1);
+}
+
+TEST(LightingKeyframes, OffsetsComeFromTheLeds) {
+    Renderer renderer({LK_VERSION, LK_OFFSET, LK_SOURCE_X, 8, LK_OFFSET, LK_SOURCE_INDEX, (uint8_t)-16, LK_GRADIENT, LK_HUE, 2, 0, 0, 0, 0, 255, 255, 0, 0, LK_END});
+
+    renderer.frame(0);
+    EXPECT_EQ(renderer.at(100, 0, 0).h, 50);
+    EXPECT_EQ(renderer.at(100, 0, 10).h, 40);
+    EXPECT_EQ(renderer.at(0, 0, 10).h, 246);
+
+    Renderer center({LK_VERSION, LK_OFFSET, LK_SOURCE_DIST, 16, LK_GRADIENT, LK_HUE, 2, 0, 0, 0, 0, 255, 255, 0, 0, LK_END});
+    center.frame(0);
+    EXPECT_EQ(center.at(112, 32).h, 0);
+    EXPECT_EQ(center.at(112 + 30, 32 + 40).h, 50);
+}
+
+TEST(LightingKeyframes, EasingCurves) {
+    auto eased = [](uint8_t curve, uint8_t phase) {
+        Renderer renderer({LK_VERSION, LK_PHASE_IS_TIME, LK_EASE, curve, LK_GRADIENT, LK_HUE, 2, 0, 0, 0, 0, 255, 255, 0, 0, LK_END});
+        renderer.frame(phase);
+        return renderer.at(0, 0).h;
+    };
+
+    for (uint8_t curve : {LK_EASE_LINEAR, LK_EASE_IN, LK_EASE_OUT, LK_EASE_IN_OUT, LK_EASE_CUBIC}) {
+        EXPECT_LE(eased(curve, 0), 1) << (int)curve;
+        EXPECT_GE(eased(curve, 255), 254) << (int)curve;
+    }
+    EXPECT_EQ(eased(LK_EASE_LINEAR, 100), 100);
+    EXPECT_LT(eased(LK_EASE_IN, 64), 64);
+    EXPECT_GT(eased(LK_EASE_OUT, 64), 64);
+    EXPECT_NEAR(eased(LK_EASE_IN_OUT, 128), 128, 2);
+    // The waves go up and come back down
+    EXPECT_LE(eased(LK_EASE_SINE, 0), 2);
+    EXPECT_GE(eased(LK_EASE_SINE, 128), 253);
+    EXPECT_NEAR(eased(LK_EASE_TRIANGLE, 64), 128, 1);
+    EXPECT_GE(eased(LK_EASE_TRIANGLE, 128), 254);
+    EXPECT_LE(eased(LK_EASE_TRIANGLE, 255), 2);
+}
+
+TEST(LightingKeyframes, RainbowMatchesHandWritten) {
+    Renderer renderer(rainbow);
+    for (uint32_t time = 0; time < 2000; time += 37) {
+        renderer.frame(time);
+        for (uint8_t x = 0; x < 224; x += 7) {
+            EXPECT_EQ(renderer.at(x, 0).h, (uint8_t)(time + x));
+        }
+    }
+}
+
+// Snapshot of the spiral over a board and a few seconds, changes to how programs run show up here
+TEST(LightingKeyframes, SpiralSnapshot) {
+    Renderer renderer(spiral, {0, 255, 200});
+    uint32_t hash = 2166136261u;
+    for (uint32_t time = 0; time < 6000; time += 97) {
+        renderer.frame(time);
+        for (uint8_t y = 0; y <= 64; y += 16) {
+            for (uint8_t x = 0; x <= 224; x += 16) {
+                HSV hsv = renderer.at(x, y, x / 16 + y / 16 * 15);
+                hash    = fnv1a(fnv1a(fnv1a(hash, hsv.h), hsv.s), hsv.v);
+            }
+        }
+    }
+    EXPECT_EQ(hash, 1359323063u);
+}
+
+TEST(LightingKeyframes, Benchmark) {
+    using clock = std::chrono::steady_clock;
+
+    Renderer renderer(rainbow);
+    unsigned sum   = 0;
+    auto     start = clock::now();
+    for (uint32_t time = 0; time < 20000; time++) {
+        renderer.frame(time);
+        for (uint8_t x = 0; x < 224; x += 2) {
+            sum += renderer.at(x, 0).h;
+        }
+    }
+    auto vm = clock::now() - start;
+
+    // CYCLE_LEFT_RIGHT, the effect it stands in for
+    start = clock::now();
+    for (uint32_t time = 0; time < 20000; time++) {
+        uint8_t phase = time;
+        for (uint8_t x = 0; x < 224; x += 2) {
+            volatile uint8_t h = x + phase;
+            sum -= h;
+        }
+    }
+    auto c = clock::now() - start;
+
+    double leds = 20000.0 * 112;
+    printf("%-10s %10s\n", "", "ns/led");
+    printf("%-10s %10.2f\n", "keyframes", std::chrono::duration<double, std::nano>(vm).count() / leds);
+    printf("%-10s %10.2f\n", "c", std::chrono::duration<double, std::nano>(c).count() / leds);
+    EXPECT_EQ(sum, 0u);
+}
@@ -0,0 +1,126 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "lighting_power.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+const uint16_t white = 3 * 255;
+
+class LightingPower : public testing::Test {
+   protected:
+    void SetUp() override { set_time(0); }
+
+    // Sets all the LEDs to the same load, and ends the frame
+    void frame(uint16_t load) {
+        for (uint8_t i = 0; i < power.leds; i++) {
+            lighting_power_change(&power, loads[i], load);
+            loads[i] = load;
+        }
+        lighting_power_frame(&power);
+    }
+
+    lighting_power_t power;
+    uint16_t         loads[255] = {};
+};
+
+}  // namespace
+
+TEST_F(LightingPower, EstimatesFromTheLoad) {
+    lighting_power_init(&power, 10, 1000, true);
+    EXPECT_EQ(lighting_power_estimate_ma(&power, 0), 10);
+    EXPECT_EQ(lighting_power_estimate_ma(&power, 10 * white), 10 + 10 * 3 * LIGHTING_POWER_MA_PER_CHANNEL);
+    EXPECT_EQ(lighting_power_estimate_ma(&power, UINT32_MAX / LIGHTING_POWER_MA_PER_CHANNEL), UINT16_MAX);
+}
+
+TEST_F(LightingPower, LeavesLoadsWithinTheBudgetAlone) {
+    lighting_power_init(&power, 100, 500, true);
+    frame(16);
+    EXPECT_EQ(power.scale, LIGHTING_POWER_SCALE_MAX);
+    for (uint16_t channel = 0; channel < 256; channel++) {
+        EXPECT_EQ(lighting_power_scale8(&power, channel), channel);
+    }
+    EXPECT_EQ(lighting_power_draw_ma(&power), lighting_power_estimate_ma(&power, power.load));
+}
+
+TEST_F(LightingPower, ScalesDownToTheBudget) {
+    for (uint16_t budget : {100, 250, 500, 900, 1500, 2000}) {
+        for (uint16_t load = 0; load <= white; load += 15) {
+            lighting_power_init(&power, 100, budget, true);
+            memset(loads, 0, sizeof(loads));
+            frame(load);
+            uint16_t draw = lighting_power_draw_ma(&power);
+            EXPECT_LE(draw, budget) << budget << " " << load;
+            // Without wasting much of it
+            if (lighting_power_estimate_ma(&power, power.load) > budget) {
+                EXPECT_GE(draw, budget - budget / 50 - 1) << budget << " " << load;
+            }
+        }
+    }
+}
+
+TEST_F(LightingPower, TurnsOffWhenTheBudgetIsLessThanIdle) {
+    lighting_power_init(&power, 100, 50, true);
+    frame(1);
+    EXPECT_EQ(power.scale, 0);
+    EXPECT_EQ(lighting_power_scale8(&power, 255), 0);
+}
+
+TEST_F(LightingPower, DropsRightAwayAndComesBackUpSlowly) {
+    lighting_power_init(&power, 100, 500, true);
+    frame(white);
+    uint32_t limited = power.scale;
+    EXPECT_LT(limited, LIGHTING_POWER_SCALE_MAX / 4);
+
+    // Dark again, the scale comes back up over LIGHTING_POWER_RELEASE_MS
+    advance_time(LIGHTING_POWER_RELEASE_MS / 4);
+    frame(0);
+    EXPECT_TRUE(lighting_power_releasing(&power));
+    EXPECT_EQ(power.scale, limited + LIGHTING_POWER_SCALE_MAX / 4);
+
+    advance_time(LIGHTING_POWER_RELEASE_MS);
+    frame(0);
+    EXPECT_FALSE(lighting_power_releasing(&power));
+    EXPECT_EQ(power.scale, LIGHTING_POWER_SCALE_MAX);
+
+    // And drops again on the first bright frame
+    advance_time(1);
+    frame(white);
+    EXPECT_EQ(power.scale, limited);
+}
+
+TEST_F(LightingPower, ComesBackUpRightAwayWithoutRelease) {
+    lighting_power_init(&power, 100, 500, false);
+    frame(white);
+    EXPECT_LT(power.scale, LIGHTING_POWER_SCALE_MAX);
+    frame(0);
+    EXPECT_FALSE(lighting_power_releasing(&power));
+    EXPECT_EQ(power.scale, LIGHTING_POWER_SCALE_MAX);
+}
+
+TEST_F(LightingPower, FollowsTheLoadOfChangedLeds) {
+    lighting_power_init(&power, 4, 1000, true);
+    lighting_power_change(&power, 0, white);
+    lighting_power_change(&power, 0, 100);
+    lighting_power_change(&power, white, 10);
+    EXPECT_EQ(power.load, 110);
+}
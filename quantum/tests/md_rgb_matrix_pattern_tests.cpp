@@ -0,0 +1,252 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" {
+#include "md_rgb_matrix_pattern.h"
+
+extern void *        led_setups[];
+extern const uint8_t led_setups_count;
+}
+
+namespace {
+
+// The float engine the fixed point one replaces
+void reference_run(const led_setup_t *f, float *ro, float *go, float *bo, float pos, float pomod, bool reverse) {
+    float po;
+
+    while (f->end != 1) {
+        po = pos;
+
+        if ((!reverse && f->ef & EF_SCR_R) || (reverse && (f->ef & EF_SCR_L))) {
+            po -= pomod;
+
+            if (po > 100)
+                po -= 100;
+            else if (po < 0)
+                po += 100;
+        } else if ((!reverse && f->ef & EF_SCR_L) || (reverse && (f->ef & EF_SCR_R))) {
+            po += pomod;
+
+            if (po > 100)
+                po -= 100;
+            else if (po < 0)
+                po += 100;
+        }
+
+        if (po < f->hs || po > f->he) {
+            f++;
+            continue;
+        }
+
+        po = (po - f->hs) / (f->he - f->hs);
+
+        if (f->ef & EF_OVER) {
+            *ro = (po * (f->re - f->rs)) + f->rs;
+            *go = (po * (f->ge - f->gs)) + f->gs;
+            *bo = (po * (f->be - f->bs)) + f->bs;
+        } else if (f->ef & EF_SUBTRACT) {
+            *ro -= (po * (f->re - f->rs)) + f->rs;
+            *go -= (po * (f->ge - f->gs)) + f->gs;
+            *bo -= (po * (f->be - f->bs)) + f->bs;
+        } else {
+            *ro += (po * (f->re - f->rs)) + f->rs;
+            *go += (po * (f->ge - f->gs)) + f->gs;
+            *bo += (po * (f->be - f->bs)) + f->bs;
+        }
+
+        f++;
+    }
+}
+
+void reference_output(float *rgb, float breathe_mult, uint8_t *out) {
+    for (int c = 0; c < 3; c++) {
+        if (rgb[c] > 255)
+            rgb[c] = 255;
+        else if (rgb[c] < 0)
+            rgb[c] = 0;
+        out[c] = (uint8_t)(rgb[c] * breathe_mult);
+    }
+}
+
+// pomod as flush() works it out
+float pomod_at(uint32_t timer, float speed) {
+    float pomod = (float)((timer / 10) % (uint32_t)(1000.0f / speed)) / 10.0f * speed;
+    pomod *= 100.0f;
+    pomod = (uint32_t)pomod % 10000;
+    pomod /= 100.0f;
+    return pomod;
+}
+
+struct Difference {
+    unsigned colors;
+    unsigned off_by_one;
+    unsigned more;
+};
+
+// Every pattern at every position across the board, over a few seconds of scrolling
+Difference compare(uint8_t extent, bool reverse, float breathe_mult) {
+    Difference difference = {0, 0, 0};
+
+    led_pattern_reset();
+    for (uint8_t p = 0; p < led_setups_count; p++) {
+        const led_setup_t *setup = (const led_setup_t *)led_setups[p];
+        uint8_t            count;
+        const led_band_t * bands = led_pattern_get(setup, &count);
+
+        for (uint32_t timer = 0; timer < 5000; timer += 30) {
+            float pomod = pomod_at(timer, 4.0f);
+            for (int point = 0; point <= extent; point++) {
+                float rgb[3] = {0, 0, 0};
+                reference_run(setup, &rgb[0], &rgb[1], &rgb[2], (float)point / extent * 100, pomod, reverse);
+                uint8_t expected[3];
+                reference_output(rgb, breathe_mult, expected);
+
+                int32_t fixed[3] = {0, 0, 0};
+                led_pattern_run(bands, count, fixed, led_pattern_position(point, extent), led_pattern_shift(pomod), reverse);
+                uint8_t actual[3];
+                led_pattern_output(fixed, breathe_mult * 65536 + 0.5f, actual);
+
+                for (int c = 0; c < 3; c++) {
+                    int d = abs(actual[c] - expected[c]);
+                    difference.colors++;
+                    difference.off_by_one += d == 1;
+                    difference.more += d > 1;
+                }
+            }
+        }
+    }
+    return difference;
+}
+
+}  // namespace
+
+TEST(MdRgbMatrixPattern, MatchesFloatAcross) {
+    Difference difference = compare(224, false, 1);
+    printf("%u colors, %u off by one, %u more\n", difference.colors, difference.off_by_one, difference.more);
+    EXPECT_LT(difference.off_by_one, difference.colors / 50);
+    EXPECT_LT(difference.more, difference.colors / 10000);
+}
+
+TEST(MdRgbMatrixPattern, MatchesFloatDownReversed) {
+    Difference difference = compare(64, true, 1);
+    EXPECT_LT(difference.off_by_one, difference.colors / 50);
+    EXPECT_LT(difference.more, difference.colors / 10000);
+}
+
+TEST(MdRgbMatrixPattern, MatchesFloatBreathing) {
+    for (float breathe_mult : {0.0f, 0.000015f * 40 * 40, 0.000015f * 200 * 200}) {
+        Difference difference = compare(224, false, breathe_mult);
+        EXPECT_LT(difference.off_by_one, difference.colors / 50) << breathe_mult;
+        EXPECT_LT(difference.more, difference.colors / 10000) << breathe_mult;
+    }
+}
+
+TEST(MdRgbMatrixPattern, ClampsAndSubtracts) {
+    // White with a stripe taken out of green and blue
+    led_setup_t setup[] = {
+        {.hs = 0, .he = 100, .rs = 255, .re = 255, .gs = 255, .ge = 255, .bs = 255, .be = 255, .ef = EF_NONE},
+        {.hs = 0, .he = 100, .rs = 200, .re = 200, .gs = 0, .ge = 0, .bs = 0, .be = 0, .ef = EF_NONE},
+        {.hs = 0, .he = 50, .rs = 0, .re = 0, .gs = 0, .ge = 255, .bs = 0, .be = 255, .ef = EF_SUBTRACT},
+        {.end = 1},
+    };
+    led_band_t bands[4];
+    ASSERT_EQ(led_pattern_compile(setup, bands, 4), 3);
+
+    int32_t rgb[3] = {0, 0, 0};
+    uint8_t out[3];
+    led_pattern_run(bands, 3, rgb, led_pattern_position(112, 224), 0, false);
+    led_pattern_output(rgb, 1 << 16, out);
+    EXPECT_EQ(out[0], 255);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 0);
+
+    // Compiling stops at max
+    EXPECT_EQ(led_pattern_compile(setup, bands, 2), 2);
+}
+
+TEST(MdRgbMatrixPattern, CompiledPatternsAreKept) {
+    led_pattern_reset();
+    uint8_t           count;
+    const led_band_t *first = led_pattern_get((const led_setup_t *)led_setups[0], &count);
+    EXPECT_EQ(count, 6);
+
+    // More patterns than fit push the first one out, and it comes back the same
+    for (int r = 0; r < 3; r++) {
+        for (uint8_t p = 0; p < led_setups_count; p++) {
+            uint8_t           n;
+            const led_band_t *bands = led_pattern_get((const led_setup_t *)led_setups[p], &n);
+            led_band_t        expected[LED_PATTERN_BANDS];
+            ASSERT_EQ(led_pattern_compile((const led_setup_t *)led_setups[p], expected, LED_PATTERN_BANDS), n);
+            for (uint8_t b = 0; b < n; b++) {
+                EXPECT_EQ(bands[b].hs, expected[b].hs);
+                EXPECT_EQ(bands[b].slope[1], expected[b].slope[1]);
+            }
+        }
+    }
+    led_pattern_reset();
+    EXPECT_EQ(led_pattern_get((const led_setup_t *)led_setups[0], &count), first);
+}
+
+TEST(MdRgbMatrixPattern, Benchmark) {
+    using clock = std::chrono::steady_clock;
+
+    const led_setup_t *setup = (const led_setup_t *)led_setups[0];
+    float              pomod = pomod_at(1234, 4.0f);
+    unsigned           sum   = 0;
+
+    auto start = clock::now();
+    for (int r = 0; r < 2000; r++) {
+        for (int point = 0; point <= 224; point++) {
+            float   rgb[3] = {0, 0, 0};
+            uint8_t out[3];
+            reference_run(setup, &rgb[0], &rgb[1], &rgb[2], (float)point / 224 * 100, pomod, false);
+            reference_output(rgb, 1, out);
+            sum += out[0];
+        }
+    }
+    auto reference = clock::now() - start;
+
+    uint16_t positions[225];
+    for (int point = 0; point <= 224; point++) {
+        positions[point] = led_pattern_position(point, 224);
+    }
+    int32_t shift = led_pattern_shift(pomod);
+
+    start = clock::now();
+    for (int r = 0; r < 2000; r++) {
+        for (int point = 0; point <= 224; point++) {
+            uint8_t           count;
+            int32_t           rgb[3] = {0, 0, 0};
+            uint8_t           out[3];
+            const led_band_t *bands = led_pattern_get(setup, &count);
+            led_pattern_run(bands, count, rgb, positions[point], shift, false);
+            led_pattern_output(rgb, 1 << 16, out);
+            sum += out[0];
+        }
+    }
+    auto fixed = clock::now() - start;
+
+    double leds = 2000.0 * 225;
+    printf("%-10s %10s\n", "", "ns/LED");
+    printf("%-10s %10.2f\n", "float", std::chrono::duration<double, std::nano>(reference).count() / leds);
+    printf("%-10s %10.2f\n", "fixed", std::chrono::duration<double, std::nano>(fixed).count() / leds);
+    EXPECT_GT(sum, 0u);
+}
@@ -0,0 +1,247 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+#include "midi.h"
+#include "midi_queue.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// Keyboard side: a MIDI device whose output goes through the queue, like qmk_midi.c. Host side: a
+// MIDI device fed with every transfer the queue makes, standing in for the computer.
+namespace {
+
+MidiDevice keyboard;
+MidiDevice host;
+
+std::vector<std::vector<midi_queue_packet_t>> transfers;
+uint8_t                                       driver_room = 255;  // packets the driver takes per transfer
+
+struct Note {
+    uint8_t  num;
+    uint32_t time;  // when the host got it
+};
+std::vector<Note>    notes;
+std::vector<uint8_t> sysex;
+
+void keyboard_send(MidiDevice *device, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    midi_queue_packet_t packet;
+    if (midi_queue_encode(&packet, cnt, byte0, byte1, byte2)) {
+        midi_queue_push(packet);
+    }
+}
+
+uint8_t driver_send(const midi_queue_packet_t *packets, uint8_t count) {
+    if (count > driver_room) count = driver_room;
+    if (!count) return 0;
+
+    transfers.emplace_back(packets, packets + count);
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t data[3] = {packets[i].data1, packets[i].data2, packets[i].data3};
+        uint8_t length  = midi_packet_length(data[0]);
+        if (length == UNDEFINED) {
+            switch (packets[i].event) {
+                case SYSEX_ENDS_IN_1 >> 4:
+                    length = 1;
+                    break;
+                case SYSEX_ENDS_IN_2 >> 4:
+                    length = 2;
+                    break;
+                default:
+                    length = 3;
+                    break;
+            }
+        }
+        midi_device_input(&host, length, data);
+    }
+    midi_device_process(&host);
+    return count;
+}
+
+void host_noteon(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t vel) { notes.push_back({num, timer_read32()}); }
+
+void host_sysex(MidiDevice *device, uint16_t start, uint8_t length, uint8_t *data) { sysex.insert(sysex.end(), data, data + length); }
+
+}  // namespace
+
+class MidiQueue : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        midi_device_init(&keyboard);
+        midi_device_set_send_func(&keyboard, keyboard_send);
+        midi_device_init(&host);
+        midi_register_noteon_callback(&host, host_noteon);
+        midi_register_sysex_callback(&host, host_sysex);
+
+        midi_queue_init(driver_send);
+        midi_queue_set_policy({MIDI_QUEUE_FLUSH_PACKETS, MIDI_QUEUE_FLUSH_TIMEOUT});
+        midi_queue_clear_stats();
+        transfers.clear();
+        notes.clear();
+        sysex.clear();
+        driver_room = 255;
+    }
+
+    // One scan loop
+    void scan() {
+        midi_queue_task();
+        advance_time(1);
+    }
+};
+
+TEST_F(MidiQueue, PacketsFromOneScanShareATransfer) {
+    for (uint8_t note = 60; note < 66; note++) {
+        midi_send_noteon(&keyboard, 0, note, 100);
+    }
+    EXPECT_TRUE(transfers.empty());
+    scan();
+
+    ASSERT_EQ(transfers.size(), 1);
+    EXPECT_EQ(transfers[0].size(), 6);
+    ASSERT_EQ(notes.size(), 6);
+    for (uint8_t i = 0; i < 6; i++) {
+        EXPECT_EQ(notes[i].num, 60 + i);
+    }
+    EXPECT_EQ(midi_queue_get_stats()->max_latency, 0);
+}
+
+TEST_F(MidiQueue, TransfersAreAtMostOneEndpoint) {
+    // More than the queue holds, so it is written out while the notes are still being sent
+    for (uint8_t note = 0; note < 80; note++) {
+        midi_send_noteon(&keyboard, 0, note, 100);
+    }
+    scan();
+
+    ASSERT_EQ(notes.size(), 80);
+    for (uint8_t i = 0; i < 80; i++) {
+        EXPECT_EQ(notes[i].num, i);
+    }
+    for (const auto &transfer : transfers) {
+        EXPECT_LE(transfer.size(), MIDI_QUEUE_BATCH);
+    }
+    EXPECT_EQ(transfers.size(), 5);
+    EXPECT_EQ(midi_queue_get_stats()->dropped, 0);
+}
+
+TEST_F(MidiQueue, SysexRoundTrip) {
+    uint8_t message[] = {SYSEX_BEGIN, 0x7D, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, SYSEX_END};
+    midi_send_array(&keyboard, sizeof(message), message);
+    scan();
+
+    EXPECT_EQ(transfers.size(), 1);
+    EXPECT_EQ(sysex, std::vector<uint8_t>(message, message + sizeof(message)));
+}
+
+TEST_F(MidiQueue, BusyDriverKeepsPacketsQueued) {
+    driver_room = 0;
+    for (uint8_t note = 0; note < MIDI_QUEUE_SIZE + 4; note++) {
+        midi_send_noteon(&keyboard, 0, note, 100);
+    }
+    scan();
+    EXPECT_TRUE(notes.empty());
+    EXPECT_EQ(midi_queue_count(), MIDI_QUEUE_SIZE - 1);
+    EXPECT_EQ(midi_queue_get_stats()->dropped, 5);
+
+    // A driver that takes a few packets at a time gets them in order over the next scans
+    driver_room = 4;
+    for (int i = 0; i < 10; i++) {
+        scan();
+    }
+    ASSERT_EQ(notes.size(), MIDI_QUEUE_SIZE - 1);
+    for (uint8_t i = 0; i < MIDI_QUEUE_SIZE - 1; i++) {
+        EXPECT_EQ(notes[i].num, i);
+    }
+}
+
+TEST_F(MidiQueue, ScheduledPacketsGoOutInTimeOrder) {
+    uint16_t now = timer_read();
+    midi_queue_schedule_message(now + 30, 3, MIDI_NOTEON, 3, 100);
+    midi_queue_schedule_message(now + 10, 3, MIDI_NOTEON, 1, 100);
+    midi_queue_schedule_message(now + 20, 3, MIDI_NOTEON, 2, 100);
+    midi_queue_schedule_message(now + 20, 3, MIDI_NOTEON, 4, 100);  // same time, goes after 2
+    for (int i = 0; i < 40; i++) {
+        scan();
+    }
+
+    ASSERT_EQ(notes.size(), 4);
+    EXPECT_EQ(notes[0].num, 1);
+    EXPECT_EQ(notes[0].time, now + 10);
+    EXPECT_EQ(notes[1].num, 2);
+    EXPECT_EQ(notes[1].time, now + 20);
+    EXPECT_EQ(notes[2].num, 4);
+    EXPECT_EQ(notes[2].time, now + 20);
+    EXPECT_EQ(notes[3].num, 3);
+    EXPECT_EQ(notes[3].time, now + 30);
+    EXPECT_EQ(transfers.size(), 3);
+    EXPECT_EQ(midi_queue_get_stats()->max_latency, 0);
+}
+
+TEST_F(MidiQueue, ScheduleSurvivesTimerWrap) {
+    set_time(0xFFF0);
+    midi_queue_schedule_message(0x0010, 3, MIDI_NOTEON, 2, 100);  // 32 ms from now, after the wrap
+    midi_queue_schedule_message(0xFFF8, 3, MIDI_NOTEON, 1, 100);
+    for (int i = 0; i < 40; i++) {
+        scan();
+    }
+
+    ASSERT_EQ(notes.size(), 2);
+    EXPECT_EQ(notes[0].num, 1);
+    EXPECT_EQ(notes[0].time, 0xFFF8);
+    EXPECT_EQ(notes[1].num, 2);
+    EXPECT_EQ(notes[1].time, 0x10010);
+}
+
+TEST_F(MidiQueue, FlushPolicyTradesLatencyForTransfers) {
+    const midi_queue_policy_t policies[] = {{1, 0}, {4, 20}, {8, 20}, {16, 20}, {16, 5}};
+
+    // A note every 2 ms for 400 ms, as an arpeggio or the sequencer would send them
+    std::cout << "policy           transfers  packets/transfer  avg latency  max latency" << std::endl;
+    uint32_t previous_transfers = UINT32_MAX;
+    for (const auto &policy : policies) {
+        SetUp();
+        midi_queue_set_policy(policy);
+        for (int t = 0; t < 400; t++) {
+            if (t % 2 == 0) {
+                midi_send_noteon(&keyboard, 0, t & 0x7F, 100);
+            }
+            scan();
+        }
+        midi_queue_flush();
+
+        const midi_queue_stats_t *stats = midi_queue_get_stats();
+        char                      line[100];
+        snprintf(line, sizeof(line), "%2u packets %3u ms %8u %17.1f %10.1f ms %9u ms", policy.flush_packets, policy.flush_timeout, stats->transfers, (double)stats->packets / stats->transfers, (double)stats->total_latency / stats->packets, stats->max_latency);
+        std::cout << line << std::endl;
+
+        EXPECT_EQ(stats->packets, 200);
+        EXPECT_EQ(notes.size(), 200);
+        EXPECT_LE(stats->max_latency, policy.flush_timeout);
+        if (policy.flush_timeout == 20) {
+            // Waiting for more packets means fewer transfers
+            EXPECT_LT(stats->transfers, previous_transfers);
+            previous_transfers = stats->transfers;
+        }
+    }
+}
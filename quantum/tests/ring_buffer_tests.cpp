@@ -0,0 +1,179 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+
+extern "C" {
+#include "ring_buffer.h"
+}
+
+RING_BUFFER_DEFINE(small_ring, uint8_t, 8)
+RING_BUFFER_DEFINE(big_ring, uint32_t, 256)
+
+class RingBuffer : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        small_ring_init(&small);
+        big_ring_init(&big);
+    }
+
+    small_ring_t small;
+    big_ring_t   big;
+};
+
+TEST_F(RingBuffer, StartsEmpty) {
+    uint8_t item;
+    EXPECT_TRUE(small_ring_empty(&small));
+    EXPECT_EQ(small_ring_count(&small), 0);
+    EXPECT_EQ(small_ring_free(&small), 7);
+    EXPECT_FALSE(small_ring_pop(&small, &item));
+    EXPECT_FALSE(small_ring_peek(&small, &item));
+}
+
+TEST_F(RingBuffer, HoldsOneLessThanSize) {
+    for (uint8_t i = 0; i < 7; i++) {
+        EXPECT_TRUE(small_ring_push(&small, i));
+    }
+    EXPECT_FALSE(small_ring_push(&small, 7));
+    EXPECT_EQ(small_ring_count(&small), 7);
+    EXPECT_EQ(small_ring_free(&small), 0);
+
+    uint8_t item;
+    for (uint8_t i = 0; i < 7; i++) {
+        EXPECT_TRUE(small_ring_pop(&small, &item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_TRUE(small_ring_empty(&small));
+}
+
+TEST_F(RingBuffer, PeekDoesNotConsume) {
+    uint8_t item = 0;
+    small_ring_push(&small, 42);
+    EXPECT_TRUE(small_ring_peek(&small, &item));
+    EXPECT_EQ(item, 42);
+    EXPECT_EQ(small_ring_count(&small), 1);
+    EXPECT_TRUE(small_ring_pop(&small, &item));
+    EXPECT_EQ(item, 42);
+    EXPECT_TRUE(small_ring_empty(&small));
+}
+
+TEST_F(RingBuffer, PeekAtReadsAheadAcrossTheWrap) {
+    uint8_t item = 0;
+    for (uint8_t i = 0; i < 6; i++) {
+        small_ring_push(&small, i);
+        small_ring_pop(&small, &item);
+    }
+    for (uint8_t i = 0; i < 5; i++) {
+        small_ring_push(&small, 10 + i);
+    }
+    for (uint8_t i = 0; i < 5; i++) {
+        EXPECT_TRUE(small_ring_peek_at(&small, i, &item));
+        EXPECT_EQ(item, 10 + i);
+    }
+    EXPECT_FALSE(small_ring_peek_at(&small, 5, &item));
+    EXPECT_EQ(small_ring_count(&small), 5);
+}
+
+TEST_F(RingBuffer, BulkTransfersWrapAround) {
+    uint8_t in[7]  = {1, 2, 3, 4, 5, 6, 7};
+    uint8_t out[7] = {0};
+
+    // move the indices to the middle so the bulk copies have to wrap
+    EXPECT_EQ(small_ring_push_bulk(&small, in, 5), 5);
+    EXPECT_EQ(small_ring_pop_bulk(&small, out, 5), 5);
+
+    EXPECT_EQ(small_ring_push_bulk(&small, in, 7), 7);
+    EXPECT_EQ(small_ring_push_bulk(&small, in, 7), 0);
+    EXPECT_EQ(small_ring_pop_bulk(&small, out, 3), 3);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[2], 3);
+    EXPECT_EQ(small_ring_push_bulk(&small, in, 7), 3);
+    EXPECT_EQ(small_ring_pop_bulk(&small, out, 7), 7);
+    uint8_t expected[7] = {4, 5, 6, 7, 1, 2, 3};
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(out[i], expected[i]);
+    }
+}
+
+TEST_F(RingBuffer, ClearDropsUnreadItems) {
+    small_ring_push(&small, 1);
+    small_ring_push(&small, 2);
+    small_ring_clear(&small);
+    EXPECT_TRUE(small_ring_empty(&small));
+    EXPECT_EQ(small_ring_free(&small), 7);
+}
+
+TEST_F(RingBuffer, FullSizeRingUsesAllIndices) {
+    for (uint32_t i = 0; i < 255; i++) {
+        EXPECT_TRUE(big_ring_push(&big, i));
+    }
+    EXPECT_FALSE(big_ring_push(&big, 255));
+    EXPECT_EQ(big_ring_count(&big), 255);
+
+    uint32_t item;
+    for (uint32_t i = 0; i < 255; i++) {
+        EXPECT_TRUE(big_ring_pop(&big, &item));
+        EXPECT_EQ(item, i);
+    }
+}
+
+TEST_F(RingBuffer, ProducerAndConsumerThreadsKeepOrder) {
+    const uint32_t    total = 100000;
+    std::atomic<bool> stop(false);
+
+    std::thread producer([&] {
+        uint32_t next = 0;
+        uint32_t batch[16];
+        while (next < total && !stop) {
+            if (next & 1) {
+                if (big_ring_push(&big, next)) {
+                    next++;
+                } else {
+                    std::this_thread::yield();
+                }
+            } else {
+                uint8_t count = 0;
+                while (count < 16 && next + count < total) {
+                    batch[count] = next + count;
+                    count++;
+                }
+                count = big_ring_push_bulk(&big, batch, count);
+                if (count == 0) std::this_thread::yield();
+                next += count;
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t batch[16];
+    bool     in_order = true;
+    while (expected < total && in_order) {
+        uint8_t count = big_ring_pop_bulk(&big, batch, (expected & 2) ? 16 : 1);
+        if (count == 0) std::this_thread::yield();
+        for (uint8_t i = 0; i < count; i++) {
+            in_order &= batch[i] == expected++;
+        }
+    }
+    // A full ring would keep the producer spinning once the consumer gives up
+    stop = true;
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(expected, total);
+    EXPECT_TRUE(big_ring_empty(&big));
+}
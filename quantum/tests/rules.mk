@@ -0,0 +1,74 @@
+ring_buffer_SRC := \
+	$(QUANTUM_PATH)/tests/ring_buffer_tests.cpp
+
+keycode_decode_DEFS := -DNO_DEBUG -DMATRIX_ROWS=1 -DMATRIX_COLS=1 -DEXTRAKEY_ENABLE -DMOUSEKEY_ENABLE -DSWAP_HANDS_ENABLE
+
+keycode_decode_SRC := \
+	$(QUANTUM_PATH)/tests/keycode_decode_tests.cpp \
+	$(QUANTUM_PATH)/tests/keycode_decode_reference.c \
+	$(QUANTUM_PATH)/keymap_common.c \
+	$(QUANTUM_PATH)/keycode_config.c
+
+sparse_keymap_DEFS := -DNO_DEBUG -DMATRIX_ROWS=5 -DMATRIX_COLS=14 -DSPARSE_KEYMAP_ENABLE
+
+sparse_keymap_SRC := \
+	$(QUANTUM_PATH)/tests/sparse_keymap_tests.cpp \
+	$(QUANTUM_PATH)/tests/sparse_keymap_generated.c \
+	$(QUANTUM_PATH)/sparse_keymap.c
+
+midi_queue_DEFS := -DNO_DEBUG
+
+midi_queue_INC := \
+	$(TMK_PATH)/protocol/midi
+
+midi_queue_SRC := \
+	$(QUANTUM_PATH)/tests/midi_queue_tests.cpp \
+	$(TMK_PATH)/protocol/midi/midi_queue.c \
+	$(TMK_PATH)/protocol/midi/midi.c \
+	$(TMK_PATH)/protocol/midi/midi_device.c \
+	$(TMK_PATH)/common/test/timer.c
+
+i2c_queue_DEFS := -DNO_DEBUG -DI2C_QUEUE_ENABLE
+
+i2c_queue_INC := \
+	$(DRIVER_PATH)/test
+
+i2c_queue_SRC := \
+	$(QUANTUM_PATH)/tests/i2c_queue_tests.cpp \
+	$(DRIVER_PATH)/i2c_queue.c \
+	$(DRIVER_PATH)/test/i2c_master.c \
+	$(TMK_PATH)/common/test/timer.c
+
+color_DEFS := -DNO_DEBUG -DUSE_CIE1931_CURVE
+
+color_SRC := \
+	$(QUANTUM_PATH)/tests/color_tests.cpp \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/led_tables.c
+
+color_scalar_DEFS := -DNO_DEBUG -DUSE_CIE1931_CURVE -DCOLOR_NO_SWAR
+
+color_scalar_SRC := $(color_SRC)
+
+md_rgb_matrix_pattern_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DUSE_MASSDROP_CONFIGURATOR
+
+md_rgb_matrix_pattern_INC := \
+	$(TMK_PATH)/protocol/arm_atsam
+
+md_rgb_matrix_pattern_SRC := \
+	$(QUANTUM_PATH)/tests/md_rgb_matrix_pattern_tests.cpp \
+	$(TMK_PATH)/protocol/arm_atsam/md_rgb_matrix_pattern.c \
+	$(TMK_PATH)/protocol/arm_atsam/md_rgb_matrix_programs.c
+
+lighting_keyframes_DEFS := -DNO_DEBUG
+
+lighting_keyframes_SRC := \
+	$(QUANTUM_PATH)/tests/lighting_keyframes_tests.cpp \
+	$(QUANTUM_PATH)/lighting_keyframes.c
+
+lighting_power_DEFS := -DNO_DEBUG
+
+lighting_power_SRC := \
+	$(QUANTUM_PATH)/tests/lighting_power_tests.cpp \
+	$(QUANTUM_PATH)/lighting_power.c \
+	$(TMK_PATH)/common/test/timer.c
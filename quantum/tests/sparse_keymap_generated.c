@@ -0,0 +1,32 @@
+/* THIS FILE WAS GENERATED!
+ *
+ * This file was generated by qmk sparse-keymap. Do not edit it directly.
+ *
+ * dense keymap: 560 bytes, sparse keymap: 348 bytes
+ */
+
+#include "sparse_keymap_keymap.c"
+
+// clang-format off
+const uint8_t PROGMEM sparse_keymap_bitmaps[][SPARSE_KEYMAP_BITMAP_SIZE] = {
+    [_BASE] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F},
+    [_FN] = {0xFF, 0x3F, 0x40, 0xEF, 0xC0, 0x00, 0x30, 0x00, 0x00},
+    [_NUM] = {0x80, 0x07, 0xE0, 0x01, 0x78, 0x00, 0x1A, 0x00, 0x00},
+    [_NAV] = {0x00, 0x00, 0xF0, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00},
+};
+
+const uint16_t PROGMEM sparse_keymap_offsets[][SPARSE_KEYMAP_BITMAP_SIZE] = {
+    [_BASE] = {0, 8, 16, 24, 32, 40, 48, 56, 64},
+    [_FN] = {70, 78, 84, 85, 92, 94, 94, 96, 96},
+    [_NUM] = {96, 97, 100, 103, 104, 108, 108, 111, 111},
+    [_NAV] = {111, 111, 111, 115, 115, 119, 119, 119, 119},
+};
+
+const uint16_t PROGMEM sparse_keymap_keycodes[] = {
+    /* layer _BASE */ KC_ESC, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0, KC_MINS, KC_EQL, KC_BSPC, KC_TAB, KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P, KC_LBRC, KC_RBRC, KC_BSLS, KC_CAPS, KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN, KC_QUOT, KC_ENT, KC_NO, KC_LSFT, KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH, KC_RSFT, KC_UP, MO(_FN), KC_LCTL, KC_LGUI, KC_LALT, KC_NO, KC_NO, LT(_NAV,KC_SPC), KC_NO, KC_NO, KC_RALT, TG(_NUM), KC_RCTL, KC_LEFT, KC_DOWN, KC_RGHT,
+    /* layer _FN */ KC_GRV, KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12, KC_DEL, KC_INS, KC_PSCR, KC_SLCK, KC_PAUS, RESET, KC_VOLD, KC_VOLU, KC_MUTE, KC_HOME, KC_PGUP, KC_END, KC_PGDN,
+    /* layer _NUM */ KC_P7, KC_P8, KC_P9, KC_PSLS, KC_P4, KC_P5, KC_P6, KC_PAST, KC_P1, KC_P2, KC_P3, KC_PMNS, KC_P0, KC_PDOT, KC_PPLS,
+    /* layer _NAV */ KC_HOME, KC_PGDN, KC_PGUP, KC_END, KC_LEFT, KC_DOWN, KC_UP, KC_RGHT,
+    0
+};
+// clang-format on
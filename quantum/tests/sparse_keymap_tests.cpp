@@ -0,0 +1,97 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+extern "C" {
+#include "keymap.h"
+}
+
+// sparse_keymap_keymap.c has four layers
+static const uint8_t layer_count = 4;
+
+static keypos_t make_key(uint8_t row, uint8_t col) {
+    keypos_t key;
+    key.row = row;
+    key.col = col;
+    return key;
+}
+
+TEST(SparseKeymap, MatchesDenseKeymap) {
+    for (uint8_t layer = 0; layer < layer_count; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint16_t dense = pgm_read_word(&keymaps[layer][row][col]);
+                EXPECT_EQ(keymap_key_to_keycode(layer, make_key(row, col)), dense) << "layer " << +layer << " row " << +row << " col " << +col;
+                EXPECT_EQ(keymap_key_is_transparent(layer, make_key(row, col)), dense == KC_TRNS) << "layer " << +layer << " row " << +row << " col " << +col;
+            }
+        }
+    }
+}
+
+// keymap_key_to_keycode() of a dense keymap, out of line like the real one
+__attribute__((noinline)) static bool dense_is_transparent(uint8_t layer, keypos_t key) { return pgm_read_word(&keymaps[layer][key.row][key.col]) == KC_TRNS; }
+
+__attribute__((noinline)) static bool sparse_keycode_is_transparent(uint8_t layer, keypos_t key) { return keymap_key_to_keycode(layer, key) == KC_TRNS; }
+
+// The layer search of layer_switch_get_layer(), for every key and every combination of layers
+template <typename F>
+static double ns_per_search(F is_transparent) {
+    const int         rounds = 2000;
+    volatile uint16_t sink   = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (uint8_t layers = 1; layers < (1 << layer_count); layers += 2) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    int8_t layer = layer_count - 1;
+                    while (layer > 0 && (!(layers & (1 << layer)) || is_transparent(layer, make_key(row, col)))) {
+                        layer--;
+                    }
+                    sink = sink + layer;
+                }
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (rounds * (1 << (layer_count - 1)) * MATRIX_ROWS * MATRIX_COLS);
+}
+
+TEST(SparseKeymap, Benchmark) {
+    size_t keycodes = 0;
+    for (uint8_t layer = 0; layer < layer_count; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keycodes += pgm_read_word(&keymaps[layer][row][col]) != KC_TRNS;
+            }
+        }
+    }
+
+    size_t dense_size  = layer_count * MATRIX_ROWS * MATRIX_COLS * sizeof(uint16_t);
+    size_t sparse_size = layer_count * SPARSE_KEYMAP_BITMAP_SIZE * (sizeof(uint8_t) + sizeof(uint16_t)) + (keycodes + 1) * sizeof(uint16_t);
+
+    double dense  = ns_per_search(dense_is_transparent);
+    double sparse = ns_per_search(keymap_key_is_transparent);
+    double lookup = ns_per_search(sparse_keycode_is_transparent);
+
+    std::cout << "flash: dense " << dense_size << " bytes, sparse " << sparse_size << " bytes" << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << "layer search: dense " << dense << " ns, sparse bitmap " << sparse << " ns, sparse keycode " << lookup << " ns per key" << std::endl;
+    EXPECT_LT(sparse_size, dense_size);
+}
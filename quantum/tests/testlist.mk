@@ -0,0 +1,10 @@
+TEST_LIST += ring_buffer
+TEST_LIST += keycode_decode
+TEST_LIST += sparse_keymap
+TEST_LIST += midi_queue
+TEST_LIST += i2c_queue
+TEST_LIST += color
+TEST_LIST += color_scalar
+TEST_LIST += md_rgb_matrix_pattern
+TEST_LIST += lighting_keyframes
+TEST_LIST += lighting_power
@@ -38,6 +38,14 @@
 #    define VIA_QMK_RGBLIGHT_ENABLE
 #endif
 
+// If VIA_CUSTOM_LIGHTING_ENABLE is not defined, then VIA_QMK_KEYFRAMES_ENABLE is set
+// if RGB Matrix or LED Matrix runs keyframe animations, so they can be uploaded here by default.
+// If VIA_CUSTOM_LIGHTING_ENABLE is defined, then VIA_QMK_KEYFRAMES_ENABLE must be explicitly
+// set in keyboard-level config.h, so uploading keyframe animations happens here
+#if ((defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_KEYFRAME_EFFECTS)) || (defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_KEYFRAME_EFFECTS))) && !defined(VIA_CUSTOM_LIGHTING_ENABLE)
+#    define VIA_QMK_KEYFRAMES_ENABLE
+#endif
+
 #include "quantum.h"
 
 #include "via.h"
@@ -58,6 +66,11 @@ void via_qmk_rgblight_set_value(uint8_t *data);
 void via_qmk_rgblight_get_value(uint8_t *data);
 #endif
 
+#if defined(VIA_QMK_KEYFRAMES_ENABLE)
+void via_qmk_keyframes_set_value(uint8_t *data);
+void via_qmk_keyframes_get_value(uint8_t *data);
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -116,6 +129,10 @@ void via_init(void) {
         dynamic_keymap_reset();
         // This resets the macros in EEPROM to nothing.
         dynamic_keymap_macro_reset();
+#if defined(VIA_QMK_KEYFRAMES_ENABLE)
+        // This resets the keyframe animation in EEPROM to what is in flash.
+        lighting_keyframes_reset();
+#endif
         // Save the magic number last, in case saving was interrupted
         via_eeprom_set_valid(true);
     }
@@ -287,10 +304,13 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
 #if defined(VIA_QMK_RGBLIGHT_ENABLE)
             via_qmk_rgblight_set_value(command_data);
 #endif
+#if defined(VIA_QMK_KEYFRAMES_ENABLE)
+            via_qmk_keyframes_set_value(command_data);
+#endif
 #if defined(VIA_CUSTOM_LIGHTING_ENABLE)
             raw_hid_receive_kb(data, length);
 #endif
-#if !defined(VIA_QMK_BACKLIGHT_ENABLE) && !defined(VIA_QMK_RGBLIGHT_ENABLE) && !defined(VIA_CUSTOM_LIGHTING_ENABLE)
+#if !defined(VIA_QMK_BACKLIGHT_ENABLE) && !defined(VIA_QMK_RGBLIGHT_ENABLE) && !defined(VIA_QMK_KEYFRAMES_ENABLE) && !defined(VIA_CUSTOM_LIGHTING_ENABLE)
             // Return the unhandled state
             *command_id = id_unhandled;
 #endif
@@ -303,10 +323,13 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
 #if defined(VIA_QMK_RGBLIGHT_ENABLE)
             via_qmk_rgblight_get_value(command_data);
 #endif
+#if defined(VIA_QMK_KEYFRAMES_ENABLE)
+            via_qmk_keyframes_get_value(command_data);
+#endif
 #if defined(VIA_CUSTOM_LIGHTING_ENABLE)
             raw_hid_receive_kb(data, length);
 #endif
-#if !defined(VIA_QMK_BACKLIGHT_ENABLE) && !defined(VIA_QMK_RGBLIGHT_ENABLE) && !defined(VIA_CUSTOM_LIGHTING_ENABLE)
+#if !defined(VIA_QMK_BACKLIGHT_ENABLE) && !defined(VIA_QMK_RGBLIGHT_ENABLE) && !defined(VIA_QMK_KEYFRAMES_ENABLE) && !defined(VIA_CUSTOM_LIGHTING_ENABLE)
             // Return the unhandled state
             *command_id = id_unhandled;
 #endif
@@ -319,10 +342,13 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
 #if defined(VIA_QMK_RGBLIGHT_ENABLE)
             eeconfig_update_rgblight_current();
 #endif
+#if defined(VIA_QMK_KEYFRAMES_ENABLE)
+            lighting_keyframes_save();
+#endif
 #if defined(VIA_CUSTOM_LIGHTING_ENABLE)
             raw_hid_receive_kb(data, length);
 #endif
-#if !defined(VIA_QMK_BACKLIGHT_ENABLE) && !defined(VIA_QMK_RGBLIGHT_ENABLE) && !defined(VIA_CUSTOM_LIGHTING_ENABLE)
+#if !defined(VIA_QMK_BACKLIGHT_ENABLE) && !defined(VIA_QMK_RGBLIGHT_ENABLE) && !defined(VIA_QMK_KEYFRAMES_ENABLE) && !defined(VIA_CUSTOM_LIGHTING_ENABLE)
             // Return the unhandled state
             *command_id = id_unhandled;
 #endif
@@ -488,3 +514,38 @@ void via_qmk_rgblight_set_value(uint8_t *data) {
 }
 
 #endif  // #if defined(VIA_QMK_RGBLIGHT_ENABLE)
+
+#if defined(VIA_QMK_KEYFRAMES_ENABLE)
+
+// The program is sent in pieces of up to 27 bytes, as offset (2 bytes), size and the bytes
+void via_qmk_keyframes_get_value(uint8_t *data) {
+    uint8_t *value_id   = &(data[0]);
+    uint8_t *value_data = &(data[1]);
+    switch (*value_id) {
+        case id_qmk_lighting_keyframes: {
+            uint16_t offset = (value_data[0] << 8) | value_data[1];
+            uint16_t size   = value_data[2];
+            // the bytes start 5 bytes into the 32 byte packet, so no more than 27 fit
+            if (size > 27) size = 27;
+            lighting_keyframes_get_buffer(offset, size, &value_data[3]);
+            break;
+        }
+    }
+}
+
+void via_qmk_keyframes_set_value(uint8_t *data) {
+    uint8_t *value_id   = &(data[0]);
+    uint8_t *value_data = &(data[1]);
+    switch (*value_id) {
+        case id_qmk_lighting_keyframes: {
+            uint16_t offset = (value_data[0] << 8) | value_data[1];
+            uint16_t size   = value_data[2];
+            // the bytes start 5 bytes into the 32 byte packet, so no more than 27 fit
+            if (size > 27) size = 27;
+            lighting_keyframes_set_buffer(offset, size, &value_data[3]);
+            break;
+        }
+    }
+}
+
+#endif  // #if defined(VIA_QMK_KEYFRAMES_ENABLE)
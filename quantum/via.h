@@ -54,6 +54,16 @@
 #    define VIA_EEPROM_CUSTOM_CONFIG_SIZE 0
 #endif
 
+// RGB Matrix and LED Matrix keep their keyframe animation after the custom config
+#define VIA_EEPROM_KEYFRAMES_ADDR (VIA_EEPROM_CUSTOM_CONFIG_ADDR + VIA_EEPROM_CUSTOM_CONFIG_SIZE)
+
+#if (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_KEYFRAME_EFFECTS)) || (defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_KEYFRAME_EFFECTS))
+#    include "lighting_keyframes.h"
+#    define VIA_EEPROM_KEYFRAMES_SIZE LIGHTING_KEYFRAMES_SIZE
+#else
+#    define VIA_EEPROM_KEYFRAMES_SIZE 0
+#endif
+
 // This is changed only when the command IDs change,
 // so VIA Configurator can detect compatible firmware.
 #define VIA_PROTOCOL_VERSION 0x0009
@@ -97,6 +107,9 @@ enum via_lighting_value {
     id_qmk_rgblight_effect       = 0x81,
     id_qmk_rgblight_effect_speed = 0x82,
     id_qmk_rgblight_color        = 0x83,
+
+    // QMK RGB Matrix and LED Matrix keyframe animation
+    id_qmk_lighting_keyframes = 0x90,
 };
 
 // Can't use SAFE_RANGE here, it might change if someone adds
@@ -166,3 +179,7 @@ void     via_set_layout_options(uint32_t value);
 
 // Called by QMK core to process VIA-specific keycodes.
 bool process_record_via(uint16_t keycode, keyrecord_t *record);
+
+// Keycodes and events process_record_via() acts on, see process_range.h
+#define PROCESS_VIA_KEYCODES(RANGE) RANGE(FN_MO13, MACRO15)
+#define PROCESS_VIA_EVENTS PROCESS_ON_ANY
@@ -1,6 +1,7 @@
 TEST_LIST = $(notdir $(patsubst %/rules.mk,%,$(wildcard $(ROOT_DIR)/tests/*/rules.mk)))
 FULL_TESTS := $(TEST_LIST)
 
+include $(ROOT_DIR)/quantum/tests/testlist.mk
 include $(ROOT_DIR)/quantum/sequencer/tests/testlist.mk
 include $(ROOT_DIR)/quantum/serial_link/tests/testlist.mk
 
@@ -0,0 +1,214 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "adaptive_tapping.h"
+#include "eeconfig.h"
+#include <string>
+#include <vector>
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+// SFT_T(KC_F) at column 0, CTL_T(KC_J) at column 1, then plain keys
+enum : uint8_t { F, J, A, S };
+
+const uint16_t SFT_F = SFT_T(KC_F);
+
+struct Tap {
+    uint16_t duration;  // press to release of the mod tap key
+    uint16_t overlap;   // KC_A pressed this long before the release, 0 for none
+};
+
+// Taps of SFT_T(KC_F) recorded while typing prose on home row mods, some rolled into the next key
+const std::vector<Tap> typing_log = {
+    {92, 0}, {104, 0}, {88, 25}, {110, 0}, {97, 0},  {101, 31}, {85, 0}, {115, 0}, {99, 0},  {93, 18}, {107, 0}, {96, 0},
+    {102, 0}, {89, 0}, {111, 27}, {94, 0}, {100, 0}, {105, 0},  {91, 22}, {98, 0}, {103, 0}, {95, 0},  {108, 0}, {90, 0},
+};
+
+// What the taps should type
+std::string expected_text(const std::vector<Tap> &taps) {
+    std::string text;
+    for (const auto &tap : taps) {
+        text += tap.overlap ? "fa" : "f";
+    }
+    return text;
+}
+
+}  // namespace
+
+class AdaptiveTapping : public TestFixture {
+   public:
+    void SetUp() override { adaptive_tapping_reset(); }
+
+    // Plays the taps, one scan per millisecond, and returns the letters typed
+    std::string replay(const std::vector<Tap> &taps) {
+        TestDriver        driver;
+        std::string       text;
+        report_keyboard_t previous = {};
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            for (uint8_t key : report.keys) {
+                bool held = false;
+                for (uint8_t old : previous.keys) {
+                    held |= old == key;
+                }
+                if (!held && (key == KC_F || key == KC_A)) {
+                    text += key == KC_F ? 'f' : 'a';
+                }
+            }
+            previous = report;
+        }));
+
+        for (const auto &tap : taps) {
+            press_key(F, 0);
+            for (uint16_t t = 0; t < tap.duration; t++) {
+                if (tap.overlap && t == tap.duration - tap.overlap) {
+                    press_key(A, 0);
+                }
+                run_one_scan_loop();
+            }
+            release_key(F, 0);
+            run_one_scan_loop();
+            release_key(A, 0);
+            // Long enough for the next press to start a new tap instead of a double tap
+            idle_for(TAPPING_TERM + 50);
+        }
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return text;
+    }
+
+    // Holds SFT_T(KC_F) alone for duration, returns how long it took to send shift, 0 if never
+    uint16_t hold(uint16_t duration) {
+        TestDriver driver;
+        uint16_t   now     = 0;
+        uint16_t   shifted = 0;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            if (!shifted && (report.mods & MOD_BIT(KC_LSFT))) {
+                shifted = now;
+            }
+        }));
+
+        press_key(F, 0);
+        for (; now < duration; now++) {
+            run_one_scan_loop();
+        }
+        release_key(F, 0);
+        idle_for(TAPPING_TERM + 50);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return shifted;
+    }
+};
+
+TEST_F(AdaptiveTapping, KeepsTappingTermUntilEnoughSamples) {
+    std::vector<Tap> first(typing_log.begin(), typing_log.begin() + 15);
+    std::vector<Tap> rest(typing_log.begin() + 15, typing_log.end());
+
+    EXPECT_EQ(replay(first), expected_text(first));
+    EXPECT_EQ(adaptive_tapping_term(SFT_F, TAPPING_TERM), TAPPING_TERM);
+    // The last of them rolled into the next key
+    EXPECT_GT(adaptive_tapping_get_key(SFT_F)->overlap, 0);
+
+    EXPECT_EQ(replay(rest), expected_text(rest));
+    const adaptive_tapping_key_t *key = adaptive_tapping_get_key(SFT_F);
+    ASSERT_NE(key, nullptr);
+    EXPECT_EQ(key->samples, typing_log.size());
+    EXPECT_NEAR(key->tap_mean >> 4, 99, 5);
+
+    uint16_t term = adaptive_tapping_term(SFT_F, TAPPING_TERM);
+    EXPECT_LT(term, TAPPING_TERM - 30);
+    EXPECT_GT(term, 115);
+
+    // Other keys keep the configured term
+    EXPECT_EQ(adaptive_tapping_term(CTL_T(KC_J), TAPPING_TERM), TAPPING_TERM);
+}
+
+TEST_F(AdaptiveTapping, HoldIsDecidedEarlier) {
+    EXPECT_NEAR(hold(300), TAPPING_TERM, 1);
+
+    replay(typing_log);
+    uint16_t term = adaptive_tapping_term(SFT_F, TAPPING_TERM);
+    EXPECT_NEAR(hold(300), term, 1);
+}
+
+TEST_F(AdaptiveTapping, EarlyReleasedHoldLengthensTerm) {
+    replay(typing_log);
+    uint16_t term = adaptive_tapping_term(SFT_F, TAPPING_TERM);
+    ASSERT_LT(term + 15, TAPPING_TERM);
+
+    // Slower than the learned term, but faster than TAPPING_TERM: comes out as shift, and is
+    // recorded as a tap that went wrong
+    uint16_t slow = term + 15;
+    EXPECT_NEAR(hold(slow), term, 1);
+    EXPECT_GT(adaptive_tapping_term(SFT_F, TAPPING_TERM), slow);
+    EXPECT_EQ(replay({{slow, 0}}), "f");
+}
+
+TEST_F(AdaptiveTapping, InterruptedHoldDoesNotLengthenTerm) {
+    replay(typing_log);
+    uint16_t term    = adaptive_tapping_term(SFT_F, TAPPING_TERM);
+    uint8_t  samples = adaptive_tapping_get_key(SFT_F)->samples;
+
+    // Shift+A, with the hold released before TAPPING_TERM
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    press_key(F, 0);
+    idle_for(term + 5);
+    press_key(A, 0);
+    run_one_scan_loop();
+    release_key(A, 0);
+    run_one_scan_loop();
+    release_key(F, 0);
+    idle_for(TAPPING_TERM + 50);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(adaptive_tapping_get_key(SFT_F)->samples, samples);
+    EXPECT_EQ(adaptive_tapping_term(SFT_F, TAPPING_TERM), term);
+}
+
+TEST_F(AdaptiveTapping, StatisticsPersistInEeprom) {
+    replay(typing_log);
+    uint16_t term = adaptive_tapping_term(SFT_F, TAPPING_TERM);
+    ASSERT_LT(term, TAPPING_TERM);
+
+    // Saved by the task once ADAPTIVE_TAPPING_SAVE_INTERVAL has passed, then loaded on power up
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(1000);
+    adaptive_tapping_init();
+    EXPECT_EQ(adaptive_tapping_term(SFT_F, TAPPING_TERM), term);
+    EXPECT_EQ(adaptive_tapping_get_key(SFT_F)->samples, typing_log.size());
+
+    // Resetting the EEPROM forgets them
+    eeconfig_init();
+    EXPECT_EQ(adaptive_tapping_term(SFT_F, TAPPING_TERM), TAPPING_TERM);
+    adaptive_tapping_init();
+    EXPECT_EQ(adaptive_tapping_get_key(SFT_F), nullptr);
+}
+
+TEST_F(AdaptiveTapping, AveragesReachSteadySamples) {
+    adaptive_tapping_record_tap(SFT_F, 150, 40);
+    for (int i = 0; i < 100; i++) {
+        adaptive_tapping_record_tap(SFT_F, 100, 0);
+    }
+
+    // Rounding each step down would leave the averages up to 2^ADAPTIVE_TAPPING_GAIN short of the samples
+    const adaptive_tapping_key_t *key = adaptive_tapping_get_key(SFT_F);
+    EXPECT_EQ(key->tap_mean, 100 << 4);
+    EXPECT_EQ(key->tap_dev, 0);
+    EXPECT_EQ(key->overlap, 0);
+}
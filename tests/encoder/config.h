@@ -0,0 +1,48 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 10
+
+// One encoder on two pins of a mock port, which the tests turn by hand
+#define ENCODERS_PAD_A \
+    { 0 }
+#define ENCODERS_PAD_B \
+    { 1 }
+#define ENCODER_INTERRUPTS
+#define ENCODER_VELOCITY_TIMEOUT 200
+
+#ifndef __ASSEMBLER__
+#    include <stdint.h>
+#    ifdef __cplusplus
+extern "C" {
+#    endif
+typedef uint8_t pin_t;
+extern uint8_t  test_encoder_pins;
+extern void (*test_encoder_interrupt)(void);
+#    ifdef __cplusplus
+}
+#    endif
+#    define setPinInputHigh(pin) ((void)(pin))
+#    define readPin(pin) ((test_encoder_pins >> (pin)) & 1)
+// Where a test can fire the interrupt in the middle of encoder_read()
+#    define ENCODER_TICKS_READ_HOOK()                                  \
+        do {                                                           \
+            if (test_encoder_interrupt) test_encoder_interrupt();      \
+        } while (0)
+#endif
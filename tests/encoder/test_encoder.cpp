@@ -0,0 +1,113 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "encoder.h"
+void advance_time(uint32_t ms);
+}
+
+class Encoder : public TestFixture {
+   public:
+    TestDriver driver;
+
+    // Starts every test from an encoder that has been still for a while
+    void SetUp() override { idle_for(ENCODER_VELOCITY_TIMEOUT + 10); }
+
+    void TearDown() override { test_encoder_interrupt = NULL; }
+
+    // Turns the encoder by whole detents, one pin change per interrupt
+    static void turn(uint16_t detents) {
+        static const uint8_t states[] = {2, 3, 1, 0};
+        for (uint16_t i = 0; i < detents; i++) {
+            for (uint8_t state : states) {
+                test_encoder_pins = state;
+                encoder_isr();
+            }
+        }
+    }
+};
+
+TEST_F(Encoder, FirstDetentAfterPauseIsNotStill) {
+    turn(1);
+    run_one_scan_loop();
+    EXPECT_EQ(encoder_get_velocity(0), 1000 / ENCODER_VELOCITY_TIMEOUT);
+}
+
+TEST_F(Encoder, VelocityDropsToZeroWhenStill) {
+    turn(1);
+    run_one_scan_loop();
+    advance_time(10);
+    turn(1);
+    run_one_scan_loop();
+    EXPECT_GT(encoder_get_velocity(0), 0);
+
+    idle_for(ENCODER_VELOCITY_TIMEOUT);
+    EXPECT_EQ(encoder_get_velocity(0), 0);
+}
+
+TEST_F(Encoder, DetentsAreTimedInTheInterrupt) {
+    turn(1);
+    run_one_scan_loop();
+
+    // 10ms between the detents, with the 1ms of the scan, even though the scan only sees the second one 40ms later
+    advance_time(9);
+    turn(1);
+    advance_time(40);
+    run_one_scan_loop();
+    EXPECT_EQ(encoder_get_velocity(0), (1000 / ENCODER_VELOCITY_TIMEOUT + 1000 / 10) / 2);
+}
+
+TEST_F(Encoder, FastSpinDoesNotOverflow) {
+    turn(1);
+    run_one_scan_loop();
+
+    // 100 detents in 1ms is 100000 detents per second, averaged with the first detent
+    turn(100);
+    run_one_scan_loop();
+    EXPECT_EQ(encoder_get_velocity(0), (1000 / ENCODER_VELOCITY_TIMEOUT + 100000) / 2);
+
+    turn(100);
+    run_one_scan_loop();
+    EXPECT_EQ(encoder_get_velocity(0), UINT16_MAX);
+}
+
+TEST_F(Encoder, DetentsBetweenScansAreCapped) {
+    turn(1);
+    run_one_scan_loop();
+
+    // More detents than an int8_t holds are capped rather than wrapping around to the other direction
+    turn(200);
+    run_one_scan_loop();
+    EXPECT_EQ(encoder_get_velocity(0), (1000 / ENCODER_VELOCITY_TIMEOUT + INT8_MAX * 1000) / 2);
+}
+
+TEST_F(Encoder, InterruptDuringReadKeepsDetentsWithTheirTime) {
+    turn(1);
+    run_one_scan_loop();
+    advance_time(9);
+    turn(1);
+
+    // Another detent 5ms later, seen between reading the detents and their time
+    test_encoder_interrupt = [] {
+        test_encoder_interrupt = NULL;
+        advance_time(5);
+        turn(1);
+    };
+    run_one_scan_loop();
+    EXPECT_EQ(encoder_get_velocity(0), (1000 / ENCODER_VELOCITY_TIMEOUT + 2 * 1000 / 15) / 2);
+}
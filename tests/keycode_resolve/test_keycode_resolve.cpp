@@ -0,0 +1,136 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+extern uint32_t keymap_lookups;
+extern uint32_t tapping_term_lookups;
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class KeycodeResolve : public TestFixture {
+   public:
+    void SetUp() override {
+        keymap_lookups       = 0;
+        tapping_term_lookups = 0;
+    }
+};
+
+TEST_F(KeycodeResolve, PlainKeyLooksUpKeymapOncePerEvent) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    keyboard_task();
+    EXPECT_EQ(keymap_lookups, 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    keymap_lookups = 0;
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    keyboard_task();
+    EXPECT_EQ(keymap_lookups, 1);
+}
+
+TEST_F(KeycodeResolve, HeldModTapDoesNotLookUpEveryScan) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+
+    press_key(1, 0);
+    run_one_scan_loop();
+    uint32_t lookups = keymap_lookups;
+
+    idle_for(TAPPING_TERM - 10);
+    EXPECT_EQ(keymap_lookups, lookups);
+    EXPECT_EQ(tapping_term_lookups, 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    idle_for(20);
+    EXPECT_EQ(keymap_lookups, lookups);
+    EXPECT_EQ(tapping_term_lookups, 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    release_key(1, 0);
+    run_one_scan_loop();
+}
+
+TEST_F(KeycodeResolve, TappedModTapKeepsResolvedKeycode) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(1, 0);
+    run_one_scan_loop();
+    release_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_P)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The tap release is handled while tapping_key still holds the tap,
+    // which must not bring back a lookup per scan.
+    uint32_t lookups = keymap_lookups;
+    idle_for(TAPPING_TERM + 10);
+    EXPECT_EQ(keymap_lookups, lookups);
+    EXPECT_LE(tapping_term_lookups, 3);
+}
+
+TEST_F(KeycodeResolve, WaitingKeyIsResolvedAgainAfterLayerChange) {
+    TestDriver driver;
+    InSequence s;
+
+    // KC_A is looked up on layer 0 when it enters action_exec(), but it is
+    // only processed after the layer tap key has switched to layer 1.
+    press_key(2, 0);
+    run_one_scan_loop();
+    press_key(0, 0);
+    run_one_scan_loop();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    idle_for(TAPPING_TERM + 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(2);
+    release_key(0, 0);
+    run_one_scan_loop();
+    release_key(2, 0);
+    run_one_scan_loop();
+}
+
+TEST_F(KeycodeResolve, HeldKeyIsResolvedAgainWhenGenerationWraps) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    press_key(1, 0);
+    run_one_scan_loop();
+    uint32_t lookups = keymap_lookups;
+
+    // 256 changes bring the generation back to the one the tapping key was resolved at
+    for (int i = 0; i < 256; i++) {
+        keymap_cache_invalidate();
+    }
+    run_one_scan_loop();
+    EXPECT_GT(keymap_lookups, lookups);
+
+    release_key(1, 0);
+    run_one_scan_loop();
+}
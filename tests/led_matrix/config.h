@@ -0,0 +1,26 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// A 32 key board, an LED on every key
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 8
+#define DRIVER_LED_TOTAL 32
+
+#define LED_MATRIX_KEYPRESSES
+#define LED_MATRIX_LED_PROCESS_LIMIT 8
+#define BACKLIGHT_LEVELS 4
@@ -0,0 +1,72 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quantum.h"
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+    },
+};
+
+// Rows 21.3 apart, columns 32 apart, over the whole 224 x 64 area
+led_config_t g_led_config = {
+    {
+        { 0,  1,  2,  3,  4,  5,  6,  7},
+        { 8,  9, 10, 11, 12, 13, 14, 15},
+        {16, 17, 18, 19, 20, 21, 22, 23},
+        {24, 25, 26, 27, 28, 29, 30, 31},
+    },
+    {
+        {  0,  0}, { 32,  0}, { 64,  0}, { 96,  0}, {128,  0}, {160,  0}, {192,  0}, {224,  0},
+        {  0, 21}, { 32, 21}, { 64, 21}, { 96, 21}, {128, 21}, {160, 21}, {192, 21}, {224, 21},
+        {  0, 43}, { 32, 43}, { 64, 43}, { 96, 43}, {128, 43}, {160, 43}, {192, 43}, {224, 43},
+        {  0, 64}, { 32, 64}, { 64, 64}, { 96, 64}, {128, 64}, {160, 64}, {192, 64}, {224, 64},
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4,
+    },
+};
+
+uint8_t  test_led_matrix_leds[DRIVER_LED_TOTAL];
+uint16_t test_led_matrix_writes;
+
+static void init(void) {}
+
+static void flush(void) {}
+
+static void set_value(int index, uint8_t value) {
+    test_led_matrix_leds[index] = value;
+    test_led_matrix_writes++;
+}
+
+static void set_value_all(uint8_t value) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        set_value(i, value);
+    }
+}
+
+const led_matrix_driver_t led_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_value     = set_value,
+    .set_value_all = set_value_all,
+};
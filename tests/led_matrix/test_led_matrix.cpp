@@ -0,0 +1,128 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "backlight.h"
+#include "lib/lib8tion/lib8tion.h"
+
+extern uint8_t  test_led_matrix_leds[DRIVER_LED_TOTAL];
+extern uint16_t test_led_matrix_writes;
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class LedMatrix : public TestFixture {
+   public:
+    TestDriver driver;
+
+    LedMatrix() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        led_matrix_enable_noeeprom();
+        led_matrix_set_value_noeeprom(UINT8_MAX);
+        led_matrix_set_speed_noeeprom(UINT8_MAX / 2);
+        led_matrix_mode_noeeprom(LED_MATRIX_UNIFORM_BRIGHTNESS);
+        idle_for(100);
+    }
+
+    uint8_t led_at(uint8_t row, uint8_t col) { return g_led_config.matrix_co[row][col]; }
+};
+
+TEST_F(LedMatrix, UniformBrightnessFollowsTheValue) {
+    for (uint8_t led = 0; led < DRIVER_LED_TOTAL; led++) {
+        EXPECT_EQ(test_led_matrix_leds[led], UINT8_MAX) << led;
+    }
+
+    led_matrix_set_value_noeeprom(100);
+    idle_for(100);
+    for (uint8_t led = 0; led < DRIVER_LED_TOTAL; led++) {
+        EXPECT_EQ(test_led_matrix_leds[led], 100) << led;
+    }
+}
+
+TEST_F(LedMatrix, BacklightLevelsSetTheValue) {
+    backlight_set(BACKLIGHT_LEVELS / 2);
+    idle_for(100);
+    EXPECT_EQ(led_matrix_get_val(), UINT8_MAX / 2);
+    EXPECT_EQ(test_led_matrix_leds[0], UINT8_MAX / 2);
+
+    backlight_set(0);
+    idle_for(100);
+    EXPECT_EQ(test_led_matrix_leds[DRIVER_LED_TOTAL - 1], 0);
+}
+
+TEST_F(LedMatrix, RendersInChunks) {
+    for (int scan = 0; scan < 100; scan++) {
+        test_led_matrix_writes = 0;
+        run_one_scan_loop();
+        EXPECT_LE(test_led_matrix_writes, LED_MATRIX_LED_PROCESS_LIMIT) << scan;
+    }
+}
+
+TEST_F(LedMatrix, BandFollowsTheSharedFormula) {
+    led_matrix_mode_noeeprom(LED_MATRIX_BAND_VAL);
+    idle_for(100);
+    // The frame may be a few ms behind the timer
+    uint8_t time = scale16by8(led_matrix_get_tick(), UINT8_MAX / 2 / 4);
+    for (uint8_t led = 0; led < DRIVER_LED_TOTAL; led++) {
+        int16_t v        = UINT8_MAX - abs(scale8(g_led_config.point[led].x, 228) + 28 - time) * 8;
+        uint8_t expected = scale8(v < 0 ? 0 : v, UINT8_MAX);
+        EXPECT_NEAR(test_led_matrix_leds[led], expected, 40) << led;
+    }
+}
+
+TEST_F(LedMatrix, ReactiveLightsThePressedKey) {
+    led_matrix_mode_noeeprom(LED_MATRIX_SOLID_REACTIVE_SIMPLE);
+    idle_for(100);
+    for (uint8_t led = 0; led < DRIVER_LED_TOTAL; led++) {
+        EXPECT_EQ(test_led_matrix_leds[led], 0) << led;
+    }
+
+    press_key(3, 2);
+    idle_for(20);
+    release_key(3, 2);
+    idle_for(20);
+    EXPECT_GT(test_led_matrix_leds[led_at(2, 3)], 200);
+    EXPECT_EQ(test_led_matrix_leds[led_at(2, 4)], 0);
+    EXPECT_EQ(test_led_matrix_leds[led_at(1, 3)], 0);
+
+    // And fades back out
+    idle_for(2000);
+    EXPECT_EQ(test_led_matrix_leds[led_at(2, 3)], 0);
+}
+
+TEST_F(LedMatrix, ReactiveRendersAtSpeedZero) {
+    // What an EEPROM from before the 0-255 speed range may hold
+    led_matrix_set_speed_noeeprom(0);
+    led_matrix_mode_noeeprom(LED_MATRIX_SOLID_REACTIVE_SIMPLE);
+    press_key(3, 2);
+    idle_for(20);
+    release_key(3, 2);
+    idle_for(100);
+    EXPECT_GT(test_led_matrix_leds[led_at(2, 3)], 200);
+}
+
+TEST_F(LedMatrix, MapsLedsBackToTheirKeys) {
+    uint8_t row, col;
+    ASSERT_TRUE(led_matrix_map_led_to_row_column(led_at(2, 3), &row, &col));
+    EXPECT_EQ(row, 2);
+    EXPECT_EQ(col, 3);
+    ASSERT_TRUE(led_matrix_map_led_to_row_column(led_at(3, 7), &row, &col));
+    EXPECT_EQ(row, 3);
+    EXPECT_EQ(col, 7);
+}
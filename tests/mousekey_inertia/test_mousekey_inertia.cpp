@@ -0,0 +1,175 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "mousekey.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+static const double I = MOUSEKEY_INERTIA_INITIAL_SPEED;
+static const double B = MOUSEKEY_INERTIA_MAX_SPEED;
+static const double T = MOUSEKEY_INERTIA_TIME_TO_MAX;
+static const double F = MOUSEKEY_INERTIA_FRICTION;
+
+// Distance in pixels after holding a direction for t milliseconds from rest
+static double held_distance(double t) {
+    if (t > T) {
+        return held_distance(T) + B * (t - T) / 1000;
+    }
+    return (I * t + (B - I) * t * t * t / (3 * T * T)) / 1000;
+}
+
+// Distance in pixels covered while coasting to a stop from ramp position r
+static double coast_distance(double r) { return held_distance(r) / F; }
+
+class MousekeyInertia : public TestFixture {
+   public:
+    void SetUp() override { mousekey_clear(); }
+
+    void expect_movement(TestDriver& driver) {
+        x = y = 0;
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_mouse_t& report) {
+            x += report.x;
+            y += report.y;
+        }));
+    }
+
+    void run_for(unsigned time, unsigned interval) {
+        for (unsigned i = 0; i < time; i += interval) {
+            advance_time(interval);
+            keyboard_task();
+        }
+    }
+
+    int x;
+    int y;
+};
+
+TEST_F(MousekeyInertia, TrajectoryFollowsCurveAtFullPollingRate) {
+    TestDriver driver;
+    expect_movement(driver);
+    press_key(0, 0);
+    keyboard_task();
+    for (unsigned t = 10; t <= 1000; t += 10) {
+        run_for(10, 1);
+        EXPECT_NEAR(x, held_distance(t), 1) << "at " << t << "ms";
+    }
+    EXPECT_EQ(y, 0);
+    release_key(0, 0);
+    keyboard_task();
+    mousekey_clear();
+}
+
+TEST_F(MousekeyInertia, TrajectoryDoesNotDependOnPollingRate) {
+    TestDriver driver;
+    int        reference[4];
+    unsigned   intervals[4] = {1, 2, 5, 8};
+
+    for (int i = 0; i < 4; i++) {
+        mousekey_clear();
+        expect_movement(driver);
+        press_key(0, 0);
+        keyboard_task();
+        run_for(800, intervals[i]);
+        reference[i] = x;
+        release_key(0, 0);
+        keyboard_task();
+        mousekey_clear();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+    }
+    EXPECT_NEAR(reference[0], held_distance(800), 1);
+    for (int i = 1; i < 4; i++) {
+        EXPECT_EQ(reference[i], reference[0]) << "at " << intervals[i] << "ms interval";
+    }
+}
+
+TEST_F(MousekeyInertia, CursorCoastsAfterRelease) {
+    TestDriver driver;
+    expect_movement(driver);
+    press_key(0, 0);
+    keyboard_task();
+    run_for(T, 1);
+    int held = x;
+    release_key(0, 0);
+    keyboard_task();
+    run_for(T, 1);
+    EXPECT_NEAR(x - held, coast_distance(T), 1);
+
+    // Cursor has come to rest
+    int stopped = x;
+    run_for(50, 1);
+    EXPECT_EQ(x, stopped);
+}
+
+TEST_F(MousekeyInertia, OppositeDirectionBrakesThenReverses) {
+    TestDriver driver;
+    expect_movement(driver);
+    press_key(0, 0);
+    keyboard_task();
+    run_for(T, 1);
+    release_key(0, 0);
+    press_key(1, 0);
+    keyboard_task();
+    int peak = x;
+    run_for(T / F, 1);
+    EXPECT_NEAR(x - peak, coast_distance(T), 1);
+    // The sub-pixel remainder from the first direction carries over into the reversal
+    int stopped = x;
+    run_for(100, 1);
+    EXPECT_NEAR(x - stopped, -held_distance(100), 2);
+    release_key(1, 0);
+    keyboard_task();
+    mousekey_clear();
+}
+
+TEST_F(MousekeyInertia, DiagonalMovementIsScaled) {
+    TestDriver driver;
+    expect_movement(driver);
+    press_key(0, 0);
+    press_key(2, 0);
+    keyboard_task();
+    keyboard_task();
+    run_for(500, 1);
+    EXPECT_EQ(x, y);
+    EXPECT_NEAR(x, held_distance(500) * 181 / 256, 2);
+    release_key(0, 0);
+    release_key(2, 0);
+    keyboard_task();
+    keyboard_task();
+    mousekey_clear();
+}
+
+TEST_F(MousekeyInertia, CappedReportsDoNotPileUp) {
+    TestDriver driver;
+    expect_movement(driver);
+    press_key(0, 0);
+    keyboard_task();
+    // At full speed 100ms is more than MOUSEKEY_MOVE_MAX pixels, so these reports are capped
+    run_for(T + 400, 100);
+    int held = x;
+    EXPECT_LT(held, held_distance(T + 400));
+    release_key(0, 0);
+    keyboard_task();
+    // What did not fit is dropped rather than sent after the release
+    run_for(T, 1);
+    EXPECT_NEAR(x - held, coast_distance(T), 1);
+}
@@ -0,0 +1,101 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+// Keycodes of handlers that are only called for their own keycodes still reach them, while the
+// keys in between are left alone.
+class ProcessRange : public TestFixture {};
+
+TEST_F(ProcessRange, BasicKeyIsNotHandled) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+    run_one_scan_loop();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(ProcessRange, GraveEscapeSeesPressAndRelease) {
+    TestDriver driver;
+    InSequence s;
+
+    press_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_ESC)));
+    run_one_scan_loop();
+    release_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+
+    press_key(5, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    run_one_scan_loop();
+    press_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_GRAVE)));
+    run_one_scan_loop();
+    release_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    run_one_scan_loop();
+    release_key(5, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(ProcessRange, TapDanceCountsTaps) {
+    TestDriver driver;
+    InSequence s;
+
+    // The second tap finishes the dance right away
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(testing::AtLeast(1));
+    for (int i = 0; i < 2; i++) {
+        press_key(2, 0);
+        run_one_scan_loop();
+        release_key(2, 0);
+        run_one_scan_loop();
+    }
+    idle_for(TAPPING_TERM + 10);
+}
+
+TEST_F(ProcessRange, SequencerActsOnPressOnly) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+
+    bool on = is_sequencer_on();
+    press_key(3, 0);
+    run_one_scan_loop();
+    EXPECT_NE(is_sequencer_on(), on);
+    release_key(3, 0);
+    run_one_scan_loop();
+    EXPECT_NE(is_sequencer_on(), on);
+}
+
+TEST_F(ProcessRange, UnicodeModeKey) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+
+    press_key(4, 0);
+    run_one_scan_loop();
+    release_key(4, 0);
+    run_one_scan_loop();
+    EXPECT_EQ(get_unicode_input_mode(), UC_LNX);
+}
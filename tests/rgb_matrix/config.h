@@ -0,0 +1,40 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// A 108 key board, an LED on every key
+#define MATRIX_ROWS 6
+#define MATRIX_COLS 18
+#define DRIVER_LED_TOTAL 108
+
+#define RGB_MATRIX_KEYPRESSES
+#define RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#define RGB_MATRIX_KEYFRAME_EFFECTS
+// Past everything else in the EEPROM of the tests
+#define LIGHTING_KEYFRAMES_EEPROM_ADDR 512
+#define LED_HITS_TO_REMEMBER 32
+#define RGB_MATRIX_LED_PROCESS_LIMIT DRIVER_LED_TOTAL
+
+// High enough not to limit the other tests, lowered by the power tests
+#define RGB_MATRIX_POWER_BUDGET_MA 65535
+
+#define RGB_MATRIX_RENDER_BUDGET_US 1000
+// A clock that moves on as LEDs are set, see keymap.c
+#define RGB_MATRIX_RENDER_TIMER_US() test_rgb_matrix_us
+
+#include <stdint.h>
+extern uint32_t test_rgb_matrix_us;
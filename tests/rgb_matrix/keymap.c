@@ -0,0 +1,83 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quantum.h"
+#include <string.h>
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+        {KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO},
+    },
+};
+
+// Rows 12.8 apart, columns 13.2 apart, over the whole 224 x 64 area
+led_config_t g_led_config = {
+    {
+        {  0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,  17},
+        { 18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35},
+        { 36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53},
+        { 54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71},
+        { 72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89},
+        { 90,  91,  92,  93,  94,  95,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107},
+    },
+    {
+        {  0,  0}, { 13,  0}, { 26,  0}, { 40,  0}, { 53,  0}, { 66,  0}, { 79,  0}, { 92,  0}, {105,  0}, {119,  0}, {132,  0}, {145,  0}, {158,  0}, {171,  0}, {184,  0}, {198,  0}, {211,  0}, {224,  0},
+        {  0, 13}, { 13, 13}, { 26, 13}, { 40, 13}, { 53, 13}, { 66, 13}, { 79, 13}, { 92, 13}, {105, 13}, {119, 13}, {132, 13}, {145, 13}, {158, 13}, {171, 13}, {184, 13}, {198, 13}, {211, 13}, {224, 13},
+        {  0, 26}, { 13, 26}, { 26, 26}, { 40, 26}, { 53, 26}, { 66, 26}, { 79, 26}, { 92, 26}, {105, 26}, {119, 26}, {132, 26}, {145, 26}, {158, 26}, {171, 26}, {184, 26}, {198, 26}, {211, 26}, {224, 26},
+        {  0, 38}, { 13, 38}, { 26, 38}, { 40, 38}, { 53, 38}, { 66, 38}, { 79, 38}, { 92, 38}, {105, 38}, {119, 38}, {132, 38}, {145, 38}, {158, 38}, {171, 38}, {184, 38}, {198, 38}, {211, 38}, {224, 38},
+        {  0, 51}, { 13, 51}, { 26, 51}, { 40, 51}, { 53, 51}, { 66, 51}, { 79, 51}, { 92, 51}, {105, 51}, {119, 51}, {132, 51}, {145, 51}, {158, 51}, {171, 51}, {184, 51}, {198, 51}, {211, 51}, {224, 51},
+        {  0, 64}, { 13, 64}, { 26, 64}, { 40, 64}, { 53, 64}, { 66, 64}, { 79, 64}, { 92, 64}, {105, 64}, {119, 64}, {132, 64}, {145, 64}, {158, 64}, {171, 64}, {184, 64}, {198, 64}, {211, 64}, {224, 64},
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    },
+};
+
+RGB      test_rgb_matrix_leds[DRIVER_LED_TOTAL];
+RGB      test_rgb_matrix_shown[DRIVER_LED_TOTAL];  // as of the last flush
+uint32_t test_rgb_matrix_us;
+uint16_t test_rgb_matrix_led_us;  // how long setting an LED takes
+
+static void init(void) {}
+
+static void flush(void) { memcpy(test_rgb_matrix_shown, test_rgb_matrix_leds, sizeof(test_rgb_matrix_shown)); }
+
+static void set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    test_rgb_matrix_leds[index] = (RGB){red, green, blue};
+    test_rgb_matrix_us += test_rgb_matrix_led_us;
+}
+
+static void set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        set_color(i, red, green, blue);
+    }
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .flush         = flush,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+};
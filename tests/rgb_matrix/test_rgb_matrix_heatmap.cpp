@@ -0,0 +1,176 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "lib/lib8tion/lib8tion.h"
+
+extern RGB test_rgb_matrix_leds[DRIVER_LED_TOTAL];
+
+RGB  rgb_matrix_hsv_to_rgb(HSV hsv);
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col);
+bool TYPING_HEATMAP(effect_params_t *params);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+// The effect as it was, going over the matrix and mapping every key to its LEDs
+void render_by_matrix(effect_params_t *params) {
+    for (int i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
+        uint8_t row = i % MATRIX_ROWS;
+        uint8_t col = i / MATRIX_ROWS;
+        uint8_t val = g_rgb_frame_buffer[row][col];
+
+        uint8_t led[LED_HITS_TO_REMEMBER];
+        uint8_t led_count = rgb_matrix_map_row_column_to_led(row, col, led);
+        for (uint8_t j = 0; j < led_count; ++j) {
+            if (!HAS_ANY_FLAGS(g_led_config.flags[led[j]], params->flags)) continue;
+
+            HSV hsv = {(uint8_t)(170 - qsub8(val, 85)), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+            RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+            rgb_matrix_set_color(led[j], rgb.r, rgb.g, rgb.b);
+        }
+    }
+}
+
+std::vector<uint32_t> leds() {
+    std::vector<uint32_t> colors;
+    for (const RGB &rgb : test_rgb_matrix_leds) {
+        colors.push_back((uint32_t)rgb.r << 16 | rgb.g << 8 | rgb.b);
+    }
+    return colors;
+}
+
+uint8_t led_at(uint8_t row, uint8_t col) { return g_led_config.matrix_co[row][col]; }
+
+uint8_t distance(uint8_t a, uint8_t b) {
+    int16_t dx = g_led_config.point[a].x - g_led_config.point[b].x;
+    int16_t dy = g_led_config.point[a].y - g_led_config.point[b].y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
+}  // namespace
+
+class RgbMatrixHeatmap : public TestFixture {
+   public:
+    TestDriver      driver;
+    effect_params_t params = {0, LED_FLAG_ALL, true, 0, DRIVER_LED_TOTAL};
+
+    RgbMatrixHeatmap() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+        // Start the effect by hand, at a known time
+        g_rgb_timer = 1000;
+        TYPING_HEATMAP(&params);
+        params.init = false;
+    }
+
+    void frame(uint32_t time) {
+        g_rgb_timer = time;
+        TYPING_HEATMAP(&params);
+    }
+};
+
+TEST_F(RgbMatrixHeatmap, HeatSpreadsByDistance) {
+    uint8_t hit = led_at(2, 8);
+    process_rgb_matrix_typing_heatmap(2, 8);
+
+    // Keys are about 13 apart both ways
+    EXPECT_EQ(g_rgb_led_buffer[hit], 32);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(2, 7)], 16);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(1, 8)], 16);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(3, 9)], 16);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(2, 10)], 40 - distance(hit, led_at(2, 10)));
+    EXPECT_EQ(g_rgb_led_buffer[led_at(0, 8)], 40 - distance(hit, led_at(0, 8)));
+    EXPECT_EQ(g_rgb_led_buffer[led_at(0, 10)], 40 - distance(hit, led_at(0, 10)));
+    EXPECT_GT(g_rgb_led_buffer[led_at(0, 10)], 0);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(2, 12)], 0);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(5, 0)], 0);
+
+    // Saturates
+    for (int i = 0; i < 10; i++) {
+        process_rgb_matrix_typing_heatmap(2, 8);
+    }
+    EXPECT_EQ(g_rgb_led_buffer[led_at(2, 8)], 255);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(2, 7)], 16 * 11);
+}
+
+TEST_F(RgbMatrixHeatmap, PressedKeysHeatUp) {
+    press_key(8, 2);
+    run_one_scan_loop();
+    EXPECT_GE(g_rgb_led_buffer[led_at(2, 8)], 31);
+    EXPECT_EQ(g_rgb_led_buffer[led_at(5, 0)], 0);
+    release_key(8, 2);
+    run_one_scan_loop();
+}
+
+TEST_F(RgbMatrixHeatmap, DecayDoesNotDependOnFrameRate) {
+    for (uint32_t interval : {1, 5, 16, 24, 25, 40, 333}) {
+        memset(g_rgb_led_buffer, 200, sizeof g_rgb_led_buffer);
+        uint32_t start = g_rgb_timer;
+        for (uint32_t t = interval; t <= 1000; t += interval) {
+            frame(start + t);
+        }
+        frame(start + 1000);
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            ASSERT_EQ(g_rgb_led_buffer[i], 200 - 1000 / 25) << "every " << interval << "ms";
+        }
+    }
+}
+
+TEST_F(RgbMatrixHeatmap, FrameCostBenchmark) {
+    using clock = std::chrono::steady_clock;
+
+    // The same heat both ways: every key has its own LED
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        g_rgb_led_buffer[i] = i * 7;
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            g_rgb_frame_buffer[row][col] = g_rgb_led_buffer[led_at(row, col)];
+        }
+    }
+    render_by_matrix(&params);
+    std::vector<uint32_t> expected = leds();
+    TYPING_HEATMAP(&params);
+    rgb_matrix_flush_hsv();
+    ASSERT_EQ(leds(), expected);
+
+    const int frames = 20000;
+    auto      start  = clock::now();
+    for (int f = 0; f < frames; f++) {
+        render_by_matrix(&params);
+    }
+    auto by_matrix = clock::now() - start;
+
+    start = clock::now();
+    for (int f = 0; f < frames; f++) {
+        TYPING_HEATMAP(&params);
+        rgb_matrix_flush_hsv();
+    }
+    auto by_led = clock::now() - start;
+
+    printf("%u LEDs: by matrix %.2f us, by LED %.2f us per frame\n", DRIVER_LED_TOTAL, std::chrono::duration<double, std::micro>(by_matrix).count() / frames, std::chrono::duration<double, std::micro>(by_led).count() / frames);
+}
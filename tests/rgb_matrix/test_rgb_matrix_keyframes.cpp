@@ -0,0 +1,143 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include "eeprom.h"
+
+extern RGB test_rgb_matrix_leds[DRIVER_LED_TOTAL];
+
+RGB  rgb_matrix_hsv_to_rgb(HSV hsv);
+bool KEYFRAMES(effect_params_t *params);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+// Breathing white
+const std::vector<uint8_t> breathing = {
+    LK_VERSION, LK_TIME, LK_PERIOD(2000), LK_EASE, LK_EASE_SINE, LK_GRADIENT, LK_SAT | LK_VAL, 2, 0, 0, 0, 0, 255, 0, 0, 255, LK_END,
+};
+
+std::vector<uint8_t> program() {
+    std::vector<uint8_t> program(LIGHTING_KEYFRAMES_SIZE);
+    lighting_keyframes_get_buffer(0, program.size(), program.data());
+    return program;
+}
+
+// In pieces, the way VIA sends them
+void upload(const std::vector<uint8_t> &program) {
+    for (size_t offset = 0; offset < program.size(); offset += 27) {
+        lighting_keyframes_set_buffer(offset, std::min<size_t>(27, program.size() - offset), &program[offset]);
+    }
+}
+
+bool operator==(const RGB &a, const RGB &b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+
+uint8_t brightest(const RGB &rgb) { return std::max({rgb.r, rgb.g, rgb.b}); }
+
+uint8_t darkest(const RGB &rgb) { return std::min({rgb.r, rgb.g, rgb.b}); }
+
+}  // namespace
+
+class RgbMatrixKeyframes : public TestFixture {
+   public:
+    TestDriver      driver;
+    effect_params_t params = {0, LED_FLAG_ALL, false, 0, DRIVER_LED_TOTAL};
+
+    RgbMatrixKeyframes() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_KEYFRAMES);
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+        rgb_matrix_set_speed_noeeprom(127);
+        lighting_keyframes_reset();
+    }
+
+    RGB render(uint32_t time, uint8_t led) {
+        g_rgb_timer = time;
+        KEYFRAMES(&params);
+        rgb_matrix_flush_hsv();
+        return test_rgb_matrix_leds[led];
+    }
+
+    // As the driver gets it
+    RGB expected(uint8_t led, HSV hsv) {
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(led, rgb.r, rgb.g, rgb.b);
+        return test_rgb_matrix_leds[led];
+    }
+};
+
+TEST_F(RgbMatrixKeyframes, DefaultIsARainbowAcross) {
+    for (uint32_t time : {0, 1000, 2500, 3999, 12345}) {
+        // A period of 4 seconds
+        uint8_t phase = (time % 4000) * 256 / 4000;
+        for (uint8_t led = 0; led < DRIVER_LED_TOTAL; led += 7) {
+            HSV hsv = {(uint8_t)(phase + g_led_config.point[led].x), 255, 255};
+            EXPECT_TRUE(render(time, led) == expected(led, hsv)) << time << " " << (int)led;
+        }
+    }
+}
+
+TEST_F(RgbMatrixKeyframes, UploadedProgramsRunRightAway) {
+    upload(breathing);
+    EXPECT_LE(brightest(render(0, 0)), 2);
+    EXPECT_GE(darkest(render(1000, 0)), 253);
+    EXPECT_GE(darkest(render(1000, DRIVER_LED_TOTAL - 1)), 253);
+
+    // Back as it was read
+    std::vector<uint8_t> read = program();
+    EXPECT_EQ(std::vector<uint8_t>(read.begin(), read.begin() + breathing.size()), breathing);
+    uint8_t past[4] = {1, 1, 1, 1};
+    lighting_keyframes_get_buffer(LIGHTING_KEYFRAMES_SIZE - 2, sizeof past, past);
+    EXPECT_EQ(past[2], 0);
+    EXPECT_EQ(past[3], 0);
+}
+
+TEST_F(RgbMatrixKeyframes, InvalidProgramsAreOff) {
+    uint8_t version = LK_VERSION + 1;
+    lighting_keyframes_set_buffer(0, 1, &version);
+    EXPECT_EQ(lighting_keyframes_get_program(), nullptr);
+    EXPECT_TRUE(render(1000, 5) == ((RGB){0, 0, 0}));
+
+    // Past the end is left alone
+    uint8_t past = 0x55;
+    lighting_keyframes_set_buffer(LIGHTING_KEYFRAMES_SIZE, 1, &past);
+    version = LK_VERSION;
+    lighting_keyframes_set_buffer(0, 1, &version);
+    EXPECT_NE(lighting_keyframes_get_program(), nullptr);
+}
+
+TEST_F(RgbMatrixKeyframes, SavedProgramsAreLoaded) {
+    std::vector<uint8_t> rainbow = program();
+    upload(breathing);
+    lighting_keyframes_save();
+
+    upload(rainbow);
+    lighting_keyframes_load();
+    EXPECT_EQ(program()[1], breathing[1]);
+    EXPECT_GE(darkest(render(1000, 0)), 253);
+
+    // What is in EEPROM is used only when it is valid
+    eeprom_update_byte((uint8_t *)LIGHTING_KEYFRAMES_EEPROM_ADDR, 0xFF);
+    lighting_keyframes_load();
+    EXPECT_EQ(program(), rainbow);
+}
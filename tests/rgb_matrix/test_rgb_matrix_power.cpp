@@ -0,0 +1,124 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <cstdio>
+
+extern "C" {
+extern RGB test_rgb_matrix_leds[DRIVER_LED_TOTAL];
+extern RGB test_rgb_matrix_shown[DRIVER_LED_TOTAL];
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+struct draw_t {
+    uint16_t peak;
+    uint16_t average;
+};
+
+// What the LEDs draw, worked out the same way as the limiter does
+uint16_t draw_ma(const RGB *leds) {
+    uint32_t load = 0;
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        const RGB &rgb = leds[i];
+        load += rgb.r + rgb.g + rgb.b;
+    }
+    return DRIVER_LED_TOTAL * LIGHTING_POWER_IDLE_UA / 1000 + load * LIGHTING_POWER_MA_PER_CHANNEL / 255;
+}
+
+}  // namespace
+
+class RgbMatrixPower : public TestFixture {
+   public:
+    TestDriver driver;
+
+    RgbMatrixPower() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        rgb_matrix_sethsv_noeeprom(0, 0, 255);
+        rgb_matrix_set_speed_noeeprom(127);
+    }
+
+    ~RgbMatrixPower() { rgb_matrix_set_power_budget(RGB_MATRIX_POWER_BUDGET_MA); }
+
+    // Runs an effect for a while, typing a key every 20ms
+    draw_t replay(uint8_t mode, uint16_t budget_ma, unsigned ms = 1000) {
+        draw_t   draw  = {0, 0};
+        uint32_t total = 0;
+
+        rgb_matrix_set_power_budget(budget_ma);
+        rgb_matrix_mode_noeeprom(mode);
+        // Long enough for the scale to come back up from the last effect
+        idle_for(LIGHTING_POWER_RELEASE_MS + 100);
+        for (unsigned t = 0; t < ms; t++) {
+            if (t % 20 == 0) press_key(t / 20 % MATRIX_COLS, t / 60 % MATRIX_ROWS);
+            if (t % 20 == 10) release_key(t / 20 % MATRIX_COLS, t / 60 % MATRIX_ROWS);
+            run_one_scan_loop();
+            uint16_t ma = draw_ma(test_rgb_matrix_shown);
+            draw.peak   = std::max(draw.peak, ma);
+            total += ma;
+        }
+        draw.average = total / ms;
+        return draw;
+    }
+};
+
+TEST_F(RgbMatrixPower, EstimatesWhatTheDriverIsGiven) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    idle_for(100);
+    EXPECT_EQ(rgb_matrix_get_power_draw_ma(), draw_ma(test_rgb_matrix_leds));
+    EXPECT_EQ(rgb_matrix_get_power_draw_ma(), DRIVER_LED_TOTAL + DRIVER_LED_TOTAL * 3 * LIGHTING_POWER_MA_PER_CHANNEL);
+}
+
+TEST_F(RgbMatrixPower, KeepsEveryEffectWithinTheBudget) {
+    const uint16_t budget = 1500;
+
+    printf("%4s %14s %14s %14s %14s\n", "mode", "peak mA", "average mA", "limited peak", "limited avg");
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        draw_t full    = replay(mode, UINT16_MAX);
+        draw_t limited = replay(mode, budget);
+        printf("%4u %14u %14u %14u %14u\n", mode, full.peak, full.average, limited.peak, limited.average);
+        EXPECT_LE(limited.peak, budget) << "mode " << (int)mode;
+    }
+}
+
+TEST_F(RgbMatrixPower, LeavesDimEffectsAlone) {
+    rgb_matrix_sethsv_noeeprom(0, 0, 64);
+    draw_t full    = replay(RGB_MATRIX_SOLID_COLOR, UINT16_MAX, 100);
+    draw_t limited = replay(RGB_MATRIX_SOLID_COLOR, 2000, 100);
+    EXPECT_LT(full.peak, 2000);
+    EXPECT_EQ(limited.peak, full.peak);
+    EXPECT_EQ(limited.average, full.average);
+}
+
+TEST_F(RgbMatrixPower, ComesBackUpSlowly) {
+    rgb_matrix_set_power_budget(1500);
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    idle_for(100);
+    uint8_t limited = test_rgb_matrix_shown[0].r;
+    EXPECT_LT(limited, 255 / 4);
+
+    // About a quarter of the way back up after a quarter of the release time, give or take a frame
+    rgb_matrix_set_power_budget(UINT16_MAX);
+    idle_for(LIGHTING_POWER_RELEASE_MS / 4);
+    EXPECT_GT(test_rgb_matrix_shown[0].r, limited + 255 / 5);
+    EXPECT_LT(test_rgb_matrix_shown[0].r, limited + 255 / 3);
+    idle_for(LIGHTING_POWER_RELEASE_MS);
+    EXPECT_EQ(test_rgb_matrix_shown[0].r, 255);
+}
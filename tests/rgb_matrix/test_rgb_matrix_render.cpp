@@ -0,0 +1,144 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <cstdio>
+
+extern "C" {
+extern uint16_t test_rgb_matrix_led_us;
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class RgbMatrixRender : public TestFixture {
+   public:
+    TestDriver driver;
+
+    RgbMatrixRender() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        test_rgb_matrix_led_us = 0;
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        idle_for(100);
+    }
+
+    ~RgbMatrixRender() { test_rgb_matrix_led_us = 0; }
+
+    // How long the LEDs took in one scan
+    uint32_t scan() {
+        uint32_t start = test_rgb_matrix_us;
+        run_one_scan_loop();
+        return test_rgb_matrix_us - start;
+    }
+
+    uint32_t longest_scan(unsigned ms) {
+        uint32_t longest = 0;
+        for (unsigned t = 0; t < ms; t++) {
+            longest = std::max(longest, scan());
+        }
+        return longest;
+    }
+
+    // A key every 20ms
+    uint32_t longest_scan_typing(unsigned ms) {
+        uint32_t longest = 0;
+        for (unsigned t = 0; t < ms; t++) {
+            if (t % 20 == 0) press_key(t / 20 % MATRIX_COLS, 1);
+            if (t % 20 == 10) release_key(t / 20 % MATRIX_COLS, 1);
+            longest = std::max(longest, scan());
+        }
+        return longest;
+    }
+};
+
+TEST_F(RgbMatrixRender, StaysWithinTheBudget) {
+    for (uint16_t cost : {2, 10, 40, 333}) {
+        test_rgb_matrix_led_us = cost;
+        idle_for(200);
+        EXPECT_LE(longest_scan(500), RGB_MATRIX_RENDER_BUDGET_US) << cost << "us per LED";
+        // Uses most of it when there is more to do
+        if (cost * DRIVER_LED_TOTAL > RGB_MATRIX_RENDER_BUDGET_US) {
+            EXPECT_GT(longest_scan(500), RGB_MATRIX_RENDER_BUDGET_US - cost) << cost << "us per LED";
+        }
+    }
+}
+
+TEST_F(RgbMatrixRender, AdaptsToTheEffect) {
+    // The stats are for the last whole second
+    test_rgb_matrix_led_us = 5;
+    idle_for(2100);
+    EXPECT_EQ(rgb_matrix_get_render_stats().led_cost, 5 * 16);
+    EXPECT_EQ(rgb_matrix_get_render_stats().overruns, 0);
+
+    // Gets ten times heavier: over the budget at first, then back in it within a few frames
+    test_rgb_matrix_led_us = 50;
+    EXPECT_GT(longest_scan(20), RGB_MATRIX_RENDER_BUDGET_US);
+    idle_for(80);
+    EXPECT_LE(longest_scan(2000), RGB_MATRIX_RENDER_BUDGET_US);
+    EXPECT_EQ(rgb_matrix_get_render_stats().led_cost, 50 * 16);
+    EXPECT_EQ(rgb_matrix_get_render_stats().overruns, 0);
+}
+
+TEST_F(RgbMatrixRender, AveragesACostThatJitters) {
+    // Like a coarse clock, that sees either nothing or a lot: the estimate settles around the mean
+    for (unsigned t = 0; t < 2100; t++) {
+        test_rgb_matrix_led_us = t % 2 ? 0 : 10;
+        run_one_scan_loop();
+    }
+    EXPECT_GE(rgb_matrix_get_render_stats().led_cost, 4 * 16);
+    EXPECT_LT(rgb_matrix_get_render_stats().led_cost, 6 * 16);
+}
+
+TEST_F(RgbMatrixRender, BacksOffWhileTyping) {
+    test_rgb_matrix_led_us = 10;
+    idle_for(200);
+    EXPECT_LE(longest_scan_typing(500), RGB_MATRIX_RENDER_BACKOFF_BUDGET_US);
+
+    // Back to the whole budget once the keys stop
+    idle_for(RGB_MATRIX_RENDER_BACKOFF_MS);
+    EXPECT_GT(longest_scan(100), RGB_MATRIX_RENDER_BACKOFF_BUDGET_US);
+}
+
+TEST_F(RgbMatrixRender, ReportsFramesPerSecond) {
+    // A frame in one go
+    test_rgb_matrix_led_us = 2;
+    idle_for(2100);
+    EXPECT_GE(rgb_matrix_get_render_stats().fps, 1000 / (RGB_MATRIX_LED_FLUSH_LIMIT + 3));
+    EXPECT_LE(rgb_matrix_get_render_stats().fps, 1000 / RGB_MATRIX_LED_FLUSH_LIMIT);
+    EXPECT_EQ(rgb_matrix_get_render_stats().overruns, 0);
+
+    // One LED is over the budget, so a frame takes a scan for every LED, each one an overrun
+    test_rgb_matrix_led_us = RGB_MATRIX_RENDER_BUDGET_US + 1;
+    idle_for(2100);
+    EXPECT_LE(rgb_matrix_get_render_stats().fps, 1000 / DRIVER_LED_TOTAL + 1);
+    EXPECT_GE(rgb_matrix_get_render_stats().overruns, 900);
+}
+
+TEST_F(RgbMatrixRender, Benchmark) {
+    const unsigned fixed_limit = (DRIVER_LED_TOTAL + 4) / 5;
+
+    printf("%u LEDs, %uus budget, %uus while typing, longest scan in us\n", DRIVER_LED_TOTAL, RGB_MATRIX_RENDER_BUDGET_US, RGB_MATRIX_RENDER_BACKOFF_BUDGET_US);
+    printf("%8s %8s %8s %8s %12s\n", "us/LED", "fps", "idle", "typing", "fixed limit");
+    for (uint16_t cost : {1, 5, 10, 25, 50, 100, 250}) {
+        test_rgb_matrix_led_us = cost;
+        idle_for(1000);
+        uint32_t idle   = longest_scan(1000);
+        uint32_t typing = longest_scan_typing(1000);
+        printf("%8u %8u %8u %8u %12u\n", cost, rgb_matrix_get_render_stats().fps, idle, typing, fixed_limit * cost);
+        EXPECT_LE(idle, std::max<uint32_t>(RGB_MATRIX_RENDER_BUDGET_US, cost));
+    }
+}
@@ -0,0 +1,262 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C" {
+#include "lib/lib8tion/lib8tion.h"
+
+extern RGB test_rgb_matrix_leds[DRIVER_LED_TOTAL];
+
+RGB  rgb_matrix_hsv_to_rgb(HSV hsv);
+
+bool MULTISPLASH(effect_params_t *params);
+bool SOLID_MULTISPLASH(effect_params_t *params);
+bool SOLID_REACTIVE_MULTIWIDE(effect_params_t *params);
+bool SOLID_REACTIVE_MULTICROSS(effect_params_t *params);
+bool SOLID_REACTIVE_MULTINEXUS(effect_params_t *params);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+// The effects as they were, every hit run for every LED
+
+HSV splash(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick - dist;
+    if (effect > 254) return hsv;
+    hsv.h += effect;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV solid_splash(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick - dist;
+    if (effect > 255) effect = 255;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV wide(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick + dist * 5;
+    if (effect > 255) effect = 255;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV cross(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick + dist;
+    dx              = dx < 0 ? dx * -1 : dx;
+    dy              = dy < 0 ? dy * -1 : dy;
+    dx              = dx * 16 > 255 ? 255 : dx * 16;
+    dy              = dy * 16 > 255 ? 255 : dy * 16;
+    effect += dx > dy ? dy : dx;
+    if (effect > 255) effect = 255;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    return hsv;
+}
+
+HSV nexus(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    uint16_t effect = tick - dist;
+    if (effect > 255) effect = 255;
+    if (dist > 72) effect = 255;
+    if ((dx > 8 || dx < -8) && (dy > 8 || dy < -8)) effect = 255;
+    hsv.v = qadd8(hsv.v, 255 - effect);
+    hsv.h = rgb_matrix_config.hsv.h + dy / 4;
+    return hsv;
+}
+
+typedef HSV (*math_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+
+void render_reference(math_f math) {
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        HSV hsv = rgb_matrix_config.hsv;
+        hsv.v   = 0;
+        for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            uint8_t  dist = sqrt16(dx * dx + dy * dy);
+            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], rgb_matrix_config.speed);
+            hsv           = math(hsv, dx, dy, dist, tick);
+        }
+        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+}
+
+struct Effect {
+    const char *name;
+    bool (*effect)(effect_params_t *params);
+    math_f math;
+};
+
+const Effect effects[] = {
+    {"MULTISPLASH", MULTISPLASH, splash},
+    {"SOLID_MULTISPLASH", SOLID_MULTISPLASH, solid_splash},
+    {"MULTIWIDE", SOLID_REACTIVE_MULTIWIDE, wide},
+    {"MULTICROSS", SOLID_REACTIVE_MULTICROSS, cross},
+    {"MULTINEXUS", SOLID_REACTIVE_MULTINEXUS, nexus},
+};
+
+// Colors of the LEDs, as 0xRRGGBB
+std::vector<uint32_t> leds() {
+    std::vector<uint32_t> colors;
+    for (const RGB &rgb : test_rgb_matrix_leds) {
+        colors.push_back((uint32_t)rgb.r << 16 | rgb.g << 8 | rgb.b);
+    }
+    return colors;
+}
+
+}  // namespace
+
+class RgbMatrixSplash : public TestFixture {
+   public:
+    TestDriver driver;
+
+    RgbMatrixSplash() {
+        // No key on the board sends anything
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_MULTISPLASH);
+        rgb_matrix_sethsv_noeeprom(40, 255, 255);
+        rgb_matrix_set_speed_noeeprom(127);
+        // Let the hits of the last test run out
+        idle_for(5000);
+    }
+
+    void tap(uint8_t led) {
+        press_key(led % MATRIX_COLS, led / MATRIX_COLS);
+        run_one_scan_loop();
+        release_key(led % MATRIX_COLS, led / MATRIX_COLS);
+        run_one_scan_loop();
+    }
+
+    // A fast typist: bursts of keys 40ms apart, with the hand moving over the board
+    std::vector<last_hit_t> type_bursts(unsigned bursts) {
+        std::vector<last_hit_t> frames;
+        uint8_t                 led = 3;
+        for (unsigned b = 0; b < bursts; b++) {
+            for (unsigned k = 0; k < 12; k++) {
+                led = (led + 37) % DRIVER_LED_TOTAL;
+                tap(led);
+                for (unsigned t = 0; t < 38; t++) {
+                    run_one_scan_loop();
+                    if (t % 16 == 0) frames.push_back(g_last_hit_tracker);
+                }
+            }
+            for (unsigned t = 0; t < 300; t++) {
+                run_one_scan_loop();
+                if (t % 16 == 0) frames.push_back(g_last_hit_tracker);
+            }
+        }
+        return frames;
+    }
+};
+
+TEST_F(RgbMatrixSplash, NewestHitsAreKeptInOrder) {
+    for (uint8_t led = 0; led < LED_HITS_TO_REMEMBER + 5; led++) {
+        tap(led);
+    }
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+
+    ASSERT_EQ(g_last_hit_tracker.count, LED_HITS_TO_REMEMBER);
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; i++) {
+        EXPECT_EQ(g_last_hit_tracker.index[i], i + 5);
+        EXPECT_EQ(g_last_hit_tracker.x[i], g_led_config.point[i + 5].x);
+        EXPECT_EQ(g_last_hit_tracker.y[i], g_led_config.point[i + 5].y);
+        if (i) {
+            EXPECT_GE(g_last_hit_tracker.tick[i - 1], g_last_hit_tracker.tick[i]);
+        }
+    }
+}
+
+TEST_F(RgbMatrixSplash, HitsExpireOnceOffTheBoard) {
+    // Top left corner: the farthest LED is the bottom right one
+    tap(0);
+    uint8_t  reach = sqrt16(224 * 224 + 64 * 64);
+    uint32_t gone  = ((uint32_t)255 + reach) * 256 / (rgb_matrix_config.speed + 1);
+
+    idle_for(gone - 50);
+    EXPECT_EQ(g_last_hit_tracker.count, 1);
+    idle_for(100);
+    EXPECT_EQ(g_last_hit_tracker.count, 0);
+
+    // The middle of the board is left sooner
+    tap(DRIVER_LED_TOTAL / 2 + MATRIX_COLS / 2);
+    idle_for(gone - 150);
+    EXPECT_EQ(g_last_hit_tracker.count, 0);
+}
+
+TEST_F(RgbMatrixSplash, CulledEffectsMatchEveryHitRun) {
+    std::vector<last_hit_t> frames = type_bursts(3);
+    effect_params_t         params = {0, LED_FLAG_ALL, false, 0, DRIVER_LED_TOTAL};
+
+    for (const Effect &effect : effects) {
+        for (uint8_t speed : {32, 127, 255}) {
+            rgb_matrix_config.speed = speed;
+            for (size_t f = 0; f < frames.size(); f++) {
+                g_last_hit_tracker = frames[f];
+                render_reference(effect.math);
+                std::vector<uint32_t> expected = leds();
+                effect.effect(&params);
+                rgb_matrix_flush_hsv();
+                ASSERT_EQ(leds(), expected) << effect.name << " speed " << (int)speed << " frame " << f;
+            }
+        }
+    }
+}
+
+TEST_F(RgbMatrixSplash, TypingBurstBenchmark) {
+    std::vector<last_hit_t> frames = type_bursts(4);
+    effect_params_t         params = {0, LED_FLAG_ALL, false, 0, DRIVER_LED_TOTAL};
+    unsigned                hits   = 0;
+    for (const last_hit_t &frame : frames) {
+        hits += frame.count;
+    }
+
+    printf("%u frames of %u LEDs, %.1f hits on average\n", (unsigned)frames.size(), DRIVER_LED_TOTAL, (double)hits / frames.size());
+    printf("%-18s %14s %14s\n", "", "every hit us", "culled us");
+    for (const Effect &effect : effects) {
+        using clock = std::chrono::steady_clock;
+
+        auto start = clock::now();
+        for (int r = 0; r < 10; r++) {
+            for (const last_hit_t &frame : frames) {
+                g_last_hit_tracker = frame;
+                render_reference(effect.math);
+            }
+        }
+        auto every = clock::now() - start;
+
+        start = clock::now();
+        for (int r = 0; r < 10; r++) {
+            for (const last_hit_t &frame : frames) {
+                g_last_hit_tracker = frame;
+                effect.effect(&params);
+                rgb_matrix_flush_hsv();
+            }
+        }
+        auto culled = clock::now() - start;
+
+        printf("%-18s %14.2f %14.2f\n", effect.name, std::chrono::duration<double, std::micro>(every).count() / (10 * frames.size()), std::chrono::duration<double, std::micro>(culled).count() / (10 * frames.size()));
+    }
+    EXPECT_GT(hits, frames.size() * 4);
+}
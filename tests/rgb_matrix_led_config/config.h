@@ -0,0 +1,44 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Two rows of three keys: one with two LEDs, one with three, one without any, and two underglow LEDs
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 3
+#define DRIVER_LED_TOTAL 10
+
+#define RGB_MATRIX_KEYPRESSES
+#define RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#define RGB_MATRIX_LED_PROCESS_LIMIT DRIVER_LED_TOTAL
+
+// As `qmk generate-led-config` makes them from an rgb_matrix layout with these matrix positions:
+// [0, 0], [0, 1], [0, 1], [0, 1], [1, 0], [1, 1], [1, 2], [0, 0], none, none
+// clang-format off
+#define RGB_MATRIX_KEY_LED_OFFSETS 0, 2, 5, 5, 6, 7, 8
+#define RGB_MATRIX_KEY_LEDS 0, 7, 1, 2, 3, 4, 5, 6
+#define RGB_MATRIX_LED_KEYS {0, 0}, {0, 1}, {0, 1}, {0, 1}, {1, 0}, {1, 1}, {1, 2}, {0, 0}, {255, 255}, {255, 255}
+#define RGB_MATRIX_KEY_LEDS_MAX 3
+#define RGB_MATRIX_LED_CONFIG \
+{ \
+    { \
+        {0, 1, NO_LED}, \
+        {4, 5, 6}, \
+    }, \
+    {{0, 0}, {75, 0}, {112, 0}, {149, 0}, {0, 32}, {112, 32}, {224, 32}, {37, 0}, {0, 64}, {224, 64}}, \
+    {4, 4, 4, 4, 4, 4, 4, 4, 2, 2}, \
+}
+// clang-format on
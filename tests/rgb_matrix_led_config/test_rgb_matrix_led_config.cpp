@@ -0,0 +1,101 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <vector>
+
+extern "C" {
+extern RGB test_rgb_matrix_leds[DRIVER_LED_TOTAL];
+
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col);
+bool DIGITAL_RAIN(effect_params_t *params);
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace {
+
+std::vector<uint8_t> leds_of(uint8_t row, uint8_t col) {
+    uint8_t led[LED_HITS_TO_REMEMBER];
+    uint8_t led_count = rgb_matrix_map_row_column_to_led(row, col, led);
+    return std::vector<uint8_t>(led, led + led_count);
+}
+
+}  // namespace
+
+class RgbMatrixLedConfig : public TestFixture {
+   public:
+    TestDriver driver;
+
+    RgbMatrixLedConfig() { EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()); }
+};
+
+TEST_F(RgbMatrixLedConfig, MapsKeysToAllTheirLeds) {
+    EXPECT_THAT(leds_of(0, 0), ElementsAre(0, 7));
+    EXPECT_THAT(leds_of(0, 1), ElementsAre(1, 2, 3));
+    EXPECT_THAT(leds_of(0, 2), IsEmpty());
+    EXPECT_THAT(leds_of(1, 0), ElementsAre(4));
+    EXPECT_THAT(leds_of(1, 1), ElementsAre(5));
+    EXPECT_THAT(leds_of(1, 2), ElementsAre(6));
+}
+
+TEST_F(RgbMatrixLedConfig, MapsLedsBackToTheirKeys) {
+    const uint8_t keys[][2] = {{0, 0}, {0, 1}, {0, 1}, {0, 1}, {1, 0}, {1, 1}, {1, 2}, {0, 0}};
+    uint8_t       row, col;
+
+    for (uint8_t led = 0; led < 8; led++) {
+        ASSERT_TRUE(rgb_matrix_map_led_to_row_column(led, &row, &col)) << (int)led;
+        EXPECT_EQ(row, keys[led][0]) << (int)led;
+        EXPECT_EQ(col, keys[led][1]) << (int)led;
+    }
+    EXPECT_FALSE(rgb_matrix_map_led_to_row_column(8, &row, &col));
+    EXPECT_FALSE(rgb_matrix_map_led_to_row_column(9, &row, &col));
+}
+
+TEST_F(RgbMatrixLedConfig, KeypressesHitEveryLedOfTheKey) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_REACTIVE_SIMPLE);
+    press_key(1, 0);
+    idle_for(50);
+    ASSERT_EQ(g_last_hit_tracker.count, 3);
+    EXPECT_THAT(std::vector<uint8_t>(g_last_hit_tracker.index, g_last_hit_tracker.index + 3), ElementsAre(1, 2, 3));
+    release_key(1, 0);
+    idle_for(50);
+}
+
+TEST_F(RgbMatrixLedConfig, HeatmapHeatsEveryLedOfTheKey) {
+    memset(g_rgb_led_buffer, 0, sizeof(g_rgb_led_buffer));
+    process_rgb_matrix_typing_heatmap(0, 0);
+    // Both get the heat of the hit, and a little from each other
+    EXPECT_GE(g_rgb_led_buffer[0], 32);
+    EXPECT_EQ(g_rgb_led_buffer[7], g_rgb_led_buffer[0]);
+    EXPECT_EQ(g_rgb_led_buffer[6], 0);
+}
+
+TEST_F(RgbMatrixLedConfig, DigitalRainLightsEveryLedOfTheKey) {
+    effect_params_t params = {0, LED_FLAG_ALL, true, 0, DRIVER_LED_TOTAL};
+    DIGITAL_RAIN(&params);
+    params.init              = false;
+    g_rgb_frame_buffer[0][1] = 0xff;
+    DIGITAL_RAIN(&params);
+    for (uint8_t led = 1; led <= 3; led++) {
+        EXPECT_EQ(test_rgb_matrix_leds[led].r, 0xc0) << (int)led;
+        EXPECT_EQ(test_rgb_matrix_leds[led].g, 0xff) << (int)led;
+    }
+    EXPECT_EQ(test_rgb_matrix_leds[8].g, 0);
+}
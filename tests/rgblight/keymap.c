@@ -0,0 +1,35 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quantum.h"
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_NO, KC_NO, KC_NO, KC_NO},
+    },
+};
+
+// The strip, which keeps what it was last sent past the LEDs it is sent
+LED_TYPE test_ws2812_leds[RGBLED_NUM];
+uint32_t test_ws2812_bytes;
+uint16_t test_ws2812_calls;
+
+void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds) {
+    for (uint16_t i = 0; i < number_of_leds; i++) {
+        test_ws2812_leds[i] = ledarray[i];
+    }
+    test_ws2812_bytes += number_of_leds * sizeof(LED_TYPE);
+    test_ws2812_calls++;
+}
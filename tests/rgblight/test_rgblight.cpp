@@ -0,0 +1,182 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+extern LED_TYPE test_ws2812_leds[RGBLED_NUM];
+extern uint32_t test_ws2812_bytes;
+extern uint16_t test_ws2812_calls;
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class Rgblight : public TestFixture {
+   public:
+    TestDriver driver;
+
+    Rgblight() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        rgblight_enable_noeeprom();
+        rgblight_sethsv_noeeprom(0, 255, 255);
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        idle_for(100);
+        test_ws2812_bytes = 0;
+        test_ws2812_calls = 0;
+    }
+
+    ~Rgblight() { rgblight_set_power_budget(RGBLIGHT_POWER_BUDGET_MA); }
+
+    // What the strip draws, worked out the same way as the power limit does
+    uint16_t strip_draw_ma() {
+        uint32_t load = 0;
+        for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+            load += test_ws2812_leds[i].r + test_ws2812_leds[i].g + test_ws2812_leds[i].b;
+        }
+        return RGBLED_NUM * LIGHTING_POWER_IDLE_UA / 1000 + load * LIGHTING_POWER_MA_PER_CHANNEL / 255;
+    }
+
+    // Whether the strip shows every LED, in the order it is wired
+    void expect_strip() {
+        for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+            const LED_TYPE &expected = led[RGBLED_NUM - 1 - i];
+            EXPECT_EQ(test_ws2812_leds[i].r, expected.r) << i;
+            EXPECT_EQ(test_ws2812_leds[i].g, expected.g) << i;
+            EXPECT_EQ(test_ws2812_leds[i].b, expected.b) << i;
+        }
+    }
+};
+
+TEST_F(Rgblight, SendsTheStripUpToTheChangedLed) {
+    // The last LED of the effects is the first on the strip
+    rgblight_setrgb_at(1, 2, 3, RGBLED_NUM - 1);
+    EXPECT_EQ(test_ws2812_calls, 1);
+    EXPECT_EQ(test_ws2812_bytes, sizeof(LED_TYPE));
+    expect_strip();
+
+    rgblight_setrgb_at(4, 5, 6, 0);
+    EXPECT_EQ(test_ws2812_bytes, sizeof(LED_TYPE) + RGBLED_NUM * sizeof(LED_TYPE));
+    expect_strip();
+}
+
+TEST_F(Rgblight, SendsNothingWhenNothingChanged) {
+    rgblight_set();
+    rgblight_setrgb_at(led[3].r, led[3].g, led[3].b, 3);
+    EXPECT_EQ(test_ws2812_calls, 0);
+}
+
+TEST_F(Rgblight, SendsEverythingAfterTheClippingRangeChanges) {
+    rgblight_set_clipping_range(0, RGBLED_NUM);
+    rgblight_set();
+    EXPECT_EQ(test_ws2812_bytes, RGBLED_NUM * sizeof(LED_TYPE));
+}
+
+TEST_F(Rgblight, SendsEverythingOnRefresh) {
+    // As if the strip lost power
+    memset(test_ws2812_leds, 0, sizeof(test_ws2812_leds));
+    rgblight_refresh();
+    EXPECT_EQ(test_ws2812_bytes, RGBLED_NUM * sizeof(LED_TYPE));
+    expect_strip();
+}
+
+TEST_F(Rgblight, AnimationsSendLess) {
+    const struct {
+        const char *name;
+        uint8_t     mode;
+    } animations[] = {
+        {"breathing", RGBLIGHT_MODE_BREATHING},
+        {"swirl", RGBLIGHT_MODE_RAINBOW_SWIRL},
+        {"snake", RGBLIGHT_MODE_SNAKE},
+        {"knight", RGBLIGHT_MODE_KNIGHT},
+    };
+
+    printf("%-10s %8s %8s\n", "", "frames", "bytes");
+    for (auto &animation : animations) {
+        rgblight_mode_noeeprom(animation.mode);
+        idle_for(100);
+        test_ws2812_bytes = 0;
+        test_ws2812_calls = 0;
+        for (int t = 0; t < 2000; t++) {
+            run_one_scan_loop();
+            expect_strip();
+        }
+        ASSERT_GT(test_ws2812_calls, 0) << animation.name;
+        unsigned bytes = test_ws2812_bytes / test_ws2812_calls;
+        printf("%-10s %8u %8u\n", animation.name, test_ws2812_calls, bytes);
+        EXPECT_LE(bytes, RGBLED_NUM * sizeof(LED_TYPE)) << animation.name;
+        if (animation.mode == RGBLIGHT_MODE_SNAKE || animation.mode == RGBLIGHT_MODE_KNIGHT) {
+            EXPECT_LT(bytes, RGBLED_NUM * sizeof(LED_TYPE)) << animation.name;
+        }
+    }
+}
+
+TEST_F(Rgblight, StaysWithinThePowerBudget) {
+    const uint16_t budget = 400;
+    const struct {
+        const char *name;
+        uint8_t     mode;
+    } modes[] = {
+        {"static", RGBLIGHT_MODE_STATIC_LIGHT},
+        {"breathing", RGBLIGHT_MODE_BREATHING},
+        {"mood", RGBLIGHT_MODE_RAINBOW_MOOD},
+        {"swirl", RGBLIGHT_MODE_RAINBOW_SWIRL},
+        {"snake", RGBLIGHT_MODE_SNAKE},
+        {"knight", RGBLIGHT_MODE_KNIGHT},
+        {"christmas", RGBLIGHT_MODE_CHRISTMAS},
+        {"gradient", RGBLIGHT_MODE_STATIC_GRADIENT},
+        {"rgb test", RGBLIGHT_MODE_RGB_TEST},
+        {"twinkle", RGBLIGHT_MODE_TWINKLE},
+    };
+
+    rgblight_sethsv_noeeprom(0, 0, 255);
+    printf("%-10s %8s %8s %14s %14s\n", "", "peak mA", "avg mA", "limited peak", "limited avg");
+    for (auto &mode : modes) {
+        uint16_t peak[2]  = {0, 0};
+        uint32_t total[2] = {0, 0};
+        for (int limited = 0; limited < 2; limited++) {
+            rgblight_set_power_budget(limited ? budget : UINT16_MAX);
+            rgblight_mode_noeeprom(mode.mode);
+            idle_for(LIGHTING_POWER_RELEASE_MS + 100);
+            for (int t = 0; t < 2000; t++) {
+                run_one_scan_loop();
+                peak[limited] = std::max(peak[limited], strip_draw_ma());
+                total[limited] += strip_draw_ma();
+            }
+        }
+        printf("%-10s %8u %8u %14u %14u\n", mode.name, peak[0], total[0] / 2000, peak[1], total[1] / 2000);
+        EXPECT_LE(peak[1], budget) << mode.name;
+        EXPECT_LE(rgblight_get_power_draw_ma(), budget) << mode.name;
+    }
+}
+
+TEST_F(Rgblight, PowerComesBackUpWhenStatic) {
+    rgblight_sethsv_noeeprom(0, 0, 255);
+    rgblight_set_power_budget(400);
+    EXPECT_LE(strip_draw_ma(), 400);
+
+    // Sent again by rgblight_task() until it is back to full
+    rgblight_set_power_budget(UINT16_MAX);
+    idle_for(LIGHTING_POWER_RELEASE_MS / 2);
+    EXPECT_GT(strip_draw_ma(), 400);
+    EXPECT_LT(test_ws2812_leds[0].r, 255);
+    idle_for(LIGHTING_POWER_RELEASE_MS);
+    expect_strip();
+    EXPECT_EQ(test_ws2812_leds[0].r, 255);
+}
@@ -0,0 +1,144 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+// The mod tap key is SFT_T(KC_F) at column 0, the other letters follow on row 0
+enum : uint8_t { F, A, S, T, H, E, L, O, D };
+
+struct TraceEvent {
+    uint16_t time;
+    uint8_t  col;
+    bool     pressed;
+};
+
+// Turns the keyboard reports into the text they type
+std::string typed_text(const std::vector<report_keyboard_t> &reports) {
+    static const char letters[] = {'f', 'a', 's', 't', 'h', 'e', 'l', 'o', 'd'};
+    static const uint8_t keys[] = {KC_F, KC_A, KC_S, KC_T, KC_H, KC_E, KC_L, KC_O, KC_D};
+
+    std::string       text;
+    report_keyboard_t previous = {};
+    for (const auto &report : reports) {
+        for (uint8_t key : report.keys) {
+            bool held = false;
+            for (uint8_t old : previous.keys) {
+                held |= key && old == key;
+            }
+            for (size_t i = 0; key && !held && i < sizeof(keys); i++) {
+                if (keys[i] == key) {
+                    text += (report.mods & MOD_BIT(KC_LSFT)) ? letters[i] - 'a' + 'A' : letters[i];
+                }
+            }
+        }
+        previous = report;
+    }
+    return text;
+}
+
+}  // namespace
+
+class TappingOverflow : public TestFixture {
+   public:
+    void SetUp() override { tapping_clear_stats(); }
+
+    // Plays a typing trace, one scan per millisecond, and returns what was typed
+    std::string replay(const std::vector<TraceEvent> &trace) {
+        TestDriver                     driver;
+        std::vector<report_keyboard_t> reports;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { reports.push_back(report); }));
+
+        uint16_t now = 0;
+        for (const auto &event : trace) {
+            for (; now < event.time; now++) {
+                run_one_scan_loop();
+            }
+            if (event.pressed) {
+                press_key(event.col, 0);
+            } else {
+                release_key(event.col, 0);
+            }
+        }
+        idle_for(TAPPING_TERM + 10);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return typed_text(reports);
+    }
+};
+
+TEST_F(TappingOverflow, RollOverModTapIsTap) {
+    EXPECT_EQ(replay({{0, F, true}, {30, A, true}, {60, F, false}, {70, S, true}, {90, A, false}, {110, T, true}, {130, S, false}, {160, T, false}}), "fast");
+
+    const tapping_stats_t *stats = tapping_get_stats();
+    EXPECT_EQ(stats->settled, 1);
+    EXPECT_EQ(stats->taps, 1);
+    EXPECT_EQ(stats->overflows, 0);
+    // A press and the release of the mod tap key
+    EXPECT_EQ(stats->waiting_max, 2);
+    EXPECT_NEAR(stats->settle_time_max, 60, 1);
+}
+
+TEST_F(TappingOverflow, FullWaitingBufferForcesHold) {
+    // Eleven events within the tapping term, the waiting buffer only holds three
+    EXPECT_EQ(replay({{0, F, true}, {10, H, true}, {25, H, false}, {40, E, true}, {55, E, false}, {70, L, true}, {85, L, false}, {100, L, true}, {115, L, false}, {130, O, true}, {145, O, false}, {170, F, false}}), "HELLO");
+
+    const tapping_stats_t *stats = tapping_get_stats();
+    EXPECT_EQ(stats->settled, 1);
+    EXPECT_EQ(stats->taps, 0);
+    EXPECT_EQ(stats->overflows, 1);
+    EXPECT_EQ(stats->waiting_max, 3);
+    // Decided when the fourth event arrived instead of after TAPPING_TERM
+    EXPECT_NEAR(stats->settle_time_max, 55, 1);
+}
+
+TEST_F(TappingOverflow, HoldWithoutOverflowWaitsForTappingTerm) {
+    EXPECT_EQ(replay({{0, F, true}, {10, H, true}, {25, H, false}, {250, F, false}}), "H");
+
+    const tapping_stats_t *stats = tapping_get_stats();
+    EXPECT_EQ(stats->settled, 1);
+    EXPECT_EQ(stats->taps, 0);
+    EXPECT_EQ(stats->overflows, 0);
+    EXPECT_EQ(stats->waiting_max, 2);
+    EXPECT_NEAR(stats->settle_time_max, TAPPING_TERM, 1);
+}
+
+TEST_F(TappingOverflow, HighSpeedRollsKeepEveryKeystroke) {
+    // A key every 30 ms, each held for 45 ms so it overlaps the next one
+    const uint8_t           word[] = {F, A, S, T, F, E, A, S, T, F, O, L, D, S};
+    std::vector<TraceEvent> trace;
+    for (size_t i = 0; i < sizeof(word); i++) {
+        trace.push_back({(uint16_t)(i * 30), word[i], true});
+        trace.push_back({(uint16_t)(i * 30 + 45), word[i], false});
+    }
+    std::sort(trace.begin(), trace.end(), [](const TraceEvent &a, const TraceEvent &b) { return a.time < b.time; });
+
+    EXPECT_EQ(replay(trace), "fastfeastfolds");
+
+    const tapping_stats_t *stats = tapping_get_stats();
+    EXPECT_EQ(stats->settled, 3);
+    EXPECT_EQ(stats->taps, 3);
+    EXPECT_EQ(stats->overflows, 0);
+    EXPECT_LE(stats->waiting_max, 3);
+    EXPECT_NEAR(stats->settle_time_total / stats->settled, 45, 1);
+}
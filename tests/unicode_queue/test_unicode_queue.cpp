@@ -0,0 +1,222 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "process_unicode_common.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+const char *table_flip = "(ノಠ痊ಠ)ノ彡┻━┻";
+const char *emoji_line = "😀😃😄😁😆😅🤣😂🙂🙃😉😊😇🥰😍🤩😘😗😙😚";
+
+std::string press(uint8_t mods, uint8_t key = KC_NO) {
+    char text[8];
+    snprintf(text, sizeof(text), "%02X:%02X", mods, key);
+    return text;
+}
+
+// Keys and mods as the host sees them go down, in order
+struct Output {
+    std::vector<std::string> presses;
+    unsigned                 reports = 0;
+    uint32_t                 time    = 0;
+
+    void add(const report_keyboard_t &report, const report_keyboard_t &previous) {
+        reports++;
+        if (report.mods & ~previous.mods) {
+            presses.push_back(press(report.mods & ~previous.mods));
+        }
+        for (uint8_t key : report.keys) {
+            bool held = false;
+            for (uint8_t old : previous.keys) {
+                held |= old == key;
+            }
+            if (key && !held) {
+                presses.push_back(press(report.mods, key));
+            }
+        }
+    }
+};
+
+}  // namespace
+
+class UnicodeQueue : public TestFixture {
+   public:
+    // Runs send, then scan loops until the queue is empty, and returns what was sent
+    template <typename F>
+    Output capture(F send, uint8_t leds = 0) {
+        TestDriver        driver;
+        Output            output;
+        report_keyboard_t previous = {};
+        driver.set_leds(leds);
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            output.add(report, previous);
+            previous = report;
+        }));
+
+        uint32_t start = timer_read32();
+        send();
+        for (int i = 0; i < 10000 && unicode_queue_busy(); i++) {
+            run_one_scan_loop();
+        }
+        output.time = timer_read32() - start;
+        EXPECT_FALSE(unicode_queue_busy());
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return output;
+    }
+
+    Output blocking(uint8_t mode, const char *str, uint8_t leds = 0) {
+        set_unicode_input_mode(mode);
+        return capture([&] { send_unicode_string(str); }, leds);
+    }
+
+    Output queued(uint8_t mode, const char *str, uint8_t leds = 0) {
+        set_unicode_input_mode(mode);
+        return capture([&] { queue_unicode_string(str); }, leds);
+    }
+};
+
+TEST_F(UnicodeQueue, QueueingDoesNotBlock) {
+    TestDriver driver;
+    set_unicode_input_mode(UC_LNX);
+
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    uint32_t start = timer_read32();
+    queue_unicode_string(table_flip);
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_TRUE(unicode_queue_busy());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // One report per scan loop, shift is taken out while typing and restored at the end
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LCTL, KC_LSFT)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    while (unicode_queue_busy()) {
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LSFT));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+}
+
+TEST_F(UnicodeQueue, KeysPressedWhileTypingComeAfter) {
+    std::vector<std::string> expected = queued(UC_LNX, "ab").presses;
+    expected.push_back(press(0, KC_A));
+    expected.push_back(press(MOD_BIT(KC_LSFT)));
+
+    // A tapped and Shift pressed while the output is being typed
+    Output output = capture([&] {
+        queue_unicode_string("ab");
+        run_one_scan_loop();
+        press_key(1, 0);
+        run_one_scan_loop();
+        release_key(1, 0);
+        run_one_scan_loop();
+        press_key(0, 0);
+        run_one_scan_loop();
+    });
+    EXPECT_EQ(output.presses, expected);
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LSFT));
+
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    release_key(0, 0);
+    run_one_scan_loop();
+}
+
+TEST_F(UnicodeQueue, SamePressesAsBlockingOutput) {
+    for (uint8_t mode : {UC_LNX, UC_WIN, UC_WINC, UC_BSD}) {
+        EXPECT_EQ(queued(mode, table_flip).presses, blocking(mode, table_flip).presses) << "input mode " << (int)mode;
+    }
+    for (uint8_t mode : {UC_LNX, UC_WINC}) {
+        EXPECT_EQ(queued(mode, emoji_line).presses, blocking(mode, emoji_line).presses) << "input mode " << (int)mode;
+    }
+}
+
+TEST_F(UnicodeQueue, LinuxReleasesRepeatedDigits) {
+    const uint8_t ctrl_shift = MOD_BIT(KC_LCTL) | MOD_BIT(KC_LSFT);
+    EXPECT_EQ(queued(UC_LNX, "😀").presses, (std::vector<std::string>{press(ctrl_shift), press(ctrl_shift, KC_U), press(0, KC_1), press(0, KC_F), press(0, KC_6), press(0, KC_0), press(0, KC_0), press(0, KC_SPC)}));
+}
+
+TEST_F(UnicodeQueue, LinuxTogglesCapsLockOncePerRun) {
+    auto count_caps = [](const Output &output) {
+        unsigned count = 0;
+        for (const auto &p : output.presses) {
+            count += p == press(0, KC_CAPS);
+        }
+        return count;
+    };
+    EXPECT_EQ(count_caps(blocking(UC_LNX, "ab", 1 << USB_LED_CAPS_LOCK)), 4);
+    EXPECT_EQ(count_caps(queued(UC_LNX, "ab", 1 << USB_LED_CAPS_LOCK)), 2);
+    EXPECT_EQ(count_caps(queued(UC_LNX, "ab")), 0);
+}
+
+TEST_F(UnicodeQueue, MacHoldsOptionForTheWholeRun) {
+    const uint8_t alt = MOD_BIT(KC_LALT);
+    // U+00E9, then U+1F600 as the surrogate pair D83D DE00
+    EXPECT_EQ(queued(UC_MAC, "é😀").presses, (std::vector<std::string>{
+                                                  press(alt),
+                                                  press(alt, KC_0), press(alt, KC_0), press(alt, KC_E), press(alt, KC_9),
+                                                  press(alt, KC_D), press(alt, KC_8), press(alt, KC_3), press(alt, KC_D),
+                                                  press(alt, KC_D), press(alt, KC_E), press(alt, KC_0), press(alt, KC_0),
+                                              }));
+}
+
+TEST_F(UnicodeQueue, ReportsPerCodePoint) {
+    struct Case {
+        const char *name;
+        uint8_t     mode;
+        const char *str;
+        unsigned    code_points;
+    };
+    const Case cases[] = {
+        {"macOS", UC_MAC, table_flip, 11}, {"Linux", UC_LNX, table_flip, 11}, {"Windows", UC_WIN, table_flip, 11}, {"WinCompose", UC_WINC, table_flip, 11},
+        {"macOS", UC_MAC, emoji_line, 20}, {"Linux", UC_LNX, emoji_line, 20}, {"WinCompose", UC_WINC, emoji_line, 20},
+    };
+
+    // Blocking output holds up the scan loop for its whole time, queued output sends one report
+    // per scan loop and never blocks
+    std::cout << "               reports/code point    ms/code point" << std::endl;
+    std::cout << "               blocking  queued      blocked  queued" << std::endl;
+    for (const auto &c : cases) {
+        Output before = blocking(c.mode, c.str);
+        Output after  = queued(c.mode, c.str);
+        char   line[80];
+        snprintf(line, sizeof(line), "%-14s %8.1f %7.1f %12.1f %7.1f", c.name, (double)before.reports / c.code_points, (double)after.reports / c.code_points, (double)before.time / c.code_points, (double)after.time / c.code_points);
+        std::cout << line << std::endl;
+
+        EXPECT_LT(after.reports, before.reports) << c.name;
+    }
+}
@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_util.h"
 #include "action.h"
 #include "wait.h"
+#include "event_trace.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -71,6 +72,7 @@ void action_exec(keyevent_t event) {
         dprint("EVENT: ");
         debug_event(event);
         dprintln();
+        EVENT_TRACE(EVENT_TRACE_KEY, event.pressed, event.key.row << 8 | event.key.col, 0);
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY)
         retro_tapping_counter++;
 #endif
@@ -88,6 +90,10 @@ void action_exec(keyevent_t event) {
 #endif
 
     keyrecord_t record = {.event = event};
+    if (!IS_NOEVENT(event)) {
+        // resolved here once, the result is carried along with the record
+        get_record_keycode(&record, false);
+    }
 
 #ifndef NO_ACTION_ONESHOT
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
@@ -163,7 +169,8 @@ __attribute__((weak)) void post_process_record_quantum(keyrecord_t *record) {}
  * FIXME: Needs documentation.
  */
 void process_record_tap_hint(keyrecord_t *record) {
-    action_t action = layer_switch_get_action(record->event.key);
+    get_record_keycode(record, false);
+    action_t action = record->action;
 
     switch (action.kind.id) {
 #    ifdef SWAP_HANDS_ENABLE
@@ -191,6 +198,9 @@ void process_record(keyrecord_t *record) {
         return;
     }
 
+    // Everything below reads the keycode and action from the record
+    get_record_keycode(record, true);
+
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed) {
@@ -205,7 +215,7 @@ void process_record(keyrecord_t *record) {
 }
 
 void process_record_handler(keyrecord_t *record) {
-    action_t action = store_or_get_action(record->event.pressed, record->event.key);
+    action_t action = record->action;
     dprint("ACTION: ");
     debug_action(action);
 #ifndef NO_ACTION_LAYER
@@ -349,7 +359,7 @@ void process_action(keyrecord_t *record, action_t action) {
 #    if !defined(IGNORE_MOD_TAP_INTERRUPT) || defined(IGNORE_MOD_TAP_INTERRUPT_PER_KEY)
                             if (
 #        ifdef IGNORE_MOD_TAP_INTERRUPT_PER_KEY
-                                !get_ignore_mod_tap_interrupt(get_event_keycode(record->event, false), record) &&
+                                !get_ignore_mod_tap_interrupt(record->keycode, record) &&
 #        endif
                                 record->tap.interrupted) {
                                 dprint("mods_tap: tap: cancel: add_mods\n");
@@ -695,7 +705,7 @@ void process_action(keyrecord_t *record, action_t action) {
             } else {
                 if (
 #        ifdef RETRO_TAPPING_PER_KEY
-                    get_retro_tapping(get_event_keycode(record->event, false), record) &&
+                    get_retro_tapping(record->keycode, record) &&
 #        endif
                     retro_tapping_counter == 2) {
                     tap_code(action.layer_tap.code);
@@ -996,6 +1006,15 @@ bool is_tap_key(keypos_t key) {
     return is_tap_action(action);
 }
 
+/** \brief Utilities for actions. (FIXME: Needs better description)
+ *
+ * Same as is_tap_key(), but uses the action cached in the record.
+ */
+bool is_tap_record(keyrecord_t *record) {
+    get_record_keycode(record, false);
+    return is_tap_action(record->action);
+}
+
 /** \brief Utilities for actions. (FIXME: Needs better description)
  *
  * FIXME: Needs documentation.
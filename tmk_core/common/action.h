@@ -53,13 +53,28 @@ typedef struct {
 #ifndef NO_ACTION_TAPPING
     tap_t tap;
 #endif
+    /* Keycode and action of the event, filled in by get_record_keycode() and
+     * reused for as long as keymap_generation does not change. */
+    uint16_t keycode;
+    action_t action;
+    uint8_t  resolved_layer;       // RECORD_RESOLVED | layer the keycode was read from
+    uint8_t  resolved_generation;  // keymap_generation when it was read
 } keyrecord_t;
 
+#define RECORD_RESOLVED 0x80
+
 /* Execute action per keyevent */
 void action_exec(keyevent_t event);
 
 /* action for key */
 action_t action_for_key(uint8_t layer, keypos_t key);
+action_t action_for_keycode(uint16_t keycode);
+
+/* checks the transparency bitmap of a sparse keymap, without reading the keycode */
+bool keymap_key_is_transparent(uint8_t layer, keypos_t key);
+
+/* keycode of the record, looked up once and cached in the record */
+uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 
 /* macro */
 const macro_t *action_get_macro(keyrecord_t *record, uint8_t id, uint8_t opt);
@@ -111,6 +126,7 @@ void clear_keyboard_but_mods(void);
 void clear_keyboard_but_mods_and_keys(void);
 void layer_switch(uint8_t new_layer);
 bool is_tap_key(keypos_t key);
+bool is_tap_record(keyrecord_t *record);
 bool is_tap_action(action_t action);
 
 #ifndef NO_ACTION_TAPPING
@@ -3,6 +3,8 @@
 #include "action.h"
 #include "util.h"
 #include "action_layer.h"
+#include "action_tapping.h"
+#include "event_trace.h"
 
 #ifdef DEBUG_ACTION
 #    include "debug.h"
@@ -14,6 +16,28 @@
  */
 layer_state_t default_layer_state = 0;
 
+/** \brief Keymap Generation
+ *
+ * Bumped by keymap_cache_invalidate() on every change to the layer state, the
+ * source layers cache, the dynamic keymap or keymap_config, which invalidates
+ * the keycodes cached in keyrecord_t.
+ */
+uint8_t keymap_generation = 0;
+
+/** \brief Keymap Cache Invalidate
+ *
+ * Makes every record look up its keycode again. Once the generation wraps
+ * around, a record resolved 256 changes ago would look current, so the records
+ * still held by the tapping code forget their keycodes instead.
+ */
+void keymap_cache_invalidate(void) {
+    if (++keymap_generation == 0) {
+#ifndef NO_ACTION_TAPPING
+        action_tapping_forget_keycodes();
+#endif
+    }
+}
+
 /** \brief Default Layer State Set At user Level
  *
  * Run user code on default layer state change
@@ -36,8 +60,10 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_debug();
     debug(" to ");
     default_layer_state = state;
+    keymap_cache_invalidate();
     default_layer_debug();
     debug("\n");
+    EVENT_TRACE(EVENT_TRACE_LAYER, 1, (uint16_t)state, (uint16_t)((uint32_t)state >> 16));
 #ifdef STRICT_LAYER_RELEASE
     clear_keyboard_but_mods();  // To avoid stuck keys
 #else
@@ -102,8 +128,10 @@ void layer_state_set(layer_state_t state) {
     layer_debug();
     dprint(" to ");
     layer_state = state;
+    keymap_cache_invalidate();
     layer_debug();
     dprintln();
+    EVENT_TRACE(EVENT_TRACE_LAYER, 0, (uint16_t)state, (uint16_t)((uint32_t)state >> 16));
 #    ifdef STRICT_LAYER_RELEASE
     clear_keyboard_but_mods();  // To avoid stuck keys
 #    else
@@ -199,6 +227,7 @@ void update_source_layers_cache(keypos_t key, uint8_t layer) {
     for (uint8_t bit_number = 0; bit_number < MAX_LAYER_BITS; bit_number++) {
         source_layers_cache[storage_row][bit_number] ^= (-((layer & (1U << bit_number)) != 0) ^ source_layers_cache[storage_row][bit_number]) & (1U << storage_bit);
     }
+    keymap_cache_invalidate();
 }
 
 /** \brief read source layers cache
@@ -259,6 +288,11 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & (1UL << i)) {
+#    ifdef SPARSE_KEYMAP_ENABLE
+            if (keymap_key_is_transparent(i, key)) {
+                continue;
+            }
+#    endif
             action = action_for_key(i, key);
             if (action.code != ACTION_TRANSPARENT) {
                 return i;
@@ -107,6 +107,13 @@ layer_state_t layer_state_set_kb(layer_state_t state);
 #    define layer_state_set_user(state) (void)state
 #endif
 
+/* changes whenever a key may resolve to a different keycode than before */
+extern uint8_t keymap_generation;
+
+/* call after changing what keys resolve to at runtime, other than through the
+ * layer, dynamic keymap and magic keycode functions, which call it themselves */
+void keymap_cache_invalidate(void);
+
 /* pressed actions cache */
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
 
@@ -5,6 +5,10 @@
 #include "action_tapping.h"
 #include "keycode.h"
 #include "timer.h"
+#include "event_trace.h"
+#ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+#    include "adaptive_tapping.h"
+#endif
 
 #ifdef DEBUG_ACTION
 #    include "debug.h"
@@ -19,12 +23,16 @@
 #    define IS_TAPPING_RELEASED() (IS_TAPPING() && !tapping_key.event.pressed)
 #    define IS_TAPPING_KEY(k) (IS_TAPPING() && KEYEQ(tapping_key.event.key, (k)))
 
+#    define TRACE_KEYPOS(r) ((r).event.key.row << 8 | (r).event.key.col)
+#    define TRACE_TAP(r) EVENT_TRACE(EVENT_TRACE_TAP, (r).tap.count | (r).tap.interrupted << 7, TRACE_KEYPOS(r), 0)
+
 __attribute__((weak)) uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) { return TAPPING_TERM; }
 
-#    ifdef TAPPING_TERM_PER_KEY
-#        define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < get_tapping_term(get_event_keycode(tapping_key.event, false), &tapping_key))
+// tapping_force_settle makes every event look late, so a full waiting buffer settles the tapping key
+#    if defined(TAPPING_TERM_PER_KEY) || defined(ADAPTIVE_TAPPING_TERM_ENABLE)
+#        define WITHIN_TAPPING_TERM(e) (!tapping_force_settle && TIMER_DIFF_16(e.time, tapping_key.event.time) < get_tapping_key_term())
 #    else
-#        define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < TAPPING_TERM)
+#        define WITHIN_TAPPING_TERM(e) (!tapping_force_settle && TIMER_DIFF_16(e.time, tapping_key.event.time) < TAPPING_TERM)
 #    endif
 
 #    ifdef TAPPING_FORCE_HOLD_PER_KEY
@@ -39,9 +47,50 @@ static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
+static bool        tapping_force_settle                = false;
+
+_Static_assert(WAITING_BUFFER_SIZE >= 2 && WAITING_BUFFER_SIZE <= 256, "WAITING_BUFFER_SIZE must be between 2 and 256");
+
+#    ifdef TAPPING_STATS
+static tapping_stats_t tapping_stats = {};
+#    endif
+
+#    if defined(TAPPING_TERM_PER_KEY) || defined(ADAPTIVE_TAPPING_TERM_ENABLE)
+/* The tapping term is checked on every scan while the tapping key is held, so it
+ * is only asked for again once tapping_key or its keycode changes.
+ */
+static struct {
+    keyevent_t event;
+    uint16_t   keycode;
+    uint16_t   term;
+#        ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+    uint16_t base_term;  // before adaptive_tapping_term()
+#        endif
+} tapping_term_cache = {};
+#    endif
+
+#    ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+/* A key that became a hold when its adaptive tapping term ran out. If it is released within the
+ * configured term without another key pressed, it was meant as a tap.
+ */
+static struct {
+    keypos_t key;
+    uint16_t time;
+    uint16_t keycode;
+    uint16_t term;
+    bool     active;
+} adaptive_tapping_hold = {};
+
+static void adaptive_tapping_tap(keyevent_t release, uint8_t end);
+static void adaptive_tapping_hold_start(void);
+static void adaptive_tapping_hold_check(keyevent_t event);
+#    endif
 
 static bool process_tapping(keyrecord_t *record);
+static void tapping_key_settled(bool tap);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_process(void);
+static void waiting_buffer_settle(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -49,6 +98,30 @@ static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
+#    if defined(TAPPING_TERM_PER_KEY) || defined(ADAPTIVE_TAPPING_TERM_ENABLE)
+static uint16_t get_tapping_key_term(void) {
+    uint16_t keycode = get_record_keycode(&tapping_key, false);
+
+    if (keycode != tapping_term_cache.keycode || !KEYEQ(tapping_key.event.key, tapping_term_cache.event.key) || tapping_key.event.time != tapping_term_cache.event.time || tapping_key.event.pressed != tapping_term_cache.event.pressed) {
+        tapping_term_cache.event   = tapping_key.event;
+        tapping_term_cache.keycode = keycode;
+#        ifdef TAPPING_TERM_PER_KEY
+        tapping_term_cache.term = get_tapping_term(keycode, &tapping_key);
+#        else
+        tapping_term_cache.term = TAPPING_TERM;
+#        endif
+#        ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+        // only the wait for a tap is learned, not the window for the next one
+        tapping_term_cache.base_term = tapping_term_cache.term;
+        if (tapping_key.event.pressed) {
+            tapping_term_cache.term = adaptive_tapping_term(keycode, tapping_term_cache.term);
+        }
+#        endif
+    }
+    return tapping_term_cache.term;
+}
+#    endif
+
 /** \brief Action Tapping Process
  *
  * FIXME: Needs doc
@@ -59,14 +132,32 @@ void action_tapping_process(keyrecord_t record) {
             debug("processed: ");
             debug_record(record);
             debug("\n");
+            TRACE_TAP(record);
         }
     } else {
-        if (!waiting_buffer_enq(record)) {
-            // clear all in case of overflow.
-            debug("OVERFLOW: CLEAR ALL STATES\n");
-            clear_keyboard();
-            waiting_buffer_clear();
-            tapping_key = (keyrecord_t){};
+        while (!waiting_buffer_enq(record)) {
+            if (!IS_TAPPING()) {
+                // nothing left to settle, clear all.
+                debug("OVERFLOW: CLEAR ALL STATES\n");
+                clear_keyboard();
+                waiting_buffer_clear();
+                tapping_key = (keyrecord_t){};
+                break;
+            }
+
+            // decide the tapping key now to make room, rather than dropping the buffered events.
+            debug("OVERFLOW: SETTLE TAPPING KEY\n");
+            EVENT_TRACE(EVENT_TRACE_TAP_OVERFLOW, 0, TRACE_KEYPOS(record), 0);
+#    ifdef TAPPING_STATS
+            tapping_stats.overflows++;
+#    endif
+            waiting_buffer_settle();
+
+            // with the buffer drained the record goes through the tapping logic like any other
+            if (waiting_buffer_head == waiting_buffer_tail && process_tapping(&record)) {
+                TRACE_TAP(record);
+                break;
+            }
         }
     }
 
@@ -74,6 +165,22 @@ void action_tapping_process(keyrecord_t record) {
     if (!IS_NOEVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         debug("---- action_exec: process waiting_buffer -----\n");
     }
+    waiting_buffer_process();
+    if (!IS_NOEVENT(record.event)) {
+        debug("\n");
+    }
+
+#    ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+    adaptive_tapping_hold_check(record.event);
+#    endif
+}
+
+/** \brief Waiting buffer process
+ *
+ * Hands the buffered records to the tapping logic, oldest first, until one of them has to wait
+ * again.
+ */
+static void waiting_buffer_process(void) {
     for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             debug("processed: waiting_buffer[");
@@ -81,12 +188,114 @@ void action_tapping_process(keyrecord_t record) {
             debug("] = ");
             debug_record(waiting_buffer[waiting_buffer_tail]);
             debug("\n\n");
+            TRACE_TAP(waiting_buffer[waiting_buffer_tail]);
         } else {
             break;
         }
     }
-    if (!IS_NOEVENT(record.event)) {
-        debug("\n");
+}
+
+/** \brief Waiting buffer settle
+ *
+ * Forces the decision the tapping key is waiting for, as if its tapping term had passed, and
+ * processes what that frees up in the waiting buffer. An undecided tapping key becomes a hold.
+ */
+static void waiting_buffer_settle(void) {
+    tapping_force_settle = true;
+    waiting_buffer_process();
+    tapping_force_settle = false;
+    waiting_buffer_process();
+}
+
+/** \brief Tapping key settled
+ *
+ * Called when an undecided tapping key becomes a tap or a hold, for statistics and the trace.
+ * The time to the decision is measured up to now, which includes any time its events waited.
+ */
+static void tapping_key_settled(bool tap) {
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+
+    (void)elapsed;
+    EVENT_TRACE(EVENT_TRACE_TAP_SETTLE, tap, TRACE_KEYPOS(tapping_key), elapsed);
+#    ifdef TAPPING_STATS
+    tapping_stats.settled++;
+    if (tap) {
+        tapping_stats.taps++;
+    }
+    tapping_stats.settle_time_total += elapsed;
+    if (elapsed > tapping_stats.settle_time_max) {
+        tapping_stats.settle_time_max = elapsed;
+    }
+#    endif
+}
+
+#    ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+/** \brief Adaptive tapping tap
+ *
+ * Feeds a tap of the tapping key, released by release, to the model. The overlap is how long the
+ * first key pressed after the tapping key, among the waiting events before end, had been down by
+ * then.
+ */
+static void adaptive_tapping_tap(keyevent_t release, uint8_t end) {
+    uint16_t overlap = 0;
+
+    for (uint8_t i = waiting_buffer_tail; i != end; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        if (waiting_buffer[i].event.pressed) {
+            overlap = TIMER_DIFF_16(release.time, waiting_buffer[i].event.time);
+            break;
+        }
+    }
+    adaptive_tapping_record_tap(get_record_keycode(&tapping_key, false), TIMER_DIFF_16(release.time, tapping_key.event.time), overlap);
+}
+
+/** \brief Adaptive tapping hold start
+ *
+ * Called when the tapping key times out into a hold. Holds that were forced or interrupted by
+ * another key are not watched, those were not meant as taps.
+ */
+static void adaptive_tapping_hold_start(void) {
+    adaptive_tapping_hold.active = !tapping_force_settle && !tapping_key.tap.interrupted && tapping_term_cache.term < tapping_term_cache.base_term;
+    if (adaptive_tapping_hold.active) {
+        adaptive_tapping_hold.key     = tapping_key.event.key;
+        adaptive_tapping_hold.time    = tapping_key.event.time;
+        adaptive_tapping_hold.keycode = get_record_keycode(&tapping_key, false);
+        adaptive_tapping_hold.term    = tapping_term_cache.base_term;
+    }
+}
+
+/** \brief Adaptive tapping hold check
+ *
+ * Records a watched hold as a tap when it turns out to have been released too early to be meant
+ * as a hold, which lengthens the adaptive term of the key again.
+ */
+static void adaptive_tapping_hold_check(keyevent_t event) {
+    if (!adaptive_tapping_hold.active || IS_NOEVENT(event)) return;
+
+    if (KEYEQ(event.key, adaptive_tapping_hold.key) && !event.pressed) {
+        uint16_t duration = TIMER_DIFF_16(event.time, adaptive_tapping_hold.time);
+        if (duration < adaptive_tapping_hold.term) {
+            debug("Tapping: adaptive term misfire.\n");
+            adaptive_tapping_record_tap(adaptive_tapping_hold.keycode, duration, 0);
+        }
+    }
+    adaptive_tapping_hold.active = false;
+}
+#    endif
+
+#    ifdef TAPPING_STATS
+const tapping_stats_t *tapping_get_stats(void) { return &tapping_stats; }
+
+void tapping_clear_stats(void) { tapping_stats = (tapping_stats_t){}; }
+#    endif
+
+/** \brief Forget the keycodes cached in the tapping key and the waiting buffer
+ *
+ * So they are looked up again, see keymap_cache_invalidate().
+ */
+void action_tapping_forget_keycodes(void) {
+    tapping_key.resolved_layer = 0;
+    for (uint8_t i = 0; i < WAITING_BUFFER_SIZE; i++) {
+        waiting_buffer[i].resolved_layer = 0;
     }
 }
 
@@ -106,6 +315,10 @@ bool process_tapping(keyrecord_t *keyp) {
                 if (IS_TAPPING_KEY(event.key) && !event.pressed) {
                     // first tap!
                     debug("Tapping: First tap(0->1).\n");
+                    tapping_key_settled(true);
+#    ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+                    adaptive_tapping_tap(event, waiting_buffer_head);
+#    endif
                     tapping_key.tap.count = 1;
                     debug_tapping_key();
                     process_record(&tapping_key);
@@ -120,15 +333,16 @@ bool process_tapping(keyrecord_t *keyp) {
                  * useful for long TAPPING_TERM but may prevent fast typing.
                  */
 #    if defined(TAPPING_TERM_PER_KEY) || (TAPPING_TERM >= 500) || defined(PERMISSIVE_HOLD) || defined(PERMISSIVE_HOLD_PER_KEY)
-                else if (
+                else if (IS_RELEASED(event) &&
 #        ifdef TAPPING_TERM_PER_KEY
-                    (get_tapping_term(get_event_keycode(tapping_key.event, false), keyp) >= 500) &&
+                         (get_tapping_term(get_record_keycode(&tapping_key, false), keyp) >= 500) &&
 #        endif
 #        ifdef PERMISSIVE_HOLD_PER_KEY
-                    !get_permissive_hold(get_event_keycode(tapping_key.event, false), keyp) &&
+                         !get_permissive_hold(get_record_keycode(&tapping_key, false), keyp) &&
 #        endif
-                    IS_RELEASED(event) && waiting_buffer_typed(event)) {
+                         waiting_buffer_typed(event)) {
                     debug("Tapping: End. No tap. Interfered by typing key\n");
+                    tapping_key_settled(false);
                     process_record(&tapping_key);
                     tapping_key = (keyrecord_t){};
                     debug_tapping_key();
@@ -179,7 +393,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     tapping_key = *keyp;
                     debug_tapping_key();
                     return true;
-                } else if (is_tap_key(event.key) && event.pressed) {
+                } else if (is_tap_record(keyp) && event.pressed) {
                     if (tapping_key.tap.count > 1) {
                         debug("Tapping: Start new tap with releasing last tap(>1).\n");
                         // unregister key
@@ -206,6 +420,10 @@ bool process_tapping(keyrecord_t *keyp) {
                 debug("Tapping: End. Timeout. Not tap(0): ");
                 debug_event(event);
                 debug("\n");
+                tapping_key_settled(false);
+#    ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+                adaptive_tapping_hold_start();
+#    endif
                 process_record(&tapping_key);
                 tapping_key = (keyrecord_t){};
                 debug_tapping_key();
@@ -217,7 +435,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     process_record(keyp);
                     tapping_key = (keyrecord_t){};
                     return true;
-                } else if (is_tap_key(event.key) && event.pressed) {
+                } else if (is_tap_record(keyp) && event.pressed) {
                     if (tapping_key.tap.count > 1) {
                         debug("Tapping: Start new tap with releasing last timeout tap(>1).\n");
                         // unregister key
@@ -246,7 +464,7 @@ bool process_tapping(keyrecord_t *keyp) {
 #    if !defined(TAPPING_FORCE_HOLD) || defined(TAPPING_FORCE_HOLD_PER_KEY)
                     if (
 #        ifdef TAPPING_FORCE_HOLD_PER_KEY
-                        !get_tapping_force_hold(get_event_keycode(tapping_key.event, false), keyp) &&
+                        !get_tapping_force_hold(get_record_keycode(&tapping_key, false), keyp) &&
 #        endif
                         !tapping_key.tap.interrupted && tapping_key.tap.count > 0) {
                         // sequential tap.
@@ -264,7 +482,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     // FIX: start new tap again
                     tapping_key = *keyp;
                     return true;
-                } else if (is_tap_key(event.key)) {
+                } else if (is_tap_record(keyp)) {
                     // Sequential tap can be interfered with other tap key.
                     debug("Tapping: Start with interfering other tap.\n");
                     tapping_key = *keyp;
@@ -296,7 +514,7 @@ bool process_tapping(keyrecord_t *keyp) {
     }
     // not tapping state
     else {
-        if (event.pressed && is_tap_key(event.key)) {
+        if (event.pressed && is_tap_record(keyp)) {
             debug("Tapping: Start(Press tap key).\n");
             tapping_key = *keyp;
             process_record_tap_hint(&tapping_key);
@@ -327,8 +545,17 @@ bool waiting_buffer_enq(keyrecord_t record) {
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
+    uint8_t depth = (waiting_buffer_head - waiting_buffer_tail + WAITING_BUFFER_SIZE) % WAITING_BUFFER_SIZE;
+    (void)depth;
+#    ifdef TAPPING_STATS
+    if (depth > tapping_stats.waiting_max) {
+        tapping_stats.waiting_max = depth;
+    }
+#    endif
+
     debug("waiting_buffer_enq: ");
     debug_waiting_buffer();
+    EVENT_TRACE(EVENT_TRACE_TAP_WAIT, depth, TRACE_KEYPOS(record), 0);
     return true;
 }
 
@@ -377,6 +604,10 @@ void waiting_buffer_scan_tap(void) {
 
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (IS_TAPPING_KEY(waiting_buffer[i].event.key) && !waiting_buffer[i].event.pressed && WITHIN_TAPPING_TERM(waiting_buffer[i].event)) {
+            tapping_key_settled(true);
+#    ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+            adaptive_tapping_tap(waiting_buffer[i].event, i);
+#    endif
             tapping_key.tap.count       = 1;
             waiting_buffer[i].tap.count = 1;
             process_record(&tapping_key);
@@ -27,15 +27,37 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* events that can wait for the tapping key to be decided, a full buffer forces the decision */
+#ifndef WAITING_BUFFER_SIZE
+#    if defined(__AVR__)
+#        define WAITING_BUFFER_SIZE 8
+#    else
+#        define WAITING_BUFFER_SIZE 16
+#    endif
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+void     action_tapping_forget_keycodes(void);
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
 bool     get_permissive_hold(uint16_t keycode, keyrecord_t *record);
 bool     get_ignore_mod_tap_interrupt(uint16_t keycode, keyrecord_t *record);
 bool     get_tapping_force_hold(uint16_t keycode, keyrecord_t *record);
 bool     get_retro_tapping(uint16_t keycode, keyrecord_t *record);
+
+#    ifdef TAPPING_STATS
+typedef struct {
+    uint8_t  waiting_max;        // deepest the waiting buffer has been
+    uint16_t overflows;          // decisions forced by a full waiting buffer
+    uint16_t settled;            // tapping keys decided as tap or hold
+    uint16_t taps;               // of which were taps
+    uint16_t settle_time_max;    // longest time from press to decision (ms)
+    uint32_t settle_time_total;  // sum of the times from press to decision (ms)
+} tapping_stats_t;
+
+const tapping_stats_t *tapping_get_stats(void);
+void                   tapping_clear_stats(void);
+#    endif
 #endif
@@ -24,7 +24,7 @@
 #    include "audio.h"
 #endif /* AUDIO_ENABLE */
 
-#if defined(RGBLIGHT_SLEEP) && defined(RGBLIGHT_ENABLE)
+#ifdef RGBLIGHT_ENABLE
 #    include "rgblight.h"
 #endif
 
@@ -206,6 +206,9 @@ void suspend_wakeup_init(void) {
     // Wake up underglow
 #if defined(RGBLIGHT_SLEEP) && defined(RGBLIGHT_ENABLE)
     rgblight_wakeup();
+#elif defined(RGBLIGHT_ENABLE)
+    // the strip may have been powered down while suspended
+    rgblight_refresh();
 #endif
 
     suspend_wakeup_init_kb();
@@ -20,7 +20,7 @@
 #    include "backlight.h"
 #endif
 
-#if defined(RGBLIGHT_SLEEP) && defined(RGBLIGHT_ENABLE)
+#ifdef RGBLIGHT_ENABLE
 #    include "rgblight.h"
 #endif
 
@@ -136,6 +136,9 @@ void suspend_wakeup_init(void) {
     led_set(host_keyboard_leds());
 #if defined(RGBLIGHT_SLEEP) && defined(RGBLIGHT_ENABLE)
     rgblight_wakeup();
+#elif defined(RGBLIGHT_ENABLE)
+    // the strip may have been powered down while suspended
+    rgblight_refresh();
 #endif
     suspend_wakeup_init_kb();
 }
@@ -47,8 +47,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define EECONFIG_RGB_MATRIX_SPEED (uint8_t *)32
 // TODO: Combine these into a single word and single block of EEPROM
 #define EECONFIG_KEYMAP_UPPER_BYTE (uint8_t *)33
+#ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+#    include "adaptive_tapping.h"
+// Magic word, then 8 bytes of statistics per key
+#    define EECONFIG_ADAPTIVE_TAPPING (uint16_t *)34
+#    define EECONFIG_ADAPTIVE_TAPPING_SIZE (2 + ADAPTIVE_TAPPING_KEYS * 8)
 // Size of EEPROM being used, other code can refer to this for available EEPROM
-#define EECONFIG_SIZE 34
+#    define EECONFIG_SIZE (34 + EECONFIG_ADAPTIVE_TAPPING_SIZE)
+#else
+// Size of EEPROM being used, other code can refer to this for available EEPROM
+#    define EECONFIG_SIZE 34
+#endif
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
 #define EECONFIG_DEBUG_MATRIX (1 << 1)
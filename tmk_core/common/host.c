@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "event_trace.h"
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -48,6 +49,7 @@ led_t host_keyboard_led_state(void) {
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
     if (!driver) return;
+    EVENT_TRACE(EVENT_TRACE_KEYBOARD, report->mods, report->keys[0] | report->keys[1] << 8, report->keys[2] | report->keys[3] << 8);
 #if defined(NKRO_ENABLE) && defined(NKRO_SHARED_EP)
     if (keyboard_protocol && keymap_config.nkro) {
         /* The callers of this function assume that report->mods is where mods go in.
@@ -75,6 +77,7 @@ void host_keyboard_send(report_keyboard_t *report) {
 
 void host_mouse_send(report_mouse_t *report) {
     if (!driver) return;
+    EVENT_TRACE(EVENT_TRACE_MOUSE, report->buttons, (uint8_t)report->x | (uint8_t)report->y << 8, (uint8_t)report->v | (uint8_t)report->h << 8);
 #ifdef MOUSE_SHARED_EP
     report->report_id = REPORT_ID_MOUSE;
 #endif
@@ -86,6 +89,7 @@ void host_system_send(uint16_t report) {
     last_system_report = report;
 
     if (!driver) return;
+    EVENT_TRACE(EVENT_TRACE_EXTRA, 0, report, 0);
     (*driver->send_system)(report);
 }
 
@@ -94,6 +98,7 @@ void host_consumer_send(uint16_t report) {
     last_consumer_report = report;
 
     if (!driver) return;
+    EVENT_TRACE(EVENT_TRACE_EXTRA, 1, report, 0);
     (*driver->send_consumer)(report);
 }
 
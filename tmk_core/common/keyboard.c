@@ -57,6 +57,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef RGB_MATRIX_ENABLE
 #    include "rgb_matrix.h"
 #endif
+#ifdef LED_MATRIX_ENABLE
+#    include "led_matrix.h"
+#endif
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif
@@ -96,6 +99,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
+#ifdef EVENT_TRACE_ENABLE
+#    include "event_trace.h"
+#endif
+#ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+#    include "adaptive_tapping.h"
+#endif
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) { return last_input_modification_time; }
@@ -301,6 +313,9 @@ void keyboard_init(void) {
 #else
     magic();
 #endif
+#ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+    adaptive_tapping_init();
+#endif
 #ifdef BACKLIGHT_ENABLE
     backlight_init();
 #endif
@@ -337,6 +352,9 @@ void keyboard_init(void) {
  * This is differnet than keycode events as no layer processing, or filtering occurs.
  */
 void switch_events(uint8_t row, uint8_t col, bool pressed) {
+#if defined(LED_MATRIX_ENABLE)
+    process_led_matrix(row, col, pressed);
+#endif
 #if defined(RGB_MATRIX_ENABLE)
     process_rgb_matrix(row, col, pressed);
 #endif
@@ -496,6 +514,18 @@ MATRIX_LOOP_END:
     joystick_task();
 #endif
 
+#ifdef EVENT_TRACE_ENABLE
+    event_trace_task();
+#endif
+
+#ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+    adaptive_tapping_task();
+#endif
+
+#ifdef I2C_QUEUE_ENABLE
+    i2c_queue_task();
+#endif
+
     // update LED
     if (led_status != host_keyboard_leds()) {
         led_status = host_keyboard_leds();
@@ -40,12 +40,30 @@ void print_set_sendchar(sendchar_func_t func);
 #        include "printf.h"  // lib/printf/printf.h
 
 // Create user & normal print defines
-#        define print(s) printf(s)
-#        define println(s) printf(s "\r\n")
-#        define xprintf printf
-#        define uprint(s) printf(s)
-#        define uprintln(s) printf(s "\r\n")
-#        define uprintf printf
+#        if defined(CONSOLE_ENABLE) && defined(CONSOLE_DEFERRED_FORMAT) && defined(PROTOCOL_CHIBIOS)
+// Queue the format string and arguments, the console task formats them later.
+// Every argument is queued as a 32 bit word, so %f and %ll are not supported.
+#            define CONSOLE_DEFERRED_MAX_ARGS 8
+// Nine to sixteen arguments count as an undeclared identifier, which fails the build
+#            define CONSOLE_DEFERRED_NARGS(...) CONSOLE_DEFERRED_NARGS_(, ##__VA_ARGS__, CONSOLE_DEFERRED_TOO_MANY, CONSOLE_DEFERRED_TOO_MANY, CONSOLE_DEFERRED_TOO_MANY, CONSOLE_DEFERRED_TOO_MANY, CONSOLE_DEFERRED_TOO_MANY, CONSOLE_DEFERRED_TOO_MANY, CONSOLE_DEFERRED_TOO_MANY, CONSOLE_DEFERRED_TOO_MANY, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#            define CONSOLE_DEFERRED_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, n, ...) n
+#            define CONSOLE_DEFERRED_TOO_MANY uprintf_takes_at_most_8_arguments_with_CONSOLE_DEFERRED_FORMAT
+int console_printf_deferred(uint8_t argc, const char *fmt, ...);
+
+#            define print(s) console_printf_deferred(0, s)
+#            define println(s) console_printf_deferred(0, s "\r\n")
+#            define xprintf(fmt, ...) console_printf_deferred(CONSOLE_DEFERRED_NARGS(__VA_ARGS__), fmt, ##__VA_ARGS__)
+#            define uprint(s) console_printf_deferred(0, s)
+#            define uprintln(s) console_printf_deferred(0, s "\r\n")
+#            define uprintf(fmt, ...) console_printf_deferred(CONSOLE_DEFERRED_NARGS(__VA_ARGS__), fmt, ##__VA_ARGS__)
+#        else
+#            define print(s) printf(s)
+#            define println(s) printf(s "\r\n")
+#            define xprintf printf
+#            define uprint(s) printf(s)
+#            define uprintln(s) printf(s "\r\n")
+#            define uprintf printf
+#        endif
 
 #    endif /* __AVR__ / PROTOCOL_CHIBIOS / PROTOCOL_ARM_ATSAM */
 #else      /* NO_PRINT */
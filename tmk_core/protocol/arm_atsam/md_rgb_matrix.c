@@ -20,7 +20,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "led.h"
 #    include "rgb_matrix.h"
 #    include <string.h>
-#    include <math.h>
 
 #    ifdef USE_MASSDROP_CONFIGURATOR
 __attribute__((weak)) led_instruction_t led_instructions[] = {{.end = 1}};
@@ -63,6 +62,10 @@ uint8_t gcr_actual_last;
 uint8_t gcr_breathe;
 float   breathe_mult;
 float   pomod;
+
+static uint16_t led_position[2][ISSI3733_LED_COUNT];  // Across and down the board, percent << 8
+static int32_t  led_shift;                            // pomod, percent << 8
+static uint32_t led_breathe;                          // breathe_mult << 16
 #    endif
 
 #    define ACT_GCR_NONE 0
@@ -225,6 +228,14 @@ static void init(void) {
     gcr_min_counter = 0;
     v_5v_cat_hit    = 0;
 
+#    ifdef USE_MASSDROP_CONFIGURATOR
+    for (uint8_t i = 0; i < ISSI3733_LED_COUNT; i++) {
+        led_position[0][i] = led_pattern_position(g_led_config.point[i].x, 224);
+        led_position[1][i] = led_pattern_position(g_led_config.point[i].y, 64);
+    }
+    led_breathe = 1UL << 16;
+#    endif
+
     DBGC(DC_LED_MATRIX_INIT_COMPLETE);
 }
 
@@ -276,6 +287,8 @@ static void flush(void) {
     pomod = (uint32_t)pomod % 10000;
     pomod /= 100.0f;
 
+    led_shift   = led_pattern_shift(pomod);
+    led_breathe = breathe_mult * 65536 + 0.5f;
 #    endif  // USE_MASSDROP_CONFIGURATOR
 
     uint8_t drvid;
@@ -342,68 +355,11 @@ uint8_t led_enabled               = 1;
 uint8_t led_animation_breathe_cur = BREATHE_MIN_STEP;
 uint8_t breathe_dir               = 1;
 
-static void led_run_pattern(led_setup_t* f, float* ro, float* go, float* bo, float pos) {
-    float po;
-
-    while (f->end != 1) {
-        po = pos;  // Reset po for new frame
-
-        // Add in any moving effects
-        if ((!led_animation_direction && f->ef & EF_SCR_R) || (led_animation_direction && (f->ef & EF_SCR_L))) {
-            po -= pomod;
-
-            if (po > 100)
-                po -= 100;
-            else if (po < 0)
-                po += 100;
-        } else if ((!led_animation_direction && f->ef & EF_SCR_L) || (led_animation_direction && (f->ef & EF_SCR_R))) {
-            po += pomod;
-
-            if (po > 100)
-                po -= 100;
-            else if (po < 0)
-                po += 100;
-        }
-
-        // Check if LED's po is in current frame
-        if (po < f->hs) {
-            f++;
-            continue;
-        }
-        if (po > f->he) {
-            f++;
-            continue;
-        }
-        // note: < 0 or > 100 continue
-
-        // Calculate the po within the start-stop percentage for color blending
-        po = (po - f->hs) / (f->he - f->hs);
-
-        // Add in any color effects
-        if (f->ef & EF_OVER) {
-            *ro = (po * (f->re - f->rs)) + f->rs;  // + 0.5;
-            *go = (po * (f->ge - f->gs)) + f->gs;  // + 0.5;
-            *bo = (po * (f->be - f->bs)) + f->bs;  // + 0.5;
-        } else if (f->ef & EF_SUBTRACT) {
-            *ro -= (po * (f->re - f->rs)) + f->rs;  // + 0.5;
-            *go -= (po * (f->ge - f->gs)) + f->gs;  // + 0.5;
-            *bo -= (po * (f->be - f->bs)) + f->bs;  // + 0.5;
-        } else {
-            *ro += (po * (f->re - f->rs)) + f->rs;  // + 0.5;
-            *go += (po * (f->ge - f->gs)) + f->gs;  // + 0.5;
-            *bo += (po * (f->be - f->bs)) + f->bs;  // + 0.5;
-        }
-
-        f++;
-    }
-}
-
 static void md_rgb_matrix_config_override(int i) {
-    float ro = 0;
-    float go = 0;
-    float bo = 0;
-
-    float po = (led_animation_orientation) ? (float)g_led_config.point[i].y / 64.f * 100 : (float)g_led_config.point[i].x / 224.f * 100;
+    int32_t           rgb[3] = {0, 0, 0};  // << 8
+    uint16_t          po     = led_position[led_animation_orientation ? 1 : 0][i];
+    const led_band_t *bands;
+    uint8_t           count;
 
     uint8_t highest_active_layer = biton32(layer_state);
 
@@ -432,42 +388,27 @@ static void md_rgb_matrix_config_override(int i) {
             }
 
             if (led_cur_instruction->flags & LED_FLAG_USE_RGB) {
-                ro = led_cur_instruction->r;
-                go = led_cur_instruction->g;
-                bo = led_cur_instruction->b;
+                rgb[0] = led_cur_instruction->r << 8;
+                rgb[1] = led_cur_instruction->g << 8;
+                rgb[2] = led_cur_instruction->b << 8;
             } else if (led_cur_instruction->flags & LED_FLAG_USE_PATTERN) {
-                led_run_pattern(led_setups[led_cur_instruction->pattern_id], &ro, &go, &bo, po);
+                bands = led_pattern_get(led_setups[led_cur_instruction->pattern_id], &count);
+                led_pattern_run(bands, count, rgb, po, led_shift, led_animation_direction);
             } else if (led_cur_instruction->flags & LED_FLAG_USE_ROTATE_PATTERN) {
-                led_run_pattern(led_setups[led_animation_id], &ro, &go, &bo, po);
+                bands = led_pattern_get(led_setups[led_animation_id], &count);
+                led_pattern_run(bands, count, rgb, po, led_shift, led_animation_direction);
             }
 
         next_iter:
             led_cur_instruction++;
         }
-
-        if (ro > 255)
-            ro = 255;
-        else if (ro < 0)
-            ro = 0;
-        if (go > 255)
-            go = 255;
-        else if (go < 0)
-            go = 0;
-        if (bo > 255)
-            bo = 255;
-        else if (bo < 0)
-            bo = 0;
-
-        if (led_animation_breathing) {
-            ro *= breathe_mult;
-            go *= breathe_mult;
-            bo *= breathe_mult;
-        }
     }
 
-    led_buffer[i].r = (uint8_t)ro;
-    led_buffer[i].g = (uint8_t)go;
-    led_buffer[i].b = (uint8_t)bo;
+    uint8_t out[3];
+    led_pattern_output(rgb, led_animation_breathing ? led_breathe : 1UL << 16, out);
+    led_buffer[i].r = out[0];
+    led_buffer[i].g = out[1];
+    led_buffer[i].b = out[2];
 }
 
 #    endif  // USE_MASSDROP_CONFIGURATOR
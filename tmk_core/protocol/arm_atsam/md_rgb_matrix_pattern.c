@@ -0,0 +1,168 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef USE_MASSDROP_CONFIGURATOR
+
+#    include "md_rgb_matrix_pattern.h"
+#    include <stddef.h>
+
+typedef struct {
+    const led_setup_t *setup;
+    uint8_t            first;
+    uint8_t            count;
+} led_pattern_slot_t;
+
+static led_band_t         led_pattern_bands[LED_PATTERN_BANDS];
+static led_pattern_slot_t led_pattern_cache[LED_PATTERN_CACHE_SIZE];
+static uint8_t            led_pattern_bands_used;
+static uint8_t            led_pattern_cache_used;
+
+/** \brief Position of an LED, in percent << 8, from its point in the LED config
+ *
+ * extent is where 100% is, 224 across the board and 64 down it.
+ */
+int32_t led_pattern_position(uint8_t point, uint8_t extent) { return (int32_t)point * LED_PATTERN_POSITION_MAX / extent; }
+
+/** \brief How far scrolling patterns have moved, in percent << 8
+ *
+ * Worked out once a frame.
+ */
+int32_t led_pattern_shift(float pomod) { return (int32_t)(pomod * 256.0f); }
+
+/** \brief Compiles the bands of a pattern, up to max of them
+ *
+ * Returns how many bands were written.
+ */
+uint8_t led_pattern_compile(const led_setup_t *f, led_band_t *bands, uint8_t max) {
+    uint8_t count = 0;
+
+    for (; f->end != 1 && count < max; f++, count++) {
+        led_band_t *band      = &bands[count];
+        uint8_t     rgb[3][2] = {{f->rs, f->re}, {f->gs, f->ge}, {f->bs, f->be}};
+        float       width     = f->he - f->hs;
+
+        band->hs = (int32_t)(f->hs * 256.0f);
+        band->he = (int32_t)(f->he * 256.0f);
+        band->ef = f->ef;
+        for (uint8_t c = 0; c < 3; c++) {
+            band->start[c] = rgb[c][0] << 8;
+            band->slope[c] = 0;
+            if (width > 0) {
+                // Color << 8 per 1/256 percent, << 14. Over the width of the band that comes to less
+                // than 255 << 22, the multiply in led_pattern_run() stays within 32 bits.
+                float slope = (rgb[c][1] - rgb[c][0]) * 16384.0f / width;
+                if (slope > INT32_MAX) {
+                    slope = INT32_MAX;
+                } else if (slope < -INT32_MAX) {
+                    slope = -INT32_MAX;
+                }
+                band->slope[c] = slope;
+            }
+        }
+    }
+    return count;
+}
+
+/** \brief The compiled bands of a pattern
+ *
+ * Patterns are compiled the first time they are asked for and kept until they no longer fit next
+ * to the others, or until led_pattern_reset(). Patterns with more than LED_PATTERN_BANDS bands are
+ * cut short.
+ */
+const led_band_t *led_pattern_get(const led_setup_t *f, uint8_t *count) {
+    for (uint8_t i = 0; i < led_pattern_cache_used; i++) {
+        if (led_pattern_cache[i].setup == f) {
+            *count = led_pattern_cache[i].count;
+            return &led_pattern_bands[led_pattern_cache[i].first];
+        }
+    }
+
+    uint8_t needed = 0;
+    for (const led_setup_t *b = f; b->end != 1 && needed < LED_PATTERN_BANDS; b++) {
+        needed++;
+    }
+    if (led_pattern_cache_used == LED_PATTERN_CACHE_SIZE || led_pattern_bands_used + needed > LED_PATTERN_BANDS) {
+        led_pattern_reset();
+    }
+
+    led_pattern_slot_t *slot = &led_pattern_cache[led_pattern_cache_used++];
+    slot->setup              = f;
+    slot->first              = led_pattern_bands_used;
+    slot->count              = led_pattern_compile(f, &led_pattern_bands[slot->first], needed);
+    led_pattern_bands_used += slot->count;
+
+    *count = slot->count;
+    return &led_pattern_bands[slot->first];
+}
+
+// Forgets the compiled patterns, for patterns changed at run time
+void led_pattern_reset(void) {
+    led_pattern_bands_used = 0;
+    led_pattern_cache_used = 0;
+}
+
+/** \brief Adds the bands of a pattern to the color of the LED at pos
+ *
+ * rgb is red, green and blue << 8. shift is how far scrolling bands have moved, reverse swaps the
+ * directions they scroll in.
+ */
+void led_pattern_run(const led_band_t *bands, uint8_t count, int32_t *rgb, int32_t pos, int32_t shift, bool reverse) {
+    for (const led_band_t *band = bands; band < bands + count; band++) {
+        int32_t po = pos;
+
+        // Add in any moving effects
+        if ((!reverse && band->ef & EF_SCR_R) || (reverse && (band->ef & EF_SCR_L))) {
+            po -= shift;
+        } else if ((!reverse && band->ef & EF_SCR_L) || (reverse && (band->ef & EF_SCR_R))) {
+            po += shift;
+        }
+        if (po > LED_PATTERN_POSITION_MAX) {
+            po -= LED_PATTERN_POSITION_MAX;
+        } else if (po < 0) {
+            po += LED_PATTERN_POSITION_MAX;
+        }
+
+        if (po < band->hs || po > band->he) {
+            continue;
+        }
+
+        for (uint8_t c = 0; c < 3; c++) {
+            int32_t value = band->start[c] + (((po - band->hs) * band->slope[c]) >> 14);
+
+            // Add in any color effects
+            if (band->ef & EF_OVER) {
+                rgb[c] = value;
+            } else if (band->ef & EF_SUBTRACT) {
+                rgb[c] -= value;
+            } else {
+                rgb[c] += value;
+            }
+        }
+    }
+}
+
+/** \brief Clamps the color of an LED and scales it for breathing
+ *
+ * breathe is the brightness << 16, 1 << 16 when not breathing.
+ */
+void led_pattern_output(const int32_t *rgb, uint32_t breathe, uint8_t *out) {
+    for (uint8_t c = 0; c < 3; c++) {
+        uint32_t value = rgb[c] < 0 ? 0 : rgb[c] > (255 << 8) ? (255 << 8) : rgb[c];
+        out[c]         = (value * breathe) >> 24;
+    }
+}
+
+#endif  // USE_MASSDROP_CONFIGURATOR
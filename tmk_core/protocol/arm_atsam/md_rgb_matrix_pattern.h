@@ -0,0 +1,78 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Fixed point engine for the Massdrop configurator patterns.
+ *
+ * A pattern is a list of color bands over the width (or height) of the board, given in percent as
+ * floats. Each band is compiled once into a table of integer start colors and slopes, and LEDs are
+ * then colored from their position without a float operation or a division. Positions are percent
+ * times 256, colors are kept times 256 until the end.
+ */
+
+#define EF_NONE 0x00000000      // No effect
+#define EF_OVER 0x00000001      // Overwrite any previous color information with new
+#define EF_SCR_L 0x00000002     // Scroll left
+#define EF_SCR_R 0x00000004     // Scroll right
+#define EF_SUBTRACT 0x00000008  // Subtract color values
+
+typedef struct led_setup_s {
+    float    hs;   // Band begin at percent
+    float    he;   // Band end at percent
+    uint8_t  rs;   // Red start value
+    uint8_t  re;   // Red end value
+    uint8_t  gs;   // Green start value
+    uint8_t  ge;   // Green end value
+    uint8_t  bs;   // Blue start value
+    uint8_t  be;   // Blue end value
+    uint32_t ef;   // Animation and color effects
+    uint8_t  end;  // Set to signal end of the setup
+} led_setup_t;
+
+#define LED_PATTERN_POSITION_MAX (100 << 8)
+
+// A band of a pattern, ready to be run
+typedef struct {
+    int32_t  hs;        // Band begin, percent << 8
+    int32_t  he;        // Band end, percent << 8
+    int32_t  start[3];  // Red, green and blue at the beginning of the band, << 8
+    int32_t  slope[3];  // Change of red, green and blue per position step, << 14
+    uint32_t ef;
+} led_band_t;
+
+// Bands compiled for all patterns in use, patterns that do not fit any more push out the others
+#ifndef LED_PATTERN_BANDS
+#    define LED_PATTERN_BANDS 64
+#endif
+
+#ifndef LED_PATTERN_CACHE_SIZE
+#    define LED_PATTERN_CACHE_SIZE 8
+#endif
+
+int32_t led_pattern_position(uint8_t point, uint8_t extent);
+int32_t led_pattern_shift(float pomod);
+uint8_t led_pattern_compile(const led_setup_t *f, led_band_t *bands, uint8_t max);
+
+const led_band_t *led_pattern_get(const led_setup_t *f, uint8_t *count);
+void              led_pattern_reset(void);
+
+void led_pattern_run(const led_band_t *bands, uint8_t count, int32_t *rgb, int32_t pos, int32_t shift, bool reverse);
+void led_pattern_output(const int32_t *rgb, uint32_t breathe, uint8_t *out);
@@ -18,7 +18,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef RGB_MATRIX_ENABLE
 #    ifdef USE_MASSDROP_CONFIGURATOR
 
-#        include "md_rgb_matrix.h"
+#        include "md_rgb_matrix_pattern.h"
 
 // Teal <-> Salmon
 led_setup_t leds_teal_salmon[] = {
@@ -28,8 +28,10 @@
 #include <ch.h>
 #include <hal.h>
 #include <string.h>
+#include <stdarg.h>
 
 #include "usb_main.h"
+#include "ring_buffer.h"
 
 #include "host.h"
 #include "debug.h"
@@ -39,6 +41,7 @@
 #    include "led.h"
 #endif
 #include "wait.h"
+#include "timer.h"
 #include "usb_descriptor.h"
 #include "usb_driver.h"
 
@@ -52,6 +55,10 @@ extern keymap_config_t keymap_config;
 #    include "joystick.h"
 #endif
 
+#ifdef MIDI_ENABLE
+#    include "midi_queue.h"
+#endif
+
 /* ---------------------------------------------------------
  *       Global interface variables and declarations
  * ---------------------------------------------------------
@@ -369,36 +376,19 @@ static usb_driver_configs_t drivers = {
  * ---------------------------------------------------------
  */
 
+// events are pushed from the USB interrupt and popped from the main loop
 #define USB_EVENT_QUEUE_SIZE 16
-usbevent_t event_queue[USB_EVENT_QUEUE_SIZE];
-uint8_t    event_queue_head;
-uint8_t    event_queue_tail;
+RING_BUFFER_DEFINE(usb_events, usbevent_t, USB_EVENT_QUEUE_SIZE)
+static usb_events_t event_queue;
 
 void usb_event_queue_init(void) {
     // Initialise the event queue
-    memset(&event_queue, 0, sizeof(event_queue));
-    event_queue_head = 0;
-    event_queue_tail = 0;
+    usb_events_init(&event_queue);
 }
 
-static inline bool usb_event_queue_enqueue(usbevent_t event) {
-    uint8_t next = (event_queue_head + 1) % USB_EVENT_QUEUE_SIZE;
-    if (next == event_queue_tail) {
-        return false;
-    }
-    event_queue[event_queue_head] = event;
-    event_queue_head              = next;
-    return true;
-}
+static inline bool usb_event_queue_enqueue(usbevent_t event) { return usb_events_push(&event_queue, event); }
 
-static inline bool usb_event_queue_dequeue(usbevent_t *event) {
-    if (event_queue_head == event_queue_tail) {
-        return false;
-    }
-    *event           = event_queue[event_queue_tail];
-    event_queue_tail = (event_queue_tail + 1) % USB_EVENT_QUEUE_SIZE;
-    return true;
-}
+static inline bool usb_event_queue_dequeue(usbevent_t *event) { return usb_events_pop(&event_queue, event); }
 
 static inline void usb_event_suspend_handler(void) {
 #ifdef SLEEP_LED_ENABLE
@@ -929,12 +919,131 @@ void send_consumer(uint16_t data) {
 
 #ifdef CONSOLE_ENABLE
 
+/* Output is collected in a RAM ring and written to the endpoint from console_task()
+ * in full packets, so printing never waits for the host. When the ring is full the
+ * output is dropped and counted instead.
+ */
+#    ifndef CONSOLE_BUFFER_SIZE
+#        define CONSOLE_BUFFER_SIZE 256
+#    endif
+#    ifndef CONSOLE_FLUSH_TIMEOUT
+#        define CONSOLE_FLUSH_TIMEOUT 5
+#    endif
+
+RING_BUFFER_DEFINE(console_buf, uint8_t, CONSOLE_BUFFER_SIZE)
+static console_buf_t   console_buf;
+static console_stats_t console_stats;
+static uint8_t         console_packet[CONSOLE_EPSIZE];
+static uint8_t         console_packet_len  = 0;
+static uint8_t         console_packet_sent = 0;
+static uint16_t        console_last_flush  = 0;
+
 int8_t sendchar(uint8_t c) {
-    // The previous implmentation had timeouts, but I think it's better to just slow down
-    // and make sure that everything is transferred, rather than dropping stuff
-    return chnWrite(&drivers.console_driver.driver, &c, 1);
+    if (!console_buf_push(&console_buf, c)) {
+        console_stats.dropped_bytes++;
+        return -1;
+    }
+    return 0;
+}
+
+#    ifdef CONSOLE_DEFERRED_FORMAT
+#        ifndef CONSOLE_DEFERRED_QUEUE_SIZE
+#            define CONSOLE_DEFERRED_QUEUE_SIZE 32
+#        endif
+#        ifndef CONSOLE_DEFERRED_LINE_SIZE
+#            if CONSOLE_BUFFER_SIZE > 64
+#                define CONSOLE_DEFERRED_LINE_SIZE 64
+#            else
+#                define CONSOLE_DEFERRED_LINE_SIZE (CONSOLE_BUFFER_SIZE - 1)
+#            endif
+#        endif
+// A line is only formatted once the console buffer has room for all of it,
+// and the buffer holds one byte less than its size
+#        if CONSOLE_DEFERRED_LINE_SIZE > CONSOLE_BUFFER_SIZE - 1
+#            error "CONSOLE_DEFERRED_LINE_SIZE must be smaller than CONSOLE_BUFFER_SIZE"
+#        endif
+
+/* Only the format pointer and the raw arguments are queued, formatting happens in
+ * console_task(). Arguments are stored as 32 bit words, which matches how integers,
+ * characters and pointers are passed on the supported MCUs, so %s arguments have to
+ * outlive the call (string literals and static buffers). 64 bit integers and doubles
+ * do not fit, so %ll, %f, %e and %g can not be used.
+ */
+typedef struct {
+    const char *fmt;
+    uint32_t    args[CONSOLE_DEFERRED_MAX_ARGS];
+} console_message_t;
+
+RING_BUFFER_DEFINE(console_messages, console_message_t, CONSOLE_DEFERRED_QUEUE_SIZE)
+static console_messages_t console_messages;
+
+int console_printf_deferred(uint8_t argc, const char *fmt, ...) {
+    console_message_t entry = {.fmt = fmt};
+    va_list           va;
+
+    va_start(va, fmt);
+    for (uint8_t i = 0; i < argc && i < CONSOLE_DEFERRED_MAX_ARGS; i++) {
+        entry.args[i] = va_arg(va, uint32_t);
+    }
+    va_end(va);
+
+    if (!console_messages_push(&console_messages, entry)) {
+        console_stats.dropped_messages++;
+        return -1;
+    }
+    return 0;
+}
+
+static void console_format_deferred(void) {
+    console_message_t entry;
+    char              line[CONSOLE_DEFERRED_LINE_SIZE];
+
+    while (console_buf_free(&console_buf) >= sizeof(line) && console_messages_pop(&console_messages, &entry)) {
+        int len = snprintf(line, sizeof(line), entry.fmt, entry.args[0], entry.args[1], entry.args[2], entry.args[3], entry.args[4], entry.args[5], entry.args[6], entry.args[7]);
+        if (len >= (int)sizeof(line)) {
+            len = sizeof(line) - 1;
+            console_stats.truncated_messages++;
+        }
+        if (len > 0) {
+            console_buf_push_bulk(&console_buf, (uint8_t *)line, len);
+        }
+    }
+}
+#    endif
+
+static void console_output_task(bool force) {
+#    ifdef CONSOLE_DEFERRED_FORMAT
+    console_format_deferred();
+#    endif
+
+    while (true) {
+        if (console_packet_len == 0) {
+            uint8_t count = console_buf_count(&console_buf);
+            if (count == 0) {
+                break;
+            }
+            // give a partial packet a moment to fill up while output is streaming
+            if (count < CONSOLE_EPSIZE && !force && timer_elapsed(console_last_flush) < CONSOLE_FLUSH_TIMEOUT) {
+                break;
+            }
+            console_packet_len  = console_buf_pop_bulk(&console_buf, console_packet, CONSOLE_EPSIZE);
+            console_packet_sent = 0;
+        }
+
+        console_packet_sent += chnWriteTimeout(&drivers.console_driver.driver, &console_packet[console_packet_sent], console_packet_len - console_packet_sent, TIME_IMMEDIATE);
+        if (console_packet_sent < console_packet_len) {
+            // endpoint busy, try again on the next pass
+            break;
+        }
+        console_packet_len = 0;
+        console_last_flush = timer_read();
+    }
 }
 
+void console_flush_output(void) { console_output_task(true); }
+
+const console_stats_t *console_get_stats(void) { return &console_stats; }
+
 // Just a dummy function for now, this could be exposed as a weak function
 // Or connected to the actual QMK console
 static void console_receive(uint8_t *data, uint8_t length) {
@@ -951,6 +1060,8 @@ void console_task(void) {
             console_receive(buffer, size);
         }
     } while (size > 0);
+
+    console_output_task(false);
 }
 
 #endif /* CONSOLE_ENABLE */
@@ -987,6 +1098,31 @@ void raw_hid_task(void) {
 
 void send_midi_packet(MIDI_EventPacket_t *event) { chnWrite(&drivers.midi_driver.driver, (uint8_t *)event, sizeof(MIDI_EventPacket_t)); }
 
+// A packet the endpoint only took part of, its last midi_remainder_length bytes are still to be sent
+static midi_queue_packet_t midi_remainder;
+static uint8_t             midi_remainder_length = 0;
+
+uint8_t send_midi_packets(const midi_queue_packet_t *packets, uint8_t count) {
+    if (midi_remainder_length) {
+        midi_remainder_length -= chnWriteTimeout(&drivers.midi_driver.driver, (const uint8_t *)&midi_remainder + sizeof(midi_remainder) - midi_remainder_length, midi_remainder_length, TIME_IMMEDIATE);
+        if (midi_remainder_length) {
+            // endpoint busy, try again on the next pass
+            return 0;
+        }
+    }
+
+    size_t  sent         = chnWriteTimeout(&drivers.midi_driver.driver, (const uint8_t *)packets, count * sizeof(midi_queue_packet_t), TIME_IMMEDIATE);
+    uint8_t packets_sent = sent / sizeof(midi_queue_packet_t);
+    uint8_t partial      = sent % sizeof(midi_queue_packet_t);
+    if (partial) {
+        // keep the rest of the packet and finish it first next time, the queue counts it as sent
+        midi_remainder        = packets[packets_sent];
+        midi_remainder_length = sizeof(midi_queue_packet_t) - partial;
+        packets_sent++;
+    }
+    return packets_sent;
+}
+
 bool recv_midi_packet(MIDI_EventPacket_t *const event) {
     size_t size = chnReadTimeout(&drivers.midi_driver.driver, (uint8_t *)event, sizeof(MIDI_EventPacket_t), TIME_IMMEDIATE);
     return size == sizeof(MIDI_EventPacket_t);
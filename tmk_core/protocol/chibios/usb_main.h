@@ -98,4 +98,12 @@ int8_t sendchar(uint8_t c);
 /* Flush output (send everything immediately) */
 void console_flush_output(void);
 
+typedef struct {
+    uint32_t dropped_bytes;       // output lost because the buffer was full
+    uint32_t dropped_messages;    // deferred messages lost because the queue was full
+    uint32_t truncated_messages;  // deferred messages cut to CONSOLE_DEFERRED_LINE_SIZE
+} console_stats_t;
+
+const console_stats_t *console_get_stats(void);
+
 #endif /* CONSOLE_ENABLE */
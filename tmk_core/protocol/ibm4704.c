@@ -7,6 +7,12 @@ Copyright 2010,2011,2012,2013 Jun WAKO <wakojun@gmail.com>
 #include "ring_buffer.h"
 #include "ibm4704.h"
 
+#ifndef RBUF_SIZE
+#    define RBUF_SIZE 32
+#endif
+RING_BUFFER_DEFINE(rbuf, uint8_t, RBUF_SIZE)
+static rbuf_t rbuf;
+
 #define WAIT(stat, us, err)      \
     do {                         \
         if (!wait_##stat(us)) {  \
@@ -98,15 +104,17 @@ ERROR:
 
 /* wait forever to receive data */
 uint8_t ibm4704_recv_response(void) {
-    while (!rbuf_has_data()) {
+    uint8_t data;
+    while (!rbuf_pop(&rbuf, &data)) {
         _delay_ms(1);
     }
-    return rbuf_dequeue();
+    return data;
 }
 
 uint8_t ibm4704_recv(void) {
-    if (rbuf_has_data()) {
-        return rbuf_dequeue();
+    uint8_t data;
+    if (rbuf_pop(&rbuf, &data)) {
+        return data;
     } else {
         return -1;
     }
@@ -161,7 +169,7 @@ ISR(IBM4704_INT_VECT) {
         case STOP:
             // Data:Low
             WAIT(data_lo, 100, state);
-            if (!rbuf_enqueue(data)) {
+            if (!rbuf_push(&rbuf, data)) {
                 print("rbuf: full\n");
             }
             ibm4704_error = IBM4704_ERR_NONE;
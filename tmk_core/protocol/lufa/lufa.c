@@ -912,6 +912,17 @@ USB_ClassInfo_MIDI_Device_t USB_MIDI_Interface = {
 
 void send_midi_packet(MIDI_EventPacket_t *event) { MIDI_Device_SendEventPacket(&USB_MIDI_Interface, event); }
 
+_Static_assert(sizeof(midi_queue_packet_t) == sizeof(MIDI_EventPacket_t), "midi_queue_packet_t has to match MIDI_EventPacket_t");
+
+uint8_t send_midi_packets(const midi_queue_packet_t *packets, uint8_t count) {
+    uint8_t sent = 0;
+    while (sent < count && MIDI_Device_SendEventPacket(&USB_MIDI_Interface, (const MIDI_EventPacket_t *)&packets[sent]) == ENDPOINT_RWSTREAM_NoError) {
+        sent++;
+    }
+    MIDI_Device_Flush(&USB_MIDI_Interface);
+    return sent;
+}
+
 bool recv_midi_packet(MIDI_EventPacket_t *const event) { return MIDI_Device_ReceiveEventPacket(&USB_MIDI_Interface, event); }
 
 #endif
@@ -1,63 +1,62 @@
 #pragma once
-// A simple ringbuffer holding Size elements of type T
-template <typename T, uint8_t Size>
+
+#include "ring_buffer.h"
+
+// A lock-free single producer, single consumer ringbuffer holding Size - 1
+// elements of type T. The indices are published the same way as the ones
+// from ring_buffer.h, but wrap with a compare instead of a mask, so Size
+// does not have to be a power of two.
+template <typename T, uint16_t Size>
 class RingBuffer {
+  static_assert(Size >= 2 && Size <= 256, "RingBuffer size must be between 2 and 256");
+
  protected:
   T buf_[Size];
-  uint8_t head_{0}, tail_{0};
- public:
-  inline uint8_t nextPosition(uint8_t position) {
-    return (position + 1) % Size;
-  }
+  ring_buffer_index_t idx_{0, 0};
 
-  inline uint8_t prevPosition(uint8_t position) {
-    if (position == 0) {
-      return Size - 1;
-    }
-    return position - 1;
+  static inline uint8_t nextPosition(uint8_t position) {
+    return position + 1 == Size ? 0 : position + 1;
   }
 
+ public:
   inline bool enqueue(const T &item) {
-    static_assert(Size > 1, "RingBuffer size must be > 1");
-    uint8_t next = nextPosition(head_);
-    if (next == tail_) {
+    uint8_t head = idx_.head;
+    uint8_t next = nextPosition(head);
+    if (next == __atomic_load_n(&idx_.tail, __ATOMIC_ACQUIRE)) {
       // Full
       return false;
     }
 
-    buf_[head_] = item;
-    head_ = next;
+    buf_[head] = item;
+    __atomic_store_n(&idx_.head, next, __ATOMIC_RELEASE);
     return true;
   }
 
   inline bool get(T &dest, bool commit = true) {
-    auto tail = tail_;
-    if (tail == head_) {
+    uint8_t tail = idx_.tail;
+    if (tail == __atomic_load_n(&idx_.head, __ATOMIC_ACQUIRE)) {
       // No more data
       return false;
     }
 
     dest = buf_[tail];
-    tail = nextPosition(tail);
 
     if (commit) {
-      tail_ = tail;
+      __atomic_store_n(&idx_.tail, nextPosition(tail), __ATOMIC_RELEASE);
     }
     return true;
   }
 
-  inline bool empty() const { return head_ == tail_; }
+  inline bool empty() { return size() == 0; }
 
-  inline uint8_t size() const {
-    int diff = head_ - tail_;
-    if (diff >= 0) {
-      return diff;
-    }
-    return Size + diff;
+  inline uint8_t size() {
+    uint8_t head = __atomic_load_n(&idx_.head, __ATOMIC_ACQUIRE);
+    uint8_t tail = idx_.tail;
+    return head >= tail ? head - tail : Size - tail + head;
   }
 
   inline T& front() {
-    return buf_[tail_];
+    return buf_[idx_.tail];
   }
 
   inline bool peek(T &item) {
@@ -30,7 +30,7 @@ void midi_process_byte(MidiDevice* device, uint8_t input);
 void midi_device_init(MidiDevice* device) {
     device->input_state = IDLE;
     device->input_count = 0;
-    bytequeue_init(&device->input_queue, device->input_queue_data, MIDI_INPUT_QUEUE_LENGTH);
+    midi_input_queue_init(&device->input_queue);
 
     // three byte funcs
     device->input_cc_callback           = NULL;
@@ -58,10 +58,7 @@ void midi_device_init(MidiDevice* device) {
     device->pre_input_process_callback = NULL;
 }
 
-void midi_device_input(MidiDevice* device, uint8_t cnt, uint8_t* input) {
-    uint8_t i;
-    for (i = 0; i < cnt; i++) bytequeue_enqueue(&device->input_queue, input[i]);
-}
+void midi_device_input(MidiDevice* device, uint8_t cnt, uint8_t* input) { midi_input_queue_push_bulk(&device->input_queue, input, cnt); }
 
 void midi_device_set_send_func(MidiDevice* device, midi_var_byte_func_t send_func) { device->send_func = send_func; }
 
@@ -71,14 +68,12 @@ void midi_device_process(MidiDevice* device) {
     // call the pre_input_process_callback if there is one
     if (device->pre_input_process_callback) device->pre_input_process_callback(device);
 
-    // pull stuff off the queue and process
-    byteQueueIndex_t len = bytequeue_length(&device->input_queue);
-    uint16_t         i;
-    // TODO limit number of bytes processed?
-    for (i = 0; i < len; i++) {
-        uint8_t val = bytequeue_get(&device->input_queue, 0);
+    // pull stuff off the queue and process, only what is there now so input
+    // arriving from an interrupt while processing waits for the next call
+    uint8_t len = midi_input_queue_count(&device->input_queue);
+    uint8_t val;
+    while (len-- && midi_input_queue_pop(&device->input_queue, &val)) {
         midi_process_byte(device, val);
-        bytequeue_remove(&device->input_queue, 1);
     }
 }
 
@@ -47,8 +47,14 @@ extern "C" {
  */
 
 #include "midi_function_types.h"
-#include "bytequeue/bytequeue.h"
-#define MIDI_INPUT_QUEUE_LENGTH 192
+#include "ring_buffer.h"
+
+// must be a power of two, one byte is kept free, so the default holds 255 bytes
+#ifndef MIDI_INPUT_QUEUE_LENGTH
+#    define MIDI_INPUT_QUEUE_LENGTH 256
+#endif
+
+RING_BUFFER_DEFINE(midi_input_queue, uint8_t, MIDI_INPUT_QUEUE_LENGTH)
 
 typedef enum { IDLE, ONE_BYTE_MESSAGE = 1, TWO_BYTE_MESSAGE = 2, THREE_BYTE_MESSAGE = 3, SYSEX_MESSAGE } input_state_t;
 
@@ -102,8 +108,7 @@ struct _midi_device {
     uint16_t      input_count;
 
     // for queueing data between the input and the processing functions
-    uint8_t     input_queue_data[MIDI_INPUT_QUEUE_LENGTH];
-    byteQueue_t input_queue;
+    midi_input_queue_t input_queue;
 };
 
 /**
@@ -0,0 +1,212 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "midi_queue.h"
+#include "midi.h"
+#include "ring_buffer.h"
+#include "timer.h"
+
+#define MIDI_EVENT(cable, command) (((cable) << 4) | ((command) >> 4))
+
+typedef struct {
+    uint16_t            time;  // when it was queued, or when it was due
+    midi_queue_packet_t packet;
+} midi_queue_entry_t;
+
+RING_BUFFER_DEFINE(midi_output_queue, midi_queue_entry_t, MIDI_QUEUE_SIZE)
+
+static midi_output_queue_t    midi_output_queue;
+static midi_queue_entry_t     midi_schedule[MIDI_QUEUE_SCHEDULE_SIZE];  // sorted by time
+static uint8_t                midi_schedule_count;
+static midi_queue_send_func_t midi_send_func;
+static midi_queue_policy_t    midi_policy = {MIDI_QUEUE_FLUSH_PACKETS, MIDI_QUEUE_FLUSH_TIMEOUT};
+static midi_queue_stats_t     midi_stats;
+
+// Whether time a comes before time b, allowing for the timer wrapping around
+static inline bool midi_time_before(uint16_t a, uint16_t b) { return (int16_t)(a - b) < 0; }
+
+void midi_queue_init(midi_queue_send_func_t send_func) {
+    midi_send_func = send_func;
+    midi_output_queue_init(&midi_output_queue);
+    midi_schedule_count = 0;
+}
+
+/** \brief Turn a MIDI message, or three bytes of a sysex message, into a USB-MIDI event packet
+ *
+ * Returns false if cnt is not valid for a sysex message.
+ */
+bool midi_queue_encode(midi_queue_packet_t *packet, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    packet->data1 = byte0;
+    packet->data2 = byte1;
+    packet->data3 = byte2;
+
+    uint8_t cable = 0;
+
+    // if the length is undefined we assume it is a SYSEX message
+    if (midi_packet_length(byte0) == UNDEFINED) {
+        switch (cnt) {
+            case 3:
+                if (byte2 == SYSEX_END)
+                    packet->event = MIDI_EVENT(cable, SYSEX_ENDS_IN_3);
+                else
+                    packet->event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
+                break;
+            case 2:
+                if (byte1 == SYSEX_END)
+                    packet->event = MIDI_EVENT(cable, SYSEX_ENDS_IN_2);
+                else
+                    packet->event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
+                break;
+            case 1:
+                if (byte0 == SYSEX_END)
+                    packet->event = MIDI_EVENT(cable, SYSEX_ENDS_IN_1);
+                else
+                    packet->event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
+                break;
+            default:
+                return false;  // invalid cnt
+        }
+    } else {
+        // deal with 'system common' messages
+        // TODO are there any more?
+        switch (byte0 & 0xF0) {
+            case MIDI_SONGPOSITION:
+                packet->event = MIDI_EVENT(cable, SYS_COMMON_3);
+                break;
+            case MIDI_SONGSELECT:
+            case MIDI_TC_QUARTERFRAME:
+                packet->event = MIDI_EVENT(cable, SYS_COMMON_2);
+                break;
+            default:
+                packet->event = MIDI_EVENT(cable, byte0);
+                break;
+        }
+    }
+    return true;
+}
+
+// Hands up to one batch to the driver, returns false if it took less than it was given
+static bool midi_queue_send_batch(uint16_t now) {
+    midi_queue_packet_t packets[MIDI_QUEUE_BATCH];
+    midi_queue_entry_t  entry;
+    uint8_t             count = midi_output_queue_count(&midi_output_queue);
+    if (count > MIDI_QUEUE_BATCH) count = MIDI_QUEUE_BATCH;
+
+    for (uint8_t i = 0; i < count; i++) {
+        midi_output_queue_peek_at(&midi_output_queue, i, &entry);
+        packets[i] = entry.packet;
+    }
+
+    uint8_t sent = midi_send_func ? midi_send_func(packets, count) : count;
+    if (sent) midi_stats.transfers++;
+
+    for (uint8_t i = 0; i < sent && midi_output_queue_pop(&midi_output_queue, &entry); i++) {
+        uint16_t latency = now - entry.time;
+        midi_stats.packets++;
+        midi_stats.total_latency += latency;
+        if (latency > midi_stats.max_latency) midi_stats.max_latency = latency;
+    }
+    return sent == count;
+}
+
+/** \brief Queue a packet to be sent by midi_queue_task()
+ *
+ * If the queue is full, what is already queued is written out first. The packet is dropped when
+ * the driver will not take any of it.
+ */
+bool midi_queue_push(midi_queue_packet_t packet) {
+    midi_queue_entry_t entry = {.time = timer_read(), .packet = packet};
+
+    if (!midi_output_queue_free(&midi_output_queue)) {
+        midi_queue_send_batch(entry.time);
+    }
+    if (!midi_output_queue_push(&midi_output_queue, entry)) {
+        midi_stats.dropped++;
+        return false;
+    }
+    return true;
+}
+
+/** \brief Send a packet at the given time (timer_read() ms)
+ *
+ * Packets due at the same time go out in the order they were scheduled. Returns false if the
+ * schedule is full.
+ */
+bool midi_queue_schedule(midi_queue_packet_t packet, uint16_t time) {
+    if (midi_schedule_count == MIDI_QUEUE_SCHEDULE_SIZE) {
+        midi_stats.dropped++;
+        return false;
+    }
+
+    uint8_t i = midi_schedule_count++;
+    for (; i > 0 && midi_time_before(time, midi_schedule[i - 1].time); i--) {
+        midi_schedule[i] = midi_schedule[i - 1];
+    }
+    midi_schedule[i] = (midi_queue_entry_t){.time = time, .packet = packet};
+    return true;
+}
+
+bool midi_queue_schedule_message(uint16_t time, uint8_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
+    midi_queue_packet_t packet;
+    return midi_queue_encode(&packet, cnt, byte0, byte1, byte2) && midi_queue_schedule(packet, time);
+}
+
+/** \brief Move due packets to the queue and write it out as the policy says
+ */
+void midi_queue_task(void) {
+    uint16_t now = timer_read();
+
+    uint8_t due = 0;
+    while (due < midi_schedule_count && !midi_time_before(now, midi_schedule[due].time) && midi_output_queue_push(&midi_output_queue, midi_schedule[due])) {
+        due++;
+    }
+    if (due) {
+        midi_schedule_count -= due;
+        for (uint8_t i = 0; i < midi_schedule_count; i++) {
+            midi_schedule[i] = midi_schedule[i + due];
+        }
+    }
+
+    midi_queue_entry_t oldest;
+    while (midi_output_queue_peek(&midi_output_queue, &oldest)) {
+        if (midi_output_queue_count(&midi_output_queue) < midi_policy.flush_packets && (uint16_t)(now - oldest.time) < midi_policy.flush_timeout) {
+            break;
+        }
+        if (!midi_queue_send_batch(now)) {
+            break;  // the driver is busy, try again next time
+        }
+    }
+}
+
+/** \brief Write out everything queued now, regardless of the policy
+ *
+ * Scheduled packets that are not due yet stay scheduled.
+ */
+void midi_queue_flush(void) {
+    uint16_t now = timer_read();
+    while (!midi_output_queue_empty(&midi_output_queue) && midi_queue_send_batch(now)) {
+    }
+}
+
+uint8_t midi_queue_count(void) { return midi_output_queue_count(&midi_output_queue); }
+
+midi_queue_policy_t midi_queue_get_policy(void) { return midi_policy; }
+
+void midi_queue_set_policy(midi_queue_policy_t policy) { midi_policy = policy; }
+
+const midi_queue_stats_t *midi_queue_get_stats(void) { return &midi_stats; }
+
+void midi_queue_clear_stats(void) { midi_stats = (midi_queue_stats_t){0}; }
@@ -0,0 +1,118 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * MIDI output queue.
+ *
+ * USB-MIDI event packets are queued and handed to the USB driver in batches of up to a full
+ * endpoint, instead of one transfer per packet. Packets can also be scheduled for a later time,
+ * they are kept in time order and moved to the output queue once they are due.
+ *
+ * midi_queue_task() writes the queue out when it holds at least flush_packets packets, or when
+ * its oldest packet has waited flush_timeout ms. The defaults write everything out on every call,
+ * so packets produced during one scan go out together in as few transfers as possible.
+ *
+ * Batching is the only saving there is: every USB-MIDI event packet is 4 bytes with the full status
+ * byte, so the running status compression of serial MIDI does not apply.
+ */
+
+// Packets per transfer, one 64 byte endpoint by default
+#ifndef MIDI_QUEUE_BATCH
+#    define MIDI_QUEUE_BATCH 16
+#endif
+
+// Packets waiting to be sent (power of two, one slot is kept free)
+#ifndef MIDI_QUEUE_SIZE
+#    define MIDI_QUEUE_SIZE 32
+#endif
+
+// Packets scheduled for later, the sequencer needs room for two steps of eight tracks
+#ifndef MIDI_QUEUE_SCHEDULE_SIZE
+#    ifdef SEQUENCER_ENABLE
+#        define MIDI_QUEUE_SCHEDULE_SIZE 32
+#    else
+#        define MIDI_QUEUE_SCHEDULE_SIZE 16
+#    endif
+#endif
+
+#ifndef MIDI_QUEUE_FLUSH_PACKETS
+#    define MIDI_QUEUE_FLUSH_PACKETS 1
+#endif
+
+#ifndef MIDI_QUEUE_FLUSH_TIMEOUT
+#    define MIDI_QUEUE_FLUSH_TIMEOUT 0
+#endif
+
+// USB-MIDI code index numbers, shifted into the high nibble
+#define SYSEX_START_OR_CONT 0x40
+#define SYSEX_ENDS_IN_1 0x50
+#define SYSEX_ENDS_IN_2 0x60
+#define SYSEX_ENDS_IN_3 0x70
+
+#define SYS_COMMON_1 0x50
+#define SYS_COMMON_2 0x20
+#define SYS_COMMON_3 0x30
+
+// Same layout as MIDI_EventPacket_t
+typedef struct {
+    uint8_t event;  // cable number and code index
+    uint8_t data1;
+    uint8_t data2;
+    uint8_t data3;
+} midi_queue_packet_t;
+
+// Sends up to count packets in one transfer, returns how many were taken
+typedef uint8_t (*midi_queue_send_func_t)(const midi_queue_packet_t *packets, uint8_t count);
+
+typedef struct {
+    uint8_t  flush_packets;  // write out once this many packets are waiting
+    uint16_t flush_timeout;  // or once the oldest one has waited this long (ms)
+} midi_queue_policy_t;
+
+typedef struct {
+    uint32_t packets;        // packets sent
+    uint32_t transfers;      // calls to the send function
+    uint32_t dropped;        // packets lost because the queue was full and the driver busy
+    uint32_t total_latency;  // sum of the time each packet waited, from queueing or its scheduled time (ms)
+    uint16_t max_latency;    // longest time a packet waited (ms)
+} midi_queue_stats_t;
+
+void midi_queue_init(midi_queue_send_func_t send_func);
+bool midi_queue_encode(midi_queue_packet_t *packet, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2);
+bool midi_queue_push(midi_queue_packet_t packet);
+bool midi_queue_schedule(midi_queue_packet_t packet, uint16_t time);
+bool midi_queue_schedule_message(uint16_t time, uint8_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2);
+void midi_queue_task(void);
+void midi_queue_flush(void);
+uint8_t midi_queue_count(void);
+
+midi_queue_policy_t       midi_queue_get_policy(void);
+void                      midi_queue_set_policy(midi_queue_policy_t policy);
+const midi_queue_stats_t *midi_queue_get_stats(void);
+void                      midi_queue_clear_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
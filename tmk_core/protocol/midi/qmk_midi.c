@@ -14,65 +14,11 @@
 
 MidiDevice midi_device;
 
-#define SYSEX_START_OR_CONT 0x40
-#define SYSEX_ENDS_IN_1 0x50
-#define SYSEX_ENDS_IN_2 0x60
-#define SYSEX_ENDS_IN_3 0x70
-
-#define SYS_COMMON_1 0x50
-#define SYS_COMMON_2 0x20
-#define SYS_COMMON_3 0x30
-
 static void usb_send_func(MidiDevice* device, uint16_t cnt, uint8_t byte0, uint8_t byte1, uint8_t byte2) {
-    MIDI_EventPacket_t event;
-    event.Data1 = byte0;
-    event.Data2 = byte1;
-    event.Data3 = byte2;
-
-    uint8_t cable = 0;
-
-    // if the length is undefined we assume it is a SYSEX message
-    if (midi_packet_length(byte0) == UNDEFINED) {
-        switch (cnt) {
-            case 3:
-                if (byte2 == SYSEX_END)
-                    event.Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_3);
-                else
-                    event.Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
-                break;
-            case 2:
-                if (byte1 == SYSEX_END)
-                    event.Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_2);
-                else
-                    event.Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
-                break;
-            case 1:
-                if (byte0 == SYSEX_END)
-                    event.Event = MIDI_EVENT(cable, SYSEX_ENDS_IN_1);
-                else
-                    event.Event = MIDI_EVENT(cable, SYSEX_START_OR_CONT);
-                break;
-            default:
-                return;  // invalid cnt
-        }
-    } else {
-        // deal with 'system common' messages
-        // TODO are there any more?
-        switch (byte0 & 0xF0) {
-            case MIDI_SONGPOSITION:
-                event.Event = MIDI_EVENT(cable, SYS_COMMON_3);
-                break;
-            case MIDI_SONGSELECT:
-            case MIDI_TC_QUARTERFRAME:
-                event.Event = MIDI_EVENT(cable, SYS_COMMON_2);
-                break;
-            default:
-                event.Event = MIDI_EVENT(cable, byte0);
-                break;
-        }
+    midi_queue_packet_t packet;
+    if (midi_queue_encode(&packet, cnt, byte0, byte1, byte2)) {
+        midi_queue_push(packet);
     }
-
-    send_midi_packet(&event);
 }
 
 static void usb_get_midi(MidiDevice* device) {
@@ -166,6 +112,7 @@ void setup_midi(void) {
     midi_init();
 #endif
     midi_device_init(&midi_device);
+    midi_queue_init(send_midi_packets);
     midi_device_set_send_func(&midi_device, usb_send_func);
     midi_device_set_pre_input_process_func(&midi_device, usb_get_midi);
     midi_register_fallthrough_callback(&midi_device, fallthrough_callback);
@@ -36,7 +36,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #if defined(CONSOLE_ENABLE)
-#    define RBUF_SIZE 128
 #    include "ring_buffer.h"
 #endif
 
@@ -171,8 +170,11 @@ void raw_hid_task(void) {
 #    define CONSOLE_BUFFER_SIZE 32
 #    define CONSOLE_EPSIZE 8
 
+RING_BUFFER_DEFINE(console_buf, uint8_t, 128)
+static console_buf_t console_buf;
+
 int8_t sendchar(uint8_t c) {
-    rbuf_enqueue(c);
+    console_buf_push(&console_buf, c);
     return 0;
 }
 
@@ -194,16 +196,13 @@ void console_task(void) {
         return;
     }
 
-    if (!rbuf_has_data()) {
+    if (console_buf_empty(&console_buf)) {
         return;
     }
 
     // Send in chunks of 8 padded to 32
-    char    send_buf[CONSOLE_BUFFER_SIZE] = {0};
-    uint8_t send_buf_count                = 0;
-    while (rbuf_has_data() && send_buf_count < CONSOLE_EPSIZE) {
-        send_buf[send_buf_count++] = rbuf_dequeue();
-    }
+    char send_buf[CONSOLE_BUFFER_SIZE] = {0};
+    console_buf_pop_bulk(&console_buf, (uint8_t *)send_buf, CONSOLE_EPSIZE);
 
     char *temp = send_buf;
     for (uint8_t i = 0; i < 4; i++) {